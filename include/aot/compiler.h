@@ -17,9 +17,13 @@
 #include "common/configure.h"
 #include "common/errcode.h"
 #include "common/filesystem.h"
+#include "common/profile.h"
 #include "common/span.h"
+#include "common/symbol.h"
 
 #include <mutex>
+#include <string>
+#include <utility>
 
 namespace WasmEdge {
 namespace AOT {
@@ -32,23 +36,80 @@ public:
   Expect<void> compile(Span<const Byte> Data, const AST::Module &Module,
                        std::filesystem::path OutputPath);
 
+  /// Set the execution profile of the module recorded by the interpreter. The
+  /// branches and the indirect calls are optimized with the profile in the
+  /// later compilations. The profile should outlive the compilations.
+  void setProfile(const ModuleProfile *P) noexcept { Profile = P; }
+
+  /// Compile the validated module in memory with the LLVM ORC JIT, and set
+  /// the symbols of the compiled functions into the module. The intrinsics
+  /// table of the module should be set by the caller before instantiation.
+  Expect<void> compileJIT(AST::Module &Module);
+
+  /// Compiled code of a single function.
+  struct FunctionCode {
+    Symbol<AST::FunctionType::Wrapper> Wrapper;
+    Symbol<void> Function;
+  };
+
+  /// Compile the validated body of a single function in memory with the LLVM
+  /// ORC JIT for the tier-up of the interpreter. The function type indices and
+  /// the global types include the imported ones. The other functions are
+  /// called through the intrinsics table.
+  Expect<FunctionCode>
+  compileFunction(Span<const AST::FunctionType> Types,
+                  Span<const uint32_t> FuncTypeIdxs,
+                  Span<const ValType> GlobalTypes, uint32_t FuncIdx,
+                  Span<const std::pair<uint32_t, ValType>> Locals,
+                  AST::InstrView Instrs,
+                  const AST::Module::IntrinsicsTable &Intrinsics);
+
   struct CompileContext;
 
 private:
   void compile(const AST::ImportSection &ImportSection);
   void compile(const AST::ExportSection &ExportSection);
   void compile(const AST::TypeSection &TypeSection);
+  void compile(Span<const AST::FunctionType> FuncTypes);
   void compile(const AST::GlobalSection &GlobalSection);
   void compile(const AST::MemorySection &MemorySection,
                const AST::DataSection &DataSection);
   void compile(const AST::TableSection &TableSection,
                const AST::ElementSection &ElementSection);
+  /// Generate the IR of the sections. The function bodies are generated only
+  /// for the code segments in [Begin, End).
+  void compileModule(const AST::Module &Module,
+                     Span<const AST::InstrVec> LazyBodies, size_t Begin,
+                     size_t End);
   void compile(const AST::FunctionSection &FunctionSection,
-               const AST::CodeSection &CodeSection);
+               const AST::CodeSection &CodeSection,
+               Span<const AST::InstrVec> LazyBodies, size_t Begin,
+               size_t End);
+
+  /// Compile the function bodies of the code segments in [Begin, End) into
+  /// the object. The other functions are declared only, and the shared
+  /// symbols are defined in the partition of the index 0.
+  Expect<void> compilePartition(Span<const Byte> Data,
+                                const AST::Module &Module,
+                                Span<const AST::InstrVec> LazyBodies,
+                                const std::filesystem::path &OutputPath,
+                                size_t Begin, size_t End, uint32_t Index,
+                                uint32_t Count, std::string &Object);
+
+  /// Compile the partitions of the indices in parallel. The partition of the
+  /// index I covers the code segments in [Bounds[I], Bounds[I + 1]).
+  Expect<void> compilePartitions(Span<const Byte> Data,
+                                 const AST::Module &Module,
+                                 Span<const AST::InstrVec> LazyBodies,
+                                 const std::filesystem::path &OutputPath,
+                                 Span<const size_t> Bounds,
+                                 Span<const uint32_t> Indices,
+                                 Span<std::string> Objects);
 
   std::mutex Mutex;
   CompileContext *Context;
   const Configure Conf;
+  const ModuleProfile *Profile = nullptr;
 };
 
 } // namespace AOT
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/aot/jit.h - JIT library class definition -----------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the JITLibrary class, which holds the
+/// code compiled in memory by the LLVM ORC JIT.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/executable.h"
+#include "common/symbol.h"
+
+#include <memory>
+
+namespace llvm::orc {
+class LLJIT;
+} // namespace llvm::orc
+
+namespace WasmEdge {
+namespace AOT {
+
+/// Holder class for the JIT compiled code. The memory of the code is released
+/// with the JIT instance when the last symbol is released.
+class JITLibrary : public Executable {
+public:
+  JITLibrary(std::unique_ptr<llvm::orc::LLJIT> JIT) noexcept;
+  ~JITLibrary() noexcept override;
+
+  /// Look up the symbol by the name in the module. Return the null symbol if
+  /// not found.
+  template <typename T> Symbol<T> get(const char *Name) noexcept {
+    return createSymbol<T>(reinterpret_cast<T *>(getSymbolAddr(Name)));
+  }
+
+private:
+  void *getSymbolAddr(const char *Name) const noexcept;
+
+  std::unique_ptr<llvm::orc::LLJIT> JIT;
+};
+
+} // namespace AOT
+} // namespace WasmEdge
@@ -110,6 +110,9 @@ typedef struct WasmEdge_CompilerContext WasmEdge_CompilerContext;
 /// Opaque struct of WasmEdge loader.
 typedef struct WasmEdge_LoaderContext WasmEdge_LoaderContext;
 
+/// Opaque struct of WasmEdge loader stream.
+typedef struct WasmEdge_LoaderStreamContext WasmEdge_LoaderStreamContext;
+
 /// Opaque struct of WasmEdge validator.
 typedef struct WasmEdge_ValidatorContext WasmEdge_ValidatorContext;
 
@@ -122,6 +125,9 @@ typedef struct WasmEdge_StoreContext WasmEdge_StoreContext;
 /// Opaque struct of WasmEdge module instance.
 typedef struct WasmEdge_ModuleInstanceContext WasmEdge_ModuleInstanceContext;
 
+/// Opaque struct of WasmEdge module template.
+typedef struct WasmEdge_ModuleTemplateContext WasmEdge_ModuleTemplateContext;
+
 /// Opaque struct of WasmEdge function instance.
 typedef struct WasmEdge_FunctionInstanceContext
     WasmEdge_FunctionInstanceContext;
@@ -241,6 +247,45 @@ WASMEDGE_CAPI_EXPORT extern void WasmEdge_LogSetDebugLevel(void);
 
 // <<<<<<<< WasmEdge logging functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>> WasmEdge allocator functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+/// Set the maximum count of the pooled linear memory regions.
+///
+/// The address space reserved for a linear memory is kept in a process-wide
+/// pool when the memory instance is destroyed, and reused by the next memory
+/// instance instead of being unmapped and mapped again. The pooled regions
+/// hold no physical memory. The pool is disabled by default. The pooled
+/// regions exceeding the new limit are released.
+///
+/// \param Limit the maximum count of the pooled regions. 0 for disabling.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_AllocatorSetPoolLimit(const uint32_t Limit);
+
+/// Reserve the linear memory regions into the pool in advance.
+///
+/// \param Count the count of the regions to reserve, which is capped by the
+/// pool limit.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_AllocatorReservePool(const uint32_t Count);
+
+/// Get the count of the regions currently in the pool.
+///
+/// \returns the count of the pooled regions.
+WASMEDGE_CAPI_EXPORT extern uint32_t WasmEdge_AllocatorGetPoolSize(void);
+
+/// Get the count of the linear memory allocations which reused a pooled
+/// region.
+///
+/// \returns the hit count of the pool.
+WASMEDGE_CAPI_EXPORT extern uint64_t WasmEdge_AllocatorGetPoolHitCount(void);
+
+/// Get the count of the linear memory allocations which reserved a new region.
+///
+/// \returns the miss count of the pool.
+WASMEDGE_CAPI_EXPORT extern uint64_t WasmEdge_AllocatorGetPoolMissCount(void);
+
+// <<<<<<<< WasmEdge allocator functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 // >>>>>>>> WasmEdge value functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 /// Generate the I32 WASM value.
@@ -534,6 +579,11 @@ WasmEdge_LimitIsEqual(const WasmEdge_Limit Lim1, const WasmEdge_Limit Lim2);
 /// The caller owns the object and should call `WasmEdge_ConfigureDelete` to
 /// destroy it.
 ///
+/// The executors and the VMs created with the configuration install the
+/// handlers of the faults, which turn the faults of the WASM execution into the
+/// traps. The handlers installed by the caller after creating them should
+/// forward the faults they don't handle to the previous handlers.
+///
 /// \returns pointer to the context, NULL if failed.
 WASMEDGE_CAPI_EXPORT extern WasmEdge_ConfigureContext *
 WasmEdge_ConfigureCreate(void);
@@ -645,6 +695,293 @@ WasmEdge_ConfigureSetMaxMemoryPage(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern uint32_t
 WasmEdge_ConfigureGetMaxMemoryPage(const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the register-based IR option of the interpreter.
+///
+/// When enabled, the function bodies are lowered into the register-based IR
+/// when instantiating, and the interpreter executes the lowered code. The
+/// functions which cannot be lowered and the execution with instruction
+/// counting or gas measuring still use the original interpreter.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsRegisterIR the boolean value to determine to lower the functions
+/// into the register-based IR or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetRegisterIR(WasmEdge_ConfigureContext *Cxt,
+                                const bool IsRegisterIR);
+
+/// Get the register-based IR option of the interpreter.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to lower the functions into the
+/// register-based IR or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsRegisterIR(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the instruction fusion option of the interpreter.
+///
+/// When enabled, the common instruction sequences in the function bodies are
+/// fused into the internal instructions when instantiating. The fusion is
+/// skipped when the instruction counting or gas measuring is enabled. With
+/// the register-based IR enabled, the functions lowered into the IR are not
+/// fused.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsFusion the boolean value to determine to fuse the instructions or
+/// not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetInstructionFusion(WasmEdge_ConfigureContext *Cxt,
+                                       const bool IsFusion);
+
+/// Get the instruction fusion option of the interpreter.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to fuse the instructions or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsInstructionFusion(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the lazy loading option of the loader.
+///
+/// When enabled, the loader records the function bodies as the byte ranges of
+/// the binary instead of decoding them, and each function body is decoded and
+/// validated on its first call. The errors of the function bodies are reported
+/// when they are called instead of when loading or validating.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsLazy the boolean value to determine to defer the decoding of the
+/// function bodies or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetLazyLoading(WasmEdge_ConfigureContext *Cxt,
+                                 const bool IsLazy);
+
+/// Get the lazy loading option of the loader.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to defer the decoding of the
+/// function bodies or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsLazyLoading(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the thread count for decoding and validating the function bodies.
+///
+/// The function bodies of the code section are decoded by the loader and
+/// validated by the validator in parallel if the thread count is greater than
+/// 1. Default is 1.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the thread count.
+/// \param Threads the thread count for decoding and validating the function
+/// bodies.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetLoadingThreads(WasmEdge_ConfigureContext *Cxt,
+                                    const uint32_t Threads);
+
+/// Get the thread count for decoding and validating the function bodies.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the thread count.
+///
+/// \returns the thread count for decoding and validating the function bodies.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetLoadingThreads(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the module caching option of the loader.
+///
+/// When enabled, the loaded and validated modules are stored into the cache
+/// directory under the WasmEdge home directory, which are keyed by the hash of
+/// the binaries and the proposals. Loading the same binaries again restores the
+/// validated modules from the cache and skips the loading and the validation.
+/// The modules compiled by the AOT compiler and the lazy loading are not
+/// cached.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsCaching the boolean value to determine to cache the validated
+/// modules or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetModuleCaching(WasmEdge_ConfigureContext *Cxt,
+                                   const bool IsCaching);
+
+/// Get the module caching option of the loader.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to cache the validated modules or
+/// not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsModuleCaching(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the JIT option of the VM.
+///
+/// The validated modules are compiled in memory with the LLVM ORC JIT by the
+/// VM, and the compiled functions are run instead of the interpreter. The
+/// option is ignored if the AOT runtime is not built. Default is false.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsJIT the boolean value to determine to compile the modules with the
+/// JIT or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetJIT(WasmEdge_ConfigureContext *Cxt, const bool IsJIT);
+
+/// Get the JIT option of the VM.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to compile the modules with the JIT
+/// or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsJIT(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the tiered execution option of the VM.
+///
+/// The functions are interpreted first, and the hot functions are compiled in
+/// the background threads with the LLVM ORC JIT. The compiled code is run from
+/// the next call of the functions. The option is ignored if the AOT runtime is
+/// not built, or the instruction counting or the cost measuring is enabled.
+/// Default is false.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsTiering the boolean value to determine to tier up the hot
+/// functions or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetTiering(WasmEdge_ConfigureContext *Cxt,
+                             const bool IsTiering);
+
+/// Get the tiered execution option of the VM.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to tier up the hot functions or
+/// not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsTiering(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the call count of a function to be compiled in the tiered execution.
+///
+/// Default is 1000.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the threshold.
+/// \param Count the call count of a function to be compiled.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetTierUpCallThreshold(WasmEdge_ConfigureContext *Cxt,
+                                         const uint32_t Count);
+
+/// Get the call count of a function to be compiled in the tiered execution.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the threshold.
+///
+/// \returns the call count of a function to be compiled.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetTierUpCallThreshold(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the taken loop back-edge count of a function to be compiled in the
+/// tiered execution.
+///
+/// Default is 100000.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the threshold.
+/// \param Count the taken loop back-edge count of a function to be compiled.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetTierUpLoopThreshold(WasmEdge_ConfigureContext *Cxt,
+                                         const uint32_t Count);
+
+/// Get the taken loop back-edge count of a function to be compiled in the
+/// tiered execution.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the threshold.
+///
+/// \returns the taken loop back-edge count of a function to be compiled.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetTierUpLoopThreshold(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the count of the background threads compiling the hot functions in the
+/// tiered execution.
+///
+/// Default is 1.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the thread count.
+/// \param Threads the count of the compiling threads.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetTierUpThreads(WasmEdge_ConfigureContext *Cxt,
+                                   const uint32_t Threads);
+
+/// Get the count of the background threads compiling the hot functions in the
+/// tiered execution.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the thread count.
+///
+/// \returns the count of the compiling threads.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetTierUpThreads(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the profiling option of recording the branches and the indirect call
+/// targets in the interpreter mode.
+///
+/// The recorded profiles can be written with `WasmEdge_VMStoreProfile` and
+/// used by the AOT compiler. The register-based IR, the instruction fusion,
+/// and the tiering are disabled for the profiled modules. The modules loaded
+/// from streams are not profiled.
+///
+/// Default is false.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsProfiling the boolean value to determine to record the profiles.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetProfiling(WasmEdge_ConfigureContext *Cxt,
+                               const bool IsProfiling);
+
+/// Get the profiling option of recording the branches and the indirect call
+/// targets in the interpreter mode.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns true if the profiling is enabled, false if not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsProfiling(const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the optimization level of AOT compiler.
 ///
 /// This function is thread-safe.
@@ -752,6 +1089,57 @@ WasmEdge_ConfigureCompilerSetInterruptible(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern bool
 WasmEdge_ConfigureCompilerIsInterruptible(const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the thread count of AOT compiler.
+///
+/// The functions are split into the partitions of the thread count, and the
+/// partitions are optimized and emitted in parallel and linked into the same
+/// output if the thread count is greater than 1. Default is 1.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the thread count.
+/// \param Jobs the thread count of the compilation in AOT compiler.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureCompilerSetJobs(WasmEdge_ConfigureContext *Cxt,
+                                  const uint32_t Jobs);
+
+/// Get the thread count of AOT compiler.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the thread count.
+///
+/// \returns the thread count of the compilation in AOT compiler.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureCompilerGetJobs(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the object caching option of AOT compiler.
+///
+/// The functions are grouped into the fragments by their contents, and the
+/// compiled objects of the fragments are cached on the disk. The later
+/// compilations only compile the fragments of the changed functions and link
+/// them with the cached objects. Default is false.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsCaching the boolean value to determine to cache the compiled
+/// objects or not when compilation in AOT compiler.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureCompilerSetObjectCaching(WasmEdge_ConfigureContext *Cxt,
+                                           const bool IsCaching);
+
+/// Get the object caching option of AOT compiler.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to cache the compiled objects or
+/// not when compilation in AOT compiler.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureCompilerIsObjectCaching(const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the instruction counting option.
 ///
 /// This function is thread-safe.
@@ -819,6 +1207,56 @@ WasmEdge_ConfigureStatisticsSetTimeMeasuring(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern bool WasmEdge_ConfigureStatisticsIsTimeMeasuring(
     const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the fusion counting option.
+///
+/// When enabled, the executed counts of the fused instructions are reported in
+/// the statistics.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsCount the boolean value to determine to count the executed fused
+/// instructions or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureStatisticsSetFusionCounting(WasmEdge_ConfigureContext *Cxt,
+                                              const bool IsCount);
+
+/// Get the fusion counting option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to count the executed fused
+/// instructions or not.
+WASMEDGE_CAPI_EXPORT extern bool WasmEdge_ConfigureStatisticsIsFusionCounting(
+    const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the tier-up counting option.
+///
+/// When enabled, the count of the functions compiled by the tiered execution
+/// is reported in the statistics.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsCount the boolean value to determine to count the compiled
+/// functions or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureStatisticsSetTierUpCounting(WasmEdge_ConfigureContext *Cxt,
+                                              const bool IsCount);
+
+/// Get the tier-up counting option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to count the compiled functions or
+/// not.
+WASMEDGE_CAPI_EXPORT extern bool WasmEdge_ConfigureStatisticsIsTierUpCounting(
+    const WasmEdge_ConfigureContext *Cxt);
+
 /// Deletion of the WasmEdge_ConfigureContext.
 ///
 /// This function is thread-safe.
@@ -1458,6 +1896,69 @@ WasmEdge_LoaderParseFromBuffer(WasmEdge_LoaderContext *Cxt,
                                WasmEdge_ASTModuleContext **Module,
                                const uint8_t *Buf, const uint32_t BufLen);
 
+/// Creation of the WasmEdge_LoaderStreamContext.
+///
+/// The stream receives the WASM binary incrementally by
+/// `WasmEdge_LoaderStreamPush`, and is parsed by
+/// `WasmEdge_LoaderParseFromStream` in another thread while the later bytes
+/// are still arriving. The caller owns the object and should call
+/// `WasmEdge_LoaderStreamDelete` to destroy it.
+///
+/// \returns pointer to context, NULL if failed.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_LoaderStreamContext *
+WasmEdge_LoaderStreamCreate(void);
+
+/// Append the bytes of the WASM binary into the stream.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_LoaderStreamContext.
+/// \param Buf the buffer of the bytes.
+/// \param BufLen the length of the buffer.
+///
+/// \returns true if succeeded, false if the stream has been finished or the
+/// capacity of the stream is exceeded.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_LoaderStreamPush(WasmEdge_LoaderStreamContext *Cxt,
+                          const uint8_t *Buf, const uint32_t BufLen);
+
+/// Mark the end of the WASM binary in the stream.
+///
+/// The parsing waits for the bytes until the stream is finished. This function
+/// is thread-safe.
+///
+/// \param Cxt the WasmEdge_LoaderStreamContext.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_LoaderStreamFinish(WasmEdge_LoaderStreamContext *Cxt);
+
+/// Deletion of the WasmEdge_LoaderStreamContext.
+///
+/// The stream is finished when deleting. The parsed AST modules keep the
+/// received bytes alive. After calling this function, the context will be
+/// destroyed and should __NOT__ be used.
+///
+/// \param Cxt the WasmEdge_LoaderStreamContext to destroy.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_LoaderStreamDelete(WasmEdge_LoaderStreamContext *Cxt);
+
+/// Load and parse the WASM module from a stream into WasmEdge_ASTModuleContext.
+///
+/// Load and parse the WASM module while the bytes are pushed into the stream
+/// by the other threads, and return a WasmEdge_ASTModuleContext as the result
+/// after the module is parsed. The caller owns the WasmEdge_ASTModuleContext
+/// object and should call `WasmEdge_ASTModuleDelete` to destroy it.
+///
+/// \param Cxt the WasmEdge_LoaderContext.
+/// \param [out] Module the output WasmEdge_ASTModuleContext if succeeded.
+/// \param StreamCxt the WasmEdge_LoaderStreamContext of the WASM binary.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_LoaderParseFromStream(WasmEdge_LoaderContext *Cxt,
+                               WasmEdge_ASTModuleContext **Module,
+                               WasmEdge_LoaderStreamContext *StreamCxt);
+
 /// Deletion of the WasmEdge_LoaderContext.
 ///
 /// After calling this function, the context will be destroyed and should
@@ -1576,6 +2077,64 @@ WASMEDGE_CAPI_EXPORT extern WasmEdge_Result WasmEdge_ExecutorRegister(
     WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
     WasmEdge_String ModuleName);
 
+/// Instantiate an AST Module and freeze it into a module template.
+///
+/// Instantiate an AST Module, and freeze the states of its tables, memories,
+/// globals, element segments, and data segments into a module template. The
+/// module instances cloned from the template by
+/// `WasmEdge_ExecutorInstantiateTemplate` skip the initialization, and their
+/// linear memories are mapped copy-on-write from the template if the platform
+/// supports it. The caller owns the object and should call
+/// `WasmEdge_ModuleTemplateDelete` to destroy it. The AST module should not be
+/// destroyed before the template. The module which imports tables, memories,
+/// or globals cannot be frozen.
+///
+/// \param Cxt the WasmEdge_ExecutorContext to instantiate the module.
+/// \param [out] TemplateCxt the output WasmEdge_ModuleTemplateContext if
+/// succeeded.
+/// \param StoreCxt the WasmEdge_StoreContext to link the imports.
+/// \param ASTCxt the WasmEdge AST Module context generated by loader or
+/// compiler.
+/// \param IsStarted true for running the start function before freezing,
+/// false for running it when every module instance is cloned.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result WasmEdge_ExecutorCreateTemplate(
+    WasmEdge_ExecutorContext *Cxt,
+    WasmEdge_ModuleTemplateContext **TemplateCxt,
+    WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
+    const bool IsStarted);
+
+/// Instantiate a module template into a module instance.
+///
+/// Clone a module instance from the module template, and return it as the
+/// result. The caller owns the object and should call
+/// `WasmEdge_ModuleInstanceDelete` to destroy it.
+///
+/// \param Cxt the WasmEdge_ExecutorContext to instantiate the module.
+/// \param [out] ModuleCxt the output WasmEdge_ModuleInstanceContext if
+/// succeeded.
+/// \param StoreCxt the WasmEdge_StoreContext to link the imports.
+/// \param TemplateCxt the WasmEdge_ModuleTemplateContext to clone.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_ExecutorInstantiateTemplate(
+    WasmEdge_ExecutorContext *Cxt, WasmEdge_ModuleInstanceContext **ModuleCxt,
+    WasmEdge_StoreContext *StoreCxt,
+    const WasmEdge_ModuleTemplateContext *TemplateCxt);
+
+/// Deletion of the WasmEdge_ModuleTemplateContext.
+///
+/// After calling this function, the context will be destroyed and should
+/// __NOT__ be used. The module instances cloned from it are not affected.
+///
+/// \param Cxt the WasmEdge_ModuleTemplateContext to destroy.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ModuleTemplateDelete(WasmEdge_ModuleTemplateContext *Cxt);
+
 /// Register a module instance into a store with exporting its module name.
 ///
 /// Register an existing module into the store with its module name.
@@ -3212,6 +3771,21 @@ WasmEdge_VMGetFunctionTypeRegistered(const WasmEdge_VMContext *Cxt,
 /// \param Cxt the WasmEdge_VMContext to reset.
 WASMEDGE_CAPI_EXPORT extern void WasmEdge_VMCleanup(WasmEdge_VMContext *Cxt);
 
+/// Write the execution profiles recorded by the VM into the profile file.
+///
+/// The profiling should be enabled by `WasmEdge_ConfigureSetProfiling`. The
+/// profiles are merged into the existing profile file.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_VMContext.
+/// \param Path the NULL-terminated C string of the profile file path.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_VMStoreProfile(const WasmEdge_VMContext *Cxt, const char *Path);
+
 /// Get the length of exported function list.
 ///
 /// This function is thread-safe.
@@ -18,12 +18,30 @@
 #include "common/types.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <vector>
 
 namespace WasmEdge {
+
+namespace Loader {
+class ModuleCache;
+}
+
 namespace AST {
 
 /// Instruction node class.
+///
+/// The instructions are stored in the fixed-size slots of 24 bytes, so that
+/// the branches can be resolved to the offsets of the instruction slots. The
+/// immediates larger than the slot, which are the label lists, the value type
+/// lists, the 128-bit constants, and the rare jump descriptors of the branches
+/// erasing more than 65535 values, are stored out of line in the pooled
+/// chunks. The chunks are shared by the instructions loaded by the same
+/// thread, which are mostly the instructions of the same function, and
+/// released when no instruction refers to them. Each instruction owns its own
+/// entry, so copying an instruction also copies the entry.
 class Instruction {
 public:
   struct JumpDescriptor {
@@ -37,37 +55,33 @@ public:
   /// Constructor assigns the OpCode and the Offset.
   Instruction(OpCode Byte, uint32_t Off = 0) noexcept
       : Offset(Off), Code(Byte) {
-#if defined(__x86_64__) || defined(__aarch64__)
-    Data.Num = static_cast<uint128_t>(0);
-#else
-    Data.Num.Low = static_cast<uint64_t>(0);
-    Data.Num.High = static_cast<uint64_t>(0);
-#endif
-    Flags.IsAllocLabelList = false;
-    Flags.IsAllocValTypeList = false;
+    std::fill(std::begin(Data.Raw), std::end(Data.Raw), 0U);
+    Meta.BlockCost = 0;
+    Meta.HandlerIndex = 0;
+    Flags.IsPooled = false;
+    Flags.IsBlockSync = false;
+    Flags.IsBlockValType = false;
+    Flags.PooledShift = 0;
   }
 
-  /// Copy constructor.
+  /// Copy constructor. The out-of-line immediates are copied.
   Instruction(const Instruction &Instr)
-      : Data(Instr.Data), Offset(Instr.Offset), Code(Instr.Code),
-        Flags(Instr.Flags) {
-    if (Flags.IsAllocLabelList) {
-      Data.BrTable.LabelList = new JumpDescriptor[Data.BrTable.LabelListSize];
-      std::copy_n(Instr.Data.BrTable.LabelList, Data.BrTable.LabelListSize,
-                  Data.BrTable.LabelList);
-    } else if (Flags.IsAllocValTypeList) {
-      Data.SelectT.ValTypeList = new ValType[Data.SelectT.ValTypeListSize];
-      std::copy_n(Instr.Data.SelectT.ValTypeList, Data.SelectT.ValTypeListSize,
-                  Data.SelectT.ValTypeList);
+      : Data(Instr.Data), Offset(Instr.Offset), Meta(Instr.Meta),
+        Code(Instr.Code), Flags(Instr.Flags), MemLane(Instr.MemLane) {
+    if (Flags.IsPooled) {
+      Flags.IsPooled = false;
+      const uint64_t Bytes = Instr.getPooledBytes();
+      Byte *Ptr = Pool::allocate(Bytes);
+      std::memcpy(Ptr, Instr.getPooled<Byte>(), static_cast<size_t>(Bytes));
+      setPooled(Ptr, Instr.Data.Pooled.Count, Instr.Flags.PooledShift);
     }
   }
 
   /// Move constructor.
-  Instruction(Instruction &&Instr)
-      : Data(Instr.Data), Offset(Instr.Offset), Code(Instr.Code),
-        Flags(Instr.Flags) {
-    Instr.Flags.IsAllocLabelList = false;
-    Instr.Flags.IsAllocValTypeList = false;
+  Instruction(Instruction &&Instr) noexcept
+      : Data(Instr.Data), Offset(Instr.Offset), Meta(Instr.Meta),
+        Code(Instr.Code), Flags(Instr.Flags), MemLane(Instr.MemLane) {
+    Instr.Flags.IsPooled = false;
   }
 
   /// Destructor.
@@ -82,18 +96,51 @@ public:
     return *this;
   }
 
-  /// Getter of OpCode.
+  /// Move assignment.
+  Instruction &operator=(Instruction &&Instr) noexcept {
+    Instruction Tmp(std::move(Instr));
+    Tmp.swap(*this);
+    return *this;
+  }
+
+  /// Getter and setter of OpCode.
   OpCode getOpCode() const noexcept { return Code; }
+  void setOpCode(OpCode Byte) noexcept { Code = Byte; }
 
   /// Getter of Offset.
   uint32_t getOffset() const noexcept { return Offset; }
 
+  /// Getter and setter of the precomputed cost of the block led by this
+  /// instruction. Zero for the instructions not leading a block. The cost is
+  /// not larger than MaxBlockCost.
+  uint32_t getBlockCost() const noexcept { return Meta.BlockCost; }
+  void setBlockCost(uint32_t Cost) noexcept { Meta.BlockCost = Cost; }
+  static inline constexpr const uint32_t MaxBlockCost = (1U << 24) - 1U;
+
+  /// Getter and setter of the handler index in the threaded dispatch, which is
+  /// assigned when the function is prepared. Zero for the fallback handler.
+  uint8_t getHandlerIndex() const noexcept { return Meta.HandlerIndex; }
+  void setHandlerIndex(uint8_t Idx) noexcept { Meta.HandlerIndex = Idx; }
+
+  /// Getter and setter of whether the gas should be synced at this block.
+  bool isBlockSync() const noexcept { return Flags.IsBlockSync; }
+  void setBlockSync(bool IsSync = true) noexcept { Flags.IsBlockSync = IsSync; }
+
   /// Getter and setter of block type.
-  BlockType getBlockType() const noexcept { return Data.Blocks.ResType; }
+  BlockType getBlockType() const noexcept {
+    if (Flags.IsBlockValType) {
+      return BlockType(static_cast<ValType>(Data.Blocks.ResType));
+    }
+    return BlockType(Data.Blocks.ResType);
+  }
   void setBlockType(ValType VType) noexcept {
-    Data.Blocks.ResType.setData(VType);
+    Data.Blocks.ResType = static_cast<uint32_t>(VType);
+    Flags.IsBlockValType = true;
+  }
+  void setBlockType(uint32_t Idx) noexcept {
+    Data.Blocks.ResType = Idx;
+    Flags.IsBlockValType = false;
   }
-  void setBlockType(uint32_t Idx) noexcept { Data.Blocks.ResType.setData(Idx); }
 
   /// Getter and setter of jump count to End instruction.
   uint32_t getJumpEnd() const noexcept { return Data.Blocks.JumpEnd; }
@@ -111,46 +158,58 @@ public:
   void setLabelListSize(uint32_t Size) {
     reset();
     if (Size > 0) {
-      Data.BrTable.LabelListSize = Size;
-      Data.BrTable.LabelList = new JumpDescriptor[Size];
-      Flags.IsAllocLabelList = true;
+      allocatePooled<JumpDescriptor>(Size);
     }
   }
   Span<const JumpDescriptor> getLabelList() const noexcept {
-    return Span<const JumpDescriptor>(
-        Data.BrTable.LabelList,
-        Flags.IsAllocLabelList ? Data.BrTable.LabelListSize : 0);
+    return Span<const JumpDescriptor>(getPooled<JumpDescriptor>(),
+                                      getPooledCount());
   }
   Span<JumpDescriptor> getLabelList() noexcept {
-    return Span<JumpDescriptor>(
-        Data.BrTable.LabelList,
-        Flags.IsAllocLabelList ? Data.BrTable.LabelListSize : 0);
+    return Span<JumpDescriptor>(getPooled<JumpDescriptor>(),
+                                getPooledCount());
   }
 
   /// Getter and setter of IsLast for End instruction.
   bool isLast() const noexcept { return Data.IsLast; }
   void setLast(bool Last = true) noexcept { Data.IsLast = Last; }
 
-  /// Getter and setter of Jump for Br* instruction.
-  const JumpDescriptor &getJump() const noexcept { return Data.Jump; }
-  JumpDescriptor &getJump() noexcept { return Data.Jump; }
+  /// Getter and setter of Jump for Br and Br_if instructions. The jump
+  /// descriptor is stored inline unless the stack erase range exceeds 16 bits.
+  JumpDescriptor getJump() const noexcept {
+    if (Flags.IsPooled) {
+      return *getPooled<JumpDescriptor>();
+    }
+    return JumpDescriptor{Data.Jump.TargetIndex, Data.Jump.StackEraseBegin,
+                          Data.Jump.StackEraseEnd, Data.Jump.PCOffset};
+  }
+  void setJump(const JumpDescriptor &Jump) {
+    reset();
+    if (Jump.StackEraseBegin <= UINT16_MAX &&
+        Jump.StackEraseEnd <= UINT16_MAX) {
+      Data.Jump.TargetIndex = Jump.TargetIndex;
+      Data.Jump.StackEraseBegin = static_cast<uint16_t>(Jump.StackEraseBegin);
+      Data.Jump.StackEraseEnd = static_cast<uint16_t>(Jump.StackEraseEnd);
+      Data.Jump.PCOffset = Jump.PCOffset;
+    } else {
+      std::memcpy(allocatePooled<JumpDescriptor>(1), &Jump,
+                  sizeof(JumpDescriptor));
+    }
+  }
 
   /// Getter and setter of selecting value types list.
   void setValTypeListSize(uint32_t Size) {
     reset();
     if (Size > 0) {
-      Data.SelectT.ValTypeListSize = Size;
-      Data.SelectT.ValTypeList = new ValType[Size];
-      Flags.IsAllocValTypeList = true;
+      allocatePooled<ValType>(Size);
     }
   }
   Span<const ValType> getValTypeList() const noexcept {
-    return Span<const ValType>(Data.SelectT.ValTypeList,
-                               Data.SelectT.ValTypeListSize);
+    return Span<const ValType>(getPooled<ValType>(),
+                               getPooledCount());
   }
   Span<ValType> getValTypeList() noexcept {
-    return Span<ValType>(Data.SelectT.ValTypeList,
-                         Data.SelectT.ValTypeListSize);
+    return Span<ValType>(getPooled<ValType>(), getPooledCount());
   }
 
   /// Getter and setter of target index.
@@ -161,6 +220,10 @@ public:
   uint32_t getSourceIndex() const noexcept { return Data.Indices.SourceIdx; }
   uint32_t &getSourceIndex() noexcept { return Data.Indices.SourceIdx; }
 
+  /// Getter and setter of the inline cache index of the indirect call.
+  uint32_t getCallCacheIndex() const noexcept { return Data.Indices.CacheIdx; }
+  void setCallCacheIndex(uint32_t Idx) noexcept { Data.Indices.CacheIdx = Idx; }
+
   /// Getter and setter of stack offset.
   uint32_t getStackOffset() const noexcept { return Data.Indices.StackOffset; }
   uint32_t &getStackOffset() noexcept { return Data.Indices.StackOffset; }
@@ -174,105 +237,169 @@ public:
   uint32_t &getMemoryOffset() noexcept { return Data.Memories.MemOffset; }
 
   /// Getter of memory lane.
-  uint8_t getMemoryLane() const noexcept { return Data.Memories.MemLane; }
-  uint8_t &getMemoryLane() noexcept { return Data.Memories.MemLane; }
+  uint8_t getMemoryLane() const noexcept { return MemLane; }
+  uint8_t &getMemoryLane() noexcept { return MemLane; }
 
-  /// Getter and setter of the constant value.
+  /// Getter and setter of the constant value. The constants wider than 64 bits
+  /// are stored out of line.
   ValVariant getNum() const noexcept {
-#if defined(__x86_64__) || defined(__aarch64__)
-    return ValVariant(Data.Num);
-#else
-    uint128_t N(Data.Num.High, Data.Num.Low);
+    uint64_t Parts[2] = {0, 0};
+    if (Flags.IsPooled) {
+      std::memcpy(Parts, getPooled<Byte>(), sizeof(Parts));
+    } else {
+      std::memcpy(Parts, Data.Num, sizeof(Data.Num));
+    }
+    uint128_t N;
+    std::memcpy(&N, Parts, sizeof(N));
     return ValVariant(N);
-#endif
   }
   void setNum(ValVariant N) noexcept {
-#if defined(__x86_64__) || defined(__aarch64__)
-    Data.Num = N.get<uint128_t>();
-#else
-    std::memcpy(&Data.Num, &N.get<uint128_t>(), sizeof(uint128_t));
-#endif
+    uint64_t Parts[2];
+    std::memcpy(Parts, &N.get<uint128_t>(), sizeof(Parts));
+    reset();
+    if (Parts[1] == 0) {
+      std::memcpy(Data.Num, Parts, sizeof(Data.Num));
+    } else {
+      std::memcpy(allocatePooled<uint64_t>(2), Parts, sizeof(Parts));
+    }
   }
 
 private:
+  friend class Loader::ModuleCache;
+
+  /// Reference-counted chunks of the out-of-line immediates. The entries are
+  /// allocated from the chunk owned by the current thread, and each entry holds
+  /// a reference of its chunk.
+  class Pool {
+  public:
+    /// Allocate the zero-initialized entry with one reference of its chunk.
+    static Byte *allocate(uint64_t Size);
+    /// Remove a reference of the chunk of the entry, and release the chunk
+    /// when no entry refers to it.
+    static void release(const Byte *Ptr) noexcept;
+  };
+
   /// Release allocated resources.
-  void reset() {
-    if (Flags.IsAllocLabelList) {
-      Data.BrTable.LabelListSize = 0;
-      delete[] Data.BrTable.LabelList;
-    } else if (Flags.IsAllocValTypeList) {
-      Data.SelectT.ValTypeListSize = 0;
-      delete[] Data.SelectT.ValTypeList;
+  void reset() noexcept {
+    if (Flags.IsPooled) {
+      Pool::release(getPooled<Byte>());
+      Flags.IsPooled = false;
     }
-    Flags.IsAllocLabelList = false;
-    Flags.IsAllocValTypeList = false;
   }
 
   /// Swap function.
   void swap(Instruction &Instr) noexcept {
     std::swap(Data, Instr.Data);
     std::swap(Offset, Instr.Offset);
+    std::swap(Meta, Instr.Meta);
     std::swap(Code, Instr.Code);
     std::swap(Flags, Instr.Flags);
+    std::swap(MemLane, Instr.MemLane);
   }
 
+  /// \name Helpers of the out-of-line immediates.
+  /// @{
+  template <typename T> T *getPooled() const noexcept {
+    T *Ptr = nullptr;
+    if (Flags.IsPooled) {
+      std::memcpy(&Ptr, Data.Pooled.Ptr, sizeof(Ptr));
+    }
+    return Ptr;
+  }
+  uint32_t getPooledCount() const noexcept {
+    return Flags.IsPooled ? Data.Pooled.Count : 0;
+  }
+  uint64_t getPooledBytes() const noexcept {
+    return static_cast<uint64_t>(Data.Pooled.Count) << Flags.PooledShift;
+  }
+  template <typename T> T *allocatePooled(uint32_t Count) {
+    static_assert(sizeof(T) <= 64 && (sizeof(T) & (sizeof(T) - 1)) == 0,
+                  "Unexpected size of the out-of-line immediates.");
+    uint8_t Shift = 0;
+    while ((static_cast<size_t>(1) << Shift) < sizeof(T)) {
+      ++Shift;
+    }
+    // Compute the size in 64 bits to prevent from the wrap around of the large
+    // label lists.
+    Byte *Ptr = Pool::allocate(static_cast<uint64_t>(Count) << Shift);
+    setPooled(Ptr, Count, Shift);
+    return reinterpret_cast<T *>(Ptr);
+  }
+  void setPooled(Byte *Ptr, uint32_t Count, uint8_t Shift) noexcept {
+    std::memcpy(Data.Pooled.Ptr, &Ptr, sizeof(Ptr));
+    Data.Pooled.Count = Count;
+    Flags.IsPooled = true;
+    Flags.PooledShift = Shift & 0x07U;
+  }
+  /// @}
+
   /// \name Data of instructions.
   /// @{
   union Inner {
-    // Type 1: BlockType, JumpEnd, and JumpElse.
+    // Type 1: BlockType, JumpEnd, and JumpElse. The block type is the value
+    // type if the IsBlockValType flag is set, or the type index otherwise.
     struct {
       uint32_t JumpEnd;
       uint32_t JumpElse;
-      BlockType ResType;
+      uint32_t ResType;
     } Blocks;
-    // Type 2: TargetIdx, SourceIdx and StackOffset.
+    // Type 2: TargetIdx, SourceIdx, and StackOffset or CacheIdx.
     struct {
       uint32_t TargetIdx;
       uint32_t SourceIdx;
-      uint32_t StackOffset;
+      union {
+        uint32_t StackOffset;
+        uint32_t CacheIdx;
+      };
     } Indices;
-    // Type 3: Jump.
-    JumpDescriptor Jump;
-    // Type 4: LabelList.
+    // Type 3: Out-of-line Jump, LabelList, ValTypeList, or 128-bit Num, and
+    // the count of the elements in the entry. The log2 of the element size is
+    // stored in the PooledShift flag. The pointer is stored as bytes to keep
+    // the 4-byte alignment of the slot.
     struct {
-      uint32_t LabelListSize;
-      JumpDescriptor *LabelList;
-    } BrTable;
-    // Type 5: RefType.
+      Byte Ptr[sizeof(void *)];
+      uint32_t Count;
+    } Pooled;
+    // Type 4: RefType.
     RefType ReferenceType;
-    // Type 6: ValTypeList.
-    struct {
-      uint32_t ValTypeListSize;
-      ValType *ValTypeList;
-    } SelectT;
-    // Type 7: TargetIdx, MemAlign, MemOffset, and MemLane.
+    // Type 5: TargetIdx, MemAlign, and MemOffset.
     struct {
       uint32_t TargetIdx;
       uint32_t MemAlign;
       uint32_t MemOffset;
-      uint8_t MemLane;
     } Memories;
-    // Type 8: Num.
-#if defined(__x86_64__) || defined(__aarch64__)
-    uint128_t Num;
-#else
-    struct {
-      uint64_t Low;
-      uint64_t High;
-    } Num;
-#endif
-    // Type 9: IsLast.
+    // Type 6: Num up to 64 bits.
+    uint32_t Num[2];
+    // Type 7: IsLast.
     bool IsLast;
+    // Type 8: Jump with the stack erase range fitting in 16 bits.
+    struct {
+      uint32_t TargetIndex;
+      uint16_t StackEraseBegin;
+      uint16_t StackEraseEnd;
+      int32_t PCOffset;
+    } Jump;
+    // Raw words for initialization.
+    uint32_t Raw[3];
   } Data;
   uint32_t Offset = 0;
+  struct {
+    uint32_t BlockCost : 24;
+    uint32_t HandlerIndex : 8;
+  } Meta;
   OpCode Code = OpCode::End;
   struct {
-    bool IsAllocLabelList : 1;
-    bool IsAllocValTypeList : 1;
+    bool IsPooled : 1;
+    bool IsBlockSync : 1;
+    bool IsBlockValType : 1;
+    uint8_t PooledShift : 3;
   } Flags;
+  uint8_t MemLane = 0;
   /// @}
 };
 
+static_assert(sizeof(Instruction) == 24, "Unexpected size of instructions.");
+
 // Type aliasing
 using InstrVec = std::vector<Instruction>;
 using InstrView = Span<const Instruction>;
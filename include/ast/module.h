@@ -15,12 +15,58 @@
 #pragma once
 
 #include "ast/section.h"
+#include "common/errcode.h"
 
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
+
+namespace Runtime::Instance {
+struct ModuleCode;
+}
+
 namespace AST {
 
+/// Decoder of the function bodies deferred by the lazy loading, which is set
+/// by the loader.
+class CodeDecoder {
+public:
+  virtual ~CodeDecoder() noexcept = default;
+
+  /// Decode the deferred function body at the offset in the binary. The body
+  /// should be kept alive by the holder of the code segment.
+  virtual Expect<InstrVec> decode(Span<const Byte> Body,
+                                  uint64_t Offset) const = 0;
+};
+
+/// Checker of the function bodies deferred by the lazy loading, which is set
+/// by the validator with the context of the validated module.
+class CodeChecker {
+public:
+  virtual ~CodeChecker() noexcept = default;
+
+  /// Validate the decoded function body with the function type index and the
+  /// local variables of the function.
+  virtual Expect<void>
+  validate(InstrView Instrs, uint32_t TypeIdx,
+           Span<const std::pair<uint32_t, ValType>> Locals) const = 0;
+};
+
+class Module;
+
+/// Writer of the validated module into the module cache, which is set by the
+/// loader and invoked by the validator.
+class CacheWriter {
+public:
+  virtual ~CacheWriter() noexcept = default;
+
+  /// Write the validated module.
+  virtual void write(const Module &Mod) const = 0;
+};
+
 /// AST Module node.
 class Module {
 public:
@@ -98,10 +144,54 @@ public:
     IntrSymbol = std::move(S);
   }
 
+  /// Getter and setter of the function code prepared by the executor, which is
+  /// shared by the module instances instantiated from this module.
+  std::shared_ptr<const Runtime::Instance::ModuleCode>
+  getPreparedCode() const noexcept {
+    return std::atomic_load(&PreparedCode);
+  }
+  void setPreparedCode(std::shared_ptr<const Runtime::Instance::ModuleCode>
+                           Code) const noexcept {
+    std::atomic_store(&PreparedCode, std::move(Code));
+  }
+
+  /// Getter and setter of the decoder and the checker of the function bodies
+  /// deferred by the lazy loading.
+  const std::shared_ptr<const CodeDecoder> &getCodeDecoder() const noexcept {
+    return Decoder;
+  }
+  void setCodeDecoder(std::shared_ptr<const CodeDecoder> D) noexcept {
+    Decoder = std::move(D);
+  }
+  const std::shared_ptr<const CodeChecker> &getCodeChecker() const noexcept {
+    return Checker;
+  }
+  void setCodeChecker(std::shared_ptr<const CodeChecker> C) noexcept {
+    Checker = std::move(C);
+  }
+
+  /// Getter and setter of the writer of the module cache.
+  const std::shared_ptr<const CacheWriter> &getCacheWriter() const noexcept {
+    return Writer;
+  }
+  void setCacheWriter(std::shared_ptr<const CacheWriter> W) noexcept {
+    Writer = std::move(W);
+  }
+
+  /// Getter and setter of the hash of the binary, which keys the execution
+  /// profiles. Empty if the profiling is disabled.
+  const std::string &getHash() const noexcept { return Hash; }
+  void setHash(std::string H) noexcept { Hash = std::move(H); }
+
   /// Getter and setter of validated flag.
   bool getIsValidated() const noexcept { return IsValidated; }
   void setIsValidated(bool V = true) noexcept { IsValidated = V; }
 
+  /// Getter and setter of the flag of the module restored from the module
+  /// cache, which has been validated before caching.
+  bool getIsCached() const noexcept { return IsCached; }
+  void setIsCached(bool C = true) noexcept { IsCached = C; }
+
 private:
   /// \name Data of Module node.
   /// @{
@@ -132,9 +222,31 @@ private:
   Symbol<const IntrinsicsTable *> IntrSymbol;
   /// @}
 
-  /// \name Validated flag.
+  /// \name Prepared code of the executor.
+  /// @{
+  mutable std::shared_ptr<const Runtime::Instance::ModuleCode> PreparedCode;
+  /// @}
+
+  /// \name Decoder and checker of the lazy loading.
+  /// @{
+  std::shared_ptr<const CodeDecoder> Decoder;
+  std::shared_ptr<const CodeChecker> Checker;
+  /// @}
+
+  /// \name Writer of the module cache.
+  /// @{
+  std::shared_ptr<const CacheWriter> Writer;
+  /// @}
+
+  /// \name Hash of the binary for the profiling.
+  /// @{
+  std::string Hash;
+  /// @}
+
+  /// \name Validated and cached flags.
   /// @{
   bool IsValidated = false;
+  bool IsCached = false;
   /// @}
 };
 
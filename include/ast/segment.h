@@ -17,6 +17,7 @@
 #include "ast/expression.h"
 #include "ast/type.h"
 
+#include <memory>
 #include <vector>
 
 namespace WasmEdge {
@@ -99,6 +100,30 @@ public:
   const auto &getSymbol() const noexcept { return FuncSymbol; }
   void setSymbol(Symbol<void> S) noexcept { FuncSymbol = std::move(S); }
 
+  /// Return true if the function body is deferred by the lazy loading and not
+  /// decoded into the expression.
+  bool isLazy() const noexcept { return !Body.empty(); }
+
+  /// Getter of the deferred function body, which is a view into the binary.
+  Span<const Byte> getBody() const noexcept { return Body; }
+
+  /// Getter of the offset of the deferred function body in the binary.
+  uint64_t getBodyOffset() const noexcept { return BodyOffset; }
+
+  /// Getter of the holder which keeps the whole binary alive.
+  const std::shared_ptr<const void> &getBodyHolder() const noexcept {
+    return Holder;
+  }
+
+  /// Setter of the deferred function body. The holder should keep the whole
+  /// binary alive, where the body is at the offset.
+  void setBody(Span<const Byte> Bytes, uint64_t Offset,
+               std::shared_ptr<const void> BinaryHolder) noexcept {
+    Body = Bytes;
+    BodyOffset = Offset;
+    Holder = std::move(BinaryHolder);
+  }
+
 private:
   /// \name Data of CodeSegment node.
   /// @{
@@ -106,6 +131,13 @@ private:
   std::vector<std::pair<uint32_t, ValType>> Locals;
   Symbol<void> FuncSymbol;
   /// @}
+
+  /// \name Deferred function body of the lazy loading.
+  /// @{
+  Span<const Byte> Body;
+  uint64_t BodyOffset = 0;
+  std::shared_ptr<const void> Holder;
+  /// @}
 };
 
 /// AST DataSegment node.
@@ -124,14 +156,32 @@ public:
 
   /// Getter of data.
   Span<const Byte> getData() const noexcept { return Data; }
-  std::vector<Byte> &getData() noexcept { return Data; }
+
+  /// Getter of the holder which keeps the data alive.
+  const std::shared_ptr<const void> &getDataHolder() const noexcept {
+    return Holder;
+  }
+
+  /// Setter of data. The data is referred without copying if the holder which
+  /// keeps it alive is given, otherwise it is copied.
+  void setData(Span<const Byte> Init,
+               std::shared_ptr<const void> DataHolder = nullptr) {
+    if (!DataHolder) {
+      auto Copy = std::make_shared<std::vector<Byte>>(Init.begin(), Init.end());
+      Init = *Copy;
+      DataHolder = std::move(Copy);
+    }
+    Holder = std::move(DataHolder);
+    Data = Init;
+  }
 
 private:
   /// \name Data of DataSegment node.
   /// @{
   DataMode Mode = DataMode::Active;
   uint32_t MemoryIdx = 0;
-  std::vector<Byte> Data;
+  std::shared_ptr<const void> Holder;
+  Span<const Byte> Data;
   /// @}
 };
 
@@ -53,6 +53,7 @@ public:
     return Type == LimitType::HasMinMax || Type == LimitType::Shared;
   }
   bool isShared() const noexcept { return Type == LimitType::Shared; }
+  LimitType getType() const noexcept { return Type; }
   void setType(LimitType TargetType) noexcept { Type = TargetType; }
 
   /// Getter and setter of min value.
@@ -34,7 +34,9 @@ public:
         OFormat(RHS.OFormat.load(std::memory_order_relaxed)),
         DumpIR(RHS.DumpIR.load(std::memory_order_relaxed)),
         GenericBinary(RHS.GenericBinary.load(std::memory_order_relaxed)),
-        Interruptible(RHS.Interruptible.load(std::memory_order_relaxed)) {}
+        Interruptible(RHS.Interruptible.load(std::memory_order_relaxed)),
+        Jobs(RHS.Jobs.load(std::memory_order_relaxed)),
+        ObjectCaching(RHS.ObjectCaching.load(std::memory_order_relaxed)) {}
 
   /// AOT compiler optimization level enum class.
   enum class OptimizationLevel : uint8_t {
@@ -98,19 +100,56 @@ public:
     return Interruptible.load(std::memory_order_relaxed);
   }
 
+  /// Count of the threads to optimize and emit the partitions of the
+  /// functions. The functions are compiled in a single module if it is 1.
+  void setJobs(uint32_t Count) noexcept {
+    Jobs.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getJobs() const noexcept {
+    return Jobs.load(std::memory_order_relaxed);
+  }
+
+  /// Cache the objects of the compiled function fragments on the disk, and
+  /// reuse them for the unchanged functions in the later compilations.
+  void setObjectCaching(bool IsCaching) noexcept {
+    ObjectCaching.store(IsCaching, std::memory_order_relaxed);
+  }
+
+  bool isObjectCaching() const noexcept {
+    return ObjectCaching.load(std::memory_order_relaxed);
+  }
+
 private:
   std::atomic<OptimizationLevel> OptLevel = OptimizationLevel::O3;
   std::atomic<OutputFormat> OFormat = OutputFormat::Wasm;
   std::atomic<bool> DumpIR = false;
   std::atomic<bool> GenericBinary = false;
   std::atomic<bool> Interruptible = false;
+  std::atomic<uint32_t> Jobs = 1;
+  std::atomic<bool> ObjectCaching = false;
 };
 
 class RuntimeConfigure {
 public:
   RuntimeConfigure() noexcept = default;
   RuntimeConfigure(const RuntimeConfigure &RHS) noexcept
-      : MaxMemPage(RHS.MaxMemPage.load(std::memory_order_relaxed)) {}
+      : MaxMemPage(RHS.MaxMemPage.load(std::memory_order_relaxed)),
+        RegisterIR(RHS.RegisterIR.load(std::memory_order_relaxed)),
+        InstrFusion(RHS.InstrFusion.load(std::memory_order_relaxed)),
+        LazyLoading(RHS.LazyLoading.load(std::memory_order_relaxed)),
+        LoadingThreads(RHS.LoadingThreads.load(std::memory_order_relaxed)),
+        ModuleCaching(RHS.ModuleCaching.load(std::memory_order_relaxed)),
+        JIT(RHS.JIT.load(std::memory_order_relaxed)),
+        Tiering(RHS.Tiering.load(std::memory_order_relaxed)),
+        TierUpCallThreshold(
+            RHS.TierUpCallThreshold.load(std::memory_order_relaxed)),
+        TierUpLoopThreshold(
+            RHS.TierUpLoopThreshold.load(std::memory_order_relaxed)),
+        TierUpThreads(RHS.TierUpThreads.load(std::memory_order_relaxed)),
+        Profiling(RHS.Profiling.load(std::memory_order_relaxed)),
+        ThreadedDispatch(
+            RHS.ThreadedDispatch.load(std::memory_order_relaxed)) {}
 
   void setMaxMemoryPage(const uint32_t Page) noexcept {
     MaxMemPage.store(Page, std::memory_order_relaxed);
@@ -120,8 +159,146 @@ public:
     return MaxMemPage.load(std::memory_order_relaxed);
   }
 
+  /// Lower the function bodies into the register-based IR when instantiating
+  /// and run them with the register-based interpreter.
+  void setRegisterIR(bool IsRegisterIR) noexcept {
+    RegisterIR.store(IsRegisterIR, std::memory_order_relaxed);
+  }
+
+  bool isRegisterIR() const noexcept {
+    return RegisterIR.load(std::memory_order_relaxed);
+  }
+
+  /// Fuse the common instruction sequences of the function bodies into the
+  /// internal superinstructions when instantiating. With the register-based
+  /// IR, only the functions which cannot be lowered are fused.
+  void setInstructionFusion(bool IsFusion) noexcept {
+    InstrFusion.store(IsFusion, std::memory_order_relaxed);
+  }
+
+  bool isInstructionFusion() const noexcept {
+    return InstrFusion.load(std::memory_order_relaxed);
+  }
+
+  /// Defer the decoding and the validation of the function bodies to their
+  /// first calls when loading. The function bodies are recorded as the byte
+  /// ranges of the binary until then.
+  void setLazyLoading(bool IsLazy) noexcept {
+    LazyLoading.store(IsLazy, std::memory_order_relaxed);
+  }
+
+  bool isLazyLoading() const noexcept {
+    return LazyLoading.load(std::memory_order_relaxed);
+  }
+
+  /// Set the thread count for decoding and validating the function bodies of
+  /// the code section. The bodies are handled sequentially if it is not
+  /// greater than 1.
+  void setLoadingThreads(const uint32_t Threads) noexcept {
+    LoadingThreads.store(Threads, std::memory_order_relaxed);
+  }
+
+  uint32_t getLoadingThreads() const noexcept {
+    return LoadingThreads.load(std::memory_order_relaxed);
+  }
+
+  /// Cache the loaded and validated modules on the disk, and load them from
+  /// the cache instead of loading and validating the same binaries again.
+  void setModuleCaching(bool IsCaching) noexcept {
+    ModuleCaching.store(IsCaching, std::memory_order_relaxed);
+  }
+
+  bool isModuleCaching() const noexcept {
+    return ModuleCaching.load(std::memory_order_relaxed);
+  }
+
+  /// Compile the validated modules in memory with the LLVM ORC JIT and run
+  /// the compiled functions instead of interpreting them. Only available if
+  /// the AOT runtime is built.
+  void setJIT(bool IsJIT) noexcept {
+    JIT.store(IsJIT, std::memory_order_relaxed);
+  }
+
+  bool isJIT() const noexcept { return JIT.load(std::memory_order_relaxed); }
+
+  /// Interpret the functions first, and compile the hot functions in the
+  /// background with the LLVM ORC JIT. The functions are switched to the
+  /// compiled code on their next calls. Only available if the AOT runtime is
+  /// built, and ignored if the instruction counting or the cost measuring is
+  /// enabled.
+  void setTiering(bool IsTiering) noexcept {
+    Tiering.store(IsTiering, std::memory_order_relaxed);
+  }
+
+  bool isTiering() const noexcept {
+    return Tiering.load(std::memory_order_relaxed);
+  }
+
+  /// Set the call count of a function for the tier-up.
+  void setTierUpCallThreshold(const uint32_t Count) noexcept {
+    TierUpCallThreshold.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getTierUpCallThreshold() const noexcept {
+    return TierUpCallThreshold.load(std::memory_order_relaxed);
+  }
+
+  /// Set the count of the loop back-edges taken in a function for the
+  /// tier-up.
+  void setTierUpLoopThreshold(const uint32_t Count) noexcept {
+    TierUpLoopThreshold.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getTierUpLoopThreshold() const noexcept {
+    return TierUpLoopThreshold.load(std::memory_order_relaxed);
+  }
+
+  /// Set the thread count for compiling the hot functions in the background.
+  void setTierUpThreads(const uint32_t Threads) noexcept {
+    TierUpThreads.store(Threads, std::memory_order_relaxed);
+  }
+
+  uint32_t getTierUpThreads() const noexcept {
+    return TierUpThreads.load(std::memory_order_relaxed);
+  }
+
+  /// Record the taken counts of the branches and the targets of the indirect
+  /// calls when interpreting, for the profile-guided AOT compilation. The
+  /// register-based IR, the instruction fusion, and the tiering are disabled
+  /// for the profiled modules.
+  void setProfiling(bool IsProfiling) noexcept {
+    Profiling.store(IsProfiling, std::memory_order_relaxed);
+  }
+
+  bool isProfiling() const noexcept {
+    return Profiling.load(std::memory_order_relaxed);
+  }
+
+  /// Use the direct threaded dispatch in the interpreter if it is built in.
+  /// Otherwise the interpreter falls back to the switch-based dispatch, which
+  /// is the reference of the threaded one.
+  void setThreadedDispatch(bool IsThreaded) noexcept {
+    ThreadedDispatch.store(IsThreaded, std::memory_order_relaxed);
+  }
+
+  bool isThreadedDispatch() const noexcept {
+    return ThreadedDispatch.load(std::memory_order_relaxed);
+  }
+
 private:
   std::atomic<uint32_t> MaxMemPage = 65536;
+  std::atomic<bool> RegisterIR = false;
+  std::atomic<bool> InstrFusion = false;
+  std::atomic<bool> LazyLoading = false;
+  std::atomic<uint32_t> LoadingThreads = 1;
+  std::atomic<bool> ModuleCaching = false;
+  std::atomic<bool> JIT = false;
+  std::atomic<bool> Tiering = false;
+  std::atomic<uint32_t> TierUpCallThreshold = 1000;
+  std::atomic<uint32_t> TierUpLoopThreshold = 100000;
+  std::atomic<uint32_t> TierUpThreads = 1;
+  std::atomic<bool> Profiling = false;
+  std::atomic<bool> ThreadedDispatch = true;
 };
 
 class StatisticsConfigure {
@@ -130,7 +307,9 @@ public:
   StatisticsConfigure(const StatisticsConfigure &RHS) noexcept
       : InstrCounting(RHS.InstrCounting.load(std::memory_order_relaxed)),
         CostMeasuring(RHS.CostMeasuring.load(std::memory_order_relaxed)),
-        TimeMeasuring(RHS.TimeMeasuring.load(std::memory_order_relaxed)) {}
+        TimeMeasuring(RHS.TimeMeasuring.load(std::memory_order_relaxed)),
+        FusionCounting(RHS.FusionCounting.load(std::memory_order_relaxed)),
+        TierUpCounting(RHS.TierUpCounting.load(std::memory_order_relaxed)) {}
 
   void setInstructionCounting(bool IsCount) noexcept {
     InstrCounting.store(IsCount, std::memory_order_relaxed);
@@ -156,6 +335,22 @@ public:
     return TimeMeasuring.load(std::memory_order_relaxed);
   }
 
+  void setFusionCounting(bool IsCount) noexcept {
+    FusionCounting.store(IsCount, std::memory_order_relaxed);
+  }
+
+  bool isFusionCounting() const noexcept {
+    return FusionCounting.load(std::memory_order_relaxed);
+  }
+
+  void setTierUpCounting(bool IsCount) noexcept {
+    TierUpCounting.store(IsCount, std::memory_order_relaxed);
+  }
+
+  bool isTierUpCounting() const noexcept {
+    return TierUpCounting.load(std::memory_order_relaxed);
+  }
+
   void setCostLimit(uint64_t Cost) noexcept {
     CostLimit.store(Cost, std::memory_order_relaxed);
   }
@@ -168,6 +363,8 @@ private:
   std::atomic<bool> InstrCounting = false;
   std::atomic<bool> CostMeasuring = false;
   std::atomic<bool> TimeMeasuring = false;
+  std::atomic<bool> FusionCounting = false;
+  std::atomic<bool> TierUpCounting = false;
   std::atomic<uint64_t> CostLimit = UINT64_C(-1);
 };
 
@@ -71,4 +71,8 @@ static inline constexpr const auto OpCodeStr = []() constexpr {
 }
 ();
 
+/// Begin value of the internal fused instruction opcodes, which are only
+/// produced by the instruction fusion in the executor.
+static inline constexpr uint16_t FusedOpCodeBegin = UINT16_C(0xFF00);
+
 } // namespace WasmEdge
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/executable.h - Executable definition --------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the Executable, which is the base
+/// class of the holders of the compiled code.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/symbol.h"
+
+#include <memory>
+
+namespace WasmEdge {
+
+/// Holder class of the compiled code. The code is kept alive by the symbols
+/// created from the holder.
+class Executable : public std::enable_shared_from_this<Executable> {
+public:
+  virtual ~Executable() noexcept = default;
+
+protected:
+  template <typename T> Symbol<T> createSymbol(T *Pointer) noexcept {
+    return Symbol<T>(shared_from_this(), Pointer);
+  }
+};
+
+} // namespace WasmEdge
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/functypeid.h - Canonical function type ID ---------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the canonicalization of the function types. The
+/// structurally equal function types are mapped to the same ID in the process,
+/// so that checking the signatures becomes an integer comparison.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/enum_types.hpp"
+#include "common/span.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace WasmEdge {
+
+/// Get the canonical ID of the function type with the params and returns.
+uint32_t getFuncTypeID(Span<const ValType> Params,
+                       Span<const ValType> Returns) noexcept;
+
+/// Generation of the function instances, which is increased once when a module
+/// instance is destroyed with its functions, or when a function instance not
+/// owned by any module is destroyed. The caches holding the addresses of the
+/// function instances are valid only in the generation they are filled in, for
+/// the addresses may be reused by the new ones.
+extern std::atomic<uint64_t> FuncInstGeneration;
+
+} // namespace WasmEdge
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/parallel.h - Parallel jobs definition -------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the helpers to run the indexed jobs on the worker
+/// threads, which stop at the lowest failed job as running them in order.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace WasmEdge {
+
+/// Get the count of the threads to run the jobs in the chunks, which is not
+/// more than the requested threads, the processors, or the chunks.
+uint32_t getParallelThreadNum(uint32_t Threads, uint32_t JobNum,
+                              uint32_t ChunkSize) noexcept;
+
+/// Run the work on the current thread and on up to Threads - 1 new threads,
+/// and join them. The threads failed to be created are skipped, and their
+/// share is taken by the running ones.
+void runOnThreads(uint32_t Threads, const std::function<void()> &Work);
+
+/// Run the jobs of the indices in [0, JobNum) on up to Threads threads, which
+/// take the jobs in the chunks of ChunkSize indices. MakeJob is called once on
+/// each thread and returns the job function owning the states of that thread,
+/// which runs the job of the index and returns false if it fails. The jobs
+/// before the lowest failed one are all done, and the ones after it may be
+/// skipped. Return the lowest failed index, or JobNum if all the jobs succeed.
+template <typename MakeJobT>
+uint32_t runParallelJobs(uint32_t JobNum, uint32_t ChunkSize, uint32_t Threads,
+                         MakeJobT &&MakeJob) {
+  std::atomic<uint32_t> NextIdx = 0;
+  std::atomic<uint32_t> MinFailedIdx = JobNum;
+  runOnThreads(getParallelThreadNum(Threads, JobNum, ChunkSize), [&]() {
+    auto Job = MakeJob();
+    while (true) {
+      const uint32_t Begin =
+          NextIdx.fetch_add(ChunkSize, std::memory_order_relaxed);
+      const uint32_t End = std::min(JobNum, Begin + ChunkSize);
+      if (Begin >= End) {
+        break;
+      }
+      for (uint32_t I = Begin; I < End; ++I) {
+        if (I >= MinFailedIdx.load(std::memory_order_relaxed)) {
+          return;
+        }
+        if (Job(I)) {
+          continue;
+        }
+        // Keep the lowest failed index.
+        uint32_t Expected = MinFailedIdx.load(std::memory_order_relaxed);
+        while (I < Expected && !MinFailedIdx.compare_exchange_weak(
+                                   Expected, I, std::memory_order_relaxed)) {
+        }
+        return;
+      }
+    }
+  });
+  return MinFailedIdx.load();
+}
+
+} // namespace WasmEdge
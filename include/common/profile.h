@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/profile.h - Execution profile definition ----------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the execution profiles recorded by the
+/// interpreter and consumed by the profile-guided AOT compilation.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace WasmEdge {
+
+/// Execution profile of a function. The instructions are indexed in the
+/// function body.
+struct FunctionProfile {
+  /// Taken counts of the branches. The `if` and `br_if` instructions have the
+  /// [not taken, taken] counts, and the `br_table` instructions have the
+  /// counts of the labels with the default label last.
+  std::map<uint32_t, std::vector<uint64_t>> Branches;
+  /// Call counts of the targets of the `call_indirect` instructions, keyed by
+  /// the function index.
+  std::map<uint32_t, std::map<uint32_t, uint64_t>> Calls;
+
+  bool empty() const noexcept { return Branches.empty() && Calls.empty(); }
+
+  /// Accumulate the counts of the other profile.
+  void merge(const FunctionProfile &RHS) {
+    for (const auto &[Idx, Counts] : RHS.Branches) {
+      auto &Dst = Branches[Idx];
+      if (Dst.size() < Counts.size()) {
+        Dst.resize(Counts.size(), 0);
+      }
+      for (size_t I = 0; I < Counts.size(); ++I) {
+        Dst[I] += Counts[I];
+      }
+    }
+    for (const auto &[Idx, Targets] : RHS.Calls) {
+      auto &Dst = Calls[Idx];
+      for (const auto &[Func, Count] : Targets) {
+        Dst[Func] += Count;
+      }
+    }
+  }
+};
+
+/// Execution profile of a module, keyed by the function index including the
+/// imported functions.
+using ModuleProfile = std::map<uint32_t, FunctionProfile>;
+
+} // namespace WasmEdge
@@ -20,6 +20,7 @@
 #include "common/span.h"
 #include "common/timer.h"
 
+#include <array>
 #include <atomic>
 #include <vector>
 
@@ -49,6 +50,25 @@ public:
   }
   std::atomic_uint64_t &getInstrCountRef() { return InstrCnt; }
 
+  /// Increment of the executed counter of the fused instruction.
+  void incFusionCount(OpCode Code) {
+    FusionCnt[getFusionIndex(Code)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Getter of the executed counter of the fused instruction.
+  uint64_t getFusionCount(OpCode Code) const {
+    return FusionCnt[getFusionIndex(Code)].load(std::memory_order_relaxed);
+  }
+
+  /// Increment of the counter of the functions switched to the compiled code
+  /// by the tier-up.
+  void incTierUpCount() { TierUpCnt.fetch_add(1, std::memory_order_relaxed); }
+
+  /// Getter of the tier-up counter.
+  uint64_t getTierUpCount() const {
+    return TierUpCnt.load(std::memory_order_relaxed);
+  }
+
   /// Getter of instruction per second.
   double getInstrPerSecond() const {
     return static_cast<double>(InstrCnt) /
@@ -97,6 +117,15 @@ public:
     return true;
   }
 
+  /// Sync the cost accumulated locally by the execution into the total cost.
+  /// Return the remaining cost under the limit.
+  uint64_t syncCost(uint64_t Cost) {
+    const uint64_t Sum =
+        Cost == 0 ? CostSum.load(std::memory_order_relaxed)
+                  : CostSum.fetch_add(Cost, std::memory_order_relaxed) + Cost;
+    return Sum < CostLimit ? CostLimit - Sum : 0;
+  }
+
   /// Return cost back.
   bool subCost(uint64_t Cost) {
     uint64_t OldCostSum = CostSum.load(std::memory_order_relaxed);
@@ -116,6 +145,10 @@ public:
     TimeRecorder.reset();
     InstrCnt.store(0, std::memory_order_relaxed);
     CostSum.store(0, std::memory_order_relaxed);
+    for (auto &Cnt : FusionCnt) {
+      Cnt.store(0, std::memory_order_relaxed);
+    }
+    TierUpCnt.store(0, std::memory_order_relaxed);
   }
 
   /// Start recording wasm time.
@@ -156,7 +189,8 @@ public:
     };
     const auto &StatConf = Conf.getStatisticsConfigure();
     if (StatConf.isTimeMeasuring() || StatConf.isInstructionCounting() ||
-        StatConf.isCostMeasuring()) {
+        StatConf.isCostMeasuring() || StatConf.isFusionCounting() ||
+        StatConf.isTierUpCounting()) {
       spdlog::info("====================  Statistics  ====================");
     }
     if (StatConf.isTimeMeasuring()) {
@@ -176,15 +210,36 @@ public:
       spdlog::info(" Instructions per second: {}",
                    static_cast<uint64_t>(getInstrPerSecond()));
     }
+    if (StatConf.isFusionCounting()) {
+      for (uint32_t I = 0; I < FusionCnt.size(); ++I) {
+        const auto Code = static_cast<OpCode>(FusedOpCodeBegin + I);
+        if (const uint64_t Cnt = getFusionCount(Code); Cnt > 0) {
+          spdlog::info(" Executed {} count: {}", OpCodeStr[Code], Cnt);
+        }
+      }
+    }
+    if (StatConf.isTierUpCounting()) {
+      spdlog::info(" Tier-up functions count: {}", getTierUpCount());
+    }
     if (StatConf.isTimeMeasuring() || StatConf.isInstructionCounting() ||
-        StatConf.isCostMeasuring()) {
+        StatConf.isCostMeasuring() || StatConf.isFusionCounting() ||
+        StatConf.isTierUpCounting()) {
       spdlog::info("=======================   End   ======================");
     }
   }
 
 private:
+  static inline constexpr uint16_t kFusedOpCodeNum = UINT16_C(0x0100);
+  static constexpr uint16_t getFusionIndex(OpCode Code) noexcept {
+    return static_cast<uint16_t>(static_cast<uint16_t>(Code) -
+                                 FusedOpCodeBegin) %
+           kFusedOpCodeNum;
+  }
+
   std::vector<uint64_t> CostTab;
   std::atomic_uint64_t InstrCnt;
+  std::array<std::atomic_uint64_t, kFusedOpCodeNum> FusionCnt = {};
+  std::atomic_uint64_t TierUpCnt = 0;
   uint64_t CostLimit;
   std::atomic_uint64_t CostSum;
   Timer::Timer TimeRecorder;
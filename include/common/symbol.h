@@ -9,26 +9,24 @@
 ///
 /// \file
 /// This file contains the declaration of the Symbol, which holds the handle to
-/// the loaded shared library.
+/// the loaded shared library or the other holders of the compiled code.
 ///
 //===----------------------------------------------------------------------===//
 #pragma once
 
 #include <memory>
 
-namespace WasmEdge::Loader {
-class SharedLibrary;
-}
-
 namespace WasmEdge {
 
+class Executable;
+
 /// Holder class for library symbol
 template <typename T = void> class Symbol {
 private:
-  friend class Loader::SharedLibrary;
+  friend class Executable;
   template <typename> friend class Symbol;
 
-  Symbol(std::shared_ptr<Loader::SharedLibrary> H, T *S) noexcept
+  Symbol(std::shared_ptr<Executable> H, T *S) noexcept
       : Library(std::move(H)), Pointer(S) {}
 
 public:
@@ -57,16 +55,16 @@ public:
   }
 
 private:
-  std::shared_ptr<Loader::SharedLibrary> Library;
+  std::shared_ptr<Executable> Library;
   T *Pointer = nullptr;
 };
 
 template <typename T> class Symbol<T[]> {
 private:
-  friend class Loader::SharedLibrary;
+  friend class Executable;
   template <typename> friend class Symbol;
 
-  Symbol(std::shared_ptr<Loader::SharedLibrary> H, T (*S)[]) noexcept
+  Symbol(std::shared_ptr<Executable> H, T (*S)[]) noexcept
       : Library(std::move(H)), Pointer(*S) {}
 
 public:
@@ -88,7 +86,7 @@ public:
   }
 
 private:
-  std::shared_ptr<Loader::SharedLibrary> Library;
+  std::shared_ptr<Executable> Library;
   T *Pointer = nullptr;
 };
 
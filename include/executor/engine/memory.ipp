@@ -1,9 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: 2019-2022 Second State INC
 
+#include "common/config.h"
 #include "executor/executor.h"
 #include "runtime/instance/memory.h"
 
+#include <atomic>
 #include <cstdint>
 
 namespace WasmEdge {
@@ -15,6 +17,22 @@ TypeT<T> Executor::runLoadOp(Runtime::StackManager &StackMgr,
                              const AST::Instruction &Instr) {
   // Calculate EA
   ValVariant &Val = StackMgr.getTop();
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+  if (likely(MemInst.isGuarded())) {
+    // The 64-bit EA of the out-of-bounds access lands in the inaccessible
+    // pages of the memory reservation, and the fault handler installed in
+    // `runFunction` turns it into the memory out of bounds trap. The handler
+    // finds this instruction by the published program counter, which the
+    // fence keeps in memory.
+    const uint64_t EA =
+        static_cast<uint64_t>(Val.get<uint32_t>()) + Instr.getMemoryOffset();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // Value = Mem.Data[EA : N / 8]
+    MemInst.loadValueUnchecked<T, BitWidth / 8>(Val.emplace<T>(), EA);
+    return {};
+  }
+#endif
   if (Val.get<uint32_t>() >
       std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
     spdlog::error(ErrCode::Value::MemoryOutOfBounds);
@@ -46,6 +64,16 @@ TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
 
   // Calculate EA = i + offset
   uint32_t I = StackMgr.pop().get<uint32_t>();
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+  if (likely(MemInst.isGuarded())) {
+    const uint64_t EA = static_cast<uint64_t>(I) + Instr.getMemoryOffset();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // Store value to bytes.
+    MemInst.storeValueUnchecked<T, BitWidth / 8>(C, EA);
+    return {};
+  }
+#endif
   if (I > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
     spdlog::error(ErrCode::Value::MemoryOutOfBounds);
     spdlog::error(ErrInfo::InfoBoundary(
@@ -66,6 +94,77 @@ TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
   return {};
 }
 
+template <typename T, uint32_t BitWidth>
+TypeT<T> Executor::runRegLoadOp(Runtime::Instance::MemoryInstance &MemInst,
+                                const AST::Instruction &Instr, ValVariant &Dst,
+                                uint32_t Addr) {
+  // Calculate EA
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+  if (likely(MemInst.isGuarded())) {
+    const uint64_t EA = static_cast<uint64_t>(Addr) + Instr.getMemoryOffset();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // Value = Mem.Data[EA : N / 8]
+    MemInst.loadValueUnchecked<T, BitWidth / 8>(Dst.emplace<T>(), EA);
+    return {};
+  }
+#endif
+  if (Addr > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
+    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+    spdlog::error(ErrInfo::InfoBoundary(
+        Addr + static_cast<uint64_t>(Instr.getMemoryOffset()), BitWidth / 8,
+        MemInst.getBoundIdx()));
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+  }
+  uint32_t EA = Addr + Instr.getMemoryOffset();
+
+  // Value = Mem.Data[EA : N / 8]
+  if (auto Res = MemInst.loadValue<T, BitWidth / 8>(Dst.emplace<T>(), EA);
+      !Res) {
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(Res);
+  }
+  return {};
+}
+
+template <typename T, uint32_t BitWidth>
+TypeN<T> Executor::runRegStoreOp(Runtime::Instance::MemoryInstance &MemInst,
+                                 const AST::Instruction &Instr, uint32_t Addr,
+                                 const ValVariant &Val) {
+  // Calculate EA = i + offset
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+  if (likely(MemInst.isGuarded())) {
+    const uint64_t EA = static_cast<uint64_t>(Addr) + Instr.getMemoryOffset();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // Store value to bytes.
+    MemInst.storeValueUnchecked<T, BitWidth / 8>(Val.get<T>(), EA);
+    return {};
+  }
+#endif
+  if (Addr > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
+    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+    spdlog::error(ErrInfo::InfoBoundary(
+        Addr + static_cast<uint64_t>(Instr.getMemoryOffset()), BitWidth / 8,
+        MemInst.getBoundIdx()));
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+  }
+  uint32_t EA = Addr + Instr.getMemoryOffset();
+
+  // Store value to bytes.
+  if (auto Res = MemInst.storeValue<T, BitWidth / 8>(Val.get<T>(), EA); !Res) {
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(Res);
+  }
+  return {};
+}
+
 template <typename TIn, typename TOut>
 Expect<void>
 Executor::runLoadExpandOp(Runtime::StackManager &StackMgr,
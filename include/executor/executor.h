@@ -18,24 +18,38 @@
 #include "common/configure.h"
 #include "common/defines.h"
 #include "common/errcode.h"
+#include "common/profile.h"
 #include "common/statistics.h"
+#include "executor/tierup.h"
 #include "runtime/callingframe.h"
 #include "runtime/instance/module.h"
+#include "runtime/instance/template.h"
 #include "runtime/stackmgr.h"
 #include "runtime/storemgr.h"
+#include "system/fault.h"
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <csignal>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+// Direct threaded dispatch relies on the labels-as-values extension. Fall back
+// to the switch-based dispatch on compilers without it.
+#if defined(WASMEDGE_INTERPRETER_THREADED_DISPATCH) &&                         \
+    (defined(__GNUC__) || defined(__clang__))
+#define WASMEDGE_USE_THREADED_DISPATCH 1
+#endif
+
 namespace WasmEdge {
 namespace Executor {
 
@@ -95,7 +109,9 @@ public:
     assuming(This == nullptr);
     if (Conf.getStatisticsConfigure().isInstructionCounting() ||
         Conf.getStatisticsConfigure().isCostMeasuring() ||
-        Conf.getStatisticsConfigure().isTimeMeasuring()) {
+        Conf.getStatisticsConfigure().isTimeMeasuring() ||
+        Conf.getStatisticsConfigure().isFusionCounting() ||
+        Conf.getStatisticsConfigure().isTierUpCounting()) {
       Stat = S;
     } else {
       Stat = nullptr;
@@ -104,6 +120,9 @@ public:
     if (Stat) {
       Stat->setCostLimit(Conf.getStatisticsConfigure().getCostLimit());
     }
+    // Install the fault handlers before the ones of the embedders installed
+    // after creating the executor, which should forward the faults to them.
+    Fault::install();
   }
   ~Executor() noexcept {
     This = nullptr;
@@ -126,6 +145,24 @@ public:
   Expect<void> registerModule(Runtime::StoreManager &StoreMgr,
                               const Runtime::Instance::ModuleInstance &ModInst);
 
+  /// Instantiate a WASM module and freeze it into a module template. The
+  /// start function is run before freezing if IsStarted is true, otherwise it
+  /// is run by every module instance cloned from the template.
+  Expect<std::unique_ptr<Runtime::Instance::ModuleTemplate>>
+  createTemplate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
+                 bool IsStarted = true);
+
+  /// Instantiate a module template into an anonymous module instance.
+  Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+  instantiateModule(Runtime::StoreManager &StoreMgr,
+                    const Runtime::Instance::ModuleTemplate &Tmpl);
+
+  /// Instantiate and register a module template into a named module instance.
+  Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+  registerModule(Runtime::StoreManager &StoreMgr,
+                 const Runtime::Instance::ModuleTemplate &Tmpl,
+                 std::string_view Name);
+
   /// Invoke a WASM function by function instance.
   Expect<std::vector<std::pair<ValVariant, ValType>>>
   invoke(const Runtime::Instance::FunctionInstance &FuncInst,
@@ -143,6 +180,14 @@ public:
     }
   }
 
+  /// Set the compiler of the hot functions. The tiered execution takes effect
+  /// on the later instantiations if enabled by the configuration.
+  void setTierUpCompiler(std::unique_ptr<TierUpCompiler> Compiler) noexcept;
+
+  /// Collect the execution profiles of the modules instantiated with the
+  /// profiling, keyed by the hashes of the binaries.
+  std::map<std::string, ModuleProfile> getProfiles() const;
+
   /// Stop execution
   void stop() noexcept {
     StopToken.store(1, std::memory_order_relaxed);
@@ -164,22 +209,140 @@ private:
                        const AST::InstrView::iterator Start,
                        const AST::InstrView::iterator End);
 
+  /// \name Statistics policies of the execution loop.
+  /// @{
+  static inline constexpr uint32_t kMeterNone = 0U;
+  static inline constexpr uint32_t kMeterInstrCount = 1U << 0;
+  static inline constexpr uint32_t kMeterCost = 1U << 1;
+  static inline constexpr uint32_t kMeterFusionCount = 1U << 2;
+  static inline constexpr uint32_t kMeterProfile = 1U << 3;
+  static inline constexpr uint32_t kMeterAll = (1U << 4) - 1;
+  /// @}
+
+  /// Execution loop of a statistics policy.
+  using ExecuteLoop = Expect<void> (Executor::*)(
+      Runtime::StackManager &, const AST::InstrView::iterator,
+      const AST::InstrView::iterator);
+
+  /// Build the table of the execution loops indexed by the policies.
+  template <uint32_t... Policies>
+  static constexpr std::array<ExecuteLoop, sizeof...(Policies)>
+  makeExecuteLoops(std::integer_sequence<uint32_t, Policies...>) noexcept {
+    return {{&Executor::execute<Policies>...}};
+  }
+
+  /// Execute instructions with the statistics policy. The loop is instantiated
+  /// for each policy, so the disabled statistics cost nothing per instruction.
+  template <uint32_t Policy>
+  Expect<void> execute(Runtime::StackManager &StackMgr,
+                       const AST::InstrView::iterator Start,
+                       const AST::InstrView::iterator End);
+
+  /// Execute the lowered register-based code of the function in the top frame.
+  Expect<void> executeRegister(Runtime::StackManager &StackMgr,
+                               const Runtime::Instance::FunctionInstance &Func,
+                               const Runtime::RegIR::Code &Code);
+
   /// \name Functions for instantiation.
   /// @{
   /// Instantiation of Module Instance.
   Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
   instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
+              std::optional<std::string_view> Name = std::nullopt,
+              bool IsStarted = true);
+
+  /// Instantiation of Module Instance by cloning the module template.
+  Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+  instantiate(Runtime::StoreManager &StoreMgr,
+              const Runtime::Instance::ModuleTemplate &Tmpl,
               std::optional<std::string_view> Name = std::nullopt);
 
+  /// Freeze the module instance instantiated from the AST module into the
+  /// module template.
+  Expect<void> freeze(Runtime::Instance::ModuleTemplate &Tmpl,
+                      const Runtime::Instance::ModuleInstance &ModInst);
+
   /// Instantiation of Imports.
   Expect<void> instantiate(Runtime::StoreManager &StoreMgr,
                            Runtime::Instance::ModuleInstance &ModInst,
                            const AST::ImportSection &ImportSec);
 
-  /// Instantiation of Function Instances.
+  /// Instantiation of Function Instances. The prepared function code is shared
+  /// by the instances of the same AST module.
   Expect<void> instantiate(Runtime::Instance::ModuleInstance &ModInst,
-                           const AST::FunctionSection &FuncSec,
-                           const AST::CodeSection &CodeSec);
+                           const AST::Module &Mod);
+
+  /// Lower the function body into the register-based IR with the functions
+  /// and the types in the module. Return nullptr if the function contains
+  /// instructions which cannot be lowered.
+  std::unique_ptr<Runtime::RegIR::Code>
+  lowerFunction(Span<Runtime::Instance::FunctionInstance *const> Funcs,
+                Span<const AST::FunctionType> Types,
+                const Runtime::Instance::FunctionInstance &Func) const;
+
+  /// Decode, validate, and prepare the function body deferred by the lazy
+  /// loading on the first call of the function. Thread-safe.
+  Expect<void>
+  prepareFunction(const Runtime::Instance::FunctionInstance &Func);
+
+  /// Fuse the common instruction sequences in the function body into the
+  /// internal fused instructions.
+  void fuseInstructions(Runtime::Instance::FunctionInstance &Func) const;
+
+  /// Assign the handlers of the threaded dispatch to the instructions in the
+  /// function body, which is done after the fusion.
+  void threadInstructions(Runtime::Instance::FunctionInstance &Func) const;
+
+  /// Precompute the costs of the straight-line blocks in the function body for
+  /// the block-based gas metering.
+  void meterBlocks(Runtime::Instance::FunctionInstance &Func) const;
+
+  /// Get the cost of the instruction charged in its block, which is capped by
+  /// the largest cost of a block.
+  uint64_t getBlockInstrCost(OpCode Code) const noexcept;
+
+  /// Find the instruction in the block led by the given one, at which the
+  /// cost of the instructions from the leader exceeds the remaining cost.
+  /// Return nullptr if the whole block can be charged, otherwise output the
+  /// cost of the instructions before the found one.
+  const AST::Instruction *findBlockTrip(const AST::Instruction *Leader,
+                                        uint64_t RemainCost,
+                                        uint64_t &Prefix) const noexcept;
+
+  /// Get the cost of the instructions after the given one in its block, which
+  /// are charged with the block but not run when the given one traps. The
+  /// instructions from the given tripping one are not charged.
+  uint64_t getUnrunBlockCost(const AST::Instruction *Instr,
+                             const AST::Instruction *Trip) const noexcept;
+
+  /// Get the instruction at the program counter of the running interpreter
+  /// loop captured by the fault.
+  static const AST::Instruction *
+  getExecutingInstr(const void *ProgramCounter) noexcept;
+
+  /// Check if the instruction is the memory access faulting on the guard pages
+  /// of its memory at the address, and log its error information.
+  bool isGuardedAccess(Runtime::StackManager &StackMgr,
+                       const AST::Instruction *Instr,
+                       const void *Address) const noexcept;
+
+  /// Sync the pending cost into the statistics when leaving the execution,
+  /// without the cost not run in the block of the trapping instruction.
+  void syncTrapCost(const AST::Instruction *Instr,
+                    const AST::Instruction *Trip) noexcept;
+
+  /// Allocate the branch profile counters of the function body.
+  void profileFunction(Runtime::Instance::FunctionInstance &Func) const;
+
+  /// Register the functions of the module instance for collecting the
+  /// profiles.
+  void registerProfile(const Runtime::Instance::ModuleInstance &ModInst,
+                       const AST::Module &Mod, uint32_t FuncBase);
+
+  /// Record the branch or the indirect call target of the instruction into the
+  /// profile of the function in the top frame.
+  void recordProfile(Runtime::StackManager &StackMgr,
+                     const AST::Instruction &Instr) noexcept;
 
   /// Instantiation of Table Instances.
   Expect<void> instantiate(Runtime::Instance::ModuleInstance &ModInst,
@@ -225,6 +388,14 @@ private:
                 const Runtime::Instance::FunctionInstance &Func,
                 const AST::InstrView::iterator RetIt, bool IsTailCall = false);
 
+  /// Helper function for calling the compiled code of the function with the
+  /// wrapper of its type.
+  Expect<AST::InstrView::iterator>
+  enterCompiledFunction(Runtime::StackManager &StackMgr,
+                        const Runtime::Instance::FunctionInstance &Func,
+                        AST::FunctionType::Wrapper &Wrapper, void *Code,
+                        const AST::InstrView::iterator RetIt, bool IsTailCall);
+
   /// Helper function for branching to label.
   Expect<void> branchToLabel(Runtime::StackManager &StackMgr,
                              uint32_t EraseBegin, uint32_t EraseEnd,
@@ -339,6 +510,15 @@ private:
   Expect<void> runMemoryFillOp(Runtime::StackManager &StackMgr,
                                Runtime::Instance::MemoryInstance &MemInst,
                                const AST::Instruction &Instr);
+  /// ======= Register-based memory instructions =======
+  template <typename T, uint32_t BitWidth = sizeof(T) * 8>
+  TypeT<T> runRegLoadOp(Runtime::Instance::MemoryInstance &MemInst,
+                        const AST::Instruction &Instr, ValVariant &Dst,
+                        uint32_t Addr);
+  template <typename T, uint32_t BitWidth = sizeof(T) * 8>
+  TypeN<T> runRegStoreOp(Runtime::Instance::MemoryInstance &MemInst,
+                         const AST::Instruction &Instr, uint32_t Addr,
+                         const ValVariant &Val);
   /// ======= Test and Relation Numeric instructions =======
   template <typename T> TypeU<T> runEqzOp(ValVariant &Val) const;
   template <typename T>
@@ -561,6 +741,23 @@ private:
   runAtomicCompareExchangeOp(Runtime::StackManager &StackMgr,
                              Runtime::Instance::MemoryInstance &MemInst,
                              const AST::Instruction &Instr);
+  /// ======= Fused instructions =======
+  /// The PC points to the head of the fused sequence when calling, and will
+  /// point to the last instruction of the sequence when returning.
+  Expect<void>
+  runFusedLocalGetLocalGetOp(Runtime::StackManager &StackMgr,
+                             AST::InstrView::iterator &PC) const noexcept;
+  Expect<void>
+  runFusedLocalGetLocalGetAddOp(Runtime::StackManager &StackMgr,
+                                AST::InstrView::iterator &PC) const noexcept;
+  Expect<void>
+  runFusedLocalGetConstAddOp(Runtime::StackManager &StackMgr,
+                             AST::InstrView::iterator &PC) const noexcept;
+  Expect<void>
+  runFusedLocalGetConstAddSetOp(Runtime::StackManager &StackMgr,
+                                AST::InstrView::iterator &PC) const noexcept;
+  Expect<void> runFusedConstBrIfOp(Runtime::StackManager &StackMgr,
+                                   AST::InstrView::iterator &PC) noexcept;
   /// @}
 
   /// \name Run compiled functions
@@ -672,6 +869,23 @@ private:
   static thread_local Runtime::StackManager *CurrentStack;
   /// Execution context for compiled functions
   static thread_local ExecutionContextStruct ExecutionContext;
+  /// Nested depth of the register-based interpreter calls
+  static thread_local uint32_t RegisterCallDepth;
+  /// Cost charged by the interpreter loop but not synced into the statistics
+  static thread_local uint64_t PendingCost;
+  /// Instruction exceeding the cost limit in the block charged in part
+  static thread_local const AST::Instruction *PendingTrip;
+  /// Lowered code of the running register-based interpreter loop, for finding
+  /// the instruction of the memory access faulting on the guard pages by the
+  /// program counter. Nullptr for the AST interpreter loop.
+  struct ExecutingCodeStruct {
+    const Runtime::RegIR::Code *Code;
+    /// Original instructions of the lowered code
+    const AST::Instruction *Origins;
+  };
+  static thread_local ExecutingCodeStruct ExecutingCode;
+  /// Maximum nested depth of the register-based interpreter calls
+  static inline constexpr uint32_t kMaxRegisterCallDepth = 1024;
   /// @}
 
 private:
@@ -681,6 +895,20 @@ private:
   Statistics::Statistics *Stat;
   /// Stop Execution
   std::atomic_uint32_t StopToken = 0;
+  /// Background compiler of the hot functions. Nullptr if not tiered.
+  std::unique_ptr<TierUpQueue> TierUp;
+  /// Functions of the profiled modules. The imported functions are only for
+  /// resolving the indices of the indirect call targets.
+  struct ProfiledModule {
+    std::string Hash;
+    std::vector<const Runtime::Instance::FunctionInstance::WasmFunction *>
+        Imports;
+    std::vector<
+        std::shared_ptr<Runtime::Instance::FunctionInstance::WasmFunction>>
+        Funcs;
+  };
+  mutable std::mutex ProfileMutex;
+  std::vector<ProfiledModule> Profiled;
 };
 
 } // namespace Executor
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/executor/tierup.h - Tier-up queue class definition -------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the TierUpQueue class, which compiles
+/// the hot functions of the interpreter in the background threads.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/errcode.h"
+#include "common/statistics.h"
+#include "runtime/instance/function.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+/// Compiler of the hot functions for the tiered execution, which is provided
+/// by the VM if the AOT runtime is built.
+class TierUpCompiler {
+public:
+  virtual ~TierUpCompiler() noexcept = default;
+
+  /// Compile the prepared function body, and set the compiled code into the
+  /// tier-up state of the function.
+  virtual Expect<void>
+  compile(Runtime::Instance::FunctionInstance::WasmFunction &Code) = 0;
+};
+
+/// Queue of the hot functions to be compiled. The functions are queued once
+/// when their counters reach the thresholds, and switched to the compiled
+/// code after compiled. The threads are started on the first queued function
+/// and joined when destroying the queue.
+class TierUpQueue {
+public:
+  using TierUp = Runtime::Instance::FunctionInstance::TierUp;
+  using WasmFunction = Runtime::Instance::FunctionInstance::WasmFunction;
+
+  TierUpQueue(std::unique_ptr<TierUpCompiler> C, uint32_t CallThres,
+              uint32_t LoopThres, uint32_t Threads,
+              Statistics::Statistics *S) noexcept;
+  ~TierUpQueue() noexcept;
+
+  /// Count the call of the function.
+  void countCall(TierUp &Tier) noexcept {
+    if (unlikely(Tier.CallCount.fetch_add(1, std::memory_order_relaxed) + 1 ==
+                 CallThreshold)) {
+      push(Tier);
+    }
+  }
+
+  /// Count the taken loop back-edge of the function.
+  void countLoop(TierUp &Tier) noexcept {
+    if (unlikely(Tier.LoopCount.fetch_add(1, std::memory_order_relaxed) + 1 ==
+                 LoopThreshold)) {
+      push(Tier);
+    }
+  }
+
+private:
+  /// Queue the function if not queued yet.
+  void push(TierUp &Tier) noexcept;
+
+  /// Compile the queued functions until stopped.
+  void run() noexcept;
+
+  std::unique_ptr<TierUpCompiler> Compiler;
+  const uint32_t CallThreshold;
+  const uint32_t LoopThreshold;
+  const uint32_t ThreadNum;
+  Statistics::Statistics *Stat;
+
+  std::mutex Mutex;
+  std::condition_variable Cond;
+  std::deque<std::shared_ptr<WasmFunction>> Jobs;
+  std::vector<std::thread> Workers;
+  bool Stopped = false;
+};
+
+} // namespace Executor
+} // namespace WasmEdge
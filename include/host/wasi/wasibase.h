@@ -13,7 +13,10 @@ namespace Host {
 
 template <typename T> class Wasi : public Runtime::HostFunction<T> {
 public:
-  Wasi(WASI::Environ &HostEnv) : Runtime::HostFunction<T>(0), Env(HostEnv) {}
+  Wasi(WASI::Environ &HostEnv) : Runtime::HostFunction<T>(0), Env(HostEnv) {
+    // The WASI functions never re-enter the VM.
+    this->setLeaf();
+  }
 
 protected:
   WASI::Environ &Env;
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/loader/cache.h - Module cache class definition -----------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the ModuleCache class, which stores
+/// the loaded and validated modules on the disk for skipping the loading and
+/// the validation of the same binaries in the interpreter mode.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "ast/module.h"
+#include "common/configure.h"
+#include "common/filesystem.h"
+#include "common/span.h"
+#include "common/types.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace WasmEdge {
+namespace Loader {
+
+/// Serializer of the validated modules. The instructions are stored with the
+/// jump descriptors and the stack offsets resolved by the validator, and the
+/// data segments refer to the mapped cache file without copying.
+class ModuleCache {
+public:
+  /// Version of the cache file format.
+  static inline constexpr const uint32_t kFormatVersion = 4;
+
+  /// Get the cache file path of the binary, which is keyed by the hash of the
+  /// runtime version, the proposals, and the binary.
+  static std::filesystem::path getPath(Span<const Byte> Code,
+                                       const Configure &Conf);
+
+  /// Restore the validated module from the cache file. Return nullptr if the
+  /// cache file is missing or broken. The restored module is marked validated
+  /// without validating again, so the cache directory must be trusted.
+  static std::unique_ptr<AST::Module>
+  load(const std::filesystem::path &Path) noexcept;
+
+  /// Store the validated module into the cache file. Return false if failed.
+  static bool store(const std::filesystem::path &Path,
+                    const AST::Module &Mod) noexcept;
+
+private:
+  class Writer;
+  class Reader;
+
+  /// \name Serialization of the instructions.
+  /// @{
+  static void writeInstr(Writer &W, const AST::Instruction &Instr);
+  static bool readInstr(Reader &R, AST::Instruction &Instr);
+  /// @}
+};
+
+/// Writer of the module cache at the given path, which is set into the loaded
+/// module and invoked after validation.
+class ModuleCacheWriter : public AST::CacheWriter {
+public:
+  ModuleCacheWriter(std::filesystem::path P) noexcept : Path(std::move(P)) {}
+
+  /// Store the validated module. The failures are ignored.
+  void write(const AST::Module &Mod) const override {
+    ModuleCache::store(Path, Mod);
+  }
+
+private:
+  std::filesystem::path Path;
+};
+
+} // namespace Loader
+} // namespace WasmEdge
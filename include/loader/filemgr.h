@@ -19,14 +19,76 @@
 #include "system/mmap.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace WasmEdge {
 
+/// Binary data fed incrementally by a producer, such as a pipe, a socket, or
+/// the push calls of the C API. The data is kept in a reserved region which
+/// never moves, so the views into the data stay valid while it grows. If the
+/// region cannot be reserved, the data is collected in a growable buffer and
+/// only readable after the stream is finished.
+class ByteStream {
+public:
+  /// Default capacity of the reserved region.
+  static inline constexpr const uint64_t kDefaultCapacity =
+      UINT64_C(0x100000000);
+
+  ByteStream(uint64_t Capacity = kDefaultCapacity) noexcept;
+  ~ByteStream() noexcept;
+  ByteStream(const ByteStream &) = delete;
+  ByteStream &operator=(const ByteStream &) = delete;
+
+  /// Append the bytes. Return false and finish the stream if the capacity is
+  /// exceeded, or return false if the stream has been finished.
+  bool push(Span<const Byte> Bytes) noexcept;
+
+  /// Mark the end of the binary data.
+  void finish() noexcept;
+
+  /// Cancel the stream from the consumer side. The following pushes return
+  /// false, and the waiting consumers are woken up with the arrived data.
+  void cancel() noexcept;
+
+  /// Return true if the stream has been cancelled.
+  bool isCancelled() const noexcept {
+    std::unique_lock Lock(Mutex);
+    return Cancelled;
+  }
+
+  /// Wait until the size of the arrived data reaches the required size or the
+  /// stream is finished, and return the size of the arrived data. Without the
+  /// reserved region, always wait until the stream is finished.
+  uint64_t wait(uint64_t Required) const noexcept;
+
+  /// Getter of the start of the binary data, which is valid after waiting.
+  const Byte *data() const noexcept {
+    std::unique_lock Lock(Mutex);
+    return Data;
+  }
+
+private:
+  /// Finish the stream with the mutex locked.
+  void finishLocked() noexcept;
+
+  Byte *Data;
+  /// Capacity of the reserved region, or 0 if using the buffer.
+  uint64_t Capacity;
+  std::vector<Byte> Buffer;
+  uint64_t Size = 0;
+  bool Finished = false;
+  bool Cancelled = false;
+  mutable std::mutex Mutex;
+  mutable std::condition_variable Cond;
+};
+
 /// File manager interface.
 class FileMgr {
 public:
@@ -54,12 +116,35 @@ public:
   /// Set the binary data.
   Expect<void> setCode(std::vector<Byte> CodeData);
 
+  /// Set the stream of the binary data. The reading waits for the data
+  /// arriving from the stream.
+  Expect<void> setStream(std::shared_ptr<ByteStream> CodeStream);
+
+  /// Return true if reading from the stream.
+  bool isStream() const noexcept { return static_cast<bool>(Stream); }
+
   /// Read one byte.
   Expect<Byte> readByte();
 
   /// Read number of bytes into a vector.
   Expect<std::vector<Byte>> readBytes(size_t SizeToRead);
 
+  /// Read number of bytes as a view into the binary data without copying.
+  Expect<Span<const Byte>> readSpan(size_t SizeToRead);
+
+  /// Get the holder which keeps the binary data alive, so that the views read
+  /// by `readSpan()` outlive the file manager. Return nullptr if the binary
+  /// data is owned by the caller of `setCode()`.
+  std::shared_ptr<const void> getHolder() const noexcept {
+    if (FileMap) {
+      return FileMap;
+    }
+    if (Stream) {
+      return Stream;
+    }
+    return DataHolder;
+  }
+
   /// Read an unsigned int.
   Expect<uint32_t> readU32();
 
@@ -93,11 +178,19 @@ public:
   /// Get remain size.
   uint64_t getRemainSize() const noexcept { return Size - Pos; }
 
+  /// Get the whole binary data. For the stream, only the arrived data.
+  Span<const Byte> getData() const noexcept {
+    return Span<const Byte>(Data, Size);
+  }
+
   /// Jump the content with size (size + content).
   Expect<void> jumpContent();
 
   /// Change the access position of the file.
   void seek(uint64_t NewPos) {
+    if (Stream && NewPos > Size) {
+      Size = Stream->wait(NewPos);
+    }
     if (Status != ErrCode::Value::IllegalPath) {
       Pos = std::min(NewPos, Size);
       LastPos = Pos;
@@ -114,6 +207,7 @@ public:
     Data = nullptr;
     FileMap.reset();
     DataHolder.reset();
+    Stream.reset();
   }
 
 private:
@@ -140,8 +234,9 @@ private:
 
   /// File or data management.
   const Byte *Data;
-  std::optional<MMap> FileMap;
-  std::optional<std::vector<Byte>> DataHolder;
+  std::shared_ptr<MMap> FileMap;
+  std::shared_ptr<std::vector<Byte>> DataHolder;
+  std::shared_ptr<ByteStream> Stream;
 };
 
 } // namespace WasmEdge
@@ -94,21 +94,38 @@ public:
   /// Parse module from byte code.
   Expect<std::unique_ptr<AST::Module>> parseModule(Span<const uint8_t> Code);
 
+  /// Parse module from the stream, which is fed by the other threads. The
+  /// sections and the function bodies are parsed while the later bytes are
+  /// still arriving.
+  Expect<std::unique_ptr<AST::Module>>
+  parseModule(std::shared_ptr<ByteStream> Stream);
+
 private:
+  friend class LazyCodeDecoder;
+
+  /// Feed the stream by reading the pipe or the character device until the
+  /// end of the file, or until the stream is finished or cancelled.
+  static void feedStream(const std::filesystem::path &FilePath,
+                         ByteStream &Stream) noexcept;
+
   /// \name Helper functions to print error log when loading AST nodes
   /// @{
   inline auto logLoadError(ErrCode Code, uint64_t Off, ASTNodeAttr Node) {
-    spdlog::error(Code);
-    spdlog::error(ErrInfo::InfoLoading(Off));
-    spdlog::error(ErrInfo::InfoAST(Node));
+    if (!IsQuiet) {
+      spdlog::error(Code);
+      spdlog::error(ErrInfo::InfoLoading(Off));
+      spdlog::error(ErrInfo::InfoAST(Node));
+    }
     return Unexpect(Code);
   }
   inline auto logNeedProposal(ErrCode Code, Proposal Prop, uint64_t Off,
                               ASTNodeAttr Node) {
-    spdlog::error(Code);
-    spdlog::error(ErrInfo::InfoProposal(Prop));
-    spdlog::error(ErrInfo::InfoLoading(Off));
-    spdlog::error(ErrInfo::InfoAST(Node));
+    if (!IsQuiet) {
+      spdlog::error(Code);
+      spdlog::error(ErrInfo::InfoProposal(Prop));
+      spdlog::error(ErrInfo::InfoLoading(Off));
+      spdlog::error(ErrInfo::InfoAST(Node));
+    }
     return Unexpect(Code);
   }
   Expect<ValType> checkValTypeProposals(ValType VType, bool AcceptNone,
@@ -121,6 +138,7 @@ private:
   /// \name Load AST Module functions
   /// @{
   Expect<std::unique_ptr<AST::Module>> loadModule();
+  Expect<std::unique_ptr<AST::Module>> loadModuleOrCache();
   Expect<void> loadCompiled(AST::Module &Mod);
   /// @}
 
@@ -187,6 +205,8 @@ private:
   Expect<void> loadSection(AST::DataSection &Sec);
   Expect<void> loadSection(AST::DataCountSection &Sec);
   static Expect<void> loadSection(FileMgr &VecMgr, AST::AOTSection &Sec);
+  Expect<void> loadCodeSegmentsParallel(AST::CodeSection &Sec,
+                                        uint32_t Threads);
   Expect<void> loadSegment(AST::GlobalSegment &GlobSeg);
   Expect<void> loadSegment(AST::ElementSegment &ElemSeg);
   Expect<void> loadSegment(AST::CodeSegment &CodeSeg);
@@ -202,9 +222,26 @@ private:
                               std::optional<uint64_t> SizeBound = std::nullopt);
   Expect<OpCode> loadOpCode();
   Expect<AST::InstrVec> loadInstrSeq(std::optional<uint64_t> SizeBound);
-  Expect<void> loadInstruction(AST::Instruction &Instr);
+  Expect<void>
+  loadInstruction(AST::Instruction &Instr,
+                  std::optional<uint64_t> SizeBound = std::nullopt);
+  Expect<AST::InstrVec> loadFunctionBody(Span<const Byte> Body,
+                                         uint64_t Offset);
+  /// @}
+
+  /// \name Parallel decoding of the code section
+  /// @{
+  /// Minimum code section size in bytes for decoding in parallel.
+  static inline constexpr const uint32_t kParallelDecodingSize = 64 * 1024;
+  /// Count of the segments taken by a worker at a time.
+  static inline constexpr const uint32_t kParallelDecodingChunk = 16;
   /// @}
 
+  /// Size of the chunks read from the pipes and the character devices.
+  static inline constexpr const uint32_t kStreamChunkSize = 64 * 1024;
+  /// Timeout in milliseconds of polling the pipes for checking cancellation.
+  static inline constexpr const int kStreamPollTimeout = 50;
+
   /// \name Loader members
   /// @{
   const Configure Conf;
@@ -215,8 +252,30 @@ private:
   bool HasDataSection;
   bool IsSharedLibraryWASM;
   bool IsUniversalWASM;
+  /// Suppress the error logs, for the workers of the parallel decoding.
+  bool IsQuiet = false;
+  /// Record the function bodies instead of decoding them.
+  bool IsDeferringBody = false;
   /// @}
 };
 
+/// Decoder of the function bodies deferred by the lazy loading. The function
+/// bodies are decoded with the same configuration and the data count section
+/// presence of the module.
+class LazyCodeDecoder : public AST::CodeDecoder {
+public:
+  LazyCodeDecoder(const Configure &Conf, bool HasDataSection) noexcept
+      : Load(Conf) {
+    Load.HasDataSection = HasDataSection;
+  }
+
+  /// Decode the deferred function body. Thread-safe.
+  Expect<AST::InstrVec> decode(Span<const Byte> Body,
+                               uint64_t Offset) const override;
+
+private:
+  mutable Loader Load;
+};
+
 } // namespace Loader
 } // namespace WasmEdge
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/loader/profile.h - Profile file class definition ---------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the ProfileFile class, which reads
+/// and writes the execution profiles recorded by the interpreter for the
+/// profile-guided AOT compilation.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/errcode.h"
+#include "common/filesystem.h"
+#include "common/profile.h"
+#include "common/span.h"
+#include "common/types.h"
+
+#include <map>
+#include <string>
+
+namespace WasmEdge {
+namespace Loader {
+
+/// Profile file of the modules, keyed by the hash of the binaries. The file is
+/// in the text format:
+///
+///   module <hash>
+///   function <function index>
+///   branch <instruction index> <count>...
+///   call <instruction index> <function index>:<count>...
+class ProfileFile {
+public:
+  /// Get the key of the module profile from the binary.
+  static std::string getKey(Span<const Byte> Code);
+
+  /// Read the profile file. The missing file is treated as empty.
+  Expect<void> load(const std::filesystem::path &Path);
+
+  /// Write the profile file.
+  Expect<void> store(const std::filesystem::path &Path) const;
+
+  /// Find the profile of the module. Return nullptr if not found.
+  const ModuleProfile *find(const std::string &Key) const noexcept;
+
+  /// Accumulate the counts of the module profile.
+  void merge(const std::string &Key, const ModuleProfile &Prof);
+
+private:
+  std::map<std::string, ModuleProfile> Modules;
+};
+
+} // namespace Loader
+} // namespace WasmEdge
@@ -17,6 +17,7 @@
 #include "ast/section.h"
 #include "common/defines.h"
 #include "common/errcode.h"
+#include "common/executable.h"
 #include "common/filesystem.h"
 #include "common/symbol.h"
 
@@ -32,7 +33,7 @@ namespace WasmEdge {
 namespace Loader {
 
 /// Holder class for library handle
-class SharedLibrary : public std::enable_shared_from_this<SharedLibrary> {
+class SharedLibrary : public Executable {
   SharedLibrary(const SharedLibrary &) = delete;
   SharedLibrary &operator=(const SharedLibrary &) = delete;
   SharedLibrary(SharedLibrary &&) = delete;
@@ -46,14 +47,13 @@ public:
 #endif
 
   SharedLibrary() noexcept = default;
-  ~SharedLibrary() noexcept { unload(); }
+  ~SharedLibrary() noexcept override { unload(); }
   Expect<void> load(const std::filesystem::path &Path) noexcept;
   Expect<void> load(const AST::AOTSection &AOTSec) noexcept;
   void unload() noexcept;
 
   template <typename T> Symbol<T> get(const char *Name) {
-    return Symbol<T>(shared_from_this(),
-                     reinterpret_cast<T *>(getSymbolAddr(Name)));
+    return createSymbol<T>(reinterpret_cast<T *>(getSymbolAddr(Name)));
   }
 
   uintptr_t getOffset() const noexcept;
@@ -64,7 +64,7 @@ public:
 
   template <typename T> Symbol<T> getIntrinsics() noexcept {
     if (Binary) {
-      return Symbol<T>(shared_from_this(), getPointer<T>(IntrinsicsAddress));
+      return createSymbol<T>(getPointer<T>(IntrinsicsAddress));
     }
     return {};
   }
@@ -74,7 +74,7 @@ public:
     if (Binary) {
       Result.reserve(TypesAddress.size());
       for (const auto Address : TypesAddress) {
-        Result.push_back(Symbol<T>(shared_from_this(), getPointer<T>(Address)));
+        Result.push_back(createSymbol<T>(getPointer<T>(Address)));
       }
     }
     return Result;
@@ -85,7 +85,7 @@ public:
     if (Binary) {
       Result.reserve(CodesAddress.size());
       for (const auto Address : CodesAddress) {
-        Result.push_back(Symbol<T>(shared_from_this(), getPointer<T>(Address)));
+        Result.push_back(createSymbol<T>(getPointer<T>(Address)));
       }
     }
     return Result;
@@ -44,9 +44,15 @@ public:
   /// Getter of host function cost.
   uint64_t getCost() const { return Cost; }
 
+  /// Getter and setter of the leaf flag. A leaf host function never re-enters
+  /// the VM, so the executor can call it without pushing a frame.
+  bool isLeaf() const noexcept { return IsLeaf; }
+  void setLeaf(bool Leaf = true) noexcept { IsLeaf = Leaf; }
+
 protected:
   AST::FunctionType FuncType;
   const uint64_t Cost;
+  bool IsLeaf = false;
 };
 
 template <typename T> class HostFunction : public HostFunctionBase {
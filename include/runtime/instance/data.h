@@ -16,6 +16,7 @@
 #include "common/span.h"
 #include "common/types.h"
 
+#include <memory>
 #include <vector>
 
 namespace WasmEdge {
@@ -25,8 +26,17 @@ namespace Instance {
 class DataInstance {
 public:
   DataInstance() = delete;
-  DataInstance(const uint32_t Offset, Span<const Byte> Init) noexcept
-      : Off(Offset), Data(Init.begin(), Init.end()) {}
+  /// The data is referred without copying if the holder which keeps it alive
+  /// is given, otherwise it is copied.
+  DataInstance(const uint32_t Offset, Span<const Byte> Init,
+               std::shared_ptr<const void> DataHolder = nullptr)
+      : Off(Offset), Holder(std::move(DataHolder)), Data(Init) {
+    if (!Holder) {
+      auto Copy = std::make_shared<std::vector<Byte>>(Init.begin(), Init.end());
+      Data = *Copy;
+      Holder = std::move(Copy);
+    }
+  }
 
   /// Get offset in data instance.
   uint32_t getOffset() const noexcept { return Off; }
@@ -34,14 +44,23 @@ public:
   /// Get data in data instance.
   Span<const Byte> getData() const noexcept { return Data; }
 
-  /// Clear data in data instance.
-  void clear() { Data.clear(); }
+  /// Get the holder which keeps the data alive.
+  const std::shared_ptr<const void> &getDataHolder() const noexcept {
+    return Holder;
+  }
+
+  /// Clear data in data instance. The reference to the data is released.
+  void clear() {
+    Data = {};
+    Holder.reset();
+  }
 
 private:
   /// \name Data of data instance.
   /// @{
   const uint32_t Off;
-  std::vector<Byte> Data;
+  std::shared_ptr<const void> Holder;
+  Span<const Byte> Data;
   /// @}
 };
 
@@ -38,8 +38,8 @@ public:
   /// Get reference lists in element instance.
   Span<const RefVariant> getRefs() const noexcept { return Refs; }
 
-  /// Clear references in element instance.
-  void clear() { Refs.clear(); }
+  /// Clear references in element instance and release the storage.
+  void clear() { std::vector<RefVariant>().swap(Refs); }
 
 private:
   /// \name Data of element instance.
@@ -14,15 +14,31 @@
 #pragma once
 
 #include "ast/instruction.h"
+#include "common/functypeid.h"
 #include "common/symbol.h"
 #include "runtime/hostfunc.h"
+#include "runtime/regir.h"
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
+
+namespace AST {
+class CodeDecoder;
+class CodeChecker;
+} // namespace AST
+
+namespace Executor {
+class Executor;
+}
+
 namespace Runtime {
 namespace Instance {
 
@@ -32,32 +48,151 @@ class FunctionInstance {
 public:
   using CompiledFunction = void;
 
+  /// Function body deferred by the lazy loading, which is decoded, validated,
+  /// and prepared by the executor on the first call of the function.
+  struct LazyBody {
+    std::shared_ptr<const AST::CodeDecoder> Decoder;
+    std::shared_ptr<const AST::CodeChecker> Checker;
+    std::shared_ptr<const void> Holder;
+    Span<const Byte> Body;
+    uint64_t Offset = 0;
+    uint32_t TypeIdx = 0;
+    /// Base index of the inline caches for each type of the indirect calls.
+    uint32_t CacheBase = 0;
+    /// Preparing options decided when instantiating.
+    bool IsFused = false;
+    bool IsLowered = false;
+    bool IsMetered = false;
+    bool IsProfiled = false;
+    /// Once flag and the result of the preparing.
+    std::once_flag Once;
+    ErrCode Error;
+  };
+
+  /// Types of the module for compiling the function bodies by the tier-up,
+  /// which are shared by the functions of the same module.
+  struct TierUpModule {
+    std::vector<AST::FunctionType> Types;
+    /// Type indices of the functions, including the imported functions.
+    std::vector<uint32_t> FuncTypeIdxs;
+    /// Value types of the globals, including the imported globals.
+    std::vector<ValType> GlobalTypes;
+  };
+
+  struct WasmFunction;
+
+  /// State of the tiered execution of the native wasm function. The compiled
+  /// code is set once by the background compiler and published by the flag.
+  struct TierUp {
+    std::shared_ptr<const TierUpModule> Module;
+    /// Code of the function owning this state, for queueing the function.
+    std::weak_ptr<WasmFunction> Code;
+    /// Index of the function in the module.
+    uint32_t FuncIdx = 0;
+    /// Counters of the calls and the taken loop back-edges.
+    std::atomic<uint32_t> CallCount = 0;
+    std::atomic<uint32_t> LoopCount = 0;
+    std::atomic<bool> IsQueued = false;
+    std::atomic<bool> IsCompiled = false;
+    Symbol<AST::FunctionType::Wrapper> Wrapper;
+    Symbol<CompiledFunction> Function;
+  };
+
+  /// Counters of the branch profile of the native wasm function, which are
+  /// recorded by the interpreter and indexed by the instructions.
+  struct Profile {
+    /// Begin of the function body for the instruction indices.
+    const AST::Instruction *Begin = nullptr;
+    /// Index of the first counter of each instruction, with the total count
+    /// at last. The `if` and `br_if` instructions have the counters of not
+    /// taken and taken, and the `br_table` instructions have the counters of
+    /// the labels.
+    std::vector<uint32_t> Slots;
+    std::unique_ptr<std::atomic<uint64_t>[]> Counts;
+    /// Counts of the called functions of the `call_indirect` instructions.
+    std::mutex Mutex;
+    std::map<std::pair<uint32_t, const WasmFunction *>, uint64_t> Calls;
+  };
+
+  /// Code of the native wasm function. The code is immutable after prepared by
+  /// the executor, and shared by the function instances instantiated from the
+  /// same AST module.
+  struct WasmFunction {
+    const std::vector<std::pair<uint32_t, ValType>> Locals;
+    const uint32_t LocalNum;
+    AST::InstrVec Instrs;
+    std::unique_ptr<RegIR::Code> RegCode;
+    std::unique_ptr<LazyBody> Lazy;
+    std::unique_ptr<TierUp> Tier;
+    std::unique_ptr<Profile> Prof;
+    std::atomic<bool> IsPending = false;
+    WasmFunction(Span<const std::pair<uint32_t, ValType>> Locs,
+                 AST::InstrView Expr) noexcept
+        : Locals(Locs.begin(), Locs.end()),
+          LocalNum(
+              std::accumulate(Locals.begin(), Locals.end(), UINT32_C(0),
+                              [](uint32_t N, const auto &Pair) -> uint32_t {
+                                return N + Pair.first;
+                              })) {
+      // Reserve one more slot to keep the end of the body away from the
+      // beginning of the other allocated bodies, so that the PCs of different
+      // functions never alias.
+      Instrs.reserve(Expr.size() + 1);
+      Instrs.assign(Expr.begin(), Expr.end());
+    }
+    WasmFunction(Span<const std::pair<uint32_t, ValType>> Locs,
+                 std::unique_ptr<LazyBody> Body) noexcept
+        : WasmFunction(Locs, AST::InstrView()) {
+      Lazy = std::move(Body);
+      IsPending.store(true, std::memory_order_relaxed);
+    }
+  };
+
   FunctionInstance() = delete;
   /// Move constructor.
   FunctionInstance(FunctionInstance &&Inst) noexcept
       : ModInst(Inst.ModInst), FuncType(Inst.FuncType),
-        Data(std::move(Inst.Data)) {}
+        FuncTypeID(Inst.FuncTypeID), Data(std::move(Inst.Data)) {}
   /// Constructor for native function.
   FunctionInstance(const ModuleInstance *Mod, const AST::FunctionType &Type,
                    Span<const std::pair<uint32_t, ValType>> Locs,
                    AST::InstrView Expr) noexcept
       : ModInst(Mod), FuncType(Type),
-        Data(std::in_place_type_t<WasmFunction>(), Locs, Expr) {}
+        FuncTypeID(WasmEdge::getFuncTypeID(Type.getParamTypes(),
+                                           Type.getReturnTypes())),
+        Data(std::make_shared<WasmFunction>(Locs, Expr)) {}
+  /// Constructor for native function with the shared code and the canonical
+  /// ID of the function type.
+  FunctionInstance(const ModuleInstance *Mod, const AST::FunctionType &Type,
+                   uint32_t TypeID, std::shared_ptr<WasmFunction> Code) noexcept
+      : ModInst(Mod), FuncType(Type), FuncTypeID(TypeID),
+        Data(std::move(Code)) {}
   /// Constructor for compiled function.
   FunctionInstance(const ModuleInstance *Mod, const AST::FunctionType &Type,
                    Symbol<CompiledFunction> S) noexcept
       : ModInst(Mod), FuncType(Type),
+        FuncTypeID(WasmEdge::getFuncTypeID(Type.getParamTypes(),
+                                           Type.getReturnTypes())),
         Data(std::in_place_type_t<Symbol<CompiledFunction>>(), std::move(S)) {}
   /// Constructor for host function.
   FunctionInstance(const ModuleInstance *Mod,
                    std::unique_ptr<HostFunctionBase> &&Func) noexcept
       : ModInst(Mod), FuncType(Func->getFuncType()),
+        FuncTypeID(WasmEdge::getFuncTypeID(FuncType.getParamTypes(),
+                                           FuncType.getReturnTypes())),
         Data(std::in_place_type_t<std::unique_ptr<HostFunctionBase>>(),
              std::move(Func)) {}
+  ~FunctionInstance() noexcept {
+    // The functions owned by a module instance are counted once when the
+    // module instance is destroyed.
+    if (ModInst == nullptr) {
+      FuncInstGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
 
   /// Getter of checking is native wasm function.
   bool isWasmFunction() const noexcept {
-    return std::holds_alternative<WasmFunction>(Data);
+    return std::holds_alternative<std::shared_ptr<WasmFunction>>(Data);
   }
 
   /// Getter of checking is compiled function.
@@ -76,25 +211,54 @@ public:
   /// Getter of function type.
   const AST::FunctionType &getFuncType() const noexcept { return FuncType; }
 
+  /// Getter of the canonical ID of the function type.
+  uint32_t getFuncTypeID() const noexcept { return FuncTypeID; }
+
+  /// Return true if the function body is deferred by the lazy loading and not
+  /// prepared yet.
+  bool isPending() const noexcept {
+    if (auto *Func = getWasmFunction()) {
+      return Func->IsPending.load(std::memory_order_acquire);
+    }
+    return false;
+  }
+
+  /// Return true if the native wasm function is switched to the code compiled
+  /// by the tier-up.
+  bool isTieredUp() const noexcept {
+    if (auto *Func = getWasmFunction(); Func && Func->Tier) {
+      return Func->Tier->IsCompiled.load(std::memory_order_acquire);
+    }
+    return false;
+  }
+
   /// Getter of function local variables.
   Span<const std::pair<uint32_t, ValType>> getLocals() const noexcept {
-    return std::get_if<WasmFunction>(&Data)->Locals;
+    return getWasmFunction()->Locals;
   }
 
   /// Getter of function local number.
   uint32_t getLocalNum() const noexcept {
-    return std::get_if<WasmFunction>(&Data)->LocalNum;
+    return getWasmFunction()->LocalNum;
   }
 
   /// Getter of function body instrs.
   AST::InstrView getInstrs() const noexcept {
-    if (std::holds_alternative<WasmFunction>(Data)) {
-      return std::get<WasmFunction>(Data).Instrs;
+    if (auto *Func = getWasmFunction()) {
+      return Func->Instrs;
     } else {
       return {};
     }
   }
 
+  /// Getter of the lowered register-based code. Nullptr if not lowered.
+  const RegIR::Code *getRegisterCode() const noexcept {
+    if (auto *Func = getWasmFunction()) {
+      return Func->RegCode.get();
+    }
+    return nullptr;
+  }
+
   /// Getter of symbol
   auto &getSymbol() const noexcept {
     return *std::get_if<Symbol<CompiledFunction>>(&Data);
@@ -106,32 +270,55 @@ public:
   }
 
 private:
-  struct WasmFunction {
-    const std::vector<std::pair<uint32_t, ValType>> Locals;
-    const uint32_t LocalNum;
-    AST::InstrVec Instrs;
-    WasmFunction(Span<const std::pair<uint32_t, ValType>> Locs,
-                 AST::InstrView Expr) noexcept
-        : Locals(Locs.begin(), Locs.end()),
-          LocalNum(
-              std::accumulate(Locals.begin(), Locals.end(), UINT32_C(0),
-                              [](uint32_t N, const auto &Pair) -> uint32_t {
-                                return N + Pair.first;
-                              })) {
-      // FIXME: Modify the capacity to prevent from connection of 2 vectors.
-      Instrs.reserve(Expr.size() + 1);
-      Instrs.assign(Expr.begin(), Expr.end());
-    }
-  };
-
   friend class ModuleInstance;
   void setModule(const ModuleInstance *Mod) noexcept { ModInst = Mod; }
 
+  /// Getter of the code of the native wasm function. Nullptr if not native.
+  WasmFunction *getWasmFunction() const noexcept {
+    if (auto *Func = std::get_if<std::shared_ptr<WasmFunction>>(&Data)) {
+      return Func->get();
+    }
+    return nullptr;
+  }
+
+  /// Getters and setters of the code for preparing in the executor. The code
+  /// should not be modified after shared.
+  friend class Executor::Executor;
+  const std::shared_ptr<WasmFunction> &getSharedCode() const noexcept {
+    return *std::get_if<std::shared_ptr<WasmFunction>>(&Data);
+  }
+  Span<AST::Instruction> getMutableInstrs() noexcept {
+    if (auto *Func = getWasmFunction()) {
+      return Func->Instrs;
+    }
+    return {};
+  }
+  void setRegisterCode(std::unique_ptr<RegIR::Code> Code) noexcept {
+    if (auto *Func = getWasmFunction()) {
+      Func->RegCode = std::move(Code);
+    }
+  }
+  /// Getter of the tier-up state. Nullptr if the tiering is disabled.
+  TierUp *getTierUp() const noexcept {
+    if (auto *Func = getWasmFunction()) {
+      return Func->Tier.get();
+    }
+    return nullptr;
+  }
+  /// Getter of the branch profile. Nullptr if the profiling is disabled.
+  Profile *getProfile() const noexcept {
+    if (auto *Func = getWasmFunction()) {
+      return Func->Prof.get();
+    }
+    return nullptr;
+  }
+
   /// \name Data of function instance.
   /// @{
   const ModuleInstance *ModInst;
   const AST::FunctionType &FuncType;
-  std::variant<WasmFunction, Symbol<CompiledFunction>,
+  const uint32_t FuncTypeID;
+  std::variant<std::shared_ptr<WasmFunction>, Symbol<CompiledFunction>,
                std::unique_ptr<HostFunctionBase>>
       Data;
   /// @}
@@ -39,7 +39,7 @@ public:
   MemoryInstance() = delete;
   MemoryInstance(MemoryInstance &&Inst) noexcept
       : MemType(Inst.MemType), DataPtr(Inst.DataPtr),
-        PageLimit(Inst.PageLimit) {
+        PageLimit(Inst.PageLimit), IsGuarded(Inst.IsGuarded) {
     Inst.DataPtr = nullptr;
   }
   MemoryInstance(const AST::MemoryType &MType,
@@ -56,6 +56,7 @@ public:
       spdlog::error("Unable to find usable memory address");
       return;
     }
+    IsGuarded = Allocator::isReserved(DataPtr);
   }
   ~MemoryInstance() noexcept {
     Allocator::release(DataPtr, MemType.getLimit().getMin());
@@ -63,6 +64,11 @@ public:
 
   bool isShared() const noexcept { return MemType.getLimit().isShared(); }
 
+  /// Return true if the memory owns the whole reserved region of the
+  /// allocator, whose inaccessible pages trap the out-of-bounds accesses
+  /// instead of the explicit bounds checks.
+  bool isGuarded() const noexcept { return IsGuarded; }
+
   /// Get page size of memory.data
   uint32_t getPageSize() const noexcept {
     // The memory page size is binded with the limit in memory type.
@@ -253,6 +259,46 @@ public:
       spdlog::error(ErrInfo::InfoBoundary(Offset, Length, getBoundIdx()));
       return Unexpect(ErrCode::Value::MemoryOutOfBounds);
     }
+    loadValueUnchecked<T, Length>(Value, Offset);
+    return {};
+  }
+
+  /// Template of loading bytes and convert to a value.
+  ///
+  /// Destruct and Store the value to length of vector.
+  /// Only input value of uint32, uint64, float, and double are allowed.
+  ///
+  /// \param Value the value want to store into data array.
+  /// \param Offset the start offset in data array.
+  ///
+  /// \returns void when success, ErrCode when failed.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNativeNumV<T>, Expect<void>>
+  storeValue(const T &Value, uint32_t Offset) noexcept {
+    // Check the data boundary.
+    static_assert(Length <= sizeof(T));
+    // Check the memory boundary.
+    if (unlikely(!checkAccessBound(Offset, Length))) {
+      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+      spdlog::error(ErrInfo::InfoBoundary(Offset, Length, getBoundIdx()));
+      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    }
+    storeValueUnchecked<T, Length>(Value, Offset);
+    return {};
+  }
+
+  /// Load bytes and convert to a value without checking the boundary.
+  ///
+  /// The offset is the effective address in 64-bit, which never wraps around.
+  /// The out-of-bounds accesses hit the inaccessible pages of the memory
+  /// reservation and should be trapped by the fault handler of the caller.
+  ///
+  /// \param Value the constructed output value.
+  /// \param Offset the start offset in data array.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNumV<T>, void>
+  loadValueUnchecked(T &Value, uint64_t Offset) const noexcept {
+    static_assert(Length <= sizeof(T));
     // Load the data to the value.
     if (likely(Length > 0)) {
       if constexpr (std::is_floating_point_v<T>) {
@@ -277,34 +323,20 @@ public:
         }
       }
     }
-    return {};
   }
 
-  /// Template of loading bytes and convert to a value.
-  ///
-  /// Destruct and Store the value to length of vector.
-  /// Only input value of uint32, uint64, float, and double are allowed.
+  /// Store a value to bytes without checking the boundary.
   ///
   /// \param Value the value want to store into data array.
   /// \param Offset the start offset in data array.
-  ///
-  /// \returns void when success, ErrCode when failed.
   template <typename T, uint32_t Length = sizeof(T)>
-  typename std::enable_if_t<IsWasmNativeNumV<T>, Expect<void>>
-  storeValue(const T &Value, uint32_t Offset) noexcept {
-    // Check the data boundary.
+  typename std::enable_if_t<IsWasmNativeNumV<T>, void>
+  storeValueUnchecked(const T &Value, uint64_t Offset) noexcept {
     static_assert(Length <= sizeof(T));
-    // Check the memory boundary.
-    if (unlikely(!checkAccessBound(Offset, Length))) {
-      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-      spdlog::error(ErrInfo::InfoBoundary(Offset, Length, getBoundIdx()));
-      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-    }
     // Copy the stored data to the value.
     if (likely(Length > 0)) {
       std::memcpy(&DataPtr[Offset], &Value, Length);
     }
-    return {};
   }
 
   uint8_t *getDataPtr() const noexcept { return DataPtr; }
@@ -315,6 +347,7 @@ private:
   AST::MemoryType MemType;
   uint8_t *DataPtr = nullptr;
   const uint32_t PageLimit;
+  bool IsGuarded = false;
   /// @}
 };
 
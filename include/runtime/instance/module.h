@@ -63,6 +63,22 @@ inline constexpr const bool IsInstanceV =
     std::is_same_v<T, Instance::DataInstance>;
 } // namespace
 
+/// Code of the native wasm functions in a module prepared by the executor. It
+/// is immutable and shared by the module instances instantiated from the same
+/// AST module.
+struct ModuleCode {
+  /// Whether the instructions are fused.
+  bool IsFused = false;
+  /// Whether the functions are lowered into the register-based IR.
+  bool IsLowered = false;
+  /// Whether the functions are counted for the tier-up.
+  bool IsTiered = false;
+  /// Count of the inline caches of the indirect call sites.
+  uint32_t CallCacheNum = 0;
+  /// Code of the functions in the code section.
+  std::vector<std::shared_ptr<FunctionInstance::WasmFunction>> Funcs;
+};
+
 class ModuleInstance {
 public:
   ModuleInstance(std::string_view Name) : ModName(Name) {}
@@ -73,6 +89,10 @@ public:
       assuming(Pair.second);
       Pair.second(Pair.first, this);
     }
+    // Invalidate the inline caches once for all the owned function instances.
+    if (!OwnedFuncInsts.empty()) {
+      FuncInstGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   std::string_view getModuleName() const noexcept {
@@ -180,6 +200,40 @@ protected:
   void addFuncType(const AST::FunctionType &FuncType) {
     std::unique_lock Lock(Mutex);
     FuncTypes.emplace_back(FuncType);
+    FuncTypeIDs.push_back(WasmEdge::getFuncTypeID(
+        FuncType.getParamTypes(), FuncType.getReturnTypes()));
+  }
+
+  /// Inline cache of the indirect call site, which holds the last callee
+  /// passing the signature check and the generation of the function instances
+  /// when checked. The hit skips the loads of the type IDs of the callee and
+  /// the module. The cache is stale after a module instance owning functions
+  /// or a function instance not owned by any module is destroyed, for the
+  /// address of the freed one may be reused by another one with a different
+  /// type.
+  struct CallCache {
+    std::atomic<const FunctionInstance *> Func = nullptr;
+    std::atomic<uint64_t> Generation = 0;
+
+    bool isHit(const FunctionInstance *Callee) const noexcept {
+      return Func.load(std::memory_order_relaxed) == Callee &&
+             Generation.load(std::memory_order_relaxed) ==
+                 FuncInstGeneration.load(std::memory_order_relaxed);
+    }
+    /// The generation is read before the check of the callee, which is alive
+    /// until it is called.
+    void fill(const FunctionInstance *Callee, uint64_t Gen) noexcept {
+      Func.store(Callee, std::memory_order_relaxed);
+      Generation.store(Gen, std::memory_order_relaxed);
+    }
+  };
+
+  /// Allocate the inline caches of the indirect call sites.
+  void setCallCacheNum(uint32_t Num) { CallCaches.reset(new CallCache[Num]()); }
+
+  /// Getter of the inline cache of the indirect call site.
+  CallCache &getCallCache(uint32_t Idx) const noexcept {
+    return CallCaches[Idx];
   }
 
   /// Create and add instances into this module instance.
@@ -256,6 +310,16 @@ protected:
     return &FuncTypes[Idx];
   }
 
+  /// Get the canonical ID of the function type by index.
+  Expect<uint32_t> getFuncTypeID(uint32_t Idx) const noexcept {
+    std::shared_lock Lock(Mutex);
+    if (unlikely(Idx >= FuncTypeIDs.size())) {
+      // Error logging need to be handled in caller.
+      return Unexpect(ErrCode::Value::WrongInstanceIndex);
+    }
+    return FuncTypeIDs[Idx];
+  }
+
   /// Get instance pointer by index.
   Expect<FunctionInstance *> getFunc(uint32_t Idx) const noexcept {
     std::shared_lock Lock(Mutex);
@@ -321,6 +385,12 @@ protected:
     return DataInsts[Idx];
   }
 
+  /// Get the function types count.
+  uint32_t getFuncTypeNum() const noexcept {
+    std::shared_lock Lock(Mutex);
+    return static_cast<uint32_t>(FuncTypes.size());
+  }
+
   /// Get the instances count.
   uint32_t getFuncNum() const noexcept {
     std::shared_lock Lock(Mutex);
@@ -421,6 +491,10 @@ protected:
 
   /// Function types.
   std::vector<AST::FunctionType> FuncTypes;
+  std::vector<uint32_t> FuncTypeIDs;
+
+  /// Inline caches of the indirect call sites.
+  std::unique_ptr<CallCache[]> CallCaches;
 
   /// Owned instances in this module.
   std::vector<std::unique_ptr<Instance::FunctionInstance>> OwnedFuncInsts;
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/runtime/instance/template.h - Module template definition -===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the module template definition, which is the frozen
+/// state of an instantiated module for cloning the module instances.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "ast/module.h"
+#include "ast/type.h"
+#include "common/types.h"
+#include "system/snapshot.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace WasmEdge {
+
+namespace Executor {
+class Executor;
+}
+
+namespace Runtime {
+namespace Instance {
+
+class ModuleTemplate {
+public:
+  ModuleTemplate() = delete;
+  ModuleTemplate(const AST::Module &M) noexcept : Mod(M) {}
+
+  /// Getter of the AST module. The AST module should outlive the template.
+  const AST::Module &getModule() const noexcept { return Mod; }
+
+  /// Return true if the start function has been run before freezing.
+  bool isStarted() const noexcept { return IsStarted; }
+
+  /// Index for the references not pointing to the function index space.
+  static inline constexpr const uint32_t kNoFuncIdx = UINT32_MAX;
+
+  /// Value captured in the template. The function references to the function
+  /// index space of the module are kept as the indices and rebound to the
+  /// functions of each cloned module instance.
+  struct ValueImage {
+    ValVariant Value;
+    uint32_t FuncIdx;
+  };
+
+private:
+  friend class Executor::Executor;
+
+  struct TableImage {
+    AST::TableType TabType;
+    std::vector<ValueImage> Refs;
+  };
+
+  struct MemoryImage {
+    AST::MemoryType MemType;
+    std::unique_ptr<MemorySnapshot> Snapshot;
+  };
+
+  struct GlobalImage {
+    AST::GlobalType GlobType;
+    ValueImage Value;
+  };
+
+  struct ElementImage {
+    uint32_t Offset;
+    RefType Type;
+    std::vector<ValueImage> Refs;
+  };
+
+  struct DataImage {
+    uint32_t Offset;
+    Span<const Byte> Data;
+    std::shared_ptr<const void> Holder;
+  };
+
+  /// \name Data of module template.
+  /// @{
+  const AST::Module &Mod;
+  bool IsStarted = false;
+  std::vector<TableImage> Tables;
+  std::vector<MemoryImage> Memories;
+  std::vector<GlobalImage> Globals;
+  std::vector<ElementImage> Elems;
+  std::vector<DataImage> Datas;
+  /// @}
+};
+
+} // namespace Instance
+} // namespace Runtime
+} // namespace WasmEdge
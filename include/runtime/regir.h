@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/runtime/regir.h - Register-based IR definition -----------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the definition of the register-based internal IR which
+/// the interpreter lowers validated function bodies into.
+///
+/// The registers of a function frame are laid out in the value stack as:
+///   [ params and locals | operand stack slots | constants ]
+/// The operand stack slot of the height `H` is the register `LocalNum + H`.
+/// Constants are copied into the tail of the frame when entering a function,
+/// so every operand of an instruction is simply a register index.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/enum_ast.hpp"
+#include "common/types.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace WasmEdge {
+namespace Runtime {
+namespace RegIR {
+
+/// Register-based instruction.
+///
+/// The `Code` field reuses the Wasm opcodes with the register operands:
+///   - Numeric unary:   Dst <- op(A)
+///   - Numeric binary:  Dst <- op(A, B)
+///   - Local.set:       Dst <- A (register move)
+///   - Global.get:      Dst <- global[A]
+///   - Global.set:      global[B] <- A
+///   - Loads:           Dst <- memory[Index][A + offset]
+///   - Stores:          memory[Index][A + offset] <- B, where the offset of
+///                      loads and stores is in the originated AST instruction
+///   - Memory.size:     Dst <- pages of memory[Index]
+///   - Memory.grow:     Dst <- grow(memory[Index], A)
+///   - Select:          Dst <- (B != 0) ? Dst : A
+///   - Br:              jump to A
+///   - Br_if:           jump to B if A != 0
+///   - If:              jump to B if A == 0
+///   - Br_table:        jump to Labels[B + min(A, Dst - 1)]
+///   - Call:            call function A with the arguments from Dst, and store
+///                      the results from Dst
+///   - Call_indirect:   call table[Index][A] with type B, the arguments and
+///                      results are the same as Call
+///   - Return:          return the results from the first operand stack slot
+///   - Unreachable:     trap
+struct Instruction {
+  OpCode Code;
+  uint16_t Index;
+  uint32_t Dst;
+  uint32_t A;
+  uint32_t B;
+};
+
+/// Lowered function body.
+struct Code {
+  /// Register instructions.
+  std::vector<Instruction> Instrs;
+  /// Index of the originated AST instruction for every register instruction,
+  /// used for error reporting.
+  std::vector<uint32_t> Origins;
+  /// Jump targets of the br_table instructions.
+  std::vector<uint32_t> Labels;
+  /// Constant values placed at the tail of the frame.
+  std::vector<ValVariant> Constants;
+  /// Count of params and locals.
+  uint32_t LocalNum = 0;
+  /// Maximum height of the operand stack.
+  uint32_t StackNum = 0;
+
+  /// Getter of the count of registers in a frame.
+  uint32_t getFrameSize() const noexcept {
+    return LocalNum + StackNum + static_cast<uint32_t>(Constants.size());
+  }
+};
+
+} // namespace RegIR
+} // namespace Runtime
+} // namespace WasmEdge
@@ -14,8 +14,13 @@
 #pragma once
 
 #include "ast/instruction.h"
+#include "common/config.h"
 #include "runtime/instance/module.h"
+#include "system/allocator.h"
 
+#include <algorithm>
+#include <new>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
@@ -26,13 +31,21 @@ public:
   struct Frame {
     Frame() = delete;
     Frame(const Instance::ModuleInstance *Mod, AST::InstrView::iterator FromIt,
-          uint32_t L, uint32_t A, uint32_t V) noexcept
-        : Module(Mod), From(FromIt), Locals(L), Arity(A), VPos(V) {}
+          uint32_t L, uint32_t A, uint32_t V,
+          Instance::FunctionInstance::TierUp *T,
+          Instance::FunctionInstance::Profile *P) noexcept
+        : Module(Mod), From(FromIt), Locals(L), Arity(A), VPos(V), Tier(T),
+          Prof(P) {}
     const Instance::ModuleInstance *Module;
     AST::InstrView::iterator From;
     uint32_t Locals;
     uint32_t Arity;
     uint32_t VPos;
+    /// Tier-up state of the interpreted function for counting the loop
+    /// back-edges. Nullptr if not counted.
+    Instance::FunctionInstance::TierUp *Tier;
+    /// Branch profile of the interpreted function. Nullptr if not profiled.
+    Instance::FunctionInstance::Profile *Prof;
   };
 
   using Value = ValVariant;
@@ -41,58 +54,142 @@ public:
   /// modules. All operations of instructions passed validation, therefore no
   /// unexpect operations will occur.
   StackManager() noexcept {
-    ValueStack.reserve(2048U);
+#if WASMEDGE_GUARDED_VALUE_STACK
+    // Reuse the region released on this thread to save the mapping.
+    uint8_t *Region = std::exchange(Cache.Region, nullptr);
+    if (Region == nullptr) {
+      Region = Allocator::allocate_guarded_chunk(kValueStackBytes);
+    }
+    if (likely(Region != nullptr)) {
+      Bottom = reinterpret_cast<Value *>(Region);
+      Limit = nullptr;
+    } else {
+      // Fall back to the growable stack when the address space is not
+      // available for the region.
+      Storage.resize(2048U);
+      Bottom = Storage.data();
+      Limit = Bottom + Storage.size();
+    }
+#else
+    Storage.resize(2048U);
+    Bottom = Storage.data();
+    Limit = Bottom + Storage.size();
+#endif
+    Top = Bottom;
     FrameStack.reserve(16U);
   }
-  ~StackManager() = default;
+  ~StackManager() noexcept {
+#if WASMEDGE_GUARDED_VALUE_STACK
+    if (!isGuarded()) {
+      return;
+    }
+    auto *Region = reinterpret_cast<uint8_t *>(Bottom);
+    if (Cache.Region == nullptr) {
+      Cache.Region = Region;
+    } else {
+      Allocator::release_guarded_chunk(Region, kValueStackBytes);
+    }
+#endif
+  }
+  StackManager(const StackManager &) = delete;
+  StackManager &operator=(const StackManager &) = delete;
+
+#if WASMEDGE_GUARDED_VALUE_STACK
+  /// Check if the value stack is in the guarded region, which never moves.
+  /// False if the stack falls back to the growable one.
+  bool isGuarded() const noexcept { return Limit == nullptr; }
+
+  /// Getter of the guard region after the value stack. The pushing into the
+  /// full stack accesses this region and raises the fault. Nullptr if the
+  /// stack is not guarded.
+  const void *getGuardBegin() const noexcept {
+    if (!isGuarded()) {
+      return nullptr;
+    }
+    return reinterpret_cast<const uint8_t *>(Bottom) + kValueStackBytes;
+  }
+  const void *getGuardEnd() const noexcept {
+    if (!isGuarded()) {
+      return nullptr;
+    }
+    return reinterpret_cast<const uint8_t *>(Bottom) + kValueStackBytes +
+           Allocator::kGuardSize;
+  }
+#endif
+
+  /// Check if the frame stack is full. The frames are not in the guarded
+  /// region, and the calls pushing no values, such as the recursion of
+  /// `(func call 0)`, are bounded only by this check.
+  bool isFrameFull() const noexcept {
+    return FrameStack.size() >= kMaxFrameNum;
+  }
 
   /// Getter of stack size.
-  size_t size() const noexcept { return ValueStack.size(); }
+  size_t size() const noexcept { return static_cast<size_t>(Top - Bottom); }
 
   /// Unsafe Getter of top entry of stack.
-  Value &getTop() { return ValueStack.back(); }
+  Value &getTop() { return *(Top - 1); }
 
   /// Unsafe Getter of top N-th value entry of stack.
   Value &getTopN(uint32_t Offset) noexcept {
-    assuming(0 < Offset && Offset <= ValueStack.size());
-    return ValueStack[ValueStack.size() - Offset];
+    assuming(0 < Offset && Offset <= size());
+    return *(Top - Offset);
   }
 
   /// Unsafe Getter of top N value entries of stack.
-  Span<Value> getTopSpan(uint32_t N) {
-    return Span<Value>(ValueStack.end() - N, N);
-  }
+  Span<Value> getTopSpan(uint32_t N) { return Span<Value>(Top - N, N); }
 
   /// Push a new value entry to stack.
   template <typename T> void push(T &&Val) {
-    ValueStack.push_back(std::forward<T>(Val));
+    // The limit of the guarded stack is nullptr and never reached, and the
+    // pushing into the full stack raises the fault instead.
+    if (unlikely(Top == Limit)) {
+      // The value may reference to the stack entry invalidated by growing.
+      growAndPush(Value(std::forward<T>(Val)));
+      return;
+    }
+    new (Top++) Value(std::forward<T>(Val));
   }
 
-  /// Unsafe Pop and return the top entry.
-  Value pop() {
-    Value V = std::move(ValueStack.back());
-    ValueStack.pop_back();
-    return V;
+  /// Push N value entries to stack and return them to be written in place.
+  Span<Value> pushTopSpan(uint32_t N) {
+    if (unlikely(Limit != nullptr)) {
+      while (static_cast<size_t>(Limit - Top) < N) {
+        grow();
+      }
+    }
+    Value *First = Top;
+    for (uint32_t I = 0; I < N; ++I) {
+      new (Top++) Value();
+    }
+    return Span<Value>(First, N);
   }
 
+  /// Unsafe Pop and return the top entry.
+  Value pop() { return *--Top; }
+
   /// Push a new frame entry to stack.
   void pushFrame(const Instance::ModuleInstance *Module,
                  AST::InstrView::iterator From, uint32_t LocalNum = 0,
-                 uint32_t Arity = 0, bool IsTailCall = false) noexcept {
+                 uint32_t Arity = 0, bool IsTailCall = false,
+                 Instance::FunctionInstance::TierUp *Tier = nullptr,
+                 Instance::FunctionInstance::Profile *Prof = nullptr) noexcept {
     if (likely(!IsTailCall)) {
-      FrameStack.emplace_back(Module, From, LocalNum, Arity, ValueStack.size());
+      FrameStack.emplace_back(Module, From, LocalNum, Arity,
+                              static_cast<uint32_t>(size()), Tier, Prof);
     } else {
       assuming(!FrameStack.empty());
       assuming(FrameStack.back().VPos >= FrameStack.back().Locals);
       assuming(FrameStack.back().VPos - FrameStack.back().Locals <=
-               ValueStack.size() - LocalNum);
-      ValueStack.erase(ValueStack.begin() + FrameStack.back().VPos -
-                           FrameStack.back().Locals,
-                       ValueStack.end() - LocalNum);
+               size() - LocalNum);
+      erase(Bottom + FrameStack.back().VPos - FrameStack.back().Locals,
+            Top - LocalNum);
       FrameStack.back().Module = Module;
       FrameStack.back().Locals = LocalNum;
       FrameStack.back().Arity = Arity;
-      FrameStack.back().VPos = static_cast<uint32_t>(ValueStack.size());
+      FrameStack.back().VPos = static_cast<uint32_t>(size());
+      FrameStack.back().Tier = Tier;
+      FrameStack.back().Prof = Prof;
     }
   }
 
@@ -101,10 +198,9 @@ public:
     assuming(!FrameStack.empty());
     assuming(FrameStack.back().VPos >= FrameStack.back().Locals);
     assuming(FrameStack.back().VPos - FrameStack.back().Locals <=
-             ValueStack.size() - FrameStack.back().Arity);
-    ValueStack.erase(ValueStack.begin() + FrameStack.back().VPos -
-                         FrameStack.back().Locals,
-                     ValueStack.end() - FrameStack.back().Arity);
+             size() - FrameStack.back().Arity);
+    erase(Bottom + FrameStack.back().VPos - FrameStack.back().Locals,
+          Top - FrameStack.back().Arity);
     auto From = FrameStack.back().From;
     FrameStack.pop_back();
     return From;
@@ -112,9 +208,8 @@ public:
 
   /// Unsafe erase stack.
   void stackErase(uint32_t EraseBegin, uint32_t EraseEnd) noexcept {
-    assuming(EraseEnd <= EraseBegin && EraseBegin <= ValueStack.size());
-    ValueStack.erase(ValueStack.end() - EraseBegin,
-                     ValueStack.end() - EraseEnd);
+    assuming(EraseEnd <= EraseBegin && EraseBegin <= size());
+    erase(Top - EraseBegin, Top - EraseEnd);
   }
 
   /// Unsafe leave top label.
@@ -132,16 +227,72 @@ public:
     return FrameStack.back().Module;
   }
 
+  /// Unsafe getter of the tier-up state of the top frame.
+  Instance::FunctionInstance::TierUp *getTierUp() const noexcept {
+    assuming(!FrameStack.empty());
+    return FrameStack.back().Tier;
+  }
+
+  /// Unsafe getter of the branch profile of the top frame.
+  Instance::FunctionInstance::Profile *getProfile() const noexcept {
+    assuming(!FrameStack.empty());
+    return FrameStack.back().Prof;
+  }
+
   /// Reset stack.
   void reset() noexcept {
-    ValueStack.clear();
+    Top = Bottom;
     FrameStack.clear();
   }
 
 private:
+  /// Erase the values in [First, Last) and move down the values above them.
+  void erase(Value *First, Value *Last) noexcept {
+    Top = std::copy(Last, Top, First);
+  }
+
+#if WASMEDGE_GUARDED_VALUE_STACK
+  /// Size of the value stack region, which is committed lazily by the
+  /// operating system when touched.
+  static inline constexpr const uint64_t kValueStackBytes =
+      UINT64_C(64) * 1024 * 1024;
+  /// Value stack region released by the last stack manager on this thread.
+  /// The thread local storage is zero-initialized.
+  struct RegionCache {
+    ~RegionCache() noexcept {
+      Allocator::release_guarded_chunk(Region, kValueStackBytes);
+    }
+    uint8_t *Region;
+  };
+  static inline thread_local RegionCache Cache;
+#endif
+
+  /// Maximum number of frames. The value stack of the recursion pushing values
+  /// is exhausted earlier.
+  static inline constexpr const size_t kMaxFrameNum = 1U << 20;
+
+  /// Grow the full value stack and push the value. Kept out of the inlined
+  /// pushing in the interpreter loop.
+  [[gnu::noinline]] void growAndPush(Value V) {
+    grow();
+    new (Top++) Value(V);
+  }
+
+  /// Grow the value stack. The pointers into the stack are invalidated.
+  void grow() {
+    const size_t Size = size();
+    Storage.resize(Storage.size() * 2);
+    Bottom = Storage.data();
+    Top = Bottom + Size;
+    Limit = Bottom + Storage.size();
+  }
+
   /// \name Data of stack manager.
   /// @{
-  std::vector<Value> ValueStack;
+  Value *Bottom;
+  Value *Top;
+  Value *Limit;
+  std::vector<Value> Storage;
   std::vector<Frame> FrameStack;
   /// @}
 };
@@ -27,8 +27,35 @@ public:
 
   static void release(uint8_t *Pointer, uint32_t PageCount) noexcept;
 
+  /// \name Pool of the reserved regions of the linear memories.
+  /// The released regions are decommitted and kept in the pool for the next
+  /// allocations instead of being unmapped, up to the pool limit.
+  /// @{
+  /// Set the maximum count of the pooled regions. Zero disables the pool.
+  static void setPoolLimit(uint32_t Limit) noexcept;
+  static uint32_t getPoolLimit() noexcept;
+  /// Reserve regions into the pool in advance, up to the pool limit.
+  static void reservePool(uint32_t Count) noexcept;
+  /// Count of the regions in the pool.
+  static uint32_t getPoolSize() noexcept;
+  /// Count of the allocations which reuse or miss the pooled regions.
+  static uint64_t getPoolHitCount() noexcept;
+  static uint64_t getPoolMissCount() noexcept;
+  /// @}
+
+  /// Return true if the address is in the reserved region of a linear memory,
+  /// including its guard regions. Safe to call in the signal handlers.
+  static bool isReserved(const void *Address) noexcept;
+
   static uint8_t *allocate_chunk(uint64_t Size) noexcept;
   static void release_chunk(uint8_t *Pointer, uint64_t Size) noexcept;
+  /// Size of the inaccessible guard region after the guarded chunk.
+  static inline constexpr const uint64_t kGuardSize = UINT64_C(65536);
+
+  /// Allocate a readable and writable chunk followed by an inaccessible guard
+  /// region. The pages are committed lazily by the operating system.
+  static uint8_t *allocate_guarded_chunk(uint64_t Size) noexcept;
+  static void release_guarded_chunk(uint8_t *Pointer, uint64_t Size) noexcept;
   static bool set_chunk_executable(uint8_t *Pointer, uint64_t Size) noexcept;
   static bool set_chunk_readable(uint8_t *Pointer, uint64_t Size) noexcept;
   static bool set_chunk_readable_writable(uint8_t *Pointer,
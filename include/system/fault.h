@@ -24,14 +24,57 @@ class Fault {
 public:
   Fault();
 
+  /// Construct with the guard region of the value stack. The access violations
+  /// inside the region are reported as the call stack exhaustion.
+  Fault(const void *GuardBegin, const void *GuardEnd);
+
   ~Fault() noexcept;
 
+  /// Install the handlers of the faults once for the process. The handlers
+  /// installed later should forward the faults they do not handle to the
+  /// previous ones, or the faults of the WebAssembly execution are not
+  /// reported as the traps.
+  static void install() noexcept;
+
   [[noreturn]] static void emitFault(ErrCode Error);
 
+  /// Return true if the access violation at the address is raised by the
+  /// WebAssembly execution, which hits the guard region of the value stack or
+  /// the reserved region of a linear memory while running the guarded code.
+  /// The other faults, such as the ones in the host functions and the plugins,
+  /// are not handled.
+  static bool isAccessViolation(const void *Address) noexcept;
+
+  /// Set whether this thread is running the WebAssembly code guarded by the
+  /// handler, which is cleared when calling the host functions. Return the
+  /// previous state.
+  static bool exchangeGuarded(bool Guarded) noexcept;
+
+  [[noreturn]] static void emitAccessViolation(const void *Address);
+
   std::jmp_buf &buffer() noexcept { return Buffer; }
 
+  /// Getter of the address of the last access violation.
+  const void *address() const noexcept { return Address; }
+
+  /// Getter of the program counter of the running loop when the last access
+  /// violation was raised.
+  const void *programCounter() const noexcept { return ProgramCounter; }
+
+  /// Set the slot of the program counter of the running interpreter loop on
+  /// this thread, which is read when raising the access violation before the
+  /// stack frame of the loop is left. Return the previous slot.
+  static const void *const *
+  exchangeProgramCounter(const void *const *Slot) noexcept;
+
 private:
+  static bool isStackGuard(const void *Address) noexcept;
+
   Fault *Prev = nullptr;
+  const void *GuardBegin = nullptr;
+  const void *GuardEnd = nullptr;
+  const void *Address = nullptr;
+  const void *ProgramCounter = nullptr;
   std::jmp_buf Buffer;
 };
 
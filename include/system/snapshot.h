@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/system/snapshot.h - Memory snapshot ----------------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the immutable snapshot of the linear memory contents,
+/// which is restored copy-on-write into the linear memories if the operating
+/// system supports it.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstdint>
+
+namespace WasmEdge {
+
+class MemorySnapshot {
+public:
+  /// Take the snapshot of the Pointer[0 : Size - 1].
+  MemorySnapshot(const uint8_t *Pointer, uint64_t Size) noexcept;
+  ~MemorySnapshot() noexcept;
+  MemorySnapshot(const MemorySnapshot &) = delete;
+  MemorySnapshot &operator=(const MemorySnapshot &) = delete;
+
+  /// Getter of the snapshot size in bytes.
+  uint64_t size() const noexcept { return Size; }
+
+  /// Restore the snapshot into the linear memory allocated by the allocator.
+  /// The pages are mapped privately from the snapshot and copied on the first
+  /// writing if supported, otherwise the contents are copied.
+  bool restore(uint8_t *Pointer) const noexcept;
+
+  /// Return true if the snapshot is restored copy-on-write.
+  static bool supported() noexcept;
+
+private:
+  uint64_t Size;
+  void *Handle;
+};
+
+} // namespace WasmEdge
@@ -17,6 +17,8 @@
 #include "ast/instruction.h"
 #include "ast/module.h"
 #include "common/errcode.h"
+#include "common/errinfo.h"
+#include "common/log.h"
 #include "common/span.h"
 
 #include <cstddef>
@@ -57,6 +59,11 @@ public:
   Expect<void> validate(AST::InstrView Instrs, Span<const ValType> RetVals);
   Expect<void> validate(AST::InstrView Instrs, Span<const VType> RetVals);
 
+  /// Setter and getter of the quiet mode, which suppresses the error logs for
+  /// the workers of the parallel validation.
+  void setQuiet(bool Quiet = true) noexcept { IsQuiet = Quiet; }
+  bool isQuiet() const noexcept { return IsQuiet; }
+
   /// Adder of contexts
   void addType(const AST::FunctionType &Func);
   void addFunc(const uint32_t TypeIdx, const bool IsImport = false);
@@ -69,7 +76,7 @@ public:
   void addLocal(const ValType &V);
   void addLocal(const VType &V);
 
-  std::vector<VType> result() { return ValStack; }
+  Span<const VType> result() const noexcept { return ValStack; }
   auto &getTypes() { return Types; }
   auto &getFunctions() { return Funcs; }
   auto &getTables() { return Tables; }
@@ -84,22 +91,17 @@ public:
   VType ASTToVType(const RefType &V);
   ValType VTypeToAST(const VType &V);
 
+  /// Control frame. The block types are referenced from the function types,
+  /// the return types, or the single value types, which outlive the frames.
   struct CtrlFrame {
     CtrlFrame() = default;
-    CtrlFrame(struct CtrlFrame &&F)
-        : StartTypes(std::move(F.StartTypes)), EndTypes(std::move(F.EndTypes)),
-          Jump(F.Jump), Height(F.Height), IsUnreachable(F.IsUnreachable),
-          Code(F.Code) {}
-    CtrlFrame(const struct CtrlFrame &F)
-        : StartTypes(F.StartTypes), EndTypes(F.EndTypes), Jump(F.Jump),
-          Height(F.Height), IsUnreachable(F.IsUnreachable), Code(F.Code) {}
     CtrlFrame(Span<const VType> In, Span<const VType> Out,
               const AST::Instruction *J, size_t H,
               OpCode Op = OpCode::Unreachable)
-        : StartTypes(In.begin(), In.end()), EndTypes(Out.begin(), Out.end()),
-          Jump(J), Height(H), IsUnreachable(false), Code(Op) {}
-    std::vector<VType> StartTypes;
-    std::vector<VType> EndTypes;
+        : StartTypes(In), EndTypes(Out), Jump(J), Height(H),
+          IsUnreachable(false), Code(Op) {}
+    Span<const VType> StartTypes;
+    Span<const VType> EndTypes;
     const AST::Instruction *Jump;
     size_t Height;
     bool IsUnreachable;
@@ -107,6 +109,19 @@ public:
   };
 
 private:
+  /// Helper functions for printing error log unless in the quiet mode.
+  template <typename T> void logError(const T &Info) const {
+    if (!IsQuiet) {
+      spdlog::error(Info);
+    }
+  }
+  auto logOutOfRange(ErrCode Code, ErrInfo::IndexCategory Cate, uint32_t Idx,
+                     uint32_t Bound) const {
+    logError(Code);
+    logError(ErrInfo::InfoForbidIndex(Cate, Idx, Bound));
+    return Unexpect(Code);
+  }
+
   /// Checking expression
   Expect<void> checkExpr(AST::InstrView Instrs);
 
@@ -144,9 +159,13 @@ private:
   std::vector<VType> Locals;
   std::vector<VType> Returns;
 
-  /// Running stack.
+  /// Running stack. The stacks and the buffer keep their capacities across
+  /// the functions to avoid allocations.
   std::vector<CtrlFrame> CtrlStack;
   std::vector<VType> ValStack;
+  std::vector<VType> TypeBuf;
+
+  bool IsQuiet = false;
 };
 
 } // namespace Validator
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 namespace WasmEdge {
 namespace Validator {
@@ -74,5 +75,21 @@ private:
   FormChecker Checker;
 };
 
+/// Checker of the function bodies deferred by the lazy loading, which keeps a
+/// copy of the formal checker with the context of the validated module.
+class LazyCodeChecker : public AST::CodeChecker {
+public:
+  LazyCodeChecker(const FormChecker &C) noexcept : Checker(C) {}
+
+  /// Validate the deferred function body. Thread-safe.
+  Expect<void>
+  validate(AST::InstrView Instrs, uint32_t TypeIdx,
+           Span<const std::pair<uint32_t, ValType>> Locals) const override;
+
+private:
+  mutable std::mutex Mutex;
+  mutable FormChecker Checker;
+};
+
 } // namespace Validator
 } // namespace WasmEdge
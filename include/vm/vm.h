@@ -193,6 +193,13 @@ public:
     return unsafeGetActiveModule();
   }
 
+  /// Merge the execution profiles recorded by the profiling into the profile
+  /// file.
+  Expect<void> storeProfile(const std::filesystem::path &Path) const {
+    std::shared_lock Lock(Mutex);
+    return unsafeStoreProfile(Path);
+  }
+
   /// Getter of store set in VM.
   Runtime::StoreManager &getStoreManager() noexcept { return StoreRef; }
   const Runtime::StoreManager &getStoreManager() const noexcept {
@@ -252,6 +259,7 @@ private:
                 Span<const ValType> ParamTypes = {});
 
   void unsafeCleanup();
+  Expect<void> unsafeStoreProfile(const std::filesystem::path &Path) const;
 
   std::vector<std::pair<std::string, const AST::FunctionType &>>
   unsafeGetFunctionList() const;
@@ -271,6 +279,9 @@ private:
                 std::string_view Func, Span<const ValVariant> Params = {},
                 Span<const ValType> ParamTypes = {});
 
+  /// Helper function for compiling the module with the JIT if enabled.
+  Expect<void> unsafeCompileJIT(AST::Module &Module);
+
   /// VM environment.
   const Configure Conf;
   Statistics::Statistics Stat;
@@ -3,10 +3,15 @@
 
 #include "aot/compiler.h"
 
+#include "aot/blake3.h"
+#include "aot/cache.h"
+#include "aot/jit.h"
 #include "aot/version.h"
 #include "common/defines.h"
 #include "common/filesystem.h"
 #include "common/log.h"
+#include "common/parallel.h"
+#include "common/version.h"
 
 #include <algorithm>
 #include <array>
@@ -15,27 +20,38 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <map>
 #include <lld/Common/Driver.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/SubtargetFeature.h>
 #include <llvm/Object/ObjectFile.h>
 #include <llvm/Passes/PassBuilder.h>
+#include <llvm/ProfileData/InstrProf.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/Instrumentation/PGOInstrumentation.h>
 #include <llvm/Transforms/Scalar/TailRecursionElimination.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <type_traits>
 
 #if WASMEDGE_OS_WINDOWS
 #include <llvm/Object/COFF.h>
@@ -597,12 +613,17 @@ public:
     return BB;
   }
 
-  void compile(const AST::CodeSegment &Code,
+  /// Set the execution profile of the function recorded by the interpreter,
+  /// which is indexed by the instructions of the function body.
+  void setProfile(const FunctionProfile *P) noexcept { Profile = P; }
+
+  void compile(AST::InstrView Instrs,
                std::pair<std::vector<ValType>, std::vector<ValType>> Type) {
+    InstrBegin = Instrs.data();
     auto *RetBB = llvm::BasicBlock::Create(LLContext, "ret", F);
     Type.first.clear();
     enterBlock(RetBB, nullptr, nullptr, {}, std::move(Type));
-    compile(Code.getExpr().getInstrs());
+    compile(Instrs);
     assuming(ControlStack.empty());
     compileReturn();
 
@@ -688,7 +709,7 @@ public:
         } else {
           Cond = Builder.CreateICmpNE(stackPop(), Builder.getInt32(0));
         }
-        Builder.CreateCondBr(Cond, Then, Else);
+        Builder.CreateCondBr(Cond, Then, Else, getBranchWeights(Instr));
 
         Builder.SetInsertPoint(Then);
         auto Type = Context.resolveBlockType(Instr.getBlockType());
@@ -764,7 +785,8 @@ public:
         auto *Cond = Builder.CreateICmpNE(stackPop(), Builder.getInt32(0));
         setLableJumpPHI(Label);
         auto *Next = llvm::BasicBlock::Create(LLContext, "br_if.end", F);
-        Builder.CreateCondBr(Cond, getLabel(Label), Next);
+        Builder.CreateCondBr(Cond, getLabel(Label), Next,
+                             getBranchWeights(Instr));
         Builder.SetInsertPoint(Next);
         break;
       }
@@ -777,7 +799,7 @@ public:
         setLableJumpPHI(LabelTable[LabelTableSize].TargetIndex);
         auto *Switch = Builder.CreateSwitch(
             Value, getLabel(LabelTable[LabelTableSize].TargetIndex),
-            LabelTableSize);
+            LabelTableSize, getBranchWeights(Instr));
         for (uint32_t I = 0; I < LabelTableSize; ++I) {
           setLableJumpPHI(LabelTable[I].TargetIndex);
           Switch->addCase(Builder.getInt32(I),
@@ -796,7 +818,8 @@ public:
       case OpCode::Call_indirect:
         updateInstrCount();
         updateGas();
-        compileIndirectCallOp(Instr.getSourceIndex(), Instr.getTargetIndex());
+        compileIndirectCallOp(Instr.getSourceIndex(), Instr.getTargetIndex(),
+                              getCallTargets(Instr));
         break;
       case OpCode::Return_call:
         updateInstrCount();
@@ -810,7 +833,8 @@ public:
         updateInstrCount();
         updateGas();
         compileReturnIndirectCallOp(Instr.getSourceIndex(),
-                                    Instr.getTargetIndex());
+                                    Instr.getTargetIndex(),
+                                    getCallTargets(Instr));
         setUnreachable();
         Builder.SetInsertPoint(
             llvm::BasicBlock::Create(LLContext, "ret_call_indir.end", F));
@@ -3508,8 +3532,9 @@ private:
     }
   }
 
-  void compileIndirectCallOp(const uint32_t TableIndex,
-                             const uint32_t FuncTypeIndex) {
+  void compileIndirectCallOp(
+      const uint32_t TableIndex, const uint32_t FuncTypeIndex,
+      const std::map<uint32_t, uint64_t> *Targets = nullptr) {
     auto *NotNullBB = llvm::BasicBlock::Create(LLContext, "c_i.not_null", F);
     auto *IsNullBB = llvm::BasicBlock::Create(LLContext, "c_i.is_null", F);
     auto *EndBB = llvm::BasicBlock::Create(LLContext, "c_i.end", F);
@@ -3547,6 +3572,7 @@ private:
 
       auto *FPtrRet =
           Builder.CreateCall(llvm::FunctionCallee(FTy, FPtr), ArgsVec);
+      annotateCallTargets(*FPtrRet, Targets);
       if (RetSize == 0) {
         // nothing to do
       } else if (RetSize == 1) {
@@ -3652,8 +3678,9 @@ private:
     }
   }
 
-  void compileReturnIndirectCallOp(const uint32_t TableIndex,
-                                   const uint32_t FuncTypeIndex) {
+  void compileReturnIndirectCallOp(
+      const uint32_t TableIndex, const uint32_t FuncTypeIndex,
+      const std::map<uint32_t, uint64_t> *Targets = nullptr) {
     auto *NotNullBB = llvm::BasicBlock::Create(LLContext, "c_i.not_null", F);
     auto *IsNullBB = llvm::BasicBlock::Create(LLContext, "c_i.is_null", F);
 
@@ -3688,6 +3715,7 @@ private:
 
       auto *FPtrRet =
           Builder.CreateCall(llvm::FunctionCallee(FTy, FPtr), ArgsVec);
+      annotateCallTargets(*FPtrRet, Targets);
       if (RetSize == 0) {
         Builder.CreateRetVoid();
       } else {
@@ -4615,6 +4643,98 @@ private:
     return Value;
   }
 
+  /// Get the branch weights of the `if`, `br_if`, or `br_table` instruction
+  /// in the order of the successors from the profile. Nullptr if not
+  /// profiled.
+  llvm::MDNode *getBranchWeights(const AST::Instruction &Instr) {
+    if (!Profile) {
+      return nullptr;
+    }
+    const auto Iter = Profile->Branches.find(
+        static_cast<uint32_t>(&Instr - InstrBegin));
+    if (Iter == Profile->Branches.end()) {
+      return nullptr;
+    }
+    const auto &Counts = Iter->second;
+    // The profile has the [not taken, taken] counts of the conditions, and the
+    // counts of the labels with the default label last. The branches take the
+    // true successor first, and the switches take the default one first.
+    std::vector<uint64_t> Ordered;
+    if (Instr.getOpCode() == OpCode::Br_table) {
+      if (Counts.size() != Instr.getLabelList().size()) {
+        return nullptr;
+      }
+      Ordered.push_back(Counts.back());
+      Ordered.insert(Ordered.end(), Counts.begin(), Counts.end() - 1);
+    } else {
+      if (Counts.size() != 2) {
+        return nullptr;
+      }
+      Ordered = {Counts[1], Counts[0]};
+    }
+    // Scale the counts into the 32-bit weights.
+    const uint64_t Scale =
+        *std::max_element(Ordered.begin(), Ordered.end()) /
+            std::numeric_limits<uint32_t>::max() +
+        1;
+    std::vector<uint32_t> Weights;
+    Weights.reserve(Ordered.size());
+    for (const auto Count : Ordered) {
+      Weights.push_back(static_cast<uint32_t>(Count / Scale));
+    }
+    return llvm::MDBuilder(LLContext).createBranchWeights(Weights);
+  }
+
+  /// Get the profiled call counts of the targets of the `call_indirect` or
+  /// `return_call_indirect` instruction. Nullptr if not profiled.
+  const std::map<uint32_t, uint64_t> *
+  getCallTargets(const AST::Instruction &Instr) const noexcept {
+    if (!Profile) {
+      return nullptr;
+    }
+    const auto Iter =
+        Profile->Calls.find(static_cast<uint32_t>(&Instr - InstrBegin));
+    if (Iter == Profile->Calls.end()) {
+      return nullptr;
+    }
+    return &Iter->second;
+  }
+
+  /// Attach the value profile of the call targets to the indirect call for
+  /// the indirect call promotion. Only the functions defined in the module
+  /// with the same type can be promoted.
+  void annotateCallTargets(llvm::CallInst &Call,
+                           const std::map<uint32_t, uint64_t> *Targets) {
+    if (!Targets) {
+      return;
+    }
+    std::vector<InstrProfValueData> Values;
+    uint64_t Sum = 0;
+    for (const auto &[FuncIdx, Count] : *Targets) {
+      Sum += Count;
+      if (FuncIdx >= Context.Functions.size()) {
+        continue;
+      }
+      const auto &[TypeIdx, Callee, Code] = Context.Functions[FuncIdx];
+      if (Code == nullptr ||
+          Callee->getFunctionType() != Call.getFunctionType()) {
+        continue;
+      }
+      Values.push_back(
+          {llvm::Function::getGUID(llvm::getPGOFuncName(*Callee)), Count});
+    }
+    if (Values.empty()) {
+      return;
+    }
+    std::sort(Values.begin(), Values.end(),
+              [](const auto &LHS, const auto &RHS) {
+                return LHS.Count > RHS.Count;
+              });
+    llvm::annotateValueSite(*F->getParent(), Call, Values, Sum,
+                            llvm::IPVK_IndirectCallTarget,
+                            static_cast<uint32_t>(Values.size()));
+  }
+
   AOT::Compiler::CompileContext &Context;
   llvm::LLVMContext &LLContext;
   std::vector<std::pair<llvm::Type *, llvm::Value *>> Local;
@@ -4648,6 +4768,8 @@ private:
     Control &operator=(Control &&) = default;
   };
   std::vector<Control> ControlStack;
+  const FunctionProfile *Profile = nullptr;
+  const AST::Instruction *InstrBegin = nullptr;
   llvm::Function *F;
   llvm::LoadInst *ExecCtx;
   llvm::IRBuilder<> Builder;
@@ -4672,12 +4794,12 @@ static llvm::Value *createLikely(llvm::IRBuilder<> &Builder,
 
 // Write output object and link
 Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
-                                 const llvm::SmallString<0> &OSVec) {
+                                 Span<const std::string> Objects) {
   using namespace std::literals;
 
   spdlog::info("output start");
-  std::string ObjectName;
-  {
+  std::vector<std::string> ObjectNames;
+  for (const auto &OSVec : Objects) {
     // tempfile
     std::filesystem::path OPath(OutputPath);
 #if WASMEDGE_OS_WINDOWS
@@ -4690,6 +4812,9 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
       // TODO:return error
       spdlog::error("so file creation failed:{}", OPath.u8string());
       llvm::consumeError(Object.takeError());
+      for (const auto &ObjectName : ObjectNames) {
+        llvm::sys::fs::remove(ObjectName);
+      }
       return WasmEdge::Unexpect(WasmEdge::ErrCode::Value::IllegalPath);
     }
     llvm::raw_fd_ostream OS(Object->FD, false);
@@ -4699,9 +4824,21 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #else
     OS.close();
 #endif
-    ObjectName = Object->TmpName;
+    ObjectNames.push_back(Object->TmpName);
     llvm::consumeError(Object->keep());
   }
+  std::vector<const char *> ObjectArgs;
+  for (const auto &ObjectName : ObjectNames) {
+    ObjectArgs.push_back(ObjectName.c_str());
+  }
+  const auto LinkArgs = [&ObjectArgs](
+                            std::initializer_list<const char *> Front,
+                            std::initializer_list<const char *> Back) {
+    std::vector<const char *> Args(Front);
+    Args.insert(Args.end(), ObjectArgs.begin(), ObjectArgs.end());
+    Args.insert(Args.end(), Back);
+    return Args;
+  };
 
   // link
   bool LinkResult = false;
@@ -4714,38 +4851,37 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #else
   LinkResult = lld::mach_o::link(
 #endif
-      std::initializer_list<const char *> {
-        "lld", "-arch",
+      LinkArgs(
+          {
+            "lld", "-arch",
 #if defined(__x86_64__)
-            "x86_64",
+                "x86_64",
 #elif defined(__aarch64__)
-            "arm64",
+                "arm64",
 #else
 #error Unsupported architectur on the MacOS!
 #endif
 #if LLVM_VERSION_MAJOR >= 14
-            // LLVM 14 replaces the older mach_o lld implementation with the new
-            // one. And it require -arch and -platform_version to always be
-            // specified. Reference: https://reviews.llvm.org/D97799
-            "-platform_version", "macos", "10.0", "11.0",
+                // LLVM 14 replaces the older mach_o lld implementation with the
+                // new one. And it require -arch and -platform_version to always
+                // be specified. Reference: https://reviews.llvm.org/D97799
+                "-platform_version", "macos", "10.0", "11.0",
 #else
-            "-sdk_version", "11.3",
+                "-sdk_version", "11.3",
 #endif
-            "-dylib", "-demangle", "-macosx_version_min", "10.0.0",
-            "-syslibroot",
-            "/Library/Developer/CommandLineTools/SDKs/MacOSX.sdk",
-            ObjectName.c_str(), "-o", OutputPath.u8string().c_str(), "-lSystem"
-      },
+                "-dylib", "-demangle", "-macosx_version_min", "10.0.0",
+                "-syslibroot",
+                "/Library/Developer/CommandLineTools/SDKs/MacOSX.sdk"
+          },
+          {"-o", OutputPath.u8string().c_str(), "-lSystem"}),
 #elif WASMEDGE_OS_LINUX
   LinkResult = lld::elf::link(
-      std::initializer_list<const char *>{"ld.lld", "--shared", "--gc-sections",
-                                          "--discard-all", ObjectName.c_str(),
-                                          "-o", OutputPath.u8string().c_str()},
+      LinkArgs({"ld.lld", "--shared", "--gc-sections", "--discard-all"},
+               {"-o", OutputPath.u8string().c_str()}),
 #elif WASMEDGE_OS_WINDOWS
   LinkResult = lld::coff::link(
-      std::initializer_list<const char *>{
-          "lld-link", "-dll", "-defaultlib:libcmt", "-base:0", "-nologo",
-          ObjectName.c_str(), ("-out:" + OutputPath.u8string()).c_str()},
+      LinkArgs({"lld-link", "-dll", "-defaultlib:libcmt", "-base:0", "-nologo"},
+               {("-out:" + OutputPath.u8string()).c_str()}),
 #endif
 
 #if LLVM_VERSION_MAJOR >= 14
@@ -4762,7 +4898,9 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #endif
 
   if (LinkResult) {
-    llvm::sys::fs::remove(ObjectName);
+    for (const auto &ObjectName : ObjectNames) {
+      llvm::sys::fs::remove(ObjectName);
+    }
 #if WASMEDGE_OS_WINDOWS
     std::filesystem::path LibPath(OutputPath);
     LibPath.replace_extension(".lib"sv);
@@ -4799,7 +4937,7 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 
 Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
                                Span<const Byte> Data,
-                               const llvm::SmallString<0> &OSVec) {
+                               Span<const std::string> Objects) {
   using namespace std::literals;
 
   std::string SharedObjectName;
@@ -4815,7 +4953,6 @@ Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
       return WasmEdge::Unexpect(WasmEdge::ErrCode::Value::IllegalPath);
     }
     llvm::raw_fd_ostream OS(Object->FD, false);
-    OS.write(OSVec.data(), OSVec.size());
 #if WASMEDGE_OS_WINDOWS
     OS.flush();
 #else
@@ -4825,8 +4962,8 @@ Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
     llvm::consumeError(Object->keep());
   }
 
-  if (auto Res =
-          outputNativeLibrary(std::filesystem::u8path(SharedObjectName), OSVec);
+  if (auto Res = outputNativeLibrary(std::filesystem::u8path(SharedObjectName),
+                                     Objects);
       unlikely(!Res)) {
     return Unexpect(Res);
   }
@@ -5010,6 +5147,512 @@ Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
 namespace WasmEdge {
 namespace AOT {
 
+namespace {
+/// Instruction count bounds of the cached fragments, and the mask of the
+/// function hash to end a fragment between the bounds.
+static inline constexpr const uint64_t kFragmentMinInstrs = 1 << 13;
+static inline constexpr const uint64_t kFragmentMaxInstrs = 1 << 16;
+static inline constexpr const uint8_t kFragmentMask = 0x7;
+
+using Hash = std::array<Byte, 32>;
+
+/// Get the instructions of the code segment.
+AST::InstrView getInstrs(Span<const AST::CodeSegment> CodeSegs,
+                         Span<const AST::InstrVec> LazyBodies, size_t I) {
+  if (CodeSegs[I].isLazy()) {
+    return LazyBodies[I];
+  }
+  return CodeSegs[I].getExpr().getInstrs();
+}
+
+/// Split the code segments into the contiguous ranges of the similar
+/// instruction counts. Return the boundaries of the ranges.
+std::vector<size_t>
+partitionCodeSegments(Span<const AST::CodeSegment> CodeSegs,
+                      Span<const AST::InstrVec> LazyBodies, uint32_t Count) {
+  const auto InstrCount = [&](size_t I) -> uint64_t {
+    return getInstrs(CodeSegs, LazyBodies, I).size();
+  };
+  uint64_t Total = 0;
+  for (size_t I = 0; I < CodeSegs.size(); ++I) {
+    Total += InstrCount(I);
+  }
+  std::vector<size_t> Bounds = {0};
+  uint64_t Acc = 0;
+  for (size_t I = 0; I < CodeSegs.size() && Bounds.size() < Count; ++I) {
+    Acc += InstrCount(I);
+    if (Acc * Count >= Total * Bounds.size()) {
+      Bounds.push_back(I + 1);
+    }
+  }
+  Bounds.resize(Count + 1, CodeSegs.size());
+  return Bounds;
+}
+
+/// Decode and validate the function bodies deferred by the lazy loading.
+Expect<std::vector<AST::InstrVec>>
+decodeLazyBodies(const AST::Module &Module) {
+  std::vector<AST::InstrVec> LazyBodies;
+  if (const auto &Decoder = Module.getCodeDecoder()) {
+    const auto &TypeIdxs = Module.getFunctionSection().getContent();
+    const auto &CodeSegs = Module.getCodeSection().getContent();
+    LazyBodies.resize(CodeSegs.size());
+    for (size_t I = 0; I < CodeSegs.size(); ++I) {
+      if (!CodeSegs[I].isLazy()) {
+        continue;
+      }
+      auto Res = Decoder->decode(CodeSegs[I].getBody(),
+                                 CodeSegs[I].getBodyOffset());
+      if (unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+      if (auto Check = Module.getCodeChecker()->validate(
+              *Res, TypeIdxs[I], CodeSegs[I].getLocals());
+          unlikely(!Check)) {
+        return Unexpect(Check);
+      }
+      LazyBodies[I] = std::move(*Res);
+    }
+  }
+  return LazyBodies;
+}
+
+/// Split the code segments into the fragments of the cached objects. The
+/// boundaries are decided by the function hashes after the minimum instruction
+/// count, so that an edit of a function only changes the fragments around it
+/// instead of shifting all the later boundaries. Return the boundaries.
+std::vector<size_t>
+fragmentCodeSegments(Span<const AST::CodeSegment> CodeSegs,
+                     Span<const AST::InstrVec> LazyBodies,
+                     Span<const Hash> FuncHashes) {
+  std::vector<size_t> Bounds = {0};
+  uint64_t Acc = 0;
+  for (size_t I = 0; I < CodeSegs.size(); ++I) {
+    Acc += getInstrs(CodeSegs, LazyBodies, I).size();
+    const bool IsCut = (FuncHashes[I][0] & kFragmentMask) == 0;
+    if (Acc >= kFragmentMaxInstrs || (Acc >= kFragmentMinInstrs && IsCut)) {
+      Bounds.push_back(I + 1);
+      Acc = 0;
+    }
+  }
+  if (Bounds.back() != CodeSegs.size()) {
+    Bounds.push_back(CodeSegs.size());
+  }
+  return Bounds;
+}
+
+template <typename T> void hashValue(Blake3 &Hasher, const T &Value) noexcept {
+  static_assert(std::is_trivially_copyable_v<T>);
+  Hasher.update({reinterpret_cast<const Byte *>(&Value), sizeof(Value)});
+}
+
+void hashValTypes(Blake3 &Hasher, Span<const ValType> Types) noexcept {
+  hashValue(Hasher, static_cast<uint32_t>(Types.size()));
+  for (const auto Type : Types) {
+    hashValue(Hasher, Type);
+  }
+}
+
+/// Hash the environment shared by all the fragments, which is the compiler,
+/// the target, the options, and the type section of the module.
+Hash hashContext(const Configure &Conf, const AST::Module &Module) {
+  Blake3 Hasher;
+  Hasher.update({reinterpret_cast<const Byte *>(kVersionString.data()),
+                 kVersionString.size()});
+  hashValue(Hasher, kBinaryVersion);
+  const std::string_view LLVMVersion = LLVM_VERSION_STRING;
+  Hasher.update({reinterpret_cast<const Byte *>(LLVMVersion.data()),
+                 LLVMVersion.size()});
+
+  std::string Target = llvm::sys::getProcessTriple();
+  const auto &CompilerConf = Conf.getCompilerConfigure();
+  if (!CompilerConf.isGenericBinary()) {
+    // The features are sorted for the stable hash of the same host.
+    Target += ' ';
+    Target += llvm::sys::getHostCPUName();
+    llvm::StringMap<bool> FeatureMap;
+    std::vector<std::string> Features;
+    if (llvm::sys::getHostCPUFeatures(FeatureMap)) {
+      for (const auto &Feature : FeatureMap) {
+        Features.push_back((Feature.second ? "+" : "-") +
+                           Feature.first().str());
+      }
+    }
+    std::sort(Features.begin(), Features.end());
+    for (const auto &Feature : Features) {
+      Target += ' ';
+      Target += Feature;
+    }
+  }
+  Hasher.update(
+      {reinterpret_cast<const Byte *>(Target.data()), Target.size()});
+
+  hashValue(Hasher, CompilerConf.getOptimizationLevel());
+  hashValue(Hasher, CompilerConf.isGenericBinary());
+  hashValue(Hasher, CompilerConf.isInterruptible());
+  hashValue(Hasher, Conf.getStatisticsConfigure().isInstructionCounting());
+  hashValue(Hasher, Conf.getStatisticsConfigure().isCostMeasuring());
+  uint64_t Proposals = 0;
+  for (uint8_t I = 0; I < static_cast<uint8_t>(Proposal::Max); ++I) {
+    if (Conf.hasProposal(static_cast<Proposal>(I))) {
+      Proposals |= UINT64_C(1) << I;
+    }
+  }
+  hashValue(Hasher, Proposals);
+
+  const auto &Types = Module.getTypeSection().getContent();
+  hashValue(Hasher, static_cast<uint32_t>(Types.size()));
+  for (const auto &Type : Types) {
+    hashValTypes(Hasher, Type.getParamTypes());
+    hashValTypes(Hasher, Type.getReturnTypes());
+  }
+
+  Hash Result;
+  Hasher.finalize(Result);
+  return Result;
+}
+
+/// Hash the functions of the code segments. A function is hashed with its
+/// index, its type index, its locals and body, the type indices of the direct
+/// callees and whether they are imported, the types of the used globals, and
+/// its profile. Return nothing if the body of any function is not found in the
+/// binary.
+std::optional<std::vector<Hash>>
+hashFunctions(Span<const Byte> Data, const AST::Module &Module,
+              Span<const AST::InstrVec> LazyBodies,
+              const ModuleProfile *Profile) {
+  std::vector<uint32_t> FuncTypeIdxs;
+  std::vector<ValType> GlobalTypes;
+  for (const auto &ImpDesc : Module.getImportSection().getContent()) {
+    switch (ImpDesc.getExternalType()) {
+    case ExternalType::Function:
+      FuncTypeIdxs.push_back(ImpDesc.getExternalFuncTypeIdx());
+      break;
+    case ExternalType::Global:
+      GlobalTypes.push_back(ImpDesc.getExternalGlobalType().getValType());
+      break;
+    default:
+      break;
+    }
+  }
+  const auto FuncBase = static_cast<uint32_t>(FuncTypeIdxs.size());
+  const auto &TypeIdxs = Module.getFunctionSection().getContent();
+  FuncTypeIdxs.insert(FuncTypeIdxs.end(), TypeIdxs.begin(), TypeIdxs.end());
+  for (const auto &GlobalSeg : Module.getGlobalSection().getContent()) {
+    GlobalTypes.push_back(GlobalSeg.getGlobalType().getValType());
+  }
+
+  const auto &CodeSegs = Module.getCodeSection().getContent();
+  std::vector<Hash> Hashes(CodeSegs.size());
+  for (size_t I = 0; I < CodeSegs.size(); ++I) {
+    const auto FuncIdx = FuncBase + static_cast<uint32_t>(I);
+    const auto Instrs = getInstrs(CodeSegs, LazyBodies, I);
+    // The body is hashed from the binary by the offsets of the instructions.
+    if (Instrs.empty() || Instrs.back().getOpCode() != OpCode::End ||
+        Instrs.front().getOffset() > Instrs.back().getOffset() ||
+        Instrs.back().getOffset() >= Data.size() ||
+        Data[Instrs.back().getOffset()] != 0x0B) {
+      return std::nullopt;
+    }
+
+    Blake3 Hasher;
+    hashValue(Hasher, FuncIdx);
+    hashValue(Hasher, FuncTypeIdxs[FuncIdx]);
+    hashValue(Hasher, static_cast<uint32_t>(CodeSegs[I].getLocals().size()));
+    for (const auto &[Count, Type] : CodeSegs[I].getLocals()) {
+      hashValue(Hasher, Count);
+      hashValue(Hasher, Type);
+    }
+    Hasher.update(Data.subspan(Instrs.front().getOffset(),
+                               Instrs.back().getOffset() -
+                                   Instrs.front().getOffset() + 1));
+    for (const auto &Instr : Instrs) {
+      switch (Instr.getOpCode()) {
+      case OpCode::Call:
+      case OpCode::Return_call:
+      case OpCode::Ref__func:
+        // The imported functions are called through the thunks instead of
+        // the symbols of the other fragments.
+        hashValue(Hasher, FuncTypeIdxs[Instr.getTargetIndex()]);
+        hashValue(Hasher, Instr.getTargetIndex() < FuncBase);
+        break;
+      case OpCode::Global__get:
+      case OpCode::Global__set:
+        hashValue(Hasher, GlobalTypes[Instr.getTargetIndex()]);
+        break;
+      default:
+        break;
+      }
+    }
+    if (Profile) {
+      if (auto It = Profile->find(FuncIdx); It != Profile->end()) {
+        for (const auto &[Idx, Counts] : It->second.Branches) {
+          hashValue(Hasher, Idx);
+          for (const auto Count : Counts) {
+            hashValue(Hasher, Count);
+          }
+        }
+        for (const auto &[Idx, Targets] : It->second.Calls) {
+          hashValue(Hasher, Idx);
+          for (const auto &[Target, Count] : Targets) {
+            hashValue(Hasher, Target);
+            hashValue(Hasher, Target < FuncTypeIdxs.size()
+                                  ? FuncTypeIdxs[Target]
+                                  : UINT32_C(0));
+            hashValue(Hasher, Count);
+          }
+        }
+      }
+    }
+    Hasher.finalize(Hashes[I]);
+  }
+  return Hashes;
+}
+
+/// Read the cached object. Return false if not cached.
+bool loadObject(const std::filesystem::path &Path, std::string &Object) {
+  auto Buffer = llvm::MemoryBuffer::getFile(Path.u8string(), false, false);
+  if (!Buffer) {
+    return false;
+  }
+  Object.assign((*Buffer)->getBufferStart(), (*Buffer)->getBufferSize());
+  return true;
+}
+
+/// Write the object into the cache. The object is renamed from a temporary
+/// file, so that the concurrent compilations never read a partial object.
+void storeObject(const std::filesystem::path &Path, std::string_view Object) {
+  using namespace std::literals;
+
+  std::error_code EC;
+  std::filesystem::create_directories(Path.parent_path(), EC);
+  std::filesystem::path TmpPath(Path);
+  TmpPath.replace_extension("%%%%%%%%%%.tmp"sv);
+  auto File = llvm::sys::fs::TempFile::create(TmpPath.u8string());
+  if (!File) {
+    spdlog::warn("object cache creation failed:{}", TmpPath.u8string());
+    llvm::consumeError(File.takeError());
+    return;
+  }
+  {
+    llvm::raw_fd_ostream OS(File->FD, false);
+    OS.write(Object.data(), Object.size());
+  }
+  if (auto Err = File->keep(Path.u8string())) {
+    spdlog::warn("object cache creation failed:{}", Path.u8string());
+    llvm::consumeError(std::move(Err));
+    llvm::consumeError(File->discard());
+  }
+}
+
+/// Set the compile context of the compiler in the scope.
+struct RAIICleanup {
+  RAIICleanup(Compiler::CompileContext *&Context,
+              Compiler::CompileContext &NewContext)
+      : Context(Context) {
+    Context = &NewContext;
+  }
+  ~RAIICleanup() { Context = nullptr; }
+  Compiler::CompileContext *&Context;
+};
+
+/// Run the optimization pipeline of the configured level on the module.
+void optimizeModule(llvm::Module &LLModule, llvm::TargetMachine &TM,
+                    llvm::TargetLibraryInfoImpl &TLII,
+                    const CompilerConfigure &Conf, bool IsProfiled = false) {
+#if LLVM_VERSION_MAJOR == 12
+  llvm::PassBuilder PB(false, &TM);
+#else
+  llvm::PassBuilder PB(&TM);
+#endif
+
+  llvm::LoopAnalysisManager LAM;
+  llvm::FunctionAnalysisManager FAM;
+  llvm::CGSCCAnalysisManager CGAM;
+  llvm::ModuleAnalysisManager MAM;
+
+  // Register the AA manager first so that our version is the one
+  // used.
+  FAM.registerPass([&] { return PB.buildDefaultAAPipeline(); });
+
+  // Register the target library analysis directly and give it a
+  // customized preset TLI.
+  FAM.registerPass([&] { return llvm::TargetLibraryAnalysis(TLII); });
+#if LLVM_VERSION_MAJOR <= 9
+  MAM.registerPass([&] { return llvm::TargetLibraryAnalysis(TLII); });
+#endif
+
+  // Register all the basic analyses with the managers.
+  PB.registerModuleAnalyses(MAM);
+  PB.registerCGSCCAnalyses(CGAM);
+  PB.registerFunctionAnalyses(FAM);
+  PB.registerLoopAnalyses(LAM);
+  PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+  llvm::ModulePassManager MPM;
+  if (Conf.getOptimizationLevel() == CompilerConfigure::OptimizationLevel::O0) {
+    MPM.addPass(
+        llvm::createModuleToFunctionPassAdaptor(llvm::TailCallElimPass()));
+    MPM.addPass(llvm::AlwaysInlinerPass(false));
+  } else {
+    // Promote the profiled targets of the indirect calls into the direct
+    // calls, which are inlined by the default pipeline.
+    if (IsProfiled) {
+      MPM.addPass(llvm::PGOIndirectCallPromotion());
+    }
+    MPM.addPass(PB.buildPerModuleDefaultPipeline(
+        toLLVMLevel(Conf.getOptimizationLevel())));
+  }
+
+  MPM.run(LLModule, MAM);
+}
+
+/// Create the function which calls the function of the index through the
+/// intrinsics table, for the imported functions and the functions not
+/// compiled together.
+llvm::Function *createCallThunk(Compiler::CompileContext &Context,
+                                uint32_t FuncID, uint32_t TypeIdx) {
+  const auto &FuncType = *Context.FunctionTypes[TypeIdx];
+
+  auto *FTy = toLLVMType(Context.ExecCtxPtrTy, FuncType);
+  auto *RTy = FTy->getReturnType();
+  auto *F = llvm::Function::Create(FTy, llvm::Function::PrivateLinkage,
+                                   "f" + std::to_string(FuncID),
+                                   Context.LLModule);
+  F->addFnAttr(llvm::Attribute::StrictFP);
+  F->addParamAttr(0, llvm::Attribute::AttrKind::ReadOnly);
+  F->addParamAttr(0, llvm::Attribute::AttrKind::NoAlias);
+
+  auto *Entry = llvm::BasicBlock::Create(Context.LLContext, "entry", F);
+  llvm::IRBuilder<> Builder(Entry);
+  setIsFPConstrained(Builder);
+
+  const auto ArgSize = FuncType.getParamTypes().size();
+  const auto RetSize = RTy->isVoidTy() ? 0 : FuncType.getReturnTypes().size();
+
+  llvm::Value *Args;
+  if (ArgSize == 0) {
+    Args = llvm::ConstantPointerNull::get(Context.Int8PtrTy);
+  } else {
+    auto *Alloca = Builder.CreateAlloca(
+        Context.Int8Ty, Builder.getInt64(ArgSize * kValSize));
+    Alloca->setAlignment(Align(kValSize));
+    Args = Alloca;
+  }
+
+  llvm::Value *Rets;
+  if (RetSize == 0) {
+    Rets = llvm::ConstantPointerNull::get(Context.Int8PtrTy);
+  } else {
+    auto *Alloca = Builder.CreateAlloca(
+        Context.Int8Ty, Builder.getInt64(RetSize * kValSize));
+    Alloca->setAlignment(Align(kValSize));
+    Rets = Alloca;
+  }
+
+  for (unsigned I = 0; I < ArgSize; ++I) {
+    llvm::Argument *Arg = F->arg_begin() + 1 + I;
+    llvm::Value *Ptr = Builder.CreateConstInBoundsGEP1_64(
+        Context.Int8Ty, Args, I * kValSize);
+    Builder.CreateStore(
+        Arg, Builder.CreateBitCast(Ptr, Arg->getType()->getPointerTo()));
+  }
+
+  Builder.CreateCall(
+      Context.getIntrinsic(
+          Builder, AST::Module::Intrinsics::kCall,
+          llvm::FunctionType::get(
+              Context.VoidTy,
+              {Context.Int32Ty, Context.Int8PtrTy, Context.Int8PtrTy},
+              false)),
+      {Builder.getInt32(FuncID), Args, Rets});
+
+  if (RetSize == 0) {
+    Builder.CreateRetVoid();
+  } else if (RetSize == 1) {
+    llvm::Value *VPtr =
+        Builder.CreateConstInBoundsGEP1_64(Context.Int8Ty, Rets, 0);
+    llvm::Value *Ptr =
+        Builder.CreateBitCast(VPtr, F->getReturnType()->getPointerTo());
+    Builder.CreateRet(Builder.CreateLoad(F->getReturnType(), Ptr));
+  } else {
+    std::vector<llvm::Value *> Ret;
+    Ret.reserve(RetSize);
+    for (unsigned I = 0; I < RetSize; ++I) {
+      llvm::Value *VPtr = Builder.CreateConstInBoundsGEP1_64(
+          Context.Int8Ty, Rets, I * kValSize);
+      llvm::Value *Ptr = Builder.CreateBitCast(
+          VPtr, RTy->getStructElementType(I)->getPointerTo());
+      Ret.push_back(Builder.CreateLoad(RTy->getStructElementType(I), Ptr));
+    }
+    Builder.CreateAggregateRet(Ret.data(), static_cast<uint32_t>(RetSize));
+  }
+  return F;
+}
+
+/// Initialize the native target once for the JIT compiling, which may be run
+/// by the compilers in several threads.
+void initNativeTarget() {
+  static std::once_flag Once;
+  std::call_once(Once, []() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+}
+
+/// Detect the host machine for the JIT compiling.
+Expect<llvm::orc::JITTargetMachineBuilder> detectHostMachine() {
+  initNativeTarget();
+  auto JTMB = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    spdlog::error("detectHost failed:{}", llvm::toString(JTMB.takeError()));
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  JTMB->setCodeGenOptLevel(llvm::CodeGenOpt::Level::Aggressive);
+  return std::move(*JTMB);
+}
+
+/// Generate the code of the module with the ORC JIT. The symbols of the
+/// current process are visible to the compiled code as the AOT compiled
+/// shared libraries.
+Expect<std::shared_ptr<JITLibrary>>
+createJITLibrary(llvm::orc::JITTargetMachineBuilder JTMB,
+                 std::unique_ptr<llvm::LLVMContext> LLContext,
+                 std::unique_ptr<llvm::Module> LLModule) {
+  auto JIT = llvm::orc::LLJITBuilder()
+                 .setJITTargetMachineBuilder(std::move(JTMB))
+                 .create();
+  if (!JIT) {
+    spdlog::error("LLJIT creation failed:{}", llvm::toString(JIT.takeError()));
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  if (auto Gen = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          (*JIT)->getDataLayout().getGlobalPrefix())) {
+    (*JIT)->getMainJITDylib().addGenerator(std::move(*Gen));
+  } else {
+    spdlog::error("symbol generator creation failed:{}",
+                  llvm::toString(Gen.takeError()));
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  if (auto Err = (*JIT)->addIRModule(llvm::orc::ThreadSafeModule(
+          std::move(LLModule), std::move(LLContext)))) {
+    spdlog::error("addIRModule failed:{}", llvm::toString(std::move(Err)));
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  return std::make_shared<JITLibrary>(std::move(*JIT));
+}
+
+/// Set the null initializer of the intrinsics table, which is set by the
+/// runtime after loading.
+void initIntrinsicsTable(llvm::Module &LLModule) {
+  if (auto *IntrinsicsTable = LLModule.getNamedGlobal("intrinsics")) {
+    IntrinsicsTable->setInitializer(llvm::ConstantPointerNull::get(
+        llvm::cast<llvm::PointerType>(IntrinsicsTable->getValueType())));
+    IntrinsicsTable->setConstant(false);
+  }
+}
+} // namespace
+
 Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
                                std::filesystem::path OutputPath) {
   // Check the module is validated.
@@ -5018,16 +5661,144 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
     return Unexpect(ErrCode::Value::NotValidated);
   }
 
+  // Decode and validate the function bodies deferred by the lazy loading.
+  std::vector<AST::InstrVec> LazyBodies;
+  if (auto Res = decodeLazyBodies(Module); unlikely(!Res)) {
+    return Unexpect(Res);
+  } else {
+    LazyBodies = std::move(*Res);
+  }
+
   using namespace std::literals;
 
   std::unique_lock Lock(Mutex);
   spdlog::info("compile start");
-  std::filesystem::path LLPath(OutputPath);
-  LLPath.replace_extension("ll"sv);
 
   llvm::InitializeNativeTarget();
   llvm::InitializeNativeTargetAsmPrinter();
 
+  const auto &CodeSegs = Module.getCodeSection().getContent();
+  std::vector<size_t> Bounds;
+  std::vector<std::filesystem::path> CachePaths;
+  if (Conf.getCompilerConfigure().isObjectCaching()) {
+    if (auto FuncHashes = hashFunctions(Data, Module, LazyBodies, Profile)) {
+      // The first partition has the shared symbols and the embedded binary
+      // only, and the fragments of the functions are cached by the hashes of
+      // the context and their functions.
+      const auto ContextHash = hashContext(Conf, Module);
+      const auto Fragments =
+          fragmentCodeSegments(CodeSegs, LazyBodies, *FuncHashes);
+      Bounds.push_back(0);
+      Bounds.insert(Bounds.end(), Fragments.begin(), Fragments.end());
+      CachePaths.resize(Bounds.size() - 1);
+      for (size_t I = 1; I + 1 < Bounds.size(); ++I) {
+        std::vector<Byte> Key(ContextHash.begin(), ContextHash.end());
+        for (size_t J = Bounds[I]; J < Bounds[I + 1]; ++J) {
+          Key.insert(Key.end(), (*FuncHashes)[J].begin(),
+                     (*FuncHashes)[J].end());
+        }
+        if (auto Res = Cache::getPath(Key, Cache::StorageScope::Local,
+                                      "objects"sv)) {
+          CachePaths[I] = std::move(*Res);
+        }
+      }
+    } else {
+      spdlog::warn("function bodies not found in binary, object cache skipped");
+    }
+  }
+  const bool IsCached = !Bounds.empty();
+  if (!IsCached) {
+    const uint32_t Count = static_cast<uint32_t>(
+        std::clamp<size_t>(Conf.getCompilerConfigure().getJobs(), 1,
+                           std::max<size_t>(CodeSegs.size(), 1)));
+    Bounds = partitionCodeSegments(CodeSegs, LazyBodies, Count);
+    CachePaths.resize(Count);
+  }
+
+  std::vector<std::string> Objects(Bounds.size() - 1);
+  std::vector<uint32_t> Indices;
+  for (uint32_t I = 0; I < Objects.size(); ++I) {
+    if (CachePaths[I].empty() || !loadObject(CachePaths[I], Objects[I])) {
+      Indices.push_back(I);
+    }
+  }
+  if (IsCached) {
+    spdlog::info("object cache: {} of {} fragments reused",
+                 Objects.size() - Indices.size(), Objects.size() - 1);
+  }
+  if (auto Res = compilePartitions(Data, Module, LazyBodies, OutputPath, Bounds,
+                                   Indices, Objects);
+      unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  for (const auto I : Indices) {
+    if (!CachePaths[I].empty()) {
+      storeObject(CachePaths[I], Objects[I]);
+    }
+  }
+
+  switch (Conf.getCompilerConfigure().getOutputFormat()) {
+  case CompilerConfigure::OutputFormat::Native:
+    if (auto Res = outputNativeLibrary(OutputPath, Objects); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    break;
+  case CompilerConfigure::OutputFormat::Wasm:
+    if (auto Res = outputWasmLibrary(OutputPath, Data, Objects);
+        unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    break;
+  }
+
+  return {};
+}
+
+Expect<void> Compiler::compilePartitions(
+    Span<const Byte> Data, const AST::Module &Module,
+    Span<const AST::InstrVec> LazyBodies,
+    const std::filesystem::path &OutputPath, Span<const size_t> Bounds,
+    Span<const uint32_t> Indices, Span<std::string> Objects) {
+  // Compile the partitions in parallel. Each partition is compiled by its own
+  // compiler with its own LLVM context. The partitions after the lowest failed
+  // one are skipped.
+  const auto Count = static_cast<uint32_t>(Bounds.size() - 1);
+  const auto PartNum = static_cast<uint32_t>(Indices.size());
+  std::vector<Expect<void>> Results(PartNum);
+  const uint32_t FailedIdx = runParallelJobs(
+      PartNum, 1, std::max<uint32_t>(Conf.getCompilerConfigure().getJobs(), 1),
+      [&]() {
+        return [&](uint32_t I) {
+          const auto Index = Indices[I];
+          Compiler PartCompiler(Conf);
+          PartCompiler.setProfile(Profile);
+          Results[I] = PartCompiler.compilePartition(
+              Data, Module, LazyBodies, OutputPath, Bounds[Index],
+              Bounds[Index + 1], Index, Count, Objects[Index]);
+          return static_cast<bool>(Results[I]);
+        };
+      });
+  if (unlikely(FailedIdx < PartNum)) {
+    return Unexpect(Results[FailedIdx]);
+  }
+  return {};
+}
+
+Expect<void> Compiler::compilePartition(Span<const Byte> Data,
+                                        const AST::Module &Module,
+                                        Span<const AST::InstrVec> LazyBodies,
+                                        const std::filesystem::path &OutputPath,
+                                        size_t Begin, size_t End,
+                                        uint32_t Index, uint32_t Count,
+                                        std::string &Object) {
+  using namespace std::literals;
+
+  std::filesystem::path LLPath(OutputPath);
+  LLPath.replace_extension("ll"sv);
+  // Name the dumped IR files by the partition index if partitioned.
+  const std::string DumpSuffix =
+      Count > 1 ? "-"s + std::to_string(Index) : ""s;
+
   llvm::LLVMContext LLContext;
   llvm::Module LLModule(LLPath.u8string(), LLContext);
   LLModule.setTargetTriple(llvm::sys::getProcessTriple());
@@ -5038,34 +5809,23 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
 #endif
   CompileContext NewContext(LLModule,
                             Conf.getCompilerConfigure().isGenericBinary());
-  struct RAIICleanup {
-    RAIICleanup(CompileContext *&Context, CompileContext &NewContext)
-        : Context(Context) {
-      Context = &NewContext;
-    }
-    ~RAIICleanup() { Context = nullptr; }
-    CompileContext *&Context;
-  };
   RAIICleanup Cleanup(Context, NewContext);
+  compileModule(Module, LazyBodies, Begin, End);
 
-  // Compile Function Types
-  compile(Module.getTypeSection());
-  // Compile ImportSection
-  compile(Module.getImportSection());
-  // Compile GlobalSection
-  compile(Module.getGlobalSection());
-  // Compile MemorySection (MemorySec, DataSec)
-  compile(Module.getMemorySection(), Module.getDataSection());
-  // Compile TableSection (TableSec, ElemSec)
-  compile(Module.getTableSection(), Module.getElementSection());
-  // compile Functions in module. (FunctionSec, CodeSec)
-  compile(Module.getFunctionSection(), Module.getCodeSection());
-  // Compile ExportSection
-  compile(Module.getExportSection());
-  // StartSection is not required to compile
-
-  if (Conf.getCompilerConfigure().getOutputFormat() ==
-      CompilerConfigure::OutputFormat::Native) {
+  if (Index != 0) {
+    // The version and the type wrappers are defined in the first partition.
+    for (auto &Alias : llvm::make_early_inc_range(LLModule.aliases())) {
+      Alias.replaceAllUsesWith(Alias.getAliasee());
+      Alias.eraseFromParent();
+    }
+    for (auto *F : Context->FunctionWrappers) {
+      F->deleteBody();
+    }
+    if (auto *Version = LLModule.getNamedGlobal("version")) {
+      Version->setInitializer(nullptr);
+    }
+  } else if (Conf.getCompilerConfigure().getOutputFormat() ==
+             CompilerConfigure::OutputFormat::Native) {
     // create wasm.code and wasm.size
     auto *Int32Ty = Context->Int32Ty;
     auto *Content = llvm::ConstantDataArray::getString(
@@ -5081,6 +5841,12 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
         llvm::ConstantInt::get(Int32Ty, Data.size()), "wasm.size");
   }
 
+  if (Index == 0) {
+    // Keep the intrinsics table defined even if no function in the first
+    // partition uses it.
+    llvm::appendToCompilerUsed(LLModule, {Context->IntrinsicsTable});
+  }
+
   // set dllexport
   for (auto &GV : LLModule.global_values()) {
     if (GV.hasExternalLinkage()) {
@@ -5091,7 +5857,7 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
 
   if (Conf.getCompilerConfigure().isDumpIR()) {
     int Fd;
-    llvm::sys::fs::openFileForWrite("wasm.ll", Fd);
+    llvm::sys::fs::openFileForWrite("wasm" + DumpSuffix + ".ll", Fd);
     llvm::raw_fd_ostream OS(Fd, true);
     LLModule.print(OS, nullptr);
   }
@@ -5126,56 +5892,12 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
     LLModule.setDataLayout(TM->createDataLayout());
 
     llvm::TargetLibraryInfoImpl TLII(Triple);
-
-    {
-#if LLVM_VERSION_MAJOR == 12
-      llvm::PassBuilder PB(false, TM.get());
-#else
-      llvm::PassBuilder PB(TM.get());
-#endif
-
-      llvm::LoopAnalysisManager LAM;
-      llvm::FunctionAnalysisManager FAM;
-      llvm::CGSCCAnalysisManager CGAM;
-      llvm::ModuleAnalysisManager MAM;
-
-      // Register the AA manager first so that our version is the one
-      // used.
-      FAM.registerPass([&] { return PB.buildDefaultAAPipeline(); });
-
-      // Register the target library analysis directly and give it a
-      // customized preset TLI.
-      FAM.registerPass([&] { return llvm::TargetLibraryAnalysis(TLII); });
-#if LLVM_VERSION_MAJOR <= 9
-      MAM.registerPass([&] { return llvm::TargetLibraryAnalysis(TLII); });
-#endif
-
-      // Register all the basic analyses with the managers.
-      PB.registerModuleAnalyses(MAM);
-      PB.registerCGSCCAnalyses(CGAM);
-      PB.registerFunctionAnalyses(FAM);
-      PB.registerLoopAnalyses(LAM);
-      PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
-
-      llvm::ModulePassManager MPM;
-      if (Conf.getCompilerConfigure().getOptimizationLevel() ==
-          CompilerConfigure::OptimizationLevel::O0) {
-        MPM.addPass(
-            llvm::createModuleToFunctionPassAdaptor(llvm::TailCallElimPass()));
-        MPM.addPass(llvm::AlwaysInlinerPass(false));
-      } else {
-        MPM.addPass(PB.buildPerModuleDefaultPipeline(
-            toLLVMLevel(Conf.getCompilerConfigure().getOptimizationLevel())));
-      }
-
-      MPM.run(LLModule, MAM);
-    }
+    optimizeModule(LLModule, *TM, TLII, Conf.getCompilerConfigure(),
+                   Profile != nullptr);
 
     // Set initializer for constant value
-    if (auto *IntrinsicsTable = LLModule.getNamedGlobal("intrinsics")) {
-      IntrinsicsTable->setInitializer(llvm::ConstantPointerNull::get(
-          llvm::cast<llvm::PointerType>(IntrinsicsTable->getValueType())));
-      IntrinsicsTable->setConstant(false);
+    if (Index == 0) {
+      initIntrinsicsTable(LLModule);
     }
 
     llvm::legacy::PassManager CodeGenPasses;
@@ -5200,7 +5922,7 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
 
     if (Conf.getCompilerConfigure().isDumpIR()) {
       int Fd;
-      llvm::sys::fs::openFileForWrite("wasm-opt.ll", Fd);
+      llvm::sys::fs::openFileForWrite("wasm-opt" + DumpSuffix + ".ll", Fd);
       llvm::raw_fd_ostream LLOS(Fd, true);
       LLModule.print(LLOS, nullptr);
     }
@@ -5208,29 +5930,276 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
     CodeGenPasses.run(LLModule);
   }
 
-  switch (Conf.getCompilerConfigure().getOutputFormat()) {
-  case CompilerConfigure::OutputFormat::Native:
-    if (auto Res = outputNativeLibrary(OutputPath, OSVec); unlikely(!Res)) {
-      return Unexpect(Res);
-    }
-    break;
-  case CompilerConfigure::OutputFormat::Wasm:
-    if (auto Res = outputWasmLibrary(OutputPath, Data, OSVec); unlikely(!Res)) {
-      return Unexpect(Res);
+  Object.assign(OSVec.data(), OSVec.size());
+  return {};
+}
+
+Expect<void> Compiler::compileJIT(AST::Module &Module) {
+  // Check the module is validated.
+  if (unlikely(!Module.getIsValidated())) {
+    spdlog::error(ErrCode::Value::NotValidated);
+    return Unexpect(ErrCode::Value::NotValidated);
+  }
+
+  // Decode and validate the function bodies deferred by the lazy loading.
+  std::vector<AST::InstrVec> LazyBodies;
+  if (auto Res = decodeLazyBodies(Module); unlikely(!Res)) {
+    return Unexpect(Res);
+  } else {
+    LazyBodies = std::move(*Res);
+  }
+
+  std::unique_lock Lock(Mutex);
+  spdlog::info("jit compile start");
+
+  auto JTMB = detectHostMachine();
+  if (unlikely(!JTMB)) {
+    return Unexpect(JTMB);
+  }
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    spdlog::error("createTargetMachine failed:{}",
+                  llvm::toString(TM.takeError()));
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+
+  // The compiled code is generated for the host.
+  auto LLContext = std::make_unique<llvm::LLVMContext>();
+  auto LLModule = std::make_unique<llvm::Module>("wasm", *LLContext);
+  LLModule->setTargetTriple((*TM)->getTargetTriple().str());
+  LLModule->setDataLayout((*TM)->createDataLayout());
+  {
+    CompileContext NewContext(*LLModule, false);
+    RAIICleanup Cleanup(Context, NewContext);
+    compileModule(Module, LazyBodies, 0,
+                  Module.getCodeSection().getContent().size());
+  }
+
+  spdlog::info("verify start");
+  llvm::verifyModule(*LLModule, &llvm::errs());
+  spdlog::info("optimize start");
+  llvm::TargetLibraryInfoImpl TLII((*TM)->getTargetTriple());
+  optimizeModule(*LLModule, **TM, TLII, Conf.getCompilerConfigure());
+  initIntrinsicsTable(*LLModule);
+  if (!LLModule->getNamedGlobal("intrinsics")) {
+    // The unused declaration is removed by the optimization, but the symbol is
+    // still required to set the intrinsics table of the module.
+    auto *PtrTy = llvm::Type::getInt8PtrTy(*LLContext);
+    new llvm::GlobalVariable(*LLModule, PtrTy, false,
+                             llvm::GlobalValue::ExternalLinkage,
+                             llvm::ConstantPointerNull::get(PtrTy),
+                             "intrinsics");
+  }
+
+  spdlog::info("codegen start");
+  auto Res = createJITLibrary(std::move(*JTMB), std::move(LLContext),
+                              std::move(LLModule));
+  if (unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  auto Library = std::move(*Res);
+
+  // Look up the symbols, which materializes the module.
+  auto &FuncTypes = Module.getTypeSection().getContent();
+  auto &CodeSegs = Module.getCodeSection().getContent();
+  std::vector<Symbol<AST::FunctionType::Wrapper>> FuncTypeSymbols;
+  std::vector<Symbol<void>> CodeSymbols;
+  FuncTypeSymbols.reserve(FuncTypes.size());
+  CodeSymbols.reserve(CodeSegs.size());
+  for (size_t I = 0; I < FuncTypes.size(); ++I) {
+    const std::string Name = "t" + std::to_string(I);
+    FuncTypeSymbols.push_back(
+        Library->get<AST::FunctionType::Wrapper>(Name.c_str()));
+  }
+  size_t Offset = 0;
+  for (const auto &ImpDesc : Module.getImportSection().getContent()) {
+    if (ImpDesc.getExternalType() == ExternalType::Function) {
+      ++Offset;
     }
-    break;
+  }
+  for (size_t I = 0; I < CodeSegs.size(); ++I) {
+    const std::string Name = "f" + std::to_string(I + Offset);
+    CodeSymbols.push_back(Library->get<void>(Name.c_str()));
+  }
+  auto IntrinsicsSymbol =
+      Library->get<const AST::Module::IntrinsicsTable *>("intrinsics");
+  if (unlikely(!IntrinsicsSymbol ||
+               std::any_of(FuncTypeSymbols.begin(), FuncTypeSymbols.end(),
+                           [](const auto &S) { return !S; }) ||
+               std::any_of(CodeSymbols.begin(), CodeSymbols.end(),
+                           [](const auto &S) { return !S; }))) {
+    spdlog::error("jit symbols lookup failed");
+    return Unexpect(ErrCode::Value::RuntimeError);
   }
 
+  // Set the symbols into the module.
+  for (size_t I = 0; I < FuncTypes.size(); ++I) {
+    FuncTypes[I].setSymbol(std::move(FuncTypeSymbols[I]));
+  }
+  for (size_t I = 0; I < CodeSegs.size(); ++I) {
+    CodeSegs[I].setSymbol(std::move(CodeSymbols[I]));
+  }
+  Module.setSymbol(std::move(IntrinsicsSymbol));
+  spdlog::info("jit compile done");
   return {};
 }
 
+Expect<Compiler::FunctionCode> Compiler::compileFunction(
+    Span<const AST::FunctionType> Types, Span<const uint32_t> FuncTypeIdxs,
+    Span<const ValType> GlobalTypes, uint32_t FuncIdx,
+    Span<const std::pair<uint32_t, ValType>> Locals, AST::InstrView Instrs,
+    const AST::Module::IntrinsicsTable &Intrinsics) {
+  assuming(FuncIdx < FuncTypeIdxs.size());
+  std::unique_lock Lock(Mutex);
+
+  auto JTMB = detectHostMachine();
+  if (unlikely(!JTMB)) {
+    return Unexpect(JTMB);
+  }
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    spdlog::error("createTargetMachine failed:{}",
+                  llvm::toString(TM.takeError()));
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+
+  auto LLContext = std::make_unique<llvm::LLVMContext>();
+  auto LLModule = std::make_unique<llvm::Module>("wasm", *LLContext);
+  LLModule->setTargetTriple((*TM)->getTargetTriple().str());
+  LLModule->setDataLayout((*TM)->createDataLayout());
+  const auto TypeIdx = FuncTypeIdxs[FuncIdx];
+  std::string WrapperName;
+  const std::string FuncName = "f" + std::to_string(FuncIdx);
+  {
+    CompileContext NewContext(*LLModule, false);
+    RAIICleanup Cleanup(Context, NewContext);
+
+    // Only the wrapper of the function type is required.
+    compile(Types);
+    while (!LLModule->alias_empty()) {
+      auto &Alias = *LLModule->alias_begin();
+      Alias.replaceAllUsesWith(Alias.getAliasee());
+      Alias.eraseFromParent();
+    }
+    auto *Wrapper = Context->FunctionWrappers[TypeIdx];
+    WrapperName = Wrapper->getName().str();
+    std::vector<llvm::Function *> Wrappers = Context->FunctionWrappers;
+    std::sort(Wrappers.begin(), Wrappers.end());
+    Wrappers.erase(std::unique(Wrappers.begin(), Wrappers.end()),
+                   Wrappers.end());
+    for (auto *F : Wrappers) {
+      if (F != Wrapper) {
+        F->eraseFromParent();
+      }
+    }
+
+    for (const auto &Type : GlobalTypes) {
+      Context->Globals.push_back(toLLVMType(*LLContext, Type));
+    }
+
+    // The other functions are called through the intrinsics table.
+    llvm::Function *Function = nullptr;
+    for (uint32_t I = 0; I < FuncTypeIdxs.size(); ++I) {
+      llvm::Function *F;
+      if (I == FuncIdx) {
+        F = llvm::Function::Create(
+            toLLVMType(Context->ExecCtxPtrTy,
+                       *Context->FunctionTypes[FuncTypeIdxs[I]]),
+            llvm::Function::ExternalLinkage, FuncName, *LLModule);
+        F->addFnAttr(llvm::Attribute::StrictFP);
+        F->addParamAttr(0, llvm::Attribute::AttrKind::ReadOnly);
+        F->addParamAttr(0, llvm::Attribute::AttrKind::NoAlias);
+        Function = F;
+      } else {
+        F = createCallThunk(*Context, I, FuncTypeIdxs[I]);
+      }
+      Context->Functions.emplace_back(FuncTypeIdxs[I], F, nullptr);
+    }
+
+    std::vector<ValType> LocalTypes;
+    for (const auto &Local : Locals) {
+      LocalTypes.insert(LocalTypes.end(), Local.first, Local.second);
+    }
+    FunctionCompiler FC(*Context, Function, LocalTypes,
+                        Conf.getCompilerConfigure().isInterruptible(),
+                        Conf.getStatisticsConfigure().isInstructionCounting(),
+                        Conf.getStatisticsConfigure().isCostMeasuring(),
+                        Conf.getCompilerConfigure().getOptimizationLevel() ==
+                            CompilerConfigure::OptimizationLevel::O0);
+    FC.compile(Instrs, Context->resolveBlockType(TypeIdx));
+    llvm::EliminateUnreachableBlocks(*Function);
+
+    for (auto &[T, F, Code] : Context->Functions) {
+      if (F != Function && F->use_empty()) {
+        F->eraseFromParent();
+      }
+    }
+
+    // The intrinsics table of the running module is known, so the loads of the
+    // table are folded by the optimization.
+    auto *IntrinsicsTable = Context->IntrinsicsTable;
+    IntrinsicsTable->setInitializer(llvm::ConstantExpr::getIntToPtr(
+        llvm::ConstantInt::get(Context->Int64Ty,
+                               reinterpret_cast<uintptr_t>(&Intrinsics)),
+        Context->IntrinsicsTablePtrTy));
+    IntrinsicsTable->setConstant(true);
+    IntrinsicsTable->setLinkage(llvm::GlobalValue::PrivateLinkage);
+  }
+
+  if (llvm::verifyModule(*LLModule, &llvm::errs())) {
+    spdlog::error("verify function {} failed", FuncIdx);
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  llvm::TargetLibraryInfoImpl TLII((*TM)->getTargetTriple());
+  optimizeModule(*LLModule, **TM, TLII, Conf.getCompilerConfigure());
+
+  auto Res = createJITLibrary(std::move(*JTMB), std::move(LLContext),
+                              std::move(LLModule));
+  if (unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  auto Library = std::move(*Res);
+  FunctionCode Code{
+      Library->get<AST::FunctionType::Wrapper>(WrapperName.c_str()),
+      Library->get<void>(FuncName.c_str())};
+  if (unlikely(!Code.Wrapper || !Code.Function)) {
+    spdlog::error("jit symbols lookup failed");
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  return Code;
+}
+
+void Compiler::compileModule(const AST::Module &Module,
+                             Span<const AST::InstrVec> LazyBodies, size_t Begin,
+                             size_t End) {
+  // Compile Function Types
+  compile(Module.getTypeSection());
+  // Compile ImportSection
+  compile(Module.getImportSection());
+  // Compile GlobalSection
+  compile(Module.getGlobalSection());
+  // Compile MemorySection (MemorySec, DataSec)
+  compile(Module.getMemorySection(), Module.getDataSection());
+  // Compile TableSection (TableSec, ElemSec)
+  compile(Module.getTableSection(), Module.getElementSection());
+  // compile Functions in module. (FunctionSec, CodeSec)
+  compile(Module.getFunctionSection(), Module.getCodeSection(), LazyBodies,
+          Begin, End);
+  // Compile ExportSection
+  compile(Module.getExportSection());
+  // StartSection is not required to compile
+}
+
 void Compiler::compile(const AST::TypeSection &TypeSec) {
+  compile(TypeSec.getContent());
+}
+
+void Compiler::compile(Span<const AST::FunctionType> FuncTypes) {
   auto *WrapperTy =
       llvm::FunctionType::get(Context->VoidTy,
                               {Context->ExecCtxPtrTy, Context->Int8PtrTy,
                                Context->Int8PtrTy, Context->Int8PtrTy},
                               false);
-  const auto &FuncTypes = TypeSec.getContent();
   const auto Size = FuncTypes.size();
   if (Size == 0) {
     return;
@@ -5341,83 +6310,7 @@ void Compiler::compile(const AST::ImportSection &ImportSec) {
       // Get the function type index in module.
       uint32_t TypeIdx = ImpDesc.getExternalFuncTypeIdx();
       assuming(TypeIdx < Context->FunctionTypes.size());
-      const auto &FuncType = *Context->FunctionTypes[TypeIdx];
-
-      auto *FTy = toLLVMType(Context->ExecCtxPtrTy, FuncType);
-      auto *RTy = FTy->getReturnType();
-      auto *F = llvm::Function::Create(FTy, llvm::Function::PrivateLinkage,
-                                       "f" + std::to_string(FuncID),
-                                       Context->LLModule);
-      F->addFnAttr(llvm::Attribute::StrictFP);
-      F->addParamAttr(0, llvm::Attribute::AttrKind::ReadOnly);
-      F->addParamAttr(0, llvm::Attribute::AttrKind::NoAlias);
-
-      auto *Entry = llvm::BasicBlock::Create(Context->LLContext, "entry", F);
-      llvm::IRBuilder<> Builder(Entry);
-      setIsFPConstrained(Builder);
-
-      const auto ArgSize = FuncType.getParamTypes().size();
-      const auto RetSize =
-          RTy->isVoidTy() ? 0 : FuncType.getReturnTypes().size();
-
-      llvm::Value *Args;
-      if (ArgSize == 0) {
-        Args = llvm::ConstantPointerNull::get(Context->Int8PtrTy);
-      } else {
-        auto *Alloca = Builder.CreateAlloca(
-            Context->Int8Ty, Builder.getInt64(ArgSize * kValSize));
-        Alloca->setAlignment(Align(kValSize));
-        Args = Alloca;
-      }
-
-      llvm::Value *Rets;
-      if (RetSize == 0) {
-        Rets = llvm::ConstantPointerNull::get(Context->Int8PtrTy);
-      } else {
-        auto *Alloca = Builder.CreateAlloca(
-            Context->Int8Ty, Builder.getInt64(RetSize * kValSize));
-        Alloca->setAlignment(Align(kValSize));
-        Rets = Alloca;
-      }
-
-      for (unsigned I = 0; I < ArgSize; ++I) {
-        llvm::Argument *Arg = F->arg_begin() + 1 + I;
-        llvm::Value *Ptr = Builder.CreateConstInBoundsGEP1_64(
-            Context->Int8Ty, Args, I * kValSize);
-        Builder.CreateStore(
-            Arg, Builder.CreateBitCast(Ptr, Arg->getType()->getPointerTo()));
-      }
-
-      Builder.CreateCall(
-          Context->getIntrinsic(
-              Builder, AST::Module::Intrinsics::kCall,
-              llvm::FunctionType::get(
-                  Context->VoidTy,
-                  {Context->Int32Ty, Context->Int8PtrTy, Context->Int8PtrTy},
-                  false)),
-          {Builder.getInt32(FuncID), Args, Rets});
-
-      if (RetSize == 0) {
-        Builder.CreateRetVoid();
-      } else if (RetSize == 1) {
-        llvm::Value *VPtr =
-            Builder.CreateConstInBoundsGEP1_64(Context->Int8Ty, Rets, 0);
-        llvm::Value *Ptr =
-            Builder.CreateBitCast(VPtr, F->getReturnType()->getPointerTo());
-        Builder.CreateRet(Builder.CreateLoad(F->getReturnType(), Ptr));
-      } else {
-        std::vector<llvm::Value *> Ret;
-        Ret.reserve(RetSize);
-        for (unsigned I = 0; I < RetSize; ++I) {
-          llvm::Value *VPtr = Builder.CreateConstInBoundsGEP1_64(
-              Context->Int8Ty, Rets, I * kValSize);
-          llvm::Value *Ptr = Builder.CreateBitCast(
-              VPtr, RTy->getStructElementType(I)->getPointerTo());
-          Ret.push_back(Builder.CreateLoad(RTy->getStructElementType(I), Ptr));
-        }
-        Builder.CreateAggregateRet(Ret.data(), static_cast<uint32_t>(RetSize));
-      }
-
+      auto *F = createCallThunk(*Context, FuncID, TypeIdx);
       Context->Functions.emplace_back(TypeIdx, F, nullptr);
       break;
     }
@@ -5462,7 +6355,9 @@ void Compiler::compile(const AST::TableSection &, const AST::ElementSection &) {
 }
 
 void Compiler::compile(const AST::FunctionSection &FuncSec,
-                       const AST::CodeSection &CodeSec) {
+                       const AST::CodeSection &CodeSec,
+                       Span<const AST::InstrVec> LazyBodies, size_t Begin,
+                       size_t End) {
   const auto &TypeIdxs = FuncSec.getContent();
   const auto &CodeSegs = CodeSec.getContent();
   if (TypeIdxs.size() == 0 || CodeSegs.size() == 0) {
@@ -5490,6 +6385,11 @@ void Compiler::compile(const AST::FunctionSection &FuncSec,
     if (!Code) {
       continue;
     }
+    // The functions out of the partition are declared only.
+    if (const auto Idx = static_cast<size_t>(Code - CodeSegs.data());
+        Idx < Begin || Idx >= End) {
+      continue;
+    }
 
     std::vector<ValType> Locals;
     for (const auto &Local : Code->getLocals()) {
@@ -5503,8 +6403,22 @@ void Compiler::compile(const AST::FunctionSection &FuncSec,
                         Conf.getStatisticsConfigure().isCostMeasuring(),
                         Conf.getCompilerConfigure().getOptimizationLevel() ==
                             CompilerConfigure::OptimizationLevel::O0);
+    // The profiles are keyed by the function indices including the imports.
+    if (Profile) {
+      const auto FuncIdx = static_cast<uint32_t>(
+          Context->Functions.size() - CodeSegs.size() +
+          static_cast<size_t>(Code - CodeSegs.data()));
+      if (auto Iter = Profile->find(FuncIdx); Iter != Profile->end()) {
+        FC.setProfile(&Iter->second);
+      }
+    }
     auto Type = Context->resolveBlockType(T);
-    FC.compile(*Code, std::move(Type));
+    if (Code->isLazy()) {
+      FC.compile(LazyBodies[static_cast<size_t>(Code - CodeSegs.data())],
+                 std::move(Type));
+    } else {
+      FC.compile(Code->getExpr().getInstrs(), std::move(Type));
+    }
     llvm::EliminateUnreachableBlocks(*F);
   }
 }
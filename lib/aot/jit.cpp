@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "aot/jit.h"
+
+#include "common/log.h"
+
+#include <cstdint>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+
+namespace WasmEdge {
+namespace AOT {
+
+JITLibrary::JITLibrary(std::unique_ptr<llvm::orc::LLJIT> J) noexcept
+    : JIT(std::move(J)) {}
+
+JITLibrary::~JITLibrary() noexcept = default;
+
+void *JITLibrary::getSymbolAddr(const char *Name) const noexcept {
+  auto Res = JIT->lookup(Name);
+  if (!Res) {
+    spdlog::error("jit symbol {} not found:{}", Name,
+                  llvm::toString(Res.takeError()));
+    return nullptr;
+  }
+#if LLVM_VERSION_MAJOR >= 15
+  return Res->toPtr<void *>();
+#else
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(Res->getAddress()));
+#endif
+}
+
+} // namespace AOT
+} // namespace WasmEdge
@@ -8,6 +8,7 @@
 #include "driver/tool.h"
 #include "host/wasi/wasimodule.h"
 #include "plugin/plugin.h"
+#include "system/allocator.h"
 #include "vm/vm.h"
 
 #ifdef WASMEDGE_BUILD_FUZZING
@@ -71,6 +72,14 @@ struct WasmEdge_CompilerContext {
 // WasmEdge_LoaderContext implementation.
 struct WasmEdge_LoaderContext {};
 
+// WasmEdge_LoaderStreamContext implementation.
+struct WasmEdge_LoaderStreamContext {
+  WasmEdge_LoaderStreamContext() noexcept
+      : Stream(std::make_shared<WasmEdge::ByteStream>()) {}
+  ~WasmEdge_LoaderStreamContext() noexcept { Stream->finish(); }
+  std::shared_ptr<WasmEdge::ByteStream> Stream;
+};
+
 // WasmEdge_ValidatorContext implementation.
 struct WasmEdge_ValidatorContext {};
 
@@ -83,6 +92,9 @@ struct WasmEdge_StoreContext {};
 // WasmEdge_ModuleInstanceContext implementation.
 struct WasmEdge_ModuleInstanceContext {};
 
+// WasmEdge_ModuleTemplateContext implementation.
+struct WasmEdge_ModuleTemplateContext {};
+
 // WasmEdge_FunctionInstanceContext implementation.
 struct WasmEdge_FunctionInstanceContext {};
 
@@ -312,6 +324,7 @@ CONVTO(Validator, Validator::Validator, Validator, )
 CONVTO(Executor, Executor::Executor, Executor, )
 CONVTO(Mod, Runtime::Instance::ModuleInstance, ModuleInstance, )
 CONVTO(Mod, Runtime::Instance::ModuleInstance, ModuleInstance, const)
+CONVTO(Tmpl, Runtime::Instance::ModuleTemplate, ModuleTemplate, )
 CONVTO(Func, Runtime::Instance::FunctionInstance, FunctionInstance, )
 CONVTO(Func, Runtime::Instance::FunctionInstance, FunctionInstance, const)
 CONVTO(Tab, Runtime::Instance::TableInstance, TableInstance, )
@@ -346,6 +359,8 @@ CONVFROM(Validator, Validator::Validator, Validator, )
 CONVFROM(Executor, Executor::Executor, Executor, )
 CONVFROM(Mod, Runtime::Instance::ModuleInstance, ModuleInstance, )
 CONVFROM(Mod, Runtime::Instance::ModuleInstance, ModuleInstance, const)
+CONVFROM(Tmpl, Runtime::Instance::ModuleTemplate, ModuleTemplate, )
+CONVFROM(Tmpl, Runtime::Instance::ModuleTemplate, ModuleTemplate, const)
 CONVFROM(Func, Runtime::Instance::FunctionInstance, FunctionInstance, )
 CONVFROM(Func, Runtime::Instance::FunctionInstance, FunctionInstance, const)
 CONVFROM(Tab, Runtime::Instance::TableInstance, TableInstance, )
@@ -456,6 +471,30 @@ WASMEDGE_CAPI_EXPORT void WasmEdge_LogSetDebugLevel(void) {
 
 // <<<<<<<< WasmEdge logging functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>> WasmEdge allocator functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+WASMEDGE_CAPI_EXPORT void WasmEdge_AllocatorSetPoolLimit(const uint32_t Limit) {
+  WasmEdge::Allocator::setPoolLimit(Limit);
+}
+
+WASMEDGE_CAPI_EXPORT void WasmEdge_AllocatorReservePool(const uint32_t Count) {
+  WasmEdge::Allocator::reservePool(Count);
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t WasmEdge_AllocatorGetPoolSize(void) {
+  return WasmEdge::Allocator::getPoolSize();
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t WasmEdge_AllocatorGetPoolHitCount(void) {
+  return WasmEdge::Allocator::getPoolHitCount();
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t WasmEdge_AllocatorGetPoolMissCount(void) {
+  return WasmEdge::Allocator::getPoolMissCount();
+}
+
+// <<<<<<<< WasmEdge allocator functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 // >>>>>>>> WasmEdge value functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 WASMEDGE_CAPI_EXPORT WasmEdge_Value WasmEdge_ValueGenI32(const int32_t Val) {
@@ -730,6 +769,181 @@ WasmEdge_ConfigureGetMaxMemoryPage(const WasmEdge_ConfigureContext *Cxt) {
   return 0;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetRegisterIR(WasmEdge_ConfigureContext *Cxt,
+                                const bool IsRegisterIR) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setRegisterIR(IsRegisterIR);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsRegisterIR(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isRegisterIR();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetInstructionFusion(WasmEdge_ConfigureContext *Cxt,
+                                       const bool IsFusion) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setInstructionFusion(IsFusion);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsInstructionFusion(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isInstructionFusion();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetLazyLoading(WasmEdge_ConfigureContext *Cxt,
+                                 const bool IsLazy) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setLazyLoading(IsLazy);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsLazyLoading(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isLazyLoading();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetLoadingThreads(WasmEdge_ConfigureContext *Cxt,
+                                    const uint32_t Threads) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setLoadingThreads(Threads);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetLoadingThreads(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getLoadingThreads();
+  }
+  return 1;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetModuleCaching(WasmEdge_ConfigureContext *Cxt,
+                                   const bool IsCaching) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setModuleCaching(IsCaching);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsModuleCaching(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isModuleCaching();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetJIT(WasmEdge_ConfigureContext *Cxt, const bool IsJIT) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setJIT(IsJIT);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsJIT(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isJIT();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetTiering(WasmEdge_ConfigureContext *Cxt,
+                             const bool IsTiering) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setTiering(IsTiering);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsTiering(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isTiering();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetTierUpCallThreshold(WasmEdge_ConfigureContext *Cxt,
+                                         const uint32_t Count) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setTierUpCallThreshold(Count);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetTierUpCallThreshold(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getTierUpCallThreshold();
+  }
+  return 1000;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetTierUpLoopThreshold(WasmEdge_ConfigureContext *Cxt,
+                                         const uint32_t Count) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setTierUpLoopThreshold(Count);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetTierUpLoopThreshold(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getTierUpLoopThreshold();
+  }
+  return 100000;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetTierUpThreads(WasmEdge_ConfigureContext *Cxt,
+                                   const uint32_t Threads) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setTierUpThreads(Threads);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetTierUpThreads(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getTierUpThreads();
+  }
+  return 1;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetProfiling(WasmEdge_ConfigureContext *Cxt,
+                               const bool IsProfiling) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setProfiling(IsProfiling);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsProfiling(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isProfiling();
+  }
+  return false;
+}
+
 WASMEDGE_CAPI_EXPORT void WasmEdge_ConfigureCompilerSetOptimizationLevel(
     WasmEdge_ConfigureContext *Cxt,
     const enum WasmEdge_CompilerOptimizationLevel Level) {
@@ -816,6 +1030,38 @@ WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureCompilerIsInterruptible(
   return false;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureCompilerSetJobs(WasmEdge_ConfigureContext *Cxt,
+                                  const uint32_t Jobs) {
+  if (Cxt) {
+    Cxt->Conf.getCompilerConfigure().setJobs(Jobs);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureCompilerGetJobs(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getCompilerConfigure().getJobs();
+  }
+  return 1;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureCompilerSetObjectCaching(WasmEdge_ConfigureContext *Cxt,
+                                           const bool IsCaching) {
+  if (Cxt) {
+    Cxt->Conf.getCompilerConfigure().setObjectCaching(IsCaching);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureCompilerIsObjectCaching(
+    const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getCompilerConfigure().isObjectCaching();
+  }
+  return false;
+}
+
 WASMEDGE_CAPI_EXPORT void WasmEdge_ConfigureStatisticsSetInstructionCounting(
     WasmEdge_ConfigureContext *Cxt, const bool IsCount) {
   if (Cxt) {
@@ -863,6 +1109,38 @@ WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureStatisticsIsTimeMeasuring(
   return false;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureStatisticsSetFusionCounting(WasmEdge_ConfigureContext *Cxt,
+                                              const bool IsCount) {
+  if (Cxt) {
+    Cxt->Conf.getStatisticsConfigure().setFusionCounting(IsCount);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureStatisticsIsFusionCounting(
+    const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getStatisticsConfigure().isFusionCounting();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureStatisticsSetTierUpCounting(WasmEdge_ConfigureContext *Cxt,
+                                              const bool IsCount) {
+  if (Cxt) {
+    Cxt->Conf.getStatisticsConfigure().setTierUpCounting(IsCount);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureStatisticsIsTierUpCounting(
+    const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getStatisticsConfigure().isTierUpCounting();
+  }
+  return false;
+}
+
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_ConfigureDelete(WasmEdge_ConfigureContext *Cxt) {
   delete Cxt;
@@ -1494,6 +1772,42 @@ WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_LoaderParseFromBuffer(
       Module);
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_LoaderStreamContext *
+WasmEdge_LoaderStreamCreate(void) {
+  return new WasmEdge_LoaderStreamContext();
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_LoaderStreamPush(WasmEdge_LoaderStreamContext *Cxt,
+                          const uint8_t *Buf, const uint32_t BufLen) {
+  if (Cxt) {
+    return Cxt->Stream->push(genSpan(Buf, BufLen));
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_LoaderStreamFinish(WasmEdge_LoaderStreamContext *Cxt) {
+  if (Cxt) {
+    Cxt->Stream->finish();
+  }
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_LoaderStreamDelete(WasmEdge_LoaderStreamContext *Cxt) {
+  delete Cxt;
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_LoaderParseFromStream(WasmEdge_LoaderContext *Cxt,
+                               WasmEdge_ASTModuleContext **Module,
+                               WasmEdge_LoaderStreamContext *StreamCxt) {
+  return wrap(
+      [&]() { return fromLoaderCxt(Cxt)->parseModule(StreamCxt->Stream); },
+      [&](auto &&Res) { *Module = toASTModCxt((*Res).release()); }, Cxt,
+      Module, StreamCxt);
+}
+
 WASMEDGE_CAPI_EXPORT void WasmEdge_LoaderDelete(WasmEdge_LoaderContext *Cxt) {
   delete fromLoaderCxt(Cxt);
 }
@@ -1578,6 +1892,38 @@ WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorRegister(
       ModuleCxt, StoreCxt, ASTCxt);
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorCreateTemplate(
+    WasmEdge_ExecutorContext *Cxt,
+    WasmEdge_ModuleTemplateContext **TemplateCxt,
+    WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
+    const bool IsStarted) {
+  return wrap(
+      [&]() {
+        return fromExecutorCxt(Cxt)->createTemplate(
+            *fromStoreCxt(StoreCxt), *fromASTModCxt(ASTCxt), IsStarted);
+      },
+      [&](auto &&Res) { *TemplateCxt = toTmplCxt((*Res).release()); }, Cxt,
+      TemplateCxt, StoreCxt, ASTCxt);
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorInstantiateTemplate(
+    WasmEdge_ExecutorContext *Cxt, WasmEdge_ModuleInstanceContext **ModuleCxt,
+    WasmEdge_StoreContext *StoreCxt,
+    const WasmEdge_ModuleTemplateContext *TemplateCxt) {
+  return wrap(
+      [&]() {
+        return fromExecutorCxt(Cxt)->instantiateModule(
+            *fromStoreCxt(StoreCxt), *fromTmplCxt(TemplateCxt));
+      },
+      [&](auto &&Res) { *ModuleCxt = toModCxt((*Res).release()); }, Cxt,
+      ModuleCxt, StoreCxt, TemplateCxt);
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ModuleTemplateDelete(WasmEdge_ModuleTemplateContext *Cxt) {
+  delete fromTmplCxt(Cxt);
+}
+
 WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorRegisterImport(
     WasmEdge_ExecutorContext *Cxt, WasmEdge_StoreContext *StoreCxt,
     const WasmEdge_ModuleInstanceContext *ImportCxt) {
@@ -2627,6 +2973,13 @@ WASMEDGE_CAPI_EXPORT void WasmEdge_VMCleanup(WasmEdge_VMContext *Cxt) {
   }
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_VMStoreProfile(const WasmEdge_VMContext *Cxt, const char *Path) {
+  return wrap(
+      [&]() { return Cxt->VM.storeProfile(std::filesystem::absolute(Path)); },
+      EmptyThen, Cxt, Path);
+}
+
 WASMEDGE_CAPI_EXPORT uint32_t
 WasmEdge_VMGetFunctionListLength(const WasmEdge_VMContext *Cxt) {
   if (Cxt) {
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/functypeid.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace WasmEdge {
+
+namespace {
+
+/// The key is the param types and the return types separated by a byte which
+/// is not a value type.
+std::string makeKey(Span<const ValType> Params, Span<const ValType> Returns) {
+  std::string Key;
+  Key.reserve(Params.size() + Returns.size() + 1);
+  for (const auto &VType : Params) {
+    Key.push_back(static_cast<char>(VType));
+  }
+  Key.push_back('\0');
+  for (const auto &VType : Returns) {
+    Key.push_back(static_cast<char>(VType));
+  }
+  return Key;
+}
+
+} // namespace
+
+[[gnu::visibility("default")]] std::atomic<uint64_t> FuncInstGeneration = 0;
+
+[[gnu::visibility("default")]] uint32_t
+getFuncTypeID(Span<const ValType> Params,
+              Span<const ValType> Returns) noexcept {
+  static std::shared_mutex Mutex;
+  static std::unordered_map<std::string, uint32_t> IDs;
+
+  std::string Key = makeKey(Params, Returns);
+  {
+    std::shared_lock Lock(Mutex);
+    if (auto Iter = IDs.find(Key); Iter != IDs.end()) {
+      return Iter->second;
+    }
+  }
+  std::unique_lock Lock(Mutex);
+  const auto ID = static_cast<uint32_t>(IDs.size());
+  return IDs.try_emplace(std::move(Key), ID).first->second;
+}
+
+} // namespace WasmEdge
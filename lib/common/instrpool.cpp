@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "ast/instruction.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace WasmEdge {
+namespace AST {
+
+namespace {
+
+/// Size and alignment of the chunks. The entries larger than a chunk are
+/// allocated in the dedicated chunks with the same alignment.
+static inline constexpr const uint32_t kChunkSize = 16 * 1024;
+
+/// Header at the beginning of each chunk.
+struct alignas(16) ChunkHeader {
+  std::atomic<uint64_t> RefCnt;
+};
+
+/// Alignment of the entries.
+static inline constexpr const uint32_t kEntryAlign = 8;
+
+ChunkHeader *getHeader(const Byte *Ptr) noexcept {
+  // The chunks are aligned to their size, and the entries of the dedicated
+  // chunks start in the first chunk size.
+  const auto Addr = reinterpret_cast<uintptr_t>(Ptr) &
+                    ~static_cast<uintptr_t>(kChunkSize - 1);
+  return reinterpret_cast<ChunkHeader *>(Addr);
+}
+
+Byte *newChunk(size_t Size) {
+  void *Chunk = ::operator new(Size, std::align_val_t(kChunkSize));
+  new (Chunk) ChunkHeader{{1}};
+  return static_cast<Byte *>(Chunk);
+}
+
+void releaseChunk(ChunkHeader *Header) noexcept {
+  if (Header->RefCnt.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Header->~ChunkHeader();
+    ::operator delete(static_cast<void *>(Header),
+                      std::align_val_t(kChunkSize));
+  }
+}
+
+/// Chunk being allocated by the current thread. The arena holds a reference
+/// of the chunk until the chunk is full or the thread exits.
+struct Arena {
+  Byte *Chunk = nullptr;
+  uint32_t Used = 0;
+  ~Arena() noexcept {
+    if (Chunk) {
+      releaseChunk(reinterpret_cast<ChunkHeader *>(Chunk));
+    }
+  }
+};
+thread_local Arena CurrentArena;
+
+} // namespace
+
+// Allocate the entry. See "include/ast/instruction.h".
+Byte *Instruction::Pool::allocate(uint64_t Size) {
+  const uint32_t HeaderSize = sizeof(ChunkHeader);
+  if (Size > std::numeric_limits<size_t>::max() - HeaderSize - kEntryAlign) {
+    throw std::bad_alloc();
+  }
+  const size_t EntrySize = (static_cast<size_t>(Size) + kEntryAlign - 1) &
+                           ~static_cast<size_t>(kEntryAlign - 1);
+  Byte *Ptr = nullptr;
+  if (EntrySize > kChunkSize - HeaderSize) {
+    // The dedicated chunk is referenced by the entry only.
+    Ptr = newChunk(HeaderSize + EntrySize) + HeaderSize;
+  } else {
+    Arena &A = CurrentArena;
+    if (A.Chunk == nullptr || A.Used + EntrySize > kChunkSize) {
+      Byte *Chunk = newChunk(kChunkSize);
+      if (A.Chunk) {
+        releaseChunk(reinterpret_cast<ChunkHeader *>(A.Chunk));
+      }
+      A.Chunk = Chunk;
+      A.Used = HeaderSize;
+    }
+    Ptr = A.Chunk + A.Used;
+    A.Used += static_cast<uint32_t>(EntrySize);
+    // The entry holds a reference of the shared chunk.
+    getHeader(Ptr)->RefCnt.fetch_add(1, std::memory_order_relaxed);
+  }
+  std::memset(Ptr, 0, EntrySize);
+  return Ptr;
+}
+
+// Remove the reference. See "include/ast/instruction.h".
+void Instruction::Pool::release(const Byte *Ptr) noexcept {
+  releaseChunk(getHeader(Ptr));
+}
+
+} // namespace AST
+} // namespace WasmEdge
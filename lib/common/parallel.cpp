@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/parallel.h"
+
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace WasmEdge {
+
+uint32_t getParallelThreadNum(uint32_t Threads, uint32_t JobNum,
+                              uint32_t ChunkSize) noexcept {
+  // Not to start more workers than the processors or the chunks.
+  const uint32_t ChunkNum =
+      JobNum / ChunkSize + (JobNum % ChunkSize != 0 ? 1U : 0U);
+  Threads = std::min(Threads, ChunkNum);
+  if (const uint32_t HWThreads = std::thread::hardware_concurrency();
+      HWThreads > 0) {
+    Threads = std::min(Threads, HWThreads);
+  }
+  return Threads;
+}
+
+void runOnThreads(uint32_t Threads, const std::function<void()> &Work) {
+  std::vector<std::thread> Workers;
+  Workers.reserve(Threads > 0 ? Threads - 1 : 0);
+  for (uint32_t I = 1; I < Threads; ++I) {
+    try {
+      Workers.emplace_back(Work);
+    } catch (const std::system_error &) {
+      // Failed to create the thread. The rest chunks are taken by the started
+      // workers and the current thread.
+      break;
+    }
+  }
+  Work();
+  for (auto &T : Workers) {
+    T.join();
+  }
+}
+
+} // namespace WasmEdge
@@ -8,6 +8,7 @@
 #include "common/version.h"
 #include "driver/compiler.h"
 #include "loader/loader.h"
+#include "loader/profile.h"
 #include "po/argument_parser.h"
 #include "validator/validator.h"
 #include <cstdint>
@@ -44,6 +45,19 @@ int Compiler([[maybe_unused]] int Argc,
   PO::Option<PO::Toggle> ConfInterruptible(
       PO::Description("Generate a interruptible binary"sv));
 
+  PO::Option<uint32_t> ConfJobs(
+      PO::Description(
+          "Number of threads for compiling the partitions of the functions, default value is 1 for compiling in a single module"sv),
+      PO::MetaVar("JOBS"sv), PO::DefaultValue<uint32_t>(1));
+
+  PO::Option<std::string> ConfProfile(
+      PO::Description(
+          "Optimize the branches and the indirect calls with the profile file recorded by `wasmedge --profile-output`."sv),
+      PO::MetaVar("PROFILE"sv), PO::DefaultValue(std::string()));
+
+  PO::Option<PO::Toggle> ConfEnableObjectCache(PO::Description(
+      "Enable caching the compiled objects of the function fragments, and only recompile the fragments of the changed functions."sv));
+
   PO::Option<PO::Toggle> ConfEnableInstructionCounting(PO::Description(
       "Enable generating code for counting Wasm instructions executed."sv));
   PO::Option<PO::Toggle> ConfEnableGasMeasuring(PO::Description(
@@ -84,6 +98,9 @@ int Compiler([[maybe_unused]] int Argc,
            .add_option(SoName)
            .add_option("dump"sv, ConfDumpIR)
            .add_option("interruptible"sv, ConfInterruptible)
+           .add_option("jobs"sv, ConfJobs)
+           .add_option("profile"sv, ConfProfile)
+           .add_option("enable-object-cache"sv, ConfEnableObjectCache)
            .add_option("enable-instruction-count"sv,
                        ConfEnableInstructionCounting)
            .add_option("enable-gas-measuring"sv, ConfEnableGasMeasuring)
@@ -210,6 +227,12 @@ int Compiler([[maybe_unused]] int Argc,
     if (ConfInterruptible.value()) {
       Conf.getCompilerConfigure().setInterruptible(true);
     }
+    if (ConfJobs.value() > 1) {
+      Conf.getCompilerConfigure().setJobs(ConfJobs.value());
+    }
+    if (ConfEnableObjectCache.value()) {
+      Conf.getCompilerConfigure().setObjectCaching(true);
+    }
     if (ConfEnableAllStatistics.value()) {
       Conf.getStatisticsConfigure().setInstructionCounting(true);
       Conf.getStatisticsConfigure().setCostMeasuring(true);
@@ -233,6 +256,22 @@ int Compiler([[maybe_unused]] int Argc,
           CompilerConfigure::OutputFormat::Native);
     }
     AOT::Compiler Compiler(Conf);
+    Loader::ProfileFile Profile;
+    if (!ConfProfile.value().empty()) {
+      if (auto Res = Profile.load(std::filesystem::absolute(
+              std::filesystem::u8path(ConfProfile.value())));
+          !Res) {
+        const auto Err = static_cast<uint32_t>(Res.error());
+        spdlog::error("Load profile failed. Error code: {}", Err);
+        return EXIT_FAILURE;
+      }
+      if (const auto *Prof = Profile.find(Loader::ProfileFile::getKey(Data))) {
+        Compiler.setProfile(Prof);
+      } else {
+        spdlog::warn("No profile of the module is found, compile without "
+                     "the profile.");
+      }
+    }
     if (auto Res = Compiler.compile(Data, *Module, OutputPath); !Res) {
       const auto Err = static_cast<uint32_t>(Res.error());
       spdlog::error("Compilation failed. Error code: {}", Err);
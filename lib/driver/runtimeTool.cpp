@@ -87,6 +87,55 @@ int Tool(int Argc, const char *Argv[]) noexcept {
   PO::Option<PO::Toggle> ConfEnableAllStatistics(PO::Description(
       "Enable generating code for all statistics options include instruction counting, gas measuring, and execution time"sv));
 
+  PO::Option<PO::Toggle> ConfEnableRegisterIR(PO::Description(
+      "Enable lowering functions into the register-based IR for the interpreter."sv));
+
+  PO::Option<PO::Toggle> ConfEnableInstrFusion(PO::Description(
+      "Enable fusing common instruction sequences into superinstructions for the interpreter."sv));
+
+  PO::Option<PO::Toggle> ConfEnableLazyLoading(PO::Description(
+      "Enable decoding and validating function bodies on their first calls."sv));
+
+  PO::Option<uint32_t> LoadingThreads(
+      PO::Description(
+          "Number of threads for decoding and validating the function bodies, default value is 1 for handling sequentially"sv),
+      PO::MetaVar("THREADS"sv), PO::DefaultValue<uint32_t>(1));
+
+  PO::Option<PO::Toggle> ConfEnableModuleCache(PO::Description(
+      "Enable caching the validated modules for skipping loading and validation of the same binaries."sv));
+
+  PO::Option<PO::Toggle> ConfEnableJIT(PO::Description(
+      "Enable compiling the validated modules in memory with the LLVM JIT instead of interpreting them."sv));
+
+  PO::Option<PO::Toggle> ConfEnableTiering(PO::Description(
+      "Enable compiling the hot functions in the background with the LLVM JIT while interpreting them."sv));
+
+  PO::Option<uint32_t> TierUpCallThreshold(
+      PO::Description(
+          "Call count of a function to be compiled in the tiered execution, default value is 1000"sv),
+      PO::MetaVar("COUNT"sv), PO::DefaultValue<uint32_t>(1000));
+
+  PO::Option<uint32_t> TierUpLoopThreshold(
+      PO::Description(
+          "Taken loop back-edge count of a function to be compiled in the tiered execution, default value is 100000"sv),
+      PO::MetaVar("COUNT"sv), PO::DefaultValue<uint32_t>(100000));
+
+  PO::Option<uint32_t> TierUpThreads(
+      PO::Description(
+          "Number of threads for compiling the hot functions in the tiered execution, default value is 1"sv),
+      PO::MetaVar("THREADS"sv), PO::DefaultValue<uint32_t>(1));
+
+  PO::Option<std::string> ProfileOutput(
+      PO::Description(
+          "Record the branches and the indirect call targets, and merge them into the profile file for the AOT compiler after the execution."sv),
+      PO::MetaVar("PATH"sv), PO::DefaultValue(std::string()));
+
+  PO::Option<PO::Toggle> ConfEnableFusionCounting(PO::Description(
+      "Enable counting the executed fused instructions in the statistics."sv));
+
+  PO::Option<PO::Toggle> ConfEnableTierUpCounting(PO::Description(
+      "Enable counting the functions compiled by the tiered execution in the statistics."sv));
+
   PO::Option<uint64_t> TimeLim(
       PO::Description(
           "Limitation of maximum time(in milliseconds) for execution, default value is 0 for no limitations"sv),
@@ -115,6 +164,19 @@ int Tool(int Argc, const char *Argv[]) noexcept {
       .add_option("enable-gas-measuring"sv, ConfEnableGasMeasuring)
       .add_option("enable-time-measuring"sv, ConfEnableTimeMeasuring)
       .add_option("enable-all-statistics"sv, ConfEnableAllStatistics)
+      .add_option("enable-register-ir"sv, ConfEnableRegisterIR)
+      .add_option("enable-instruction-fusion"sv, ConfEnableInstrFusion)
+      .add_option("enable-fusion-count"sv, ConfEnableFusionCounting)
+      .add_option("enable-tier-up-count"sv, ConfEnableTierUpCounting)
+      .add_option("enable-lazy-loading"sv, ConfEnableLazyLoading)
+      .add_option("loading-threads"sv, LoadingThreads)
+      .add_option("enable-module-cache"sv, ConfEnableModuleCache)
+      .add_option("enable-jit"sv, ConfEnableJIT)
+      .add_option("enable-tiering"sv, ConfEnableTiering)
+      .add_option("tier-up-call-threshold"sv, TierUpCallThreshold)
+      .add_option("tier-up-loop-threshold"sv, TierUpLoopThreshold)
+      .add_option("tier-up-threads"sv, TierUpThreads)
+      .add_option("profile-output"sv, ProfileOutput)
       .add_option("disable-import-export-mut-globals"sv, PropMutGlobals)
       .add_option("disable-non-trap-float-to-int"sv, PropNonTrapF2IConvs)
       .add_option("disable-sign-extension-operators"sv, PropSignExtendOps)
@@ -212,6 +274,42 @@ int Tool(int Argc, const char *Argv[]) noexcept {
       Conf.getStatisticsConfigure().setTimeMeasuring(true);
     }
   }
+  if (ConfEnableFusionCounting.value()) {
+    Conf.getStatisticsConfigure().setFusionCounting(true);
+  }
+  if (ConfEnableTierUpCounting.value()) {
+    Conf.getStatisticsConfigure().setTierUpCounting(true);
+  }
+
+  if (ConfEnableRegisterIR.value()) {
+    Conf.getRuntimeConfigure().setRegisterIR(true);
+  }
+  if (ConfEnableInstrFusion.value()) {
+    Conf.getRuntimeConfigure().setInstructionFusion(true);
+  }
+  if (ConfEnableLazyLoading.value()) {
+    Conf.getRuntimeConfigure().setLazyLoading(true);
+  }
+  if (LoadingThreads.value() > 1) {
+    Conf.getRuntimeConfigure().setLoadingThreads(LoadingThreads.value());
+  }
+  if (ConfEnableModuleCache.value()) {
+    Conf.getRuntimeConfigure().setModuleCaching(true);
+  }
+  if (ConfEnableJIT.value()) {
+    Conf.getRuntimeConfigure().setJIT(true);
+  }
+  if (ConfEnableTiering.value()) {
+    Conf.getRuntimeConfigure().setTiering(true);
+    Conf.getRuntimeConfigure().setTierUpCallThreshold(
+        TierUpCallThreshold.value());
+    Conf.getRuntimeConfigure().setTierUpLoopThreshold(
+        TierUpLoopThreshold.value());
+    Conf.getRuntimeConfigure().setTierUpThreads(TierUpThreads.value());
+  }
+  if (!ProfileOutput.value().empty()) {
+    Conf.getRuntimeConfigure().setProfiling(true);
+  }
 
   for (const auto &Name : ForbiddenPlugins.value()) {
     Conf.addForbiddenPlugins(Name);
@@ -238,6 +336,15 @@ int Tool(int Argc, const char *Argv[]) noexcept {
           .u8string(),
       Args.value(), Env.value());
 
+  // Write the profiles of the executed functions, even if the execution
+  // failed. The errors are logged and ignored.
+  auto StoreProfile = [&]() {
+    if (!ProfileOutput.value().empty()) {
+      VM.storeProfile(std::filesystem::absolute(
+          std::filesystem::u8path(ProfileOutput.value())));
+    }
+  };
+
   if (!Reactor.value()) {
     // command mode
     auto AsyncResult = VM.asyncRunWasmFile(InputPath.u8string(), "_start");
@@ -246,8 +353,9 @@ int Tool(int Argc, const char *Argv[]) noexcept {
         AsyncResult.cancel();
       }
     }
-    if (auto Result = AsyncResult.get();
-        Result || Result.error() == ErrCode::Value::Terminated) {
+    auto Result = AsyncResult.get();
+    StoreProfile();
+    if (Result || Result.error() == ErrCode::Value::Terminated) {
       return static_cast<int>(WasiMod->getEnv().getExitCode());
     } else {
       return EXIT_FAILURE;
@@ -349,7 +457,9 @@ int Tool(int Argc, const char *Argv[]) noexcept {
         AsyncResult.cancel();
       }
     }
-    if (auto Result = AsyncResult.get()) {
+    auto Result = AsyncResult.get();
+    StoreProfile();
+    if (Result) {
       /// Print results.
       for (size_t I = 0; I < Result->size(); ++I) {
         switch ((*Result)[I].second) {
@@ -20,11 +20,9 @@ Expect<void> Executor::runIfElseOp(Runtime::StackManager &StackMgr,
       // No else-statement case. Jump to right before End instruction.
       PC += (Instr.getJumpEnd() - 1);
     } else {
+      // The cost of the Else instruction is charged in the execution loop.
       if (Stat) {
         Stat->incInstrCount();
-        if (unlikely(!Stat->addInstrCost(OpCode::Else))) {
-          return Unexpect(ErrCode::Value::CostLimitExceeded);
-        }
       }
       // Have else-statement case. Jump to Else instruction to continue.
       PC += Instr.getJumpElse();
@@ -36,9 +34,9 @@ Expect<void> Executor::runIfElseOp(Runtime::StackManager &StackMgr,
 Expect<void> Executor::runBrOp(Runtime::StackManager &StackMgr,
                                const AST::Instruction &Instr,
                                AST::InstrView::iterator &PC) noexcept {
-  return branchToLabel(StackMgr, Instr.getJump().StackEraseBegin,
-                       Instr.getJump().StackEraseEnd, Instr.getJump().PCOffset,
-                       PC);
+  const auto Jump = Instr.getJump();
+  return branchToLabel(StackMgr, Jump.StackEraseBegin, Jump.StackEraseEnd,
+                       Jump.PCOffset, PC);
 }
 
 Expect<void> Executor::runBrIfOp(Runtime::StackManager &StackMgr,
@@ -102,10 +100,6 @@ Expect<void> Executor::runCallIndirectOp(Runtime::StackManager &StackMgr,
   // Get Table Instance
   const auto *TabInst = getTabInstByIdx(StackMgr, Instr.getSourceIndex());
 
-  // Get function type at index x.
-  const auto *ModInst = StackMgr.getModule();
-  const auto *TargetFuncType = *ModInst->getFuncType(Instr.getTargetIndex());
-
   // Pop the value i32.const i from the Stack.
   uint32_t Idx = StackMgr.pop().get<uint32_t>();
 
@@ -128,18 +122,28 @@ Expect<void> Executor::runCallIndirectOp(Runtime::StackManager &StackMgr,
     return Unexpect(ErrCode::Value::UninitializedElement);
   }
 
-  // Check function type.
+  // Check function type. The callee which passed the check at this call site
+  // last time is cached and skips the check.
+  const auto *ModInst = StackMgr.getModule();
   const auto *FuncInst = retrieveFuncRef(Ref);
-  const auto &FuncType = FuncInst->getFuncType();
-  if (*TargetFuncType != FuncType) {
-    spdlog::error(ErrCode::Value::IndirectCallTypeMismatch);
-    spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset(),
-                                           {Idx},
-                                           {ValTypeFromType<uint32_t>()}));
-    spdlog::error(ErrInfo::InfoMismatch(
-        TargetFuncType->getParamTypes(), TargetFuncType->getReturnTypes(),
-        FuncType.getParamTypes(), FuncType.getReturnTypes()));
-    return Unexpect(ErrCode::Value::IndirectCallTypeMismatch);
+  auto &Cache = ModInst->getCallCache(Instr.getCallCacheIndex());
+  if (!Cache.isHit(FuncInst)) {
+    const uint64_t Gen = FuncInstGeneration.load(std::memory_order_relaxed);
+    if (*ModInst->getFuncTypeID(Instr.getTargetIndex()) !=
+        FuncInst->getFuncTypeID()) {
+      const auto *TargetFuncType =
+          *ModInst->getFuncType(Instr.getTargetIndex());
+      const auto &FuncType = FuncInst->getFuncType();
+      spdlog::error(ErrCode::Value::IndirectCallTypeMismatch);
+      spdlog::error(ErrInfo::InfoInstruction(
+          Instr.getOpCode(), Instr.getOffset(), {Idx},
+          {ValTypeFromType<uint32_t>()}));
+      spdlog::error(ErrInfo::InfoMismatch(
+          TargetFuncType->getParamTypes(), TargetFuncType->getReturnTypes(),
+          FuncType.getParamTypes(), FuncType.getReturnTypes()));
+      return Unexpect(ErrCode::Value::IndirectCallTypeMismatch);
+    }
+    Cache.fill(FuncInst, Gen);
   }
 
   // Enter the function.
@@ -3,15 +3,168 @@
 
 #include "executor/executor.h"
 
+#include "common/log.h"
+#include "experimental/scope.hpp"
+#include "system/fault.h"
+
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <utility>
 
 namespace WasmEdge {
 namespace Executor {
 
+thread_local uint64_t Executor::PendingCost = 0;
+thread_local const AST::Instruction *Executor::PendingTrip = nullptr;
+thread_local Executor::ExecutingCodeStruct Executor::ExecutingCode = {};
+
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+namespace {
+
+/// Get the access length of the memory instructions skipping the bounds checks
+/// on the guarded memories. Return 0 for the other instructions.
+uint32_t getGuardedAccessLength(OpCode Code) noexcept {
+  // Lengths of the instructions from `i32.load` to `i64.store32`.
+  static constexpr const std::array<uint8_t, 23> Lengths = {
+      4, 8, 4, 8, 1, 1, 2, 2, 1, 1, 2, 2, 4, 4, 4, 8, 4, 8, 1, 2, 1, 2, 4};
+  const uint32_t Idx = static_cast<uint32_t>(Code) -
+                       static_cast<uint32_t>(OpCode::I32__load);
+  return Idx < Lengths.size() ? Lengths[Idx] : 0;
+}
+
+} // namespace
+#endif
+
+#ifdef WASMEDGE_USE_THREADED_DISPATCH
+namespace {
+
+/// Instructions which have their own handler in the threaded dispatch loop.
+/// All the other instructions are forwarded to the switch-based dispatcher.
+#define WASMEDGE_THREADED_OPCODES(X)                                           \
+  X(Nop)                                                                       \
+  X(Block)                                                                     \
+  X(Loop)                                                                      \
+  X(If)                                                                        \
+  X(End)                                                                       \
+  X(Br)                                                                        \
+  X(Br_if)                                                                     \
+  X(Br_table)                                                                  \
+  X(Return)                                                                    \
+  X(Call)                                                                      \
+  X(Call_indirect)                                                             \
+  X(Drop)                                                                      \
+  X(Select)                                                                    \
+  X(Local__get)                                                                \
+  X(Local__set)                                                                \
+  X(Local__tee)                                                                \
+  X(Global__get)                                                               \
+  X(Global__set)                                                               \
+  X(I32__load)                                                                 \
+  X(I64__load)                                                                 \
+  X(I32__load8_u)                                                              \
+  X(I32__store)                                                                \
+  X(I64__store)                                                                \
+  X(I32__store8)                                                               \
+  X(I32__const)                                                                \
+  X(I64__const)                                                                \
+  X(F32__const)                                                                \
+  X(F64__const)                                                                \
+  X(I32__eqz)                                                                  \
+  X(I32__eq)                                                                   \
+  X(I32__ne)                                                                   \
+  X(I32__lt_s)                                                                 \
+  X(I32__lt_u)                                                                 \
+  X(I32__gt_s)                                                                 \
+  X(I32__gt_u)                                                                 \
+  X(I32__le_s)                                                                 \
+  X(I32__le_u)                                                                 \
+  X(I32__ge_s)                                                                 \
+  X(I32__ge_u)                                                                 \
+  X(I64__eqz)                                                                  \
+  X(I64__eq)                                                                   \
+  X(I64__ne)                                                                   \
+  X(I64__lt_s)                                                                 \
+  X(I64__lt_u)                                                                 \
+  X(I64__gt_s)                                                                 \
+  X(I64__gt_u)                                                                 \
+  X(I32__add)                                                                  \
+  X(I32__sub)                                                                  \
+  X(I32__mul)                                                                  \
+  X(I32__and)                                                                  \
+  X(I32__or)                                                                   \
+  X(I32__xor)                                                                  \
+  X(I32__shl)                                                                  \
+  X(I32__shr_s)                                                                \
+  X(I32__shr_u)                                                                \
+  X(I64__add)                                                                  \
+  X(I64__sub)                                                                  \
+  X(I64__mul)                                                                  \
+  X(I64__and)                                                                  \
+  X(I64__or)                                                                   \
+  X(I64__xor)                                                                  \
+  X(I64__shl)                                                                  \
+  X(I64__shr_s)                                                                \
+  X(I64__shr_u)                                                                \
+  X(I32__wrap_i64)                                                             \
+  X(I64__extend_i32_s)                                                         \
+  X(I64__extend_i32_u)                                                         \
+  X(Fused__local_get_local_get)                                                \
+  X(Fused__local_get_local_get_i32_add)                                        \
+  X(Fused__local_get_i32_const_i32_add)                                        \
+  X(Fused__local_get_i32_const_i32_add_local_set)                              \
+  X(Fused__i32_const_br_if)
+
+/// Indices of the handlers. Index 0 is the fallback handler which forwards to
+/// the switch-based dispatcher.
+enum ThreadedHandler : uint8_t {
+  Threaded_Fallback = 0,
+#define X(NAME) Threaded_##NAME,
+  WASMEDGE_THREADED_OPCODES(X)
+#undef X
+};
+
+/// Get the index of the handler of the opcode.
+uint8_t getThreadedHandlerIndex(OpCode Code) noexcept {
+  switch (Code) {
+#define X(NAME)                                                                \
+  case OpCode::NAME:                                                           \
+    return Threaded_##NAME;
+    WASMEDGE_THREADED_OPCODES(X)
+#undef X
+  default:
+    return Threaded_Fallback;
+  }
+}
+
+} // namespace
+#endif
+
+// Assign the threaded dispatch handlers. See "include/executor/executor.h".
+void Executor::threadInstructions(
+    [[maybe_unused]] Runtime::Instance::FunctionInstance &Func) const {
+#ifdef WASMEDGE_USE_THREADED_DISPATCH
+  // The handler index is stored in the instruction, so that the dispatch jumps
+  // to the handler without looking up the opcode.
+  for (auto &Instr : Func.getMutableInstrs()) {
+    Instr.setHandlerIndex(getThreadedHandlerIndex(Instr.getOpCode()));
+  }
+#endif
+}
+
 Expect<void> Executor::runExpression(Runtime::StackManager &StackMgr,
                                      AST::InstrView Instrs) {
+  // The constant expressions have no precomputed block costs. Charge the
+  // instructions here.
+  if (Stat && Conf.getStatisticsConfigure().isCostMeasuring()) {
+    for (const auto &Instr : Instrs) {
+      if (unlikely(!Stat->addInstrCost(Instr.getOpCode()))) {
+        spdlog::error(
+            ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+        return Unexpect(ErrCode::Value::CostLimitExceeded);
+      }
+    }
+  }
   return execute(StackMgr, Instrs.begin(), Instrs.end());
 }
 
@@ -24,6 +177,57 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
     Stat->startRecordWasm();
   }
 
+#if WASMEDGE_GUARDED_VALUE_STACK || WASMEDGE_GUARDED_LINEAR_MEMORY
+  // The value stack overflow and the out-of-bounds memory accesses hit the
+  // guard regions and raise the fault. The access violations elsewhere, such
+  // as the ones in the host functions, are not caught here.
+#if WASMEDGE_GUARDED_VALUE_STACK
+  Fault FaultHandler(StackMgr.getGuardBegin(), StackMgr.getGuardEnd());
+#else
+  Fault FaultHandler;
+#endif
+  const uint32_t CallDepth = RegisterCallDepth;
+  // Publish the guarded execution, and restore the running loop of the
+  // enclosing execution, which is left by the fault without its restoring.
+  const bool EnclosingGuarded = Fault::exchangeGuarded(true);
+  const auto *EnclosingPC = Fault::exchangeProgramCounter(nullptr);
+  const ExecutingCodeStruct EnclosingCode = ExecutingCode;
+  cxx20::scope_exit ExecutingPCHolder([&]() noexcept {
+    Fault::exchangeGuarded(EnclosingGuarded);
+    Fault::exchangeProgramCounter(EnclosingPC);
+    ExecutingCode = EnclosingCode;
+  });
+  if (uint32_t Code = PREPARE_FAULT(FaultHandler); unlikely(Code != 0)) {
+    const AST::Instruction *Instr =
+        getExecutingInstr(FaultHandler.programCounter());
+    const auto Err = ErrCode(static_cast<ErrCategory>(Code >> 24), Code);
+    spdlog::error(Err.getEnum());
+    // Only the out-of-bounds access skipping the bounds check is known to be
+    // the faulting instruction.
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+    if (Err != ErrCode::Value::MemoryOutOfBounds ||
+        !isGuardedAccess(StackMgr, Instr, FaultHandler.address())) {
+      Instr = nullptr;
+    }
+#else
+    Instr = nullptr;
+#endif
+    RegisterCallDepth = CallDepth;
+    // The fault leaves the execution loop without syncing the cost charged in
+    // the current block. The faults of the instructions other than the
+    // faulting access keep the whole cost of the block.
+    if (Stat && Conf.getStatisticsConfigure().isCostMeasuring()) {
+      syncTrapCost(Instr, std::exchange(PendingTrip, nullptr));
+    }
+    if (Stat && Conf.getStatisticsConfigure().isTimeMeasuring()) {
+      Stat->stopRecordWasm();
+    }
+    StackMgr.reset();
+    return Unexpect(Err);
+  }
+#endif
+  PendingTrip = nullptr;
+
   // Reset and push a dummy frame into stack.
   StackMgr.pushFrame(nullptr, AST::InstrView::iterator(), 0, 0);
 
@@ -32,6 +236,14 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
     StackMgr.push(Val);
   }
 
+  // Prepare the function body deferred by the lazy loading before getting the
+  // instructions.
+  if (unlikely(Func.isPending())) {
+    if (auto Res = prepareFunction(Func); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+  }
+
   // Enter and execute function.
   AST::InstrView::iterator StartIt;
   Expect<void> Res = {};
@@ -77,13 +289,135 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
   return Unexpect(Res);
 }
 
+const AST::Instruction *
+Executor::getExecutingInstr(const void *ProgramCounter) noexcept {
+  if (ProgramCounter == nullptr) {
+    return nullptr;
+  } else if (ExecutingCode.Code == nullptr) {
+    return static_cast<const AST::Instruction *>(ProgramCounter);
+  } else {
+    const auto &Code = *ExecutingCode.Code;
+    const auto *PC =
+        static_cast<const Runtime::RegIR::Instruction *>(ProgramCounter);
+    return ExecutingCode.Origins +
+           Code.Origins[static_cast<uint32_t>(PC - Code.Instrs.data())];
+  }
+}
+
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+bool Executor::isGuardedAccess(Runtime::StackManager &StackMgr,
+                               const AST::Instruction *Instr,
+                               const void *Address) const noexcept {
+  // The faults of the other instructions, such as the calls into the compiled
+  // functions, are not rebuilt.
+  const uint32_t Length =
+      Instr ? getGuardedAccessLength(Instr->getOpCode()) : 0;
+  if (Length == 0) {
+    return false;
+  }
+  const auto *MemInst = getMemInstByIdx(StackMgr, Instr->getTargetIndex());
+  if (!MemInst->isGuarded()) {
+    return false;
+  }
+
+  // The EA is the fault address from the base of the memory, which is the
+  // first inaccessible byte of the access across the bound.
+  const uint64_t EA = reinterpret_cast<uintptr_t>(Address) -
+                      reinterpret_cast<uintptr_t>(MemInst->getDataPtr());
+  spdlog::error(ErrInfo::InfoBoundary(EA, Length, MemInst->getBoundIdx()));
+  spdlog::error(
+      ErrInfo::InfoInstruction(Instr->getOpCode(), Instr->getOffset()));
+  return true;
+}
+#endif
+
+Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
+                               const AST::InstrView::iterator Start,
+                               const AST::InstrView::iterator End) {
+  // Resolve the statistics policy once for the whole execution loop.
+  uint32_t Policy = kMeterNone;
+  if (Stat) {
+    const auto &StatConf = Conf.getStatisticsConfigure();
+    if (StatConf.isInstructionCounting()) {
+      Policy |= kMeterInstrCount;
+    }
+    if (StatConf.isCostMeasuring()) {
+      Policy |= kMeterCost;
+    }
+    if (StatConf.isFusionCounting()) {
+      Policy |= kMeterFusionCount;
+    }
+  }
+  if (Conf.getRuntimeConfigure().isProfiling()) {
+    Policy |= kMeterProfile;
+  }
+  static constexpr auto Loops =
+      makeExecuteLoops(std::make_integer_sequence<uint32_t, kMeterAll + 1>());
+  return (this->*Loops[Policy])(StackMgr, Start, End);
+}
+
+template <uint32_t Policy>
 Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
                                const AST::InstrView::iterator Start,
                                const AST::InstrView::iterator End) {
   AST::InstrView::iterator PC = Start;
   AST::InstrView::iterator PCEnd = End;
 
-  auto Dispatch = [this, &PC, &StackMgr]() -> Expect<void> {
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+  // Publish the program counter for finding the faulting memory access.
+  const auto *EnclosingPC = Fault::exchangeProgramCounter(
+      reinterpret_cast<const void *const *>(&PC));
+  const ExecutingCodeStruct EnclosingCode =
+      std::exchange(ExecutingCode, {nullptr, nullptr});
+  cxx20::scope_exit ExecutingPCHolder([&]() noexcept {
+    Fault::exchangeProgramCounter(EnclosingPC);
+    ExecutingCode = EnclosingCode;
+  });
+#endif
+
+  // The gas is charged by the precomputed block costs into the thread-local
+  // counter, which is checked against the remaining cost under the limit when
+  // last synced. Sync it into the statistics at the calls, the loops and the
+  // exit, where the fault exit is synced by `runFunction`.
+  //
+  // The block exceeding the remaining cost is charged until the instruction at
+  // which the per-instruction metering exceeds the limit, and traps there. The
+  // trap in a block returns the cost of the instructions not run after it.
+  uint64_t &LocalCost = PendingCost;
+  uint64_t RemainCost = 0;
+  uint64_t ElseCost = 0;
+  AST::InstrView::iterator TripPC = nullptr;
+  if constexpr ((Policy & kMeterCost) != 0) {
+    RemainCost = Stat->syncCost(0);
+    ElseCost = Stat->getCostTable()[static_cast<uint16_t>(OpCode::Else)];
+  }
+  cxx20::scope_exit SyncCostHolder([&]() noexcept {
+    if constexpr ((Policy & kMeterCost) != 0) {
+      syncTrapCost(PC != PCEnd ? PC : nullptr, TripPC);
+      PendingTrip = nullptr;
+    }
+  });
+  auto ChargeCost = [this, &PC, &LocalCost, &RemainCost](
+                        uint64_t Cost, bool IsSync) -> Expect<void> {
+    if (unlikely(LocalCost + Cost > RemainCost)) {
+      // Sync to get the latest total cost and check again.
+      RemainCost = Stat->syncCost(std::exchange(LocalCost, 0));
+      if (unlikely(Cost > RemainCost)) {
+        spdlog::error(ErrCode::Value::CostLimitExceeded);
+        spdlog::error(
+            ErrInfo::InfoInstruction(PC->getOpCode(), PC->getOffset()));
+        return Unexpect(ErrCode::Value::CostLimitExceeded);
+      }
+    }
+    LocalCost += Cost;
+    if (IsSync) {
+      RemainCost = Stat->syncCost(std::exchange(LocalCost, 0));
+    }
+    return {};
+  };
+
+  auto Dispatch = [this, &PC, &StackMgr, &ChargeCost,
+                   ElseCost]() -> Expect<void> {
     const AST::Instruction &Instr = *PC;
     switch (Instr.getOpCode()) {
     // Control instructions.
@@ -99,21 +433,19 @@ Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
     case OpCode::Loop:
       return {};
     case OpCode::If:
-      return runIfElseOp(StackMgr, Instr, PC);
-    case OpCode::Else:
-      if (Stat && Conf.getStatisticsConfigure().isCostMeasuring()) {
-        // Reach here means end of if-statement.
-        if (unlikely(!Stat->subInstrCost(Instr.getOpCode()))) {
-          spdlog::error(
-              ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-          return Unexpect(ErrCode::Value::CostLimitExceeded);
-        }
-        if (unlikely(!Stat->addInstrCost(OpCode::End))) {
-          spdlog::error(
-              ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-          return Unexpect(ErrCode::Value::CostLimitExceeded);
+      if (auto Res = runIfElseOp(StackMgr, Instr, PC); unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+      if constexpr ((Policy & kMeterCost) != 0) {
+        // Charge the Else instruction when jumping to the else-statement.
+        if (PC->getOpCode() == OpCode::Else) {
+          return ChargeCost(ElseCost, false);
         }
       }
+      return {};
+    case OpCode::Else:
+      // Reach here means end of if-statement. The block cost has already
+      // counted the End instruction instead of this one.
       PC += PC->getJumpEnd();
       [[fallthrough]];
     case OpCode::End:
@@ -1806,33 +2138,308 @@ Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
       return runAtomicCompareExchangeOp<uint64_t, uint32_t>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
 
+    // Fused instructions.
+    case OpCode::Fused__local_get_local_get:
+      return runFusedLocalGetLocalGetOp(StackMgr, PC);
+    case OpCode::Fused__local_get_local_get_i32_add:
+      return runFusedLocalGetLocalGetAddOp(StackMgr, PC);
+    case OpCode::Fused__local_get_i32_const_i32_add:
+      return runFusedLocalGetConstAddOp(StackMgr, PC);
+    case OpCode::Fused__local_get_i32_const_i32_add_local_set:
+      return runFusedLocalGetConstAddSetOp(StackMgr, PC);
+    case OpCode::Fused__i32_const_br_if:
+      return runFusedConstBrIfOp(StackMgr, PC);
+
     default:
       return {};
     }
   };
 
-  while (PC != PCEnd) {
-    if (Stat) {
-      OpCode Code = PC->getOpCode();
-      if (Conf.getStatisticsConfigure().isInstructionCounting()) {
-        Stat->incInstrCount();
+  // Charge the block led by the instruction. Find the instruction exceeding
+  // the limit if the whole block cannot be charged.
+  auto ChargeBlock = [this, &PC, &LocalCost, &RemainCost, &TripPC,
+                      &ChargeCost](uint64_t Cost) -> Expect<void> {
+    if (likely(LocalCost + Cost <= RemainCost)) {
+      return ChargeCost(Cost, PC->isBlockSync());
+    }
+    RemainCost = Stat->syncCost(std::exchange(LocalCost, 0));
+    if (Cost <= RemainCost) {
+      return ChargeCost(Cost, PC->isBlockSync());
+    }
+    uint64_t Prefix = 0;
+    if (const auto *Trip = findBlockTrip(PC, RemainCost, Prefix)) {
+      TripPC = PendingTrip = Trip;
+      if (TripPC == PC) {
+        return ChargeCost(Cost, false);
+      }
+      RemainCost = Stat->syncCost(Prefix);
+      return {};
+    }
+    return ChargeCost(Cost, PC->isBlockSync());
+  };
+
+  // Count and measure the instruction by the statistics policy.
+  auto Meter = [this, &PC, &StackMgr, &ChargeCost, &ChargeBlock,
+                &TripPC]() -> Expect<void> {
+    if constexpr ((Policy & kMeterInstrCount) != 0) {
+      Stat->incInstrCount();
+    }
+    // Add cost of the block led by this instruction. Note: if-else case
+    // should be processed additionally.
+    if constexpr ((Policy & kMeterCost) != 0) {
+      if (unlikely(PC == TripPC)) {
+        return ChargeCost(getBlockInstrCost(PC->getOpCode()), false);
       }
-      // Add cost. Note: if-else case should be processed additionally.
-      if (Conf.getStatisticsConfigure().isCostMeasuring()) {
-        if (unlikely(!Stat->addInstrCost(Code))) {
-          const AST::Instruction &Instr = *PC;
-          spdlog::error(
-              ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-          return Unexpect(ErrCode::Value::CostLimitExceeded);
+      if (const uint32_t Cost = PC->getBlockCost(); Cost != 0) {
+        if (auto Res = ChargeBlock(Cost); unlikely(!Res)) {
+          return Unexpect(Res);
         }
       }
     }
-    if (auto Res = Dispatch(); !Res) {
-      return Unexpect(Res);
+    if constexpr ((Policy & kMeterFusionCount) != 0) {
+      if (static_cast<uint16_t>(PC->getOpCode()) >= FusedOpCodeBegin) {
+        Stat->incFusionCount(PC->getOpCode());
+      }
     }
-    PC++;
+    if constexpr ((Policy & kMeterProfile) != 0) {
+      recordProfile(StackMgr, *PC);
+    }
+    return {};
+  };
+
+  // The switch-based dispatch loop, which is also the reference of the
+  // threaded dispatch.
+  auto SwitchLoop = [&]() -> Expect<void> {
+    while (PC != PCEnd) {
+      if constexpr (Policy != kMeterNone) {
+        if (auto Res = Meter(); unlikely(!Res)) {
+          return Unexpect(Res);
+        }
+      }
+      if (auto Res = Dispatch(); !Res) {
+        return Unexpect(Res);
+      }
+      PC++;
+    }
+    return {};
+  };
+
+#ifdef WASMEDGE_USE_THREADED_DISPATCH
+  if (!Conf.getRuntimeConfigure().isThreadedDispatch()) {
+    return SwitchLoop();
+  }
+
+  // Handler addresses, in the same order as `ThreadedHandler`.
+  static const void *const Handlers[] = {
+      &&Fallback,
+#define X(NAME) &&Op_##NAME,
+      WASMEDGE_THREADED_OPCODES(X)
+#undef X
+  };
+
+  // Every handler ends with its own copy of the dispatch sequence, so that the
+  // indirect branches are predicted per instruction instead of sharing the
+  // single branch of the switch.
+#define DISPATCH()                                                             \
+  do {                                                                         \
+    if (unlikely(PC == PCEnd)) {                                               \
+      return {};                                                               \
+    }                                                                          \
+    if constexpr (Policy != kMeterNone) {                                      \
+      if (auto Res = Meter(); unlikely(!Res)) {                                \
+        return Unexpect(Res);                                                  \
+      }                                                                        \
+    }                                                                          \
+    goto *Handlers[PC->getHandlerIndex()];                                     \
+  } while (false)
+#define NEXT()                                                                 \
+  ++PC;                                                                        \
+  DISPATCH()
+#define CHECK(EXPR)                                                            \
+  if (auto Res = (EXPR); unlikely(!Res)) {                                     \
+    return Unexpect(Res);                                                      \
+  }
+#define UNARY_OP(NAME, FUNC)                                                   \
+  Op_##NAME: {                                                                 \
+    CHECK(FUNC(StackMgr.getTop()));                                            \
+    NEXT();                                                                    \
+  }
+#define BINARY_OP(NAME, FUNC)                                                  \
+  Op_##NAME: {                                                                 \
+    ValVariant Rhs = StackMgr.pop();                                           \
+    CHECK(FUNC(StackMgr.getTop(), Rhs));                                       \
+    NEXT();                                                                    \
   }
-  return {};
+#define MEMORY_OP(NAME, FUNC)                                                  \
+  Op_##NAME: {                                                                 \
+    CHECK(FUNC(StackMgr, *getMemInstByIdx(StackMgr, PC->getTargetIndex()),     \
+               *PC));                                                          \
+    NEXT();                                                                    \
+  }
+
+  DISPATCH();
+
+Fallback:
+  CHECK(Dispatch());
+  NEXT();
+
+  // Control instructions.
+Op_Nop:
+Op_Block:
+Op_Loop:
+  NEXT();
+Op_If:
+  CHECK(runIfElseOp(StackMgr, *PC, PC));
+  if constexpr ((Policy & kMeterCost) != 0) {
+    // Charge the Else instruction when jumping to the else-statement.
+    if (PC->getOpCode() == OpCode::Else) {
+      CHECK(ChargeCost(ElseCost, false));
+    }
+  }
+  NEXT();
+Op_End:
+  PC = StackMgr.maybePopFrame(PC);
+  NEXT();
+Op_Br:
+  CHECK(runBrOp(StackMgr, *PC, PC));
+  NEXT();
+Op_Br_if:
+  CHECK(runBrIfOp(StackMgr, *PC, PC));
+  NEXT();
+Op_Br_table:
+  CHECK(runBrTableOp(StackMgr, *PC, PC));
+  NEXT();
+Op_Return:
+  CHECK(runReturnOp(StackMgr, PC));
+  NEXT();
+Op_Call:
+  CHECK(runCallOp(StackMgr, *PC, PC));
+  NEXT();
+Op_Call_indirect:
+  CHECK(runCallIndirectOp(StackMgr, *PC, PC));
+  NEXT();
+
+  // Parametric instructions.
+Op_Drop:
+  StackMgr.pop();
+  NEXT();
+Op_Select: {
+  ValVariant CondVal = StackMgr.pop();
+  ValVariant Val2 = StackMgr.pop();
+  if (CondVal.get<uint32_t>() == 0) {
+    StackMgr.getTop() = Val2;
+  }
+  NEXT();
+}
+
+  // Variable instructions.
+Op_Local__get:
+  StackMgr.push(StackMgr.getTopN(PC->getStackOffset()));
+  NEXT();
+Op_Local__set: {
+  const uint32_t StackOffset = PC->getStackOffset();
+  StackMgr.getTopN(StackOffset - 1) = StackMgr.pop();
+  NEXT();
+}
+Op_Local__tee: {
+  const ValVariant &Val = StackMgr.getTop();
+  StackMgr.getTopN(PC->getStackOffset()) = Val;
+  NEXT();
+}
+Op_Global__get:
+  CHECK(runGlobalGetOp(StackMgr, PC->getTargetIndex()));
+  NEXT();
+Op_Global__set:
+  CHECK(runGlobalSetOp(StackMgr, PC->getTargetIndex()));
+  NEXT();
+
+  // Memory instructions.
+  MEMORY_OP(I32__load, runLoadOp<uint32_t>)
+  MEMORY_OP(I64__load, runLoadOp<uint64_t>)
+  MEMORY_OP(I32__load8_u, (runLoadOp<uint32_t, 8>))
+  MEMORY_OP(I32__store, runStoreOp<uint32_t>)
+  MEMORY_OP(I64__store, runStoreOp<uint64_t>)
+  MEMORY_OP(I32__store8, (runStoreOp<uint32_t, 8>))
+
+  // Const numeric instructions.
+Op_I32__const:
+Op_I64__const:
+Op_F32__const:
+Op_F64__const:
+  StackMgr.push(PC->getNum());
+  NEXT();
+
+  // Test and relation numeric instructions.
+  UNARY_OP(I32__eqz, runEqzOp<uint32_t>)
+  BINARY_OP(I32__eq, runEqOp<uint32_t>)
+  BINARY_OP(I32__ne, runNeOp<uint32_t>)
+  BINARY_OP(I32__lt_s, runLtOp<int32_t>)
+  BINARY_OP(I32__lt_u, runLtOp<uint32_t>)
+  BINARY_OP(I32__gt_s, runGtOp<int32_t>)
+  BINARY_OP(I32__gt_u, runGtOp<uint32_t>)
+  BINARY_OP(I32__le_s, runLeOp<int32_t>)
+  BINARY_OP(I32__le_u, runLeOp<uint32_t>)
+  BINARY_OP(I32__ge_s, runGeOp<int32_t>)
+  BINARY_OP(I32__ge_u, runGeOp<uint32_t>)
+  UNARY_OP(I64__eqz, runEqzOp<uint64_t>)
+  BINARY_OP(I64__eq, runEqOp<uint64_t>)
+  BINARY_OP(I64__ne, runNeOp<uint64_t>)
+  BINARY_OP(I64__lt_s, runLtOp<int64_t>)
+  BINARY_OP(I64__lt_u, runLtOp<uint64_t>)
+  BINARY_OP(I64__gt_s, runGtOp<int64_t>)
+  BINARY_OP(I64__gt_u, runGtOp<uint64_t>)
+
+  // Binary numeric instructions.
+  BINARY_OP(I32__add, runAddOp<uint32_t>)
+  BINARY_OP(I32__sub, runSubOp<uint32_t>)
+  BINARY_OP(I32__mul, runMulOp<uint32_t>)
+  BINARY_OP(I32__and, runAndOp<uint32_t>)
+  BINARY_OP(I32__or, runOrOp<uint32_t>)
+  BINARY_OP(I32__xor, runXorOp<uint32_t>)
+  BINARY_OP(I32__shl, runShlOp<uint32_t>)
+  BINARY_OP(I32__shr_s, runShrOp<int32_t>)
+  BINARY_OP(I32__shr_u, runShrOp<uint32_t>)
+  BINARY_OP(I64__add, runAddOp<uint64_t>)
+  BINARY_OP(I64__sub, runSubOp<uint64_t>)
+  BINARY_OP(I64__mul, runMulOp<uint64_t>)
+  BINARY_OP(I64__and, runAndOp<uint64_t>)
+  BINARY_OP(I64__or, runOrOp<uint64_t>)
+  BINARY_OP(I64__xor, runXorOp<uint64_t>)
+  BINARY_OP(I64__shl, runShlOp<uint64_t>)
+  BINARY_OP(I64__shr_s, runShrOp<int64_t>)
+  BINARY_OP(I64__shr_u, runShrOp<uint64_t>)
+
+  // Cast numeric instructions.
+  UNARY_OP(I32__wrap_i64, (runWrapOp<uint64_t, uint32_t>))
+  UNARY_OP(I64__extend_i32_s, (runExtendOp<int32_t, uint64_t>))
+  UNARY_OP(I64__extend_i32_u, (runExtendOp<uint32_t, uint64_t>))
+
+  // Fused instructions.
+Op_Fused__local_get_local_get:
+  CHECK(runFusedLocalGetLocalGetOp(StackMgr, PC));
+  NEXT();
+Op_Fused__local_get_local_get_i32_add:
+  CHECK(runFusedLocalGetLocalGetAddOp(StackMgr, PC));
+  NEXT();
+Op_Fused__local_get_i32_const_i32_add:
+  CHECK(runFusedLocalGetConstAddOp(StackMgr, PC));
+  NEXT();
+Op_Fused__local_get_i32_const_i32_add_local_set:
+  CHECK(runFusedLocalGetConstAddSetOp(StackMgr, PC));
+  NEXT();
+Op_Fused__i32_const_br_if:
+  CHECK(runFusedConstBrIfOp(StackMgr, PC));
+  NEXT();
+
+#undef MEMORY_OP
+#undef BINARY_OP
+#undef UNARY_OP
+#undef CHECK
+#undef NEXT
+#undef DISPATCH
+#else
+  return SwitchLoop();
+#endif
 }
 
 } // namespace Executor
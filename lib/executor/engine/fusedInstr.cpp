@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <cstdint>
+
+namespace WasmEdge {
+namespace Executor {
+
+Expect<void> Executor::runFusedLocalGetLocalGetOp(
+    Runtime::StackManager &StackMgr,
+    AST::InstrView::iterator &PC) const noexcept {
+  StackMgr.push(StackMgr.getTopN(PC[0].getStackOffset()));
+  StackMgr.push(StackMgr.getTopN(PC[1].getStackOffset()));
+  PC += 1;
+  return {};
+}
+
+Expect<void> Executor::runFusedLocalGetLocalGetAddOp(
+    Runtime::StackManager &StackMgr,
+    AST::InstrView::iterator &PC) const noexcept {
+  // The stack offset of the second `local.get` is counted with the value
+  // pushed by the first one.
+  const uint32_t Lhs =
+      StackMgr.getTopN(PC[0].getStackOffset()).get<uint32_t>();
+  const uint32_t Rhs =
+      StackMgr.getTopN(PC[1].getStackOffset() - 1).get<uint32_t>();
+  StackMgr.push(ValVariant(Lhs + Rhs));
+  PC += 2;
+  return {};
+}
+
+Expect<void> Executor::runFusedLocalGetConstAddOp(
+    Runtime::StackManager &StackMgr,
+    AST::InstrView::iterator &PC) const noexcept {
+  const uint32_t Lhs =
+      StackMgr.getTopN(PC[0].getStackOffset()).get<uint32_t>();
+  const uint32_t Rhs = PC[1].getNum().get<uint32_t>();
+  StackMgr.push(ValVariant(Lhs + Rhs));
+  PC += 2;
+  return {};
+}
+
+Expect<void> Executor::runFusedLocalGetConstAddSetOp(
+    Runtime::StackManager &StackMgr,
+    AST::InstrView::iterator &PC) const noexcept {
+  // The stack offset of the `local.set` is counted with the sum on the stack.
+  const uint32_t Lhs =
+      StackMgr.getTopN(PC[0].getStackOffset()).get<uint32_t>();
+  const uint32_t Rhs = PC[1].getNum().get<uint32_t>();
+  StackMgr.getTopN(PC[3].getStackOffset() - 1) = ValVariant(Lhs + Rhs);
+  PC += 3;
+  return {};
+}
+
+Expect<void>
+Executor::runFusedConstBrIfOp(Runtime::StackManager &StackMgr,
+                              AST::InstrView::iterator &PC) noexcept {
+  const bool Taken = PC[0].getNum().get<uint32_t>() != 0;
+  PC += 1;
+  if (Taken) {
+    return runBrOp(StackMgr, *PC, PC);
+  }
+  return {};
+}
+
+} // namespace Executor
+} // namespace WasmEdge
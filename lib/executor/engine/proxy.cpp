@@ -95,6 +95,11 @@ Expect<void> Executor::call(Runtime::StackManager &StackMgr,
     StackMgr.push(Args[I]);
   }
 
+  if (unlikely(FuncInst->isPending())) {
+    if (auto Res = prepareFunction(*FuncInst); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -132,12 +137,11 @@ Expect<void *> Executor::ptrFunc(Runtime::StackManager &StackMgr,
 
   const auto *ModInst = StackMgr.getModule();
   assuming(ModInst);
-  const auto TargetFuncType = ModInst->getFuncType(FuncTypeIdx);
-  assuming(TargetFuncType && *TargetFuncType);
+  const auto TargetFuncTypeID = ModInst->getFuncTypeID(FuncTypeIdx);
+  assuming(TargetFuncTypeID);
   const auto *FuncInst = retrieveFuncRef(*Ref);
   assuming(FuncInst);
-  const auto &FuncType = FuncInst->getFuncType();
-  if (unlikely(**TargetFuncType != FuncType)) {
+  if (unlikely(*TargetFuncTypeID != FuncInst->getFuncTypeID())) {
     return Unexpect(ErrCode::Value::IndirectCallTypeMismatch);
   }
 
@@ -167,15 +171,16 @@ Executor::callIndirect(Runtime::StackManager &StackMgr, const uint32_t TableIdx,
 
   const auto *ModInst = StackMgr.getModule();
   assuming(ModInst);
-  const auto TargetFuncType = ModInst->getFuncType(FuncTypeIdx);
-  assuming(TargetFuncType && *TargetFuncType);
+  const auto TargetFuncTypeID = ModInst->getFuncTypeID(FuncTypeIdx);
+  assuming(TargetFuncTypeID);
   const auto *FuncInst = retrieveFuncRef(*Ref);
   assuming(FuncInst);
-  const auto &FuncType = FuncInst->getFuncType();
-  if (unlikely(**TargetFuncType != FuncType)) {
+  if (unlikely(*TargetFuncTypeID != FuncInst->getFuncTypeID())) {
     return Unexpect(ErrCode::Value::IndirectCallTypeMismatch);
   }
 
+  const auto &FuncType = FuncInst->getFuncType();
+
   const uint32_t ParamsSize =
       static_cast<uint32_t>(FuncType.getParamTypes().size());
   const uint32_t ReturnsSize =
@@ -185,6 +190,11 @@ Executor::callIndirect(Runtime::StackManager &StackMgr, const uint32_t TableIdx,
     StackMgr.push(Args[I]);
   }
 
+  if (unlikely(FuncInst->isPending())) {
+    if (auto Res = prepareFunction(*FuncInst); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
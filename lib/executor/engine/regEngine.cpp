@@ -0,0 +1,603 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include "common/errinfo.h"
+#include "common/log.h"
+#include "experimental/scope.hpp"
+#include "system/fault.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace WasmEdge {
+namespace Executor {
+
+thread_local uint32_t Executor::RegisterCallDepth = 0;
+
+Expect<void>
+Executor::executeRegister(Runtime::StackManager &StackMgr,
+                          const Runtime::Instance::FunctionInstance &Func,
+                          const Runtime::RegIR::Code &Code) {
+  const uint32_t FrameSize = Code.getFrameSize();
+  const auto *ModInst = Func.getModule();
+  const AST::InstrView Origins = Func.getInstrs();
+
+  // Allocate the operand stack slots and the constants after the locals.
+  for (uint32_t I = 0; I < Code.StackNum; ++I) {
+    StackMgr.push(ValVariant(UINT32_C(0)));
+  }
+  for (const auto &Val : Code.Constants) {
+    StackMgr.push(Val);
+  }
+  ValVariant *Regs = StackMgr.getTopSpan(FrameSize).data();
+
+  const Runtime::RegIR::Instruction *const Begin = Code.Instrs.data();
+  const Runtime::RegIR::Instruction *PC = Begin;
+
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+  // Publish the program counter for finding the faulting memory access.
+  const auto *EnclosingPC = Fault::exchangeProgramCounter(
+      reinterpret_cast<const void *const *>(&PC));
+  const ExecutingCodeStruct EnclosingCode =
+      std::exchange(ExecutingCode, {&Code, Origins.data()});
+  cxx20::scope_exit ExecutingPCHolder([&]() noexcept {
+    Fault::exchangeProgramCounter(EnclosingPC);
+    ExecutingCode = EnclosingCode;
+  });
+#endif
+
+  // Helper lambda for getting the originated AST instruction.
+  auto getOrigin = [&]() -> const AST::Instruction & {
+    return Origins[Code.Origins[static_cast<uint32_t>(PC - Begin)]];
+  };
+
+  // Helper lambda for jumping to the target. Check the stop token and count
+  // the loop back-edges for the tier-up on the backward jumps.
+  auto *Tier = TierUp ? Func.getTierUp() : nullptr;
+  auto jumpTo = [&](uint32_t Target) -> Expect<void> {
+    if (Target <= static_cast<uint32_t>(PC - Begin)) {
+      if (unlikely(StopToken.load(std::memory_order_relaxed)) &&
+          StopToken.exchange(0, std::memory_order_relaxed)) {
+        spdlog::error(ErrCode::Value::Interrupted);
+        return Unexpect(ErrCode::Value::Interrupted);
+      }
+      if (Tier) {
+        TierUp->countLoop(*Tier);
+      }
+    }
+    PC = Begin + Target;
+    return {};
+  };
+
+  // Helper lambda for calling the function. The arguments and the results are
+  // in the registers from the `Base`.
+  auto call = [&](const Runtime::Instance::FunctionInstance &Callee,
+                  uint32_t Base) -> Expect<void> {
+    const auto &FuncType = Callee.getFuncType();
+    const uint32_t ParamsN =
+        static_cast<uint32_t>(FuncType.getParamTypes().size());
+    const uint32_t ReturnsN =
+        static_cast<uint32_t>(FuncType.getReturnTypes().size());
+    for (uint32_t I = 0; I < ParamsN; ++I) {
+      ValVariant Val = Regs[Base + I];
+      StackMgr.push(Val);
+      // The value stack may be reallocated when pushing.
+      Regs = StackMgr.getTopSpan(FrameSize + I + 1).data();
+    }
+
+    if (unlikely(Callee.isPending())) {
+      if (auto Res = prepareFunction(Callee); unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+    }
+    auto Instrs = Callee.getInstrs();
+    AST::InstrView::iterator StartIt;
+    if (auto Res = enterFunction(StackMgr, Callee, Instrs.end())) {
+      StartIt = *Res;
+    } else {
+      return Unexpect(Res);
+    }
+    if (auto Res = execute(StackMgr, StartIt, Instrs.end()); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+
+    Regs = StackMgr.getTopSpan(FrameSize + ReturnsN).data();
+    const ValVariant *Rets = Regs + FrameSize;
+    for (uint32_t I = 0; I < ReturnsN; ++I) {
+      Regs[Base + I] = Rets[I];
+    }
+    StackMgr.stackErase(ReturnsN, 0);
+    return {};
+  };
+
+#define CHECK(...)                                                             \
+  if (auto Res = (__VA_ARGS__); unlikely(!Res)) {                              \
+    return Unexpect(Res);                                                      \
+  }
+#define UNARY_OP(...)                                                          \
+  {                                                                            \
+    ValVariant Val = Regs[PC->A];                                              \
+    CHECK(__VA_ARGS__(Val));                                                   \
+    Regs[PC->Dst] = Val;                                                       \
+    break;                                                                     \
+  }
+#define UNARY_INSTR_OP(...)                                                    \
+  {                                                                            \
+    ValVariant Val = Regs[PC->A];                                              \
+    CHECK(__VA_ARGS__(getOrigin(), Val));                                      \
+    Regs[PC->Dst] = Val;                                                       \
+    break;                                                                     \
+  }
+#define BINARY_OP(...)                                                         \
+  {                                                                            \
+    ValVariant Val = Regs[PC->A];                                              \
+    CHECK(__VA_ARGS__(Val, Regs[PC->B]));                                      \
+    Regs[PC->Dst] = Val;                                                       \
+    break;                                                                     \
+  }
+#define BINARY_INSTR_OP(...)                                                   \
+  {                                                                            \
+    ValVariant Val = Regs[PC->A];                                              \
+    CHECK(__VA_ARGS__(getOrigin(), Val, Regs[PC->B]));                         \
+    Regs[PC->Dst] = Val;                                                       \
+    break;                                                                     \
+  }
+#define LOAD_OP(...)                                                           \
+  CHECK(__VA_ARGS__(*getMemInstByIdx(StackMgr, PC->Index), getOrigin(),        \
+                    Regs[PC->Dst], Regs[PC->A].get<uint32_t>()));              \
+  break;
+#define STORE_OP(...)                                                          \
+  CHECK(__VA_ARGS__(*getMemInstByIdx(StackMgr, PC->Index), getOrigin(),        \
+                    Regs[PC->A].get<uint32_t>(), Regs[PC->B]));                \
+  break;
+
+  while (true) {
+    switch (PC->Code) {
+    // Control instructions.
+    case OpCode::Unreachable:
+      spdlog::error(ErrCode::Value::Unreachable);
+      spdlog::error(ErrInfo::InfoInstruction(getOrigin().getOpCode(),
+                                             getOrigin().getOffset()));
+      return Unexpect(ErrCode::Value::Unreachable);
+    case OpCode::Br:
+      CHECK(jumpTo(PC->A));
+      continue;
+    case OpCode::Br_if:
+      if (Regs[PC->A].get<uint32_t>() != 0) {
+        CHECK(jumpTo(PC->B));
+        continue;
+      }
+      break;
+    case OpCode::If:
+      if (Regs[PC->A].get<uint32_t>() == 0) {
+        CHECK(jumpTo(PC->B));
+        continue;
+      }
+      break;
+    case OpCode::Br_table: {
+      const uint32_t Idx = std::min(Regs[PC->A].get<uint32_t>(), PC->Dst - 1);
+      CHECK(jumpTo(Code.Labels[PC->B + Idx]));
+      continue;
+    }
+    case OpCode::Return: {
+      // The results are in the front of the operand stack slots. Leave them on
+      // the top of the value stack for popping the frame.
+      const uint32_t ReturnsN = static_cast<uint32_t>(
+          Func.getFuncType().getReturnTypes().size());
+      StackMgr.stackErase(FrameSize - Code.LocalNum - ReturnsN, 0);
+      return {};
+    }
+    case OpCode::Call:
+      CHECK(call(**ModInst->getFunc(PC->A), PC->Dst));
+      break;
+    case OpCode::Call_indirect: {
+      const auto *TabInst = getTabInstByIdx(StackMgr, PC->Index);
+      const uint32_t Idx = Regs[PC->A].get<uint32_t>();
+      if (Idx >= TabInst->getSize()) {
+        spdlog::error(ErrCode::Value::UndefinedElement);
+        spdlog::error(ErrInfo::InfoInstruction(
+            getOrigin().getOpCode(), getOrigin().getOffset(), {Idx},
+            {ValTypeFromType<uint32_t>()}));
+        return Unexpect(ErrCode::Value::UndefinedElement);
+      }
+      ValVariant Ref = TabInst->getRefAddr(Idx)->get<UnknownRef>();
+      if (isNullRef(Ref)) {
+        spdlog::error(ErrCode::Value::UninitializedElement);
+        spdlog::error(ErrInfo::InfoInstruction(
+            getOrigin().getOpCode(), getOrigin().getOffset(), {Idx},
+            {ValTypeFromType<uint32_t>()}));
+        return Unexpect(ErrCode::Value::UninitializedElement);
+      }
+      const auto *FuncInst = retrieveFuncRef(Ref);
+      auto &Cache = ModInst->getCallCache(getOrigin().getCallCacheIndex());
+      if (!Cache.isHit(FuncInst)) {
+        const uint64_t Gen = FuncInstGeneration.load(std::memory_order_relaxed);
+        if (*ModInst->getFuncTypeID(PC->B) != FuncInst->getFuncTypeID()) {
+          const auto *TargetFuncType = *ModInst->getFuncType(PC->B);
+          const auto &FuncType = FuncInst->getFuncType();
+          spdlog::error(ErrCode::Value::IndirectCallTypeMismatch);
+          spdlog::error(ErrInfo::InfoInstruction(
+              getOrigin().getOpCode(), getOrigin().getOffset(), {Idx},
+              {ValTypeFromType<uint32_t>()}));
+          spdlog::error(ErrInfo::InfoMismatch(
+              TargetFuncType->getParamTypes(), TargetFuncType->getReturnTypes(),
+              FuncType.getParamTypes(), FuncType.getReturnTypes()));
+          return Unexpect(ErrCode::Value::IndirectCallTypeMismatch);
+        }
+        Cache.fill(FuncInst, Gen);
+      }
+      CHECK(call(*FuncInst, PC->Dst));
+      break;
+    }
+
+    // Parametric instructions.
+    case OpCode::Select:
+      if (Regs[PC->B].get<uint32_t>() == 0) {
+        Regs[PC->Dst] = Regs[PC->A];
+      }
+      break;
+
+    // Variable instructions.
+    case OpCode::Local__set:
+      Regs[PC->Dst] = Regs[PC->A];
+      break;
+    case OpCode::Global__get:
+      Regs[PC->Dst] = getGlobInstByIdx(StackMgr, PC->A)->getValue();
+      break;
+    case OpCode::Global__set:
+      getGlobInstByIdx(StackMgr, PC->B)->getValue() = Regs[PC->A];
+      break;
+
+    // Memory instructions.
+    case OpCode::I32__load:
+      LOAD_OP(runRegLoadOp<uint32_t>);
+    case OpCode::I64__load:
+      LOAD_OP(runRegLoadOp<uint64_t>);
+    case OpCode::F32__load:
+      LOAD_OP(runRegLoadOp<float>);
+    case OpCode::F64__load:
+      LOAD_OP(runRegLoadOp<double>);
+    case OpCode::I32__load8_s:
+      LOAD_OP(runRegLoadOp<int32_t, 8>);
+    case OpCode::I32__load8_u:
+      LOAD_OP(runRegLoadOp<uint32_t, 8>);
+    case OpCode::I32__load16_s:
+      LOAD_OP(runRegLoadOp<int32_t, 16>);
+    case OpCode::I32__load16_u:
+      LOAD_OP(runRegLoadOp<uint32_t, 16>);
+    case OpCode::I64__load8_s:
+      LOAD_OP(runRegLoadOp<int64_t, 8>);
+    case OpCode::I64__load8_u:
+      LOAD_OP(runRegLoadOp<uint64_t, 8>);
+    case OpCode::I64__load16_s:
+      LOAD_OP(runRegLoadOp<int64_t, 16>);
+    case OpCode::I64__load16_u:
+      LOAD_OP(runRegLoadOp<uint64_t, 16>);
+    case OpCode::I64__load32_s:
+      LOAD_OP(runRegLoadOp<int64_t, 32>);
+    case OpCode::I64__load32_u:
+      LOAD_OP(runRegLoadOp<uint64_t, 32>);
+    case OpCode::I32__store:
+      STORE_OP(runRegStoreOp<uint32_t>);
+    case OpCode::I64__store:
+      STORE_OP(runRegStoreOp<uint64_t>);
+    case OpCode::F32__store:
+      STORE_OP(runRegStoreOp<float>);
+    case OpCode::F64__store:
+      STORE_OP(runRegStoreOp<double>);
+    case OpCode::I32__store8:
+      STORE_OP(runRegStoreOp<uint32_t, 8>);
+    case OpCode::I32__store16:
+      STORE_OP(runRegStoreOp<uint32_t, 16>);
+    case OpCode::I64__store8:
+      STORE_OP(runRegStoreOp<uint64_t, 8>);
+    case OpCode::I64__store16:
+      STORE_OP(runRegStoreOp<uint64_t, 16>);
+    case OpCode::I64__store32:
+      STORE_OP(runRegStoreOp<uint64_t, 32>);
+    case OpCode::Memory__size:
+      Regs[PC->Dst].emplace<uint32_t>(
+          getMemInstByIdx(StackMgr, PC->Index)->getPageSize());
+      break;
+    case OpCode::Memory__grow: {
+      auto &MemInst = *getMemInstByIdx(StackMgr, PC->Index);
+      const uint32_t N = Regs[PC->A].get<uint32_t>();
+      const uint32_t CurrPageSize = MemInst.getPageSize();
+      Regs[PC->Dst].emplace<uint32_t>(
+          MemInst.growPage(N) ? CurrPageSize : static_cast<uint32_t>(-1));
+      break;
+    }
+
+    // Numeric instructions.
+    case OpCode::I32__eqz:
+      UNARY_OP(runEqzOp<uint32_t>);
+    case OpCode::I64__eqz:
+      UNARY_OP(runEqzOp<uint64_t>);
+    case OpCode::I32__clz:
+      UNARY_OP(runClzOp<uint32_t>);
+    case OpCode::I32__ctz:
+      UNARY_OP(runCtzOp<uint32_t>);
+    case OpCode::I32__popcnt:
+      UNARY_OP(runPopcntOp<uint32_t>);
+    case OpCode::I64__clz:
+      UNARY_OP(runClzOp<uint64_t>);
+    case OpCode::I64__ctz:
+      UNARY_OP(runCtzOp<uint64_t>);
+    case OpCode::I64__popcnt:
+      UNARY_OP(runPopcntOp<uint64_t>);
+    case OpCode::F32__abs:
+      UNARY_OP(runAbsOp<float>);
+    case OpCode::F32__neg:
+      UNARY_OP(runNegOp<float>);
+    case OpCode::F32__ceil:
+      UNARY_OP(runCeilOp<float>);
+    case OpCode::F32__floor:
+      UNARY_OP(runFloorOp<float>);
+    case OpCode::F32__trunc:
+      UNARY_OP(runTruncOp<float>);
+    case OpCode::F32__nearest:
+      UNARY_OP(runNearestOp<float>);
+    case OpCode::F32__sqrt:
+      UNARY_OP(runSqrtOp<float>);
+    case OpCode::F64__abs:
+      UNARY_OP(runAbsOp<double>);
+    case OpCode::F64__neg:
+      UNARY_OP(runNegOp<double>);
+    case OpCode::F64__ceil:
+      UNARY_OP(runCeilOp<double>);
+    case OpCode::F64__floor:
+      UNARY_OP(runFloorOp<double>);
+    case OpCode::F64__trunc:
+      UNARY_OP(runTruncOp<double>);
+    case OpCode::F64__nearest:
+      UNARY_OP(runNearestOp<double>);
+    case OpCode::F64__sqrt:
+      UNARY_OP(runSqrtOp<double>);
+    case OpCode::I32__wrap_i64:
+      UNARY_OP(runWrapOp<uint64_t, uint32_t>);
+    case OpCode::I32__trunc_f32_s:
+      UNARY_INSTR_OP(runTruncateOp<float, int32_t>);
+    case OpCode::I32__trunc_f32_u:
+      UNARY_INSTR_OP(runTruncateOp<float, uint32_t>);
+    case OpCode::I32__trunc_f64_s:
+      UNARY_INSTR_OP(runTruncateOp<double, int32_t>);
+    case OpCode::I32__trunc_f64_u:
+      UNARY_INSTR_OP(runTruncateOp<double, uint32_t>);
+    case OpCode::I64__extend_i32_s:
+      UNARY_OP(runExtendOp<int32_t, uint64_t>);
+    case OpCode::I64__extend_i32_u:
+      UNARY_OP(runExtendOp<uint32_t, uint64_t>);
+    case OpCode::I64__trunc_f32_s:
+      UNARY_INSTR_OP(runTruncateOp<float, int64_t>);
+    case OpCode::I64__trunc_f32_u:
+      UNARY_INSTR_OP(runTruncateOp<float, uint64_t>);
+    case OpCode::I64__trunc_f64_s:
+      UNARY_INSTR_OP(runTruncateOp<double, int64_t>);
+    case OpCode::I64__trunc_f64_u:
+      UNARY_INSTR_OP(runTruncateOp<double, uint64_t>);
+    case OpCode::F32__convert_i32_s:
+      UNARY_OP(runConvertOp<int32_t, float>);
+    case OpCode::F32__convert_i32_u:
+      UNARY_OP(runConvertOp<uint32_t, float>);
+    case OpCode::F32__convert_i64_s:
+      UNARY_OP(runConvertOp<int64_t, float>);
+    case OpCode::F32__convert_i64_u:
+      UNARY_OP(runConvertOp<uint64_t, float>);
+    case OpCode::F32__demote_f64:
+      UNARY_OP(runDemoteOp<double, float>);
+    case OpCode::F64__convert_i32_s:
+      UNARY_OP(runConvertOp<int32_t, double>);
+    case OpCode::F64__convert_i32_u:
+      UNARY_OP(runConvertOp<uint32_t, double>);
+    case OpCode::F64__convert_i64_s:
+      UNARY_OP(runConvertOp<int64_t, double>);
+    case OpCode::F64__convert_i64_u:
+      UNARY_OP(runConvertOp<uint64_t, double>);
+    case OpCode::F64__promote_f32:
+      UNARY_OP(runPromoteOp<float, double>);
+    case OpCode::I32__reinterpret_f32:
+      UNARY_OP(runReinterpretOp<float, uint32_t>);
+    case OpCode::I64__reinterpret_f64:
+      UNARY_OP(runReinterpretOp<double, uint64_t>);
+    case OpCode::F32__reinterpret_i32:
+      UNARY_OP(runReinterpretOp<uint32_t, float>);
+    case OpCode::F64__reinterpret_i64:
+      UNARY_OP(runReinterpretOp<uint64_t, double>);
+    case OpCode::I32__extend8_s:
+      UNARY_OP(runExtendOp<int32_t, uint32_t, 8>);
+    case OpCode::I32__extend16_s:
+      UNARY_OP(runExtendOp<int32_t, uint32_t, 16>);
+    case OpCode::I64__extend8_s:
+      UNARY_OP(runExtendOp<int64_t, uint64_t, 8>);
+    case OpCode::I64__extend16_s:
+      UNARY_OP(runExtendOp<int64_t, uint64_t, 16>);
+    case OpCode::I64__extend32_s:
+      UNARY_OP(runExtendOp<int64_t, uint64_t, 32>);
+    case OpCode::I32__trunc_sat_f32_s:
+      UNARY_OP(runTruncateSatOp<float, int32_t>);
+    case OpCode::I32__trunc_sat_f32_u:
+      UNARY_OP(runTruncateSatOp<float, uint32_t>);
+    case OpCode::I32__trunc_sat_f64_s:
+      UNARY_OP(runTruncateSatOp<double, int32_t>);
+    case OpCode::I32__trunc_sat_f64_u:
+      UNARY_OP(runTruncateSatOp<double, uint32_t>);
+    case OpCode::I64__trunc_sat_f32_s:
+      UNARY_OP(runTruncateSatOp<float, int64_t>);
+    case OpCode::I64__trunc_sat_f32_u:
+      UNARY_OP(runTruncateSatOp<float, uint64_t>);
+    case OpCode::I64__trunc_sat_f64_s:
+      UNARY_OP(runTruncateSatOp<double, int64_t>);
+    case OpCode::I64__trunc_sat_f64_u:
+      UNARY_OP(runTruncateSatOp<double, uint64_t>);
+    case OpCode::I32__eq:
+      BINARY_OP(runEqOp<uint32_t>);
+    case OpCode::I32__ne:
+      BINARY_OP(runNeOp<uint32_t>);
+    case OpCode::I32__lt_s:
+      BINARY_OP(runLtOp<int32_t>);
+    case OpCode::I32__lt_u:
+      BINARY_OP(runLtOp<uint32_t>);
+    case OpCode::I32__gt_s:
+      BINARY_OP(runGtOp<int32_t>);
+    case OpCode::I32__gt_u:
+      BINARY_OP(runGtOp<uint32_t>);
+    case OpCode::I32__le_s:
+      BINARY_OP(runLeOp<int32_t>);
+    case OpCode::I32__le_u:
+      BINARY_OP(runLeOp<uint32_t>);
+    case OpCode::I32__ge_s:
+      BINARY_OP(runGeOp<int32_t>);
+    case OpCode::I32__ge_u:
+      BINARY_OP(runGeOp<uint32_t>);
+    case OpCode::I64__eq:
+      BINARY_OP(runEqOp<uint64_t>);
+    case OpCode::I64__ne:
+      BINARY_OP(runNeOp<uint64_t>);
+    case OpCode::I64__lt_s:
+      BINARY_OP(runLtOp<int64_t>);
+    case OpCode::I64__lt_u:
+      BINARY_OP(runLtOp<uint64_t>);
+    case OpCode::I64__gt_s:
+      BINARY_OP(runGtOp<int64_t>);
+    case OpCode::I64__gt_u:
+      BINARY_OP(runGtOp<uint64_t>);
+    case OpCode::I64__le_s:
+      BINARY_OP(runLeOp<int64_t>);
+    case OpCode::I64__le_u:
+      BINARY_OP(runLeOp<uint64_t>);
+    case OpCode::I64__ge_s:
+      BINARY_OP(runGeOp<int64_t>);
+    case OpCode::I64__ge_u:
+      BINARY_OP(runGeOp<uint64_t>);
+    case OpCode::F32__eq:
+      BINARY_OP(runEqOp<float>);
+    case OpCode::F32__ne:
+      BINARY_OP(runNeOp<float>);
+    case OpCode::F32__lt:
+      BINARY_OP(runLtOp<float>);
+    case OpCode::F32__gt:
+      BINARY_OP(runGtOp<float>);
+    case OpCode::F32__le:
+      BINARY_OP(runLeOp<float>);
+    case OpCode::F32__ge:
+      BINARY_OP(runGeOp<float>);
+    case OpCode::F64__eq:
+      BINARY_OP(runEqOp<double>);
+    case OpCode::F64__ne:
+      BINARY_OP(runNeOp<double>);
+    case OpCode::F64__lt:
+      BINARY_OP(runLtOp<double>);
+    case OpCode::F64__gt:
+      BINARY_OP(runGtOp<double>);
+    case OpCode::F64__le:
+      BINARY_OP(runLeOp<double>);
+    case OpCode::F64__ge:
+      BINARY_OP(runGeOp<double>);
+    case OpCode::I32__add:
+      BINARY_OP(runAddOp<uint32_t>);
+    case OpCode::I32__sub:
+      BINARY_OP(runSubOp<uint32_t>);
+    case OpCode::I32__mul:
+      BINARY_OP(runMulOp<uint32_t>);
+    case OpCode::I32__div_s:
+      BINARY_INSTR_OP(runDivOp<int32_t>);
+    case OpCode::I32__div_u:
+      BINARY_INSTR_OP(runDivOp<uint32_t>);
+    case OpCode::I32__rem_s:
+      BINARY_INSTR_OP(runRemOp<int32_t>);
+    case OpCode::I32__rem_u:
+      BINARY_INSTR_OP(runRemOp<uint32_t>);
+    case OpCode::I32__and:
+      BINARY_OP(runAndOp<uint32_t>);
+    case OpCode::I32__or:
+      BINARY_OP(runOrOp<uint32_t>);
+    case OpCode::I32__xor:
+      BINARY_OP(runXorOp<uint32_t>);
+    case OpCode::I32__shl:
+      BINARY_OP(runShlOp<uint32_t>);
+    case OpCode::I32__shr_s:
+      BINARY_OP(runShrOp<int32_t>);
+    case OpCode::I32__shr_u:
+      BINARY_OP(runShrOp<uint32_t>);
+    case OpCode::I32__rotl:
+      BINARY_OP(runRotlOp<uint32_t>);
+    case OpCode::I32__rotr:
+      BINARY_OP(runRotrOp<uint32_t>);
+    case OpCode::I64__add:
+      BINARY_OP(runAddOp<uint64_t>);
+    case OpCode::I64__sub:
+      BINARY_OP(runSubOp<uint64_t>);
+    case OpCode::I64__mul:
+      BINARY_OP(runMulOp<uint64_t>);
+    case OpCode::I64__div_s:
+      BINARY_INSTR_OP(runDivOp<int64_t>);
+    case OpCode::I64__div_u:
+      BINARY_INSTR_OP(runDivOp<uint64_t>);
+    case OpCode::I64__rem_s:
+      BINARY_INSTR_OP(runRemOp<int64_t>);
+    case OpCode::I64__rem_u:
+      BINARY_INSTR_OP(runRemOp<uint64_t>);
+    case OpCode::I64__and:
+      BINARY_OP(runAndOp<uint64_t>);
+    case OpCode::I64__or:
+      BINARY_OP(runOrOp<uint64_t>);
+    case OpCode::I64__xor:
+      BINARY_OP(runXorOp<uint64_t>);
+    case OpCode::I64__shl:
+      BINARY_OP(runShlOp<uint64_t>);
+    case OpCode::I64__shr_s:
+      BINARY_OP(runShrOp<int64_t>);
+    case OpCode::I64__shr_u:
+      BINARY_OP(runShrOp<uint64_t>);
+    case OpCode::I64__rotl:
+      BINARY_OP(runRotlOp<uint64_t>);
+    case OpCode::I64__rotr:
+      BINARY_OP(runRotrOp<uint64_t>);
+    case OpCode::F32__add:
+      BINARY_OP(runAddOp<float>);
+    case OpCode::F32__sub:
+      BINARY_OP(runSubOp<float>);
+    case OpCode::F32__mul:
+      BINARY_OP(runMulOp<float>);
+    case OpCode::F32__div:
+      BINARY_INSTR_OP(runDivOp<float>);
+    case OpCode::F32__min:
+      BINARY_OP(runMinOp<float>);
+    case OpCode::F32__max:
+      BINARY_OP(runMaxOp<float>);
+    case OpCode::F32__copysign:
+      BINARY_OP(runCopysignOp<float>);
+    case OpCode::F64__add:
+      BINARY_OP(runAddOp<double>);
+    case OpCode::F64__sub:
+      BINARY_OP(runSubOp<double>);
+    case OpCode::F64__mul:
+      BINARY_OP(runMulOp<double>);
+    case OpCode::F64__div:
+      BINARY_INSTR_OP(runDivOp<double>);
+    case OpCode::F64__min:
+      BINARY_OP(runMinOp<double>);
+    case OpCode::F64__max:
+      BINARY_OP(runMaxOp<double>);
+    case OpCode::F64__copysign:
+      BINARY_OP(runCopysignOp<double>);
+
+    default:
+      assumingUnreachable();
+    }
+    ++PC;
+  }
+
+#undef CHECK
+#undef UNARY_OP
+#undef UNARY_INSTR_OP
+#undef BINARY_OP
+#undef BINARY_INSTR_OP
+#undef LOAD_OP
+#undef STORE_OP
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -55,6 +55,65 @@ Executor::registerModule(Runtime::StoreManager &StoreMgr,
   return {};
 }
 
+/// Create a module template. See "include/executor/executor.h".
+Expect<std::unique_ptr<Runtime::Instance::ModuleTemplate>>
+Executor::createTemplate(Runtime::StoreManager &StoreMgr,
+                         const AST::Module &Mod, bool IsStarted) {
+  // The imported tables, memories, and globals are shared with the other
+  // modules, so that their states cannot be frozen.
+  for (const auto &ImpDesc : Mod.getImportSection().getContent()) {
+    if (ImpDesc.getExternalType() != ExternalType::Function) {
+      spdlog::error(ErrCode::Value::UnfreezableModule);
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      return Unexpect(ErrCode::Value::UnfreezableModule);
+    }
+  }
+
+  auto Res = instantiate(StoreMgr, Mod, std::nullopt, IsStarted);
+  if (!Res) {
+    if (Stat) {
+      Stat->dumpToLog(Conf);
+    }
+    return Unexpect(Res);
+  }
+  auto Tmpl = std::make_unique<Runtime::Instance::ModuleTemplate>(Mod);
+  Tmpl->IsStarted = IsStarted;
+  if (auto FreezeRes = freeze(*Tmpl, **Res); !FreezeRes) {
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+    return Unexpect(FreezeRes);
+  }
+  return Tmpl;
+}
+
+/// Instantiate a module template. See "include/executor/executor.h".
+Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+Executor::instantiateModule(Runtime::StoreManager &StoreMgr,
+                            const Runtime::Instance::ModuleTemplate &Tmpl) {
+  if (auto Res = instantiate(StoreMgr, Tmpl)) {
+    return Res;
+  } else {
+    if (Stat) {
+      Stat->dumpToLog(Conf);
+    }
+    return Unexpect(Res);
+  }
+}
+
+/// Register a named module template. See "include/executor/executor.h".
+Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+Executor::registerModule(Runtime::StoreManager &StoreMgr,
+                         const Runtime::Instance::ModuleTemplate &Tmpl,
+                         std::string_view Name) {
+  if (auto Res = instantiate(StoreMgr, Tmpl, Name)) {
+    return Res;
+  } else {
+    if (Stat) {
+      Stat->dumpToLog(Conf);
+    }
+    return Unexpect(Res);
+  }
+}
+
 // Invoke function. See "include/executor/executor.h".
 Expect<std::vector<std::pair<ValVariant, ValType>>>
 Executor::invoke(const Runtime::Instance::FunctionInstance &FuncInst,
@@ -91,5 +150,23 @@ Executor::invoke(const Runtime::Instance::FunctionInstance &FuncInst,
   return Returns;
 }
 
+// Set the compiler of the tiered execution. See "include/executor/executor.h".
+void Executor::setTierUpCompiler(
+    std::unique_ptr<TierUpCompiler> Compiler) noexcept {
+  const auto &RuntimeConf = Conf.getRuntimeConfigure();
+  const auto &StatConf = Conf.getStatisticsConfigure();
+  // The compiled code does not count the instructions nor measure the costs
+  // in the same way as the interpreter.
+  if (!Compiler || !RuntimeConf.isTiering() ||
+      StatConf.isInstructionCounting() || StatConf.isCostMeasuring()) {
+    TierUp.reset();
+    return;
+  }
+  TierUp = std::make_unique<TierUpQueue>(
+      std::move(Compiler), RuntimeConf.getTierUpCallThreshold(),
+      RuntimeConf.getTierUpLoopThreshold(), RuntimeConf.getTierUpThreads(),
+      Stat);
+}
+
 } // namespace Executor
 } // namespace WasmEdge
@@ -4,6 +4,7 @@
 #include "executor/executor.h"
 
 #include "common/log.h"
+#include "experimental/scope.hpp"
 #include "system/fault.h"
 
 #include <cstdint>
@@ -25,6 +26,12 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
     return Unexpect(ErrCode::Value::Interrupted);
   }
 
+  // Check the call depth. The tail-call replaces the current frame.
+  if (unlikely(!IsTailCall && StackMgr.isFrameFull())) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
+
   // Get function type for the params and returns num.
   const auto &FuncType = Func.getFuncType();
   const uint32_t ArgsN = static_cast<uint32_t>(FuncType.getParamTypes().size());
@@ -44,13 +51,17 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
     }
     Runtime::CallingFrame CallFrame(this, ModInst);
 
-    // Push frame.
-    StackMgr.pushFrame(Func.getModule(), // Module instance
-                       RetIt,            // Return PC
-                       ArgsN,            // Only args, no locals in stack
-                       RetsN,            // Returns num
-                       IsTailCall        // For tail-call
-    );
+    // Push frame. The leaf host function never re-enters the VM and needs no
+    // frame, except for the tail-call which replaces the current frame.
+    const bool IsLeaf = HostFunc.isLeaf() && !IsTailCall;
+    if (!IsLeaf) {
+      StackMgr.pushFrame(Func.getModule(), // Module instance
+                         RetIt,            // Return PC
+                         ArgsN,            // Only args, no locals in stack
+                         RetsN,            // Returns num
+                         IsTailCall        // For tail-call
+      );
+    }
 
     // Do the statistics if the statistics turned on.
     if (Stat) {
@@ -64,10 +75,14 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
       Stat->startRecordHost();
     }
 
-    // Run host function.
-    Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN);
-    std::vector<ValVariant> Rets(RetsN);
+    // Run host function. The returns are written into the stack slots above
+    // the args directly.
+    Span<ValVariant> Rets = StackMgr.pushTopSpan(RetsN);
+    Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN + RetsN).first(ArgsN);
+    // The faults in the host function are not turned into the traps.
+    const bool EnclosingGuarded = Fault::exchangeGuarded(false);
     auto Ret = HostFunc.run(CallFrame, std::move(Args), Rets);
+    Fault::exchangeGuarded(EnclosingGuarded);
 
     // Do the statistics if the statistics turned on.
     if (Stat) {
@@ -85,75 +100,43 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
       return Unexpect(Ret);
     }
 
-    // Push returns back to stack.
-    for (auto &R : Rets) {
-      StackMgr.push(std::move(R));
+    // Erase the args under the returns. For host function case, the
+    // continuation will be the continuation from the popped frame. The frame
+    // replaced by the tail-call is pushed by the interpreter, whose return PC
+    // is the instruction before the continuation.
+    if (IsLeaf) {
+      StackMgr.stackErase(ArgsN + RetsN, RetsN);
+      return RetIt;
     }
-
-    // For host function case, the continuation will be the continuation from
-    // the popped frame.
-    return StackMgr.popFrame();
+    return StackMgr.popFrame() + (IsTailCall ? 1 : 0);
   } else if (Func.isCompiledFunction()) {
     // Compiled function case: Execute the function and jump to the
     // continuation.
+    return enterCompiledFunction(StackMgr, Func, *FuncType.getSymbol(),
+                                 Func.getSymbol().get(), RetIt, IsTailCall);
+  } else {
+    // Native function case: Jump to the start of the function body.
 
-    // Push frame.
-    StackMgr.pushFrame(Func.getModule(), // Module instance
-                       RetIt,            // Return PC
-                       ArgsN,            // Only args, no locals in stack
-                       RetsN,            // Returns num
-                       IsTailCall        // For tail-call
-    );
-
-    // Prepare arguments.
-    Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN);
-    std::vector<ValVariant> Rets(RetsN);
-
-    {
-      // Prepare the execution context.
-      CurrentStack = &StackMgr;
-      auto *ModInst =
-          const_cast<Runtime::Instance::ModuleInstance *>(Func.getModule());
-      for (uint32_t I = 0; I < ModInst->getMemoryNum(); ++I) {
-        // Update the memory pointers to prevent from the address change due to
-        // the page growing.
-        auto MemoryPtr = reinterpret_cast<std::atomic<uint8_t *> *>(
-            &(ModInst->MemoryPtrs[I]));
-        uint8_t *const DataPtr = (*(ModInst->getMemory(I)))->getDataPtr();
-        std::atomic_store_explicit(MemoryPtr, DataPtr,
-                                   std::memory_order_relaxed);
+    // Prepare the function body deferred by the lazy loading.
+    if (unlikely(Func.isPending())) {
+      if (auto Res = prepareFunction(Func); unlikely(!Res)) {
+        return Unexpect(Res);
       }
-      ExecutionContext.Memories = ModInst->MemoryPtrs.data();
-      ExecutionContext.Globals = ModInst->GlobalPtrs.data();
     }
 
-    {
-      // Get symbol and execute the function.
-      Fault FaultHandler;
-      uint32_t Code = PREPARE_FAULT(FaultHandler);
-      if (auto Err = ErrCode(static_cast<ErrCategory>(Code >> 24), Code);
-          unlikely(Err != ErrCode::Value::Success)) {
-        if (Err != ErrCode::Value::Terminated) {
-          spdlog::error(Err);
-        }
-        return Unexpect(Err);
+    // Run the code compiled by the tier-up if available. Otherwise count the
+    // call for the tier-up.
+    auto *Tier = Func.getTierUp();
+    if (Tier) {
+      if (Tier->IsCompiled.load(std::memory_order_acquire)) {
+        return enterCompiledFunction(StackMgr, Func, *Tier->Wrapper,
+                                     Tier->Function.get(), RetIt, IsTailCall);
+      }
+      if (TierUp) {
+        TierUp->countCall(*Tier);
       }
-      auto &Wrapper = FuncType.getSymbol();
-      Wrapper(&ExecutionContext, Func.getSymbol().get(), Args.data(),
-              Rets.data());
-    }
-
-    // Push returns back to stack.
-    for (uint32_t I = 0; I < Rets.size(); ++I) {
-      StackMgr.push(Rets[I]);
     }
 
-    // For compiled function case, the continuation will be the continuation
-    // from the popped frame.
-    return StackMgr.popFrame();
-  } else {
-    // Native function case: Jump to the start of the function body.
-
     // Push local variables into the stack.
     for (auto &Def : Func.getLocals()) {
       for (uint32_t I = 0; I < Def.first; I++) {
@@ -161,6 +144,34 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
       }
     }
 
+    // Run the lowered register-based code if available. The instruction
+    // counting and the gas measuring are only supported on the AST
+    // interpreter. Fall back to the AST interpreter when the nested calls are
+    // too deep, which does not consume the native stack.
+    if (const auto *Code = Func.getRegisterCode();
+        Code != nullptr && RegisterCallDepth < kMaxRegisterCallDepth &&
+        (!Stat || (!Conf.getStatisticsConfigure().isInstructionCounting() &&
+                   !Conf.getStatisticsConfigure().isCostMeasuring()))) {
+      // Push frame.
+      StackMgr.pushFrame(Func.getModule(),           // Module instance
+                         RetIt,                      // Return PC
+                         ArgsN + Func.getLocalNum(), // Arguments num + local num
+                         RetsN,                      // Returns num
+                         IsTailCall                  // For tail-call
+      );
+
+      RegisterCallDepth++;
+      auto Res = executeRegister(StackMgr, Func, *Code);
+      RegisterCallDepth--;
+      if (!Res) {
+        return Unexpect(Res);
+      }
+
+      // For register-based code case, the continuation will be the
+      // continuation from the popped frame, as the host function case.
+      return StackMgr.popFrame() + (IsTailCall ? 1 : 0);
+    }
+
     // Push frame.
     // The PC must -1 here because in the interpreter mode execution, the PC
     // will increase after the callee return.
@@ -168,7 +179,9 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
                        RetIt - 1,                  // Return PC
                        ArgsN + Func.getLocalNum(), // Arguments num + local num
                        RetsN,                      // Returns num
-                       IsTailCall                  // For tail-call
+                       IsTailCall,                 // For tail-call
+                       Tier,                       // Tier-up state
+                       Func.getProfile()           // Branch profile
     );
 
     // For native function case, the continuation will be the start of the
@@ -177,6 +190,93 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   }
 }
 
+Expect<AST::InstrView::iterator> Executor::enterCompiledFunction(
+    Runtime::StackManager &StackMgr,
+    const Runtime::Instance::FunctionInstance &Func,
+    AST::FunctionType::Wrapper &Wrapper, void *Function,
+    const AST::InstrView::iterator RetIt, bool IsTailCall) {
+  // Get function type for the params and returns num.
+  const auto &FuncType = Func.getFuncType();
+  const uint32_t ArgsN = static_cast<uint32_t>(FuncType.getParamTypes().size());
+  const uint32_t RetsN =
+      static_cast<uint32_t>(FuncType.getReturnTypes().size());
+
+  // Push frame.
+  StackMgr.pushFrame(Func.getModule(), // Module instance
+                     RetIt,            // Return PC
+                     ArgsN,            // Only args, no locals in stack
+                     RetsN,            // Returns num
+                     IsTailCall        // For tail-call
+  );
+
+  // Prepare arguments.
+#if WASMEDGE_GUARDED_VALUE_STACK
+  // The returns are written into the stack slots above the args directly.
+  // The compiled function may push onto the stack in the proxies, which is
+  // safe because the guarded stack never moves.
+  const bool IsInPlace = StackMgr.isGuarded();
+#else
+  const bool IsInPlace = false;
+#endif
+  std::vector<ValVariant> RetsBuffer;
+  Span<ValVariant> Args;
+  Span<ValVariant> Rets;
+  if (IsInPlace) {
+    Rets = StackMgr.pushTopSpan(RetsN);
+    Args = StackMgr.getTopSpan(ArgsN + RetsN).first(ArgsN);
+  } else {
+    RetsBuffer.resize(RetsN);
+    Args = StackMgr.getTopSpan(ArgsN);
+    Rets = RetsBuffer;
+  }
+
+  {
+    // Prepare the execution context.
+    CurrentStack = &StackMgr;
+    auto *ModInst =
+        const_cast<Runtime::Instance::ModuleInstance *>(Func.getModule());
+    for (uint32_t I = 0; I < ModInst->getMemoryNum(); ++I) {
+      // Update the memory pointers to prevent from the address change due to
+      // the page growing.
+      auto MemoryPtr = reinterpret_cast<std::atomic<uint8_t *> *>(
+          &(ModInst->MemoryPtrs[I]));
+      uint8_t *const DataPtr = (*(ModInst->getMemory(I)))->getDataPtr();
+      std::atomic_store_explicit(MemoryPtr, DataPtr,
+                                 std::memory_order_relaxed);
+    }
+    ExecutionContext.Memories = ModInst->MemoryPtrs.data();
+    ExecutionContext.Globals = ModInst->GlobalPtrs.data();
+  }
+
+  {
+    // Get symbol and execute the function.
+    Fault FaultHandler;
+    const bool EnclosingGuarded = Fault::exchangeGuarded(true);
+    cxx20::scope_exit GuardedHolder(
+        [&]() noexcept { Fault::exchangeGuarded(EnclosingGuarded); });
+    uint32_t Code = PREPARE_FAULT(FaultHandler);
+    if (auto Err = ErrCode(static_cast<ErrCategory>(Code >> 24), Code);
+        unlikely(Err != ErrCode::Value::Success)) {
+      if (Err != ErrCode::Value::Terminated) {
+        spdlog::error(Err);
+      }
+      return Unexpect(Err);
+    }
+    Wrapper(&ExecutionContext, Function, Args.data(), Rets.data());
+  }
+
+  // Push returns back to stack.
+  if (!IsInPlace) {
+    for (uint32_t I = 0; I < Rets.size(); ++I) {
+      StackMgr.push(Rets[I]);
+    }
+  }
+
+  // For compiled function case, the continuation will be the continuation
+  // from the popped frame, as the host function case.
+  return StackMgr.popFrame() + (IsTailCall ? 1 : 0);
+}
+
 Expect<void> Executor::branchToLabel(Runtime::StackManager &StackMgr,
                                      uint32_t EraseBegin, uint32_t EraseEnd,
                                      int32_t PCOffset,
@@ -187,6 +287,13 @@ Expect<void> Executor::branchToLabel(Runtime::StackManager &StackMgr,
     return Unexpect(ErrCode::Value::Interrupted);
   }
 
+  // Count the loop back-edges for the tier-up.
+  if (PCOffset <= 0 && TierUp) {
+    if (auto *Tier = StackMgr.getTierUp()) {
+      TierUp->countLoop(*Tier);
+    }
+  }
+
   StackMgr.stackErase(EraseBegin, EraseEnd);
   // PC need to -1 here because the PC will increase in the next iteration.
   PC += (PCOffset - 1);
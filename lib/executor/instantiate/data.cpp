@@ -49,7 +49,7 @@ Expect<void> Executor::instantiate(Runtime::StackManager &StackMgr,
     }
 
     // Create and add the data instance into the module instance.
-    ModInst.addData(Offset, DataSeg.getData());
+    ModInst.addData(Offset, DataSeg.getData(), DataSeg.getDataHolder());
   }
   return {};
 }
@@ -3,20 +3,24 @@
 
 #include "executor/executor.h"
 
+#include "common/log.h"
+
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace WasmEdge {
 namespace Executor {
 
 // Instantiate function instance. See "include/executor/executor.h".
 Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
-                                   const AST::FunctionSection &FuncSec,
-                                   const AST::CodeSection &CodeSec) {
+                                   const AST::Module &Mod) {
 
   // Get the function type indices.
-  auto TypeIdxs = FuncSec.getContent();
-  auto CodeSegs = CodeSec.getContent();
+  auto TypeIdxs = Mod.getFunctionSection().getContent();
+  auto CodeSegs = Mod.getCodeSection().getContent();
 
   if (CodeSegs.size() == 0) {
     return {};
@@ -32,13 +36,271 @@ Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
       ModInst.addFunc(*FuncType, std::move(Symbol));
     }
   } else {
+    // The instruction counting, the gas measuring, the compiling of the
+    // tier-up, and the profiling are based on the original instructions, so
+    // skip the fusion when they are enabled. The profiles are recorded by the
+    // stack-based interpreter only, and keyed by the hash of the binary.
+    const auto &StatConf = Conf.getStatisticsConfigure();
+    const bool IsProfiled = Conf.getRuntimeConfigure().isProfiling() &&
+                            !Mod.getHash().empty();
+    const bool IsTiered = TierUp != nullptr && !IsProfiled;
+    const bool IsFused = Conf.getRuntimeConfigure().isInstructionFusion() &&
+                         !StatConf.isInstructionCounting() &&
+                         !StatConf.isCostMeasuring() && !IsTiered &&
+                         !IsProfiled;
+    const bool IsLowered =
+        Conf.getRuntimeConfigure().isRegisterIR() && !IsProfiled;
+    // The block costs depend on the cost table of the statistics, which may
+    // change between the instantiations. The profile counters belong to the
+    // executor which collects them. Not to share the metered or the profiled
+    // code.
+    const bool IsMetered = Stat && StatConf.isCostMeasuring();
+    const bool IsShared = !IsMetered && !IsProfiled;
+
+    // Reuse the code prepared under the same configuration.
+    if (IsShared) {
+      if (auto Code = Mod.getPreparedCode();
+          Code && Code->IsFused == IsFused && Code->IsLowered == IsLowered &&
+          Code->IsTiered == IsTiered) {
+        for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+          auto *FuncType = *ModInst.getFuncType(TypeIdxs[I]);
+          ModInst.addFunc(*FuncType, *ModInst.getFuncTypeID(TypeIdxs[I]),
+                          Code->Funcs[I]);
+        }
+        if (Code->CallCacheNum > 0) {
+          ModInst.setCallCacheNum(Code->CallCacheNum);
+        }
+        return {};
+      }
+    }
+
     // Iterate through the code segments to instantiate function instances.
+    // The function bodies deferred by the lazy loading are prepared on their
+    // first calls, which use the inline caches for each type of the indirect
+    // calls after the ones of the call sites.
+    const uint32_t FuncBase = ModInst.getFuncNum();
+    bool HasLazy = false;
     for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
       // Create and add the function instance into the module instance.
       auto *FuncType = *ModInst.getFuncType(TypeIdxs[I]);
-      ModInst.addFunc(*FuncType, CodeSegs[I].getLocals(),
-                      CodeSegs[I].getExpr().getInstrs());
+      if (CodeSegs[I].isLazy()) {
+        auto Body =
+            std::make_unique<Runtime::Instance::FunctionInstance::LazyBody>();
+        Body->Decoder = Mod.getCodeDecoder();
+        Body->Checker = Mod.getCodeChecker();
+        Body->Holder = CodeSegs[I].getBodyHolder();
+        Body->Body = CodeSegs[I].getBody();
+        Body->Offset = CodeSegs[I].getBodyOffset();
+        Body->TypeIdx = TypeIdxs[I];
+        Body->IsFused = IsFused;
+        Body->IsLowered = IsLowered;
+        Body->IsMetered = IsMetered;
+        Body->IsProfiled = IsProfiled;
+        ModInst.addFunc(
+            *FuncType, *ModInst.getFuncTypeID(TypeIdxs[I]),
+            std::make_shared<Runtime::Instance::FunctionInstance::WasmFunction>(
+                CodeSegs[I].getLocals(), std::move(Body)));
+        HasLazy = true;
+      } else {
+        ModInst.addFunc(*FuncType, CodeSegs[I].getLocals(),
+                        CodeSegs[I].getExpr().getInstrs());
+      }
+    }
+
+    // Assign the inline caches to the indirect call sites.
+    uint32_t CacheNum = 0;
+    for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+      for (auto &Instr : (*ModInst.getFunc(FuncBase + I))->getMutableInstrs()) {
+        if (Instr.getOpCode() == OpCode::Call_indirect ||
+            Instr.getOpCode() == OpCode::Return_call_indirect) {
+          Instr.setCallCacheIndex(CacheNum++);
+        }
+      }
+    }
+    if (HasLazy) {
+      for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+        auto *FuncInst = *ModInst.getFunc(FuncBase + I);
+        if (FuncInst->isPending()) {
+          FuncInst->getWasmFunction()->Lazy->CacheBase = CacheNum;
+        }
+      }
+      CacheNum += ModInst.getFuncTypeNum();
+    }
+    if (CacheNum > 0) {
+      ModInst.setCallCacheNum(CacheNum);
+    }
+
+    // Count the calls and the loop back-edges of the functions for the
+    // tier-up, which compiles the functions with the types of the module.
+    if (IsTiered) {
+      using FunctionInstance = Runtime::Instance::FunctionInstance;
+      auto TierMod = std::make_shared<FunctionInstance::TierUpModule>();
+      const auto &Types = Mod.getTypeSection().getContent();
+      TierMod->Types.assign(Types.begin(), Types.end());
+      for (const auto &ImpDesc : Mod.getImportSection().getContent()) {
+        if (ImpDesc.getExternalType() == ExternalType::Function) {
+          TierMod->FuncTypeIdxs.push_back(ImpDesc.getExternalFuncTypeIdx());
+        } else if (ImpDesc.getExternalType() == ExternalType::Global) {
+          TierMod->GlobalTypes.push_back(
+              ImpDesc.getExternalGlobalType().getValType());
+        }
+      }
+      const auto ImportFuncNum =
+          static_cast<uint32_t>(TierMod->FuncTypeIdxs.size());
+      TierMod->FuncTypeIdxs.insert(TierMod->FuncTypeIdxs.end(),
+                                   TypeIdxs.begin(), TypeIdxs.end());
+      for (const auto &GlobSeg : Mod.getGlobalSection().getContent()) {
+        TierMod->GlobalTypes.push_back(GlobSeg.getGlobalType().getValType());
+      }
+      for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+        const auto &Code = (*ModInst.getFunc(FuncBase + I))->getSharedCode();
+        auto Tier = std::make_unique<FunctionInstance::TierUp>();
+        Tier->Module = TierMod;
+        Tier->Code = Code;
+        Tier->FuncIdx = ImportFuncNum + I;
+        Code->Tier = std::move(Tier);
+      }
+    }
+
+    // Allocate the branch profiles, and register the functions for collecting
+    // the profiles after the execution.
+    if (IsProfiled) {
+      for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+        if (auto *FuncInst = *ModInst.getFunc(FuncBase + I);
+            !FuncInst->isPending()) {
+          profileFunction(*FuncInst);
+        }
+      }
+      registerProfile(ModInst, Mod, FuncBase);
+    }
+
+    // Lower the function bodies after all the functions are added, because
+    // the lowering needs the types of the called functions.
+    if (IsLowered) {
+      for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+        auto *FuncInst = *ModInst.getFunc(FuncBase + I);
+        if (!FuncInst->isPending()) {
+          FuncInst->setRegisterCode(lowerFunction(
+              ModInst.FuncInsts, ModInst.FuncTypes, *FuncInst));
+        }
+      }
+    }
+
+    // Fuse the instructions after lowering, which reads the original
+    // instructions. The register-based IR wins over the fusion: the lowered
+    // functions are not fused, and the fusion only applies to the functions
+    // which the lowering does not support.
+    if (IsFused) {
+      for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+        if (auto *FuncInst = *ModInst.getFunc(FuncBase + I);
+            !FuncInst->isPending() && FuncInst->getRegisterCode() == nullptr) {
+          fuseInstructions(*FuncInst);
+        }
+      }
+    }
+
+    // Assign the threaded dispatch handlers to the instructions after the
+    // fusion, for the functions run by the stack-based interpreter.
+    for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+      if (auto *FuncInst = *ModInst.getFunc(FuncBase + I);
+          !FuncInst->isPending() && FuncInst->getRegisterCode() == nullptr) {
+        threadInstructions(*FuncInst);
+      }
+    }
+
+    // Precompute the block costs with the cost table of the statistics.
+    if (IsMetered) {
+      for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+        if (auto *FuncInst = *ModInst.getFunc(FuncBase + I);
+            !FuncInst->isPending()) {
+          meterBlocks(*FuncInst);
+        }
+      }
+    }
+    if (!IsShared) {
+      return {};
+    }
+
+    // Share the prepared code with the later instantiations.
+    auto Code = std::make_shared<Runtime::Instance::ModuleCode>();
+    Code->IsFused = IsFused;
+    Code->IsLowered = IsLowered;
+    Code->IsTiered = IsTiered;
+    Code->CallCacheNum = CacheNum;
+    Code->Funcs.reserve(CodeSegs.size());
+    for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+      Code->Funcs.push_back((*ModInst.getFunc(FuncBase + I))->getSharedCode());
+    }
+    Mod.setPreparedCode(std::move(Code));
+  }
+  return {};
+}
+
+// Prepare the deferred function body. See "include/executor/executor.h".
+Expect<void>
+Executor::prepareFunction(const Runtime::Instance::FunctionInstance &Func) {
+  auto *Code = Func.getWasmFunction();
+  auto &Lazy = *Code->Lazy;
+  std::call_once(Lazy.Once, [&]() {
+    // Decode and validate the function body.
+    if (unlikely(!Lazy.Checker)) {
+      spdlog::error(ErrCode::Value::NotValidated);
+      Lazy.Error = ErrCode::Value::NotValidated;
+      return;
+    }
+    auto Instrs = Lazy.Decoder->decode(Lazy.Body, Lazy.Offset);
+    if (unlikely(!Instrs)) {
+      Lazy.Error = Instrs.error();
+      return;
     }
+    if (auto Res = Lazy.Checker->validate(*Instrs, Lazy.TypeIdx, Code->Locals);
+        unlikely(!Res)) {
+      Lazy.Error = Res.error();
+      return;
+    }
+    // Reserve one more slot as the constructor of the function instance does,
+    // so that the end of the loaded body never aliases the other bodies.
+    Code->Instrs = std::move(*Instrs);
+    Code->Instrs.reserve(Code->Instrs.size() + 1);
+
+    // Assign the inline caches for each type to the indirect call sites.
+    for (auto &Instr : Code->Instrs) {
+      if (Instr.getOpCode() == OpCode::Call_indirect ||
+          Instr.getOpCode() == OpCode::Return_call_indirect) {
+        Instr.setCallCacheIndex(Lazy.CacheBase + Instr.getTargetIndex());
+      }
+    }
+
+    // Prepare the code in the same way as the instantiation. The function
+    // instance is only modified in its shared code here.
+    auto &FuncInst = const_cast<Runtime::Instance::FunctionInstance &>(Func);
+    const auto *ModInst = Func.getModule();
+    if (Lazy.IsLowered) {
+      FuncInst.setRegisterCode(
+          lowerFunction(ModInst->FuncInsts, ModInst->FuncTypes, Func));
+    }
+    if (Lazy.IsFused && FuncInst.getRegisterCode() == nullptr) {
+      fuseInstructions(FuncInst);
+    }
+    if (FuncInst.getRegisterCode() == nullptr) {
+      threadInstructions(FuncInst);
+    }
+    if (Lazy.IsMetered) {
+      meterBlocks(FuncInst);
+    }
+    if (Lazy.IsProfiled) {
+      profileFunction(FuncInst);
+    }
+
+    // Release the decoding context which is not needed anymore.
+    Lazy.Decoder.reset();
+    Lazy.Checker.reset();
+    Lazy.Holder.reset();
+    Lazy.Body = {};
+    Code->IsPending.store(false, std::memory_order_release);
+  });
+  if (unlikely(Lazy.Error != ErrCode::Value::Success)) {
+    return Unexpect(Lazy.Error);
   }
   return {};
 }
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+/// Fusion pattern of the instruction sequence.
+struct FusionPattern {
+  OpCode Fused;
+  std::initializer_list<OpCode> Seq;
+};
+
+/// Fusion patterns in the matching order. The longer patterns with the same
+/// prefix must be placed before the shorter ones.
+const std::array<FusionPattern, 5> Patterns = {{
+    {OpCode::Fused__local_get_i32_const_i32_add_local_set,
+     {OpCode::Local__get, OpCode::I32__const, OpCode::I32__add,
+      OpCode::Local__set}},
+    {OpCode::Fused__local_get_i32_const_i32_add,
+     {OpCode::Local__get, OpCode::I32__const, OpCode::I32__add}},
+    {OpCode::Fused__local_get_local_get_i32_add,
+     {OpCode::Local__get, OpCode::Local__get, OpCode::I32__add}},
+    {OpCode::Fused__local_get_local_get,
+     {OpCode::Local__get, OpCode::Local__get}},
+    {OpCode::Fused__i32_const_br_if, {OpCode::I32__const, OpCode::Br_if}},
+}};
+
+} // namespace
+
+// Fuse the instruction sequences. See "include/executor/executor.h".
+void Executor::fuseInstructions(
+    Runtime::Instance::FunctionInstance &Func) const {
+  // Only the head instruction of a matched sequence is replaced by the fused
+  // opcode, and the rest are kept in place to provide their immediates. The
+  // instruction count is unchanged, so the PC offsets of the branches computed
+  // by the validator are still valid. The sequences contain no block
+  // instructions, therefore no branch can land inside a fused sequence.
+  auto Instrs = Func.getMutableInstrs();
+  const size_t Size = Instrs.size();
+  size_t I = 0;
+  while (I < Size) {
+    size_t Len = 1;
+    for (const auto &Pattern : Patterns) {
+      const size_t PatternLen = Pattern.Seq.size();
+      if (I + PatternLen > Size) {
+        continue;
+      }
+      size_t J = 0;
+      for (OpCode Code : Pattern.Seq) {
+        if (Instrs[I + J].getOpCode() != Code) {
+          break;
+        }
+        ++J;
+      }
+      if (J == PatternLen) {
+        Instrs[I].setOpCode(Pattern.Fused);
+        Len = PatternLen;
+        break;
+      }
+    }
+    I += Len;
+  }
+}
+
+} // namespace Executor
+} // namespace WasmEdge
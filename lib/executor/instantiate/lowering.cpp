@@ -0,0 +1,708 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+using RegInstr = Runtime::RegIR::Instruction;
+
+/// Lowering context of a validated function body into the register-based IR.
+///
+/// The operand stack is simulated with a virtual stack of registers. The
+/// `local.get` and the constants only push their registers into the virtual
+/// stack without generating instructions, and the values are materialized into
+/// their operand stack slots only when required (control flow merges, calls,
+/// and overwriting of the referenced local). The branch arities and the stack
+/// heights of the labels are taken from the jump descriptors computed by the
+/// validator.
+class RegisterLowering {
+public:
+  RegisterLowering(Span<Runtime::Instance::FunctionInstance *const> Funcs,
+                   Span<const AST::FunctionType> Types,
+                   const Runtime::Instance::FunctionInstance &Func) noexcept
+      : Funcs(Funcs), Types(Types), Instrs(Func.getInstrs()),
+        Code(std::make_unique<Runtime::RegIR::Code>()) {
+    const auto &FuncType = Func.getFuncType();
+    Code->LocalNum =
+        static_cast<uint32_t>(FuncType.getParamTypes().size()) +
+        Func.getLocalNum();
+    RetsN = static_cast<uint32_t>(FuncType.getReturnTypes().size());
+  }
+
+  std::unique_ptr<Runtime::RegIR::Code> lower() {
+    // The function body is an implicit block which label is the return.
+    Frames.emplace_back(OpCode::Block, 0, RetsN, RetsN);
+    for (Pos = 0; Pos < Instrs.size(); ++Pos) {
+      const auto &Instr = Instrs[Pos];
+      if (Frames.back().IsUnreachable) {
+        // Skip the dead code until the end or else of the current block.
+        switch (Instr.getOpCode()) {
+        case OpCode::Block:
+        case OpCode::Loop:
+        case OpCode::If:
+          DeadDepth++;
+          continue;
+        case OpCode::Else:
+          if (DeadDepth > 0) {
+            continue;
+          }
+          break;
+        case OpCode::End:
+          if (DeadDepth > 0) {
+            DeadDepth--;
+            continue;
+          }
+          break;
+        default:
+          continue;
+        }
+      }
+      if (!lowerInstr(Instr)) {
+        return nullptr;
+      }
+    }
+
+    // Relocate the constants to the tail of the frame.
+    const uint32_t ConstBase = Code->LocalNum + Code->StackNum;
+    auto Relocate = [ConstBase](uint32_t &Reg) {
+      if (Reg >= kConstMark) {
+        Reg = Reg - kConstMark + ConstBase;
+      }
+    };
+    for (auto &Instr : Code->Instrs) {
+      Relocate(Instr.A);
+      Relocate(Instr.B);
+    }
+    return std::move(Code);
+  }
+
+private:
+  /// Register index mark of constants before relocation.
+  static inline constexpr uint32_t kConstMark = UINT32_C(0x80000000);
+  /// Invalid instruction index.
+  static inline constexpr uint32_t kInvalid = UINT32_MAX;
+
+  struct Fixup {
+    /// Index of the branch instruction or the br_table label.
+    uint32_t Idx;
+    bool IsLabel;
+  };
+
+  struct Frame {
+    Frame(OpCode C, uint32_t H, uint32_t A, uint32_t R) noexcept
+        : Code(C), Height(H), Arity(A), Results(R) {}
+    OpCode Code;
+    /// Operand stack height at the beginning of the block.
+    uint32_t Height;
+    /// Label arity.
+    uint32_t Arity;
+    /// Block result count.
+    uint32_t Results;
+    /// Start instruction index of the loop.
+    uint32_t Start = kInvalid;
+    /// Index of the conditional jump to the else branch of the if.
+    uint32_t Else = kInvalid;
+    std::vector<Fixup> Fixups;
+    bool IsUnreachable = false;
+  };
+
+  uint32_t height() const noexcept {
+    return static_cast<uint32_t>(Stack.size());
+  }
+  uint32_t slot(uint32_t Height) const noexcept {
+    return Code->LocalNum + Height;
+  }
+  uint32_t current() const noexcept {
+    return static_cast<uint32_t>(Code->Instrs.size());
+  }
+
+  uint32_t emit(OpCode Op, uint32_t Dst = 0, uint32_t A = 0, uint32_t B = 0,
+                uint16_t Index = 0) {
+    Code->Instrs.push_back({Op, Index, Dst, A, B});
+    Code->Origins.push_back(Pos);
+    return current() - 1;
+  }
+
+  /// Push a register into the virtual stack.
+  void push(uint32_t Reg) {
+    Stack.push_back(Reg);
+    Code->StackNum = std::max(Code->StackNum, height());
+  }
+  /// Push the value of a new operand stack slot and return its register.
+  uint32_t pushSlot() {
+    push(slot(height()));
+    return Stack.back();
+  }
+  uint32_t pop() {
+    const uint32_t Reg = Stack.back();
+    Stack.pop_back();
+    return Reg;
+  }
+
+  /// Record the last emitted instruction as the definition of the stack top.
+  void define() noexcept { LastDef = current() - 1; }
+
+  /// Move the value at the stack height into its operand stack slot.
+  void materialize(uint32_t Height) {
+    if (Stack[Height] != slot(Height)) {
+      emit(OpCode::Local__set, slot(Height), Stack[Height]);
+      Stack[Height] = slot(Height);
+    }
+  }
+  void materializeTop(uint32_t N) {
+    for (uint32_t H = height() - N; H < height(); ++H) {
+      materialize(H);
+    }
+  }
+  void materializeAll() { materializeTop(height()); }
+  /// Materialize the values which are referencing the local.
+  void materializeLocal(uint32_t Idx) {
+    for (uint32_t H = 0; H < height(); ++H) {
+      if (Stack[H] == Idx) {
+        materialize(H);
+      }
+    }
+  }
+  bool isReferenced(uint32_t Idx, uint32_t N) const noexcept {
+    return std::find(Stack.begin(), Stack.begin() + N, Idx) !=
+           Stack.begin() + N;
+  }
+
+  uint32_t getConst(ValVariant Val) {
+    const uint128_t Num = Val.get<uint128_t>();
+    const auto Key = std::make_pair(static_cast<uint64_t>(Num >> 64),
+                                    static_cast<uint64_t>(Num));
+    auto [It, Added] = ConstIdx.try_emplace(
+        Key, static_cast<uint32_t>(Code->Constants.size()));
+    if (Added) {
+      Code->Constants.push_back(Val);
+    }
+    return kConstMark + It->second;
+  }
+
+  /// Bind the label at the current instruction.
+  void bind(Frame &F) {
+    const uint32_t Target = current();
+    for (const auto &Fix : F.Fixups) {
+      if (Fix.IsLabel) {
+        Code->Labels[Fix.Idx] = Target;
+      } else if (Code->Instrs[Fix.Idx].Code == OpCode::Br) {
+        Code->Instrs[Fix.Idx].A = Target;
+      } else {
+        Code->Instrs[Fix.Idx].B = Target;
+      }
+    }
+    F.Fixups.clear();
+    LastDef = kInvalid;
+  }
+
+  Frame &getFrame(uint32_t Depth) noexcept {
+    return Frames[Frames.size() - 1 - Depth];
+  }
+
+  std::pair<uint32_t, uint32_t> getBlockArity(const BlockType &BType) const {
+    if (BType.IsValType) {
+      return {0, BType.Data.Type == ValType::None ? 0 : 1};
+    }
+    const auto &FuncType = Types[BType.Data.Idx];
+    return {static_cast<uint32_t>(FuncType.getParamTypes().size()),
+            static_cast<uint32_t>(FuncType.getReturnTypes().size())};
+  }
+
+  /// Move the branch values into the label slots. Return true if moved.
+  bool moveBranchValues(const AST::Instruction::JumpDescriptor &Jump) {
+    const uint32_t Base = height() - Jump.StackEraseBegin;
+    const uint32_t Src = height() - Jump.StackEraseEnd;
+    bool Moved = false;
+    for (uint32_t I = 0; I < Jump.StackEraseEnd; ++I) {
+      if (Stack[Src + I] != slot(Base + I)) {
+        emit(OpCode::Local__set, slot(Base + I), Stack[Src + I]);
+        Moved = true;
+      }
+    }
+    return Moved;
+  }
+  bool needMoveBranchValues(const AST::Instruction::JumpDescriptor &Jump) {
+    const uint32_t Base = height() - Jump.StackEraseBegin;
+    const uint32_t Src = height() - Jump.StackEraseEnd;
+    for (uint32_t I = 0; I < Jump.StackEraseEnd; ++I) {
+      if (Stack[Src + I] != slot(Base + I)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Emit the unconditional jump to the label.
+  void jump(Frame &F) {
+    if (F.Code == OpCode::Loop) {
+      emit(OpCode::Br, 0, F.Start);
+    } else {
+      F.Fixups.push_back({emit(OpCode::Br), false});
+    }
+  }
+
+  void setUnreachable() noexcept {
+    Frames.back().IsUnreachable = true;
+    DeadDepth = 0;
+  }
+
+  bool lowerInstr(const AST::Instruction &Instr) {
+    switch (Instr.getOpCode()) {
+    case OpCode::Unreachable:
+      emit(OpCode::Unreachable);
+      setUnreachable();
+      return true;
+    case OpCode::Nop:
+      return true;
+
+    case OpCode::Block:
+    case OpCode::Loop:
+    case OpCode::If: {
+      auto [ParamsN, ResultsN] = getBlockArity(Instr.getBlockType());
+      uint32_t Cond = 0;
+      if (Instr.getOpCode() == OpCode::If) {
+        if (ParamsN > 0) {
+          // The params of the else branch would have been overwritten.
+          return false;
+        }
+        Cond = pop();
+      }
+      materializeAll();
+      Frames.emplace_back(Instr.getOpCode(), height() - ParamsN,
+                          Instr.getOpCode() == OpCode::Loop ? ParamsN
+                                                            : ResultsN,
+                          ResultsN);
+      if (Instr.getOpCode() == OpCode::Loop) {
+        Frames.back().Start = current();
+        LastDef = kInvalid;
+      } else if (Instr.getOpCode() == OpCode::If) {
+        Frames.back().Else = emit(OpCode::If, 0, Cond);
+      }
+      return true;
+    }
+    case OpCode::Else: {
+      auto &F = Frames.back();
+      if (!F.IsUnreachable) {
+        materializeAll();
+        F.Fixups.push_back({emit(OpCode::Br), false});
+      }
+      Code->Instrs[F.Else].B = current();
+      F.Else = kInvalid;
+      F.IsUnreachable = false;
+      Stack.resize(F.Height);
+      LastDef = kInvalid;
+      return true;
+    }
+    case OpCode::End: {
+      auto &F = Frames.back();
+      if (!F.IsUnreachable) {
+        materializeAll();
+      }
+      if (F.Else != kInvalid) {
+        Code->Instrs[F.Else].B = current();
+      }
+      bind(F);
+      Stack.resize(F.Height);
+      for (uint32_t I = 0; I < F.Results; ++I) {
+        pushSlot();
+      }
+      Frames.pop_back();
+      if (Frames.empty()) {
+        // End of the function body.
+        emit(OpCode::Return);
+      }
+      return true;
+    }
+
+    case OpCode::Br: {
+      moveBranchValues(Instr.getJump());
+      jump(getFrame(Instr.getJump().TargetIndex));
+      setUnreachable();
+      return true;
+    }
+    case OpCode::Br_if: {
+      const uint32_t Cond = pop();
+      auto &F = getFrame(Instr.getJump().TargetIndex);
+      if (!needMoveBranchValues(Instr.getJump())) {
+        if (F.Code == OpCode::Loop) {
+          emit(OpCode::Br_if, 0, Cond, F.Start);
+        } else {
+          F.Fixups.push_back({emit(OpCode::Br_if, 0, Cond), false});
+        }
+      } else {
+        const uint32_t Skip = emit(OpCode::If, 0, Cond);
+        moveBranchValues(Instr.getJump());
+        jump(F);
+        Code->Instrs[Skip].B = current();
+        LastDef = kInvalid;
+      }
+      return true;
+    }
+    case OpCode::Br_table: {
+      const uint32_t Cond = pop();
+      auto LabelList = Instr.getLabelList();
+      const uint32_t Offset = static_cast<uint32_t>(Code->Labels.size());
+      Code->Labels.resize(Offset + LabelList.size(), 0);
+      emit(OpCode::Br_table, static_cast<uint32_t>(LabelList.size()), Cond,
+           Offset);
+      for (uint32_t I = 0; I < LabelList.size(); ++I) {
+        auto &F = getFrame(LabelList[I].TargetIndex);
+        if (!needMoveBranchValues(LabelList[I])) {
+          if (F.Code == OpCode::Loop) {
+            Code->Labels[Offset + I] = F.Start;
+          } else {
+            F.Fixups.push_back({Offset + I, true});
+          }
+        } else {
+          // Move the branch values in a stub for this label.
+          Code->Labels[Offset + I] = current();
+          moveBranchValues(LabelList[I]);
+          jump(F);
+        }
+      }
+      setUnreachable();
+      return true;
+    }
+    case OpCode::Return: {
+      for (uint32_t I = 0; I < RetsN; ++I) {
+        const uint32_t Src = Stack[height() - RetsN + I];
+        if (Src != slot(I)) {
+          emit(OpCode::Local__set, slot(I), Src);
+        }
+      }
+      emit(OpCode::Return);
+      setUnreachable();
+      return true;
+    }
+    case OpCode::Call: {
+      const auto *Callee = Funcs[Instr.getTargetIndex()];
+      return lowerCall(Instr, Callee->getFuncType(), 0);
+    }
+    case OpCode::Call_indirect: {
+      if (Instr.getSourceIndex() > UINT16_MAX) {
+        return false;
+      }
+      return lowerCall(Instr, Types[Instr.getTargetIndex()], pop());
+    }
+
+    case OpCode::Drop:
+      pop();
+      return true;
+    case OpCode::Select:
+    case OpCode::Select_t: {
+      const uint32_t Cond = pop();
+      const uint32_t Val2 = pop();
+      materialize(height() - 1);
+      emit(OpCode::Select, Stack.back(), Val2, Cond);
+      return true;
+    }
+
+    case OpCode::Local__get:
+      push(Instr.getTargetIndex());
+      return true;
+    case OpCode::Local__set:
+    case OpCode::Local__tee: {
+      const uint32_t Idx = Instr.getTargetIndex();
+      const bool IsTee = Instr.getOpCode() == OpCode::Local__tee;
+      const uint32_t Val = IsTee ? Stack.back() : pop();
+      if (Val == Idx) {
+        return true;
+      }
+      const uint32_t Others = height() - (IsTee ? 1 : 0);
+      if (LastDef != kInvalid && LastDef == current() - 1 &&
+          Code->Instrs.back().Dst == Val && !isReferenced(Idx, Others)) {
+        // Let the previous instruction write the local directly.
+        Code->Instrs.back().Dst = Idx;
+        if (IsTee) {
+          Stack.back() = Idx;
+        }
+      } else {
+        materializeLocal(Idx);
+        emit(OpCode::Local__set, Idx, Val);
+      }
+      LastDef = kInvalid;
+      return true;
+    }
+    case OpCode::Global__get:
+      emit(OpCode::Global__get, pushSlot(), Instr.getTargetIndex());
+      define();
+      return true;
+    case OpCode::Global__set:
+      emit(OpCode::Global__set, 0, pop(), Instr.getTargetIndex());
+      return true;
+
+    case OpCode::I32__load:
+    case OpCode::I64__load:
+    case OpCode::F32__load:
+    case OpCode::F64__load:
+    case OpCode::I32__load8_s:
+    case OpCode::I32__load8_u:
+    case OpCode::I32__load16_s:
+    case OpCode::I32__load16_u:
+    case OpCode::I64__load8_s:
+    case OpCode::I64__load8_u:
+    case OpCode::I64__load16_s:
+    case OpCode::I64__load16_u:
+    case OpCode::I64__load32_s:
+    case OpCode::I64__load32_u: {
+      if (Instr.getTargetIndex() > UINT16_MAX) {
+        return false;
+      }
+      const uint32_t Addr = pop();
+      emit(Instr.getOpCode(), pushSlot(), Addr, 0,
+           static_cast<uint16_t>(Instr.getTargetIndex()));
+      define();
+      return true;
+    }
+    case OpCode::I32__store:
+    case OpCode::I64__store:
+    case OpCode::F32__store:
+    case OpCode::F64__store:
+    case OpCode::I32__store8:
+    case OpCode::I32__store16:
+    case OpCode::I64__store8:
+    case OpCode::I64__store16:
+    case OpCode::I64__store32: {
+      if (Instr.getTargetIndex() > UINT16_MAX) {
+        return false;
+      }
+      const uint32_t Val = pop();
+      const uint32_t Addr = pop();
+      emit(Instr.getOpCode(), 0, Addr, Val,
+           static_cast<uint16_t>(Instr.getTargetIndex()));
+      return true;
+    }
+    case OpCode::Memory__size:
+    case OpCode::Memory__grow: {
+      if (Instr.getTargetIndex() > UINT16_MAX) {
+        return false;
+      }
+      const uint32_t N =
+          Instr.getOpCode() == OpCode::Memory__grow ? pop() : UINT32_C(0);
+      emit(Instr.getOpCode(), pushSlot(), N, 0,
+           static_cast<uint16_t>(Instr.getTargetIndex()));
+      define();
+      return true;
+    }
+
+    case OpCode::I32__const:
+    case OpCode::I64__const:
+    case OpCode::F32__const:
+    case OpCode::F64__const:
+      push(getConst(Instr.getNum()));
+      return true;
+
+    case OpCode::I32__eqz:
+    case OpCode::I64__eqz:
+    case OpCode::I32__clz:
+    case OpCode::I32__ctz:
+    case OpCode::I32__popcnt:
+    case OpCode::I64__clz:
+    case OpCode::I64__ctz:
+    case OpCode::I64__popcnt:
+    case OpCode::F32__abs:
+    case OpCode::F32__neg:
+    case OpCode::F32__ceil:
+    case OpCode::F32__floor:
+    case OpCode::F32__trunc:
+    case OpCode::F32__nearest:
+    case OpCode::F32__sqrt:
+    case OpCode::F64__abs:
+    case OpCode::F64__neg:
+    case OpCode::F64__ceil:
+    case OpCode::F64__floor:
+    case OpCode::F64__trunc:
+    case OpCode::F64__nearest:
+    case OpCode::F64__sqrt:
+    case OpCode::I32__wrap_i64:
+    case OpCode::I32__trunc_f32_s:
+    case OpCode::I32__trunc_f32_u:
+    case OpCode::I32__trunc_f64_s:
+    case OpCode::I32__trunc_f64_u:
+    case OpCode::I64__extend_i32_s:
+    case OpCode::I64__extend_i32_u:
+    case OpCode::I64__trunc_f32_s:
+    case OpCode::I64__trunc_f32_u:
+    case OpCode::I64__trunc_f64_s:
+    case OpCode::I64__trunc_f64_u:
+    case OpCode::F32__convert_i32_s:
+    case OpCode::F32__convert_i32_u:
+    case OpCode::F32__convert_i64_s:
+    case OpCode::F32__convert_i64_u:
+    case OpCode::F32__demote_f64:
+    case OpCode::F64__convert_i32_s:
+    case OpCode::F64__convert_i32_u:
+    case OpCode::F64__convert_i64_s:
+    case OpCode::F64__convert_i64_u:
+    case OpCode::F64__promote_f32:
+    case OpCode::I32__reinterpret_f32:
+    case OpCode::I64__reinterpret_f64:
+    case OpCode::F32__reinterpret_i32:
+    case OpCode::F64__reinterpret_i64:
+    case OpCode::I32__extend8_s:
+    case OpCode::I32__extend16_s:
+    case OpCode::I64__extend8_s:
+    case OpCode::I64__extend16_s:
+    case OpCode::I64__extend32_s:
+    case OpCode::I32__trunc_sat_f32_s:
+    case OpCode::I32__trunc_sat_f32_u:
+    case OpCode::I32__trunc_sat_f64_s:
+    case OpCode::I32__trunc_sat_f64_u:
+    case OpCode::I64__trunc_sat_f32_s:
+    case OpCode::I64__trunc_sat_f32_u:
+    case OpCode::I64__trunc_sat_f64_s:
+    case OpCode::I64__trunc_sat_f64_u: {
+      const uint32_t Val = pop();
+      emit(Instr.getOpCode(), pushSlot(), Val);
+      define();
+      return true;
+    }
+    case OpCode::I32__eq:
+    case OpCode::I32__ne:
+    case OpCode::I32__lt_s:
+    case OpCode::I32__lt_u:
+    case OpCode::I32__gt_s:
+    case OpCode::I32__gt_u:
+    case OpCode::I32__le_s:
+    case OpCode::I32__le_u:
+    case OpCode::I32__ge_s:
+    case OpCode::I32__ge_u:
+    case OpCode::I64__eq:
+    case OpCode::I64__ne:
+    case OpCode::I64__lt_s:
+    case OpCode::I64__lt_u:
+    case OpCode::I64__gt_s:
+    case OpCode::I64__gt_u:
+    case OpCode::I64__le_s:
+    case OpCode::I64__le_u:
+    case OpCode::I64__ge_s:
+    case OpCode::I64__ge_u:
+    case OpCode::F32__eq:
+    case OpCode::F32__ne:
+    case OpCode::F32__lt:
+    case OpCode::F32__gt:
+    case OpCode::F32__le:
+    case OpCode::F32__ge:
+    case OpCode::F64__eq:
+    case OpCode::F64__ne:
+    case OpCode::F64__lt:
+    case OpCode::F64__gt:
+    case OpCode::F64__le:
+    case OpCode::F64__ge:
+    case OpCode::I32__add:
+    case OpCode::I32__sub:
+    case OpCode::I32__mul:
+    case OpCode::I32__div_s:
+    case OpCode::I32__div_u:
+    case OpCode::I32__rem_s:
+    case OpCode::I32__rem_u:
+    case OpCode::I32__and:
+    case OpCode::I32__or:
+    case OpCode::I32__xor:
+    case OpCode::I32__shl:
+    case OpCode::I32__shr_s:
+    case OpCode::I32__shr_u:
+    case OpCode::I32__rotl:
+    case OpCode::I32__rotr:
+    case OpCode::I64__add:
+    case OpCode::I64__sub:
+    case OpCode::I64__mul:
+    case OpCode::I64__div_s:
+    case OpCode::I64__div_u:
+    case OpCode::I64__rem_s:
+    case OpCode::I64__rem_u:
+    case OpCode::I64__and:
+    case OpCode::I64__or:
+    case OpCode::I64__xor:
+    case OpCode::I64__shl:
+    case OpCode::I64__shr_s:
+    case OpCode::I64__shr_u:
+    case OpCode::I64__rotl:
+    case OpCode::I64__rotr:
+    case OpCode::F32__add:
+    case OpCode::F32__sub:
+    case OpCode::F32__mul:
+    case OpCode::F32__div:
+    case OpCode::F32__min:
+    case OpCode::F32__max:
+    case OpCode::F32__copysign:
+    case OpCode::F64__add:
+    case OpCode::F64__sub:
+    case OpCode::F64__mul:
+    case OpCode::F64__div:
+    case OpCode::F64__min:
+    case OpCode::F64__max:
+    case OpCode::F64__copysign: {
+      const uint32_t Rhs = pop();
+      const uint32_t Lhs = pop();
+      emit(Instr.getOpCode(), pushSlot(), Lhs, Rhs);
+      define();
+      return true;
+    }
+
+    default:
+      // Other instructions are not supported in the register-based IR.
+      return false;
+    }
+  }
+
+  bool lowerCall(const AST::Instruction &Instr,
+                 const AST::FunctionType &FuncType, uint32_t Idx) {
+    const uint32_t ParamsN =
+        static_cast<uint32_t>(FuncType.getParamTypes().size());
+    const uint32_t ReturnsN =
+        static_cast<uint32_t>(FuncType.getReturnTypes().size());
+    materializeTop(ParamsN);
+    const uint32_t Base = slot(height() - ParamsN);
+    if (Instr.getOpCode() == OpCode::Call) {
+      emit(OpCode::Call, Base, Instr.getTargetIndex());
+    } else {
+      emit(OpCode::Call_indirect, Base, Idx, Instr.getTargetIndex(),
+           static_cast<uint16_t>(Instr.getSourceIndex()));
+    }
+    Stack.resize(height() - ParamsN);
+    for (uint32_t I = 0; I < ReturnsN; ++I) {
+      pushSlot();
+    }
+    return true;
+  }
+
+  Span<Runtime::Instance::FunctionInstance *const> Funcs;
+  Span<const AST::FunctionType> Types;
+  AST::InstrView Instrs;
+  std::unique_ptr<Runtime::RegIR::Code> Code;
+  uint32_t RetsN = 0;
+  /// Index of the current AST instruction.
+  uint32_t Pos = 0;
+  /// Nested block depth in the dead code.
+  uint32_t DeadDepth = 0;
+  /// Index of the instruction defining the stack top.
+  uint32_t LastDef = kInvalid;
+  std::vector<uint32_t> Stack;
+  std::vector<Frame> Frames;
+  std::map<std::pair<uint64_t, uint64_t>, uint32_t> ConstIdx;
+};
+
+} // namespace
+
+std::unique_ptr<Runtime::RegIR::Code>
+Executor::lowerFunction(Span<Runtime::Instance::FunctionInstance *const> Funcs,
+                        Span<const AST::FunctionType> Types,
+                        const Runtime::Instance::FunctionInstance &Func) const {
+  return RegisterLowering(Funcs, Types, Func).lower();
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+/// Check if the instruction transfers the control, so that the next
+/// instruction leads a new block.
+bool isBlockTerminator(OpCode Code) noexcept {
+  switch (Code) {
+  case OpCode::Unreachable:
+  case OpCode::If:
+  case OpCode::Else:
+  case OpCode::End:
+  case OpCode::Br:
+  case OpCode::Br_if:
+  case OpCode::Br_table:
+  case OpCode::Return:
+  case OpCode::Call:
+  case OpCode::Call_indirect:
+  case OpCode::Return_call:
+  case OpCode::Return_call_indirect:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Check if the instruction leaves the execution loop or runs other code
+/// charging the shared cost, so that the local gas should be synced first.
+bool isBlockSyncPoint(OpCode Code) noexcept {
+  switch (Code) {
+  case OpCode::Loop:
+  case OpCode::Call:
+  case OpCode::Call_indirect:
+  case OpCode::Return_call:
+  case OpCode::Return_call_indirect:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Check if the instruction leads a block. The block split by the 24-bit cost
+/// field starts with a non-zero cost, and the zero-cost blocks can be treated
+/// as parts of the previous one.
+bool isBlockLeader(const AST::Instruction *Instr) noexcept {
+  const OpCode Code = Instr->getOpCode();
+  return Instr->getBlockCost() != 0 || Code == OpCode::Loop ||
+         Code == OpCode::End || isBlockTerminator((Instr - 1)->getOpCode());
+}
+
+} // namespace
+
+// Get the cost of the instruction in the block. See
+// "include/executor/executor.h".
+uint64_t Executor::getBlockInstrCost(OpCode Code) const noexcept {
+  if (Code == OpCode::Else) {
+    Code = OpCode::End;
+  }
+  return std::min(Stat->getCostTable()[static_cast<uint16_t>(Code)],
+                  static_cast<uint64_t>(AST::Instruction::MaxBlockCost));
+}
+
+// Find the instruction exceeding the cost limit in the block. See
+// "include/executor/executor.h".
+const AST::Instruction *
+Executor::findBlockTrip(const AST::Instruction *Leader, uint64_t RemainCost,
+                        uint64_t &Prefix) const noexcept {
+  // The instructions in the block run in sequence until its last one. The
+  // block cost is the sum of the instruction costs, so the block over the
+  // remaining cost always has the tripping instruction.
+  Prefix = 0;
+  const auto *It = Leader;
+  do {
+    const uint64_t Cost = getBlockInstrCost(It->getOpCode());
+    if (Prefix + Cost > RemainCost) {
+      return It;
+    }
+    Prefix += Cost;
+    ++It;
+  } while (!isBlockLeader(It));
+  return nullptr;
+}
+
+// Get the cost of the instructions not run in the block. See
+// "include/executor/executor.h".
+uint64_t Executor::getUnrunBlockCost(const AST::Instruction *Instr,
+                                     const AST::Instruction *Trip) const
+    noexcept {
+  // Nothing after the tripping instruction is charged. The function body ends
+  // with the `end` instruction, which has no following instructions in its
+  // block when trapping.
+  if (Instr == Trip || Instr->getOpCode() == OpCode::End) {
+    return 0;
+  }
+  uint64_t Cost = 0;
+  for (const auto *It = Instr + 1; It != Trip && !isBlockLeader(It); ++It) {
+    Cost += getBlockInstrCost(It->getOpCode());
+  }
+  return Cost;
+}
+
+// Sync the pending cost of the trapped execution. See
+// "include/executor/executor.h".
+void Executor::syncTrapCost(const AST::Instruction *Instr,
+                            const AST::Instruction *Trip) noexcept {
+  uint64_t Unrun = Instr ? getUnrunBlockCost(Instr, Trip) : 0;
+  // The cost charged in the block is pending unless the block has been synced.
+  const uint64_t Local = std::min(Unrun, PendingCost);
+  PendingCost -= Local;
+  Unrun -= Local;
+  Stat->syncCost(std::exchange(PendingCost, 0));
+  if (Unrun > 0) {
+    Stat->subCost(Unrun);
+  }
+}
+
+// Precompute the block costs. See "include/executor/executor.h".
+void Executor::meterBlocks(Runtime::Instance::FunctionInstance &Func) const {
+  // A block starts at the function entry, at the branch targets (`loop` and
+  // `end`), and after the instructions transferring the control. The whole
+  // cost of a block is charged at its first instruction.
+  //
+  // The `else` instruction reached at the end of the then-branch jumps to and
+  // runs the `end` instruction directly, so the block ending with `else` is
+  // charged with the cost of `end` instead, and the instruction after `end`
+  // always leads a new block. The cost of `else` on the else-branch is charged
+  // when the `if` jumps to it.
+  auto Instrs = Func.getMutableInstrs();
+  AST::Instruction *Leader = nullptr;
+  uint64_t Cost = 0;
+  for (size_t I = 0; I < Instrs.size(); ++I) {
+    auto &Instr = Instrs[I];
+    const OpCode Code = Instr.getOpCode();
+    const uint64_t InstrCost = getBlockInstrCost(Code);
+    // Also split the block when the cost overflows the 24-bit field.
+    if (Leader == nullptr || Code == OpCode::Loop || Code == OpCode::End ||
+        isBlockTerminator(Instrs[I - 1].getOpCode()) ||
+        Cost + InstrCost > AST::Instruction::MaxBlockCost) {
+      if (Leader != nullptr) {
+        Leader->setBlockCost(static_cast<uint32_t>(Cost));
+      }
+      Leader = &Instr;
+      Cost = 0;
+    }
+    Cost += InstrCost;
+    if (isBlockSyncPoint(Code)) {
+      Leader->setBlockSync();
+    }
+  }
+  if (Leader != nullptr) {
+    Leader->setBlockCost(static_cast<uint32_t>(Cost));
+  }
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -15,7 +15,7 @@ namespace Executor {
 // Instantiate module instance. See "include/executor/Executor.h".
 Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
 Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
-                      std::optional<std::string_view> Name) {
+                      std::optional<std::string_view> Name, bool IsStarted) {
   // Check the module is validated.
   if (unlikely(!Mod.getIsValidated())) {
     spdlog::error(ErrCode::Value::NotValidated);
@@ -60,10 +60,8 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
   }
 
   // Instantiate Functions in module. (FunctionSec, CodeSec)
-  const AST::FunctionSection &FuncSec = Mod.getFunctionSection();
-  const AST::CodeSection &CodeSec = Mod.getCodeSection();
   // This function will always success.
-  instantiate(*ModInst, FuncSec, CodeSec);
+  instantiate(*ModInst, Mod);
 
   // Instantiate TableSection (TableSec)
   const AST::TableSection &TabSec = Mod.getTableSection();
@@ -147,7 +145,8 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
   if (StartSec.getContent()) {
     // Get the module instance from ID.
     ModInst->setStartIdx(*StartSec.getContent());
-
+  }
+  if (StartSec.getContent() && IsStarted) {
     // Get function instance.
     const auto *FuncInst = ModInst->getStartFunc();
 
@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include "common/errinfo.h"
+#include "common/log.h"
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+using ModuleTemplate = Runtime::Instance::ModuleTemplate;
+using FuncIdxMap =
+    std::unordered_map<const Runtime::Instance::FunctionInstance *, uint32_t>;
+
+/// Capture the value and replace the function reference by the index.
+ModuleTemplate::ValueImage captureValue(const FuncIdxMap &FuncIdxs,
+                                        const ValVariant &Val,
+                                        bool IsFuncRef) noexcept {
+  if (IsFuncRef && !isNullRef(Val)) {
+    if (auto It = FuncIdxs.find(retrieveFuncRef(Val)); It != FuncIdxs.end()) {
+      return {Val, It->second};
+    }
+  }
+  return {Val, ModuleTemplate::kNoFuncIdx};
+}
+
+/// Rebind the captured value to the functions of the module instance.
+ValVariant
+restoreValue(Span<Runtime::Instance::FunctionInstance *const> Funcs,
+             const ModuleTemplate::ValueImage &Image) noexcept {
+  if (Image.FuncIdx != ModuleTemplate::kNoFuncIdx) {
+    return FuncRef(Funcs[Image.FuncIdx]);
+  }
+  return Image.Value;
+}
+} // namespace
+
+// Freeze module instance into template. See "include/executor/executor.h".
+Expect<void>
+Executor::freeze(ModuleTemplate &Tmpl,
+                 const Runtime::Instance::ModuleInstance &ModInst) {
+  const AST::Module &Mod = Tmpl.getModule();
+
+  // Index the function index space for rebinding the function references.
+  FuncIdxMap FuncIdxs;
+  for (uint32_t I = 0; I < ModInst.getFuncNum(); ++I) {
+    FuncIdxs.emplace(*ModInst.getFunc(I), I);
+  }
+
+  // Capture the tables. All tables are defined in the module.
+  const uint32_t TabNum =
+      static_cast<uint32_t>(Mod.getTableSection().getContent().size());
+  for (uint32_t I = 0; I < TabNum; ++I) {
+    const auto *TabInst = *ModInst.getTable(I);
+    const bool IsFuncRef =
+        TabInst->getTableType().getRefType() == RefType::FuncRef;
+    auto &Image = Tmpl.Tables.emplace_back();
+    Image.TabType = TabInst->getTableType();
+    const auto Refs = *TabInst->getRefs(0, TabInst->getSize());
+    Image.Refs.reserve(Refs.size());
+    for (const auto &Ref : Refs) {
+      Image.Refs.push_back(
+          captureValue(FuncIdxs, Ref.get<UnknownRef>(), IsFuncRef));
+    }
+  }
+
+  // Capture the memories. All memories are defined in the module.
+  const uint32_t MemNum =
+      static_cast<uint32_t>(Mod.getMemorySection().getContent().size());
+  for (uint32_t I = 0; I < MemNum; ++I) {
+    const auto *MemInst = *ModInst.getMemory(I);
+    if (unlikely(MemInst->getDataPtr() == nullptr)) {
+      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Memory));
+      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    }
+    auto &Image = Tmpl.Memories.emplace_back();
+    Image.MemType = MemInst->getMemoryType();
+    Image.Snapshot = std::make_unique<MemorySnapshot>(
+        MemInst->getDataPtr(),
+        MemInst->getPageSize() * Runtime::Instance::MemoryInstance::kPageSize);
+  }
+
+  // Capture the globals. All globals are defined in the module.
+  for (uint32_t I = 0; I < ModInst.getGlobalNum(); ++I) {
+    const auto *GlobInst = *ModInst.getGlobal(I);
+    const bool IsFuncRef =
+        GlobInst->getGlobalType().getValType() == ValType::FuncRef;
+    Tmpl.Globals.push_back(
+        {GlobInst->getGlobalType(),
+         captureValue(FuncIdxs, GlobInst->getValue(), IsFuncRef)});
+  }
+
+  // Capture the element instances. The dropped ones are empty.
+  const uint32_t ElemNum =
+      static_cast<uint32_t>(Mod.getElementSection().getContent().size());
+  for (uint32_t I = 0; I < ElemNum; ++I) {
+    const auto *ElemInst = *ModInst.getElem(I);
+    const bool IsFuncRef = ElemInst->getRefType() == RefType::FuncRef;
+    auto &Image = Tmpl.Elems.emplace_back();
+    Image.Offset = ElemInst->getOffset();
+    Image.Type = ElemInst->getRefType();
+    Image.Refs.reserve(ElemInst->getRefs().size());
+    for (const auto &Ref : ElemInst->getRefs()) {
+      Image.Refs.push_back(
+          captureValue(FuncIdxs, Ref.get<UnknownRef>(), IsFuncRef));
+    }
+  }
+
+  // Capture the data instances. The dropped ones are empty.
+  const uint32_t DataNum =
+      static_cast<uint32_t>(Mod.getDataSection().getContent().size());
+  for (uint32_t I = 0; I < DataNum; ++I) {
+    const auto *DataInst = *ModInst.getData(I);
+    Tmpl.Datas.push_back({DataInst->getOffset(), DataInst->getData(),
+                          DataInst->getDataHolder()});
+  }
+  return {};
+}
+
+// Instantiate module instance from template. See
+// "include/executor/executor.h".
+Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+Executor::instantiate(Runtime::StoreManager &StoreMgr,
+                      const ModuleTemplate &Tmpl,
+                      std::optional<std::string_view> Name) {
+  const AST::Module &Mod = Tmpl.getModule();
+
+  // Check is module name duplicated when trying to registration.
+  if (Name.has_value()) {
+    const auto *FindModInst = StoreMgr.findModule(Name.value());
+    if (FindModInst != nullptr) {
+      spdlog::error(ErrCode::Value::ModuleNameConflict);
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      return Unexpect(ErrCode::Value::ModuleNameConflict);
+    }
+  }
+
+  // Insert the module instance to store manager and retrieve instance.
+  std::unique_ptr<Runtime::Instance::ModuleInstance> ModInst;
+  if (Name.has_value()) {
+    ModInst = std::make_unique<Runtime::Instance::ModuleInstance>(Name.value());
+  } else {
+    ModInst = std::make_unique<Runtime::Instance::ModuleInstance>("");
+  }
+
+  // Instantiate Function Types in Module Instance. (TypeSec)
+  for (auto &FuncType : Mod.getTypeSection().getContent()) {
+    // Copy param and return lists to module instance.
+    ModInst->addFuncType(FuncType);
+  }
+
+  // Instantiate ImportSection and do import matching. (ImportSec)
+  // Only functions are imported by the templated modules.
+  const AST::ImportSection &ImportSec = Mod.getImportSection();
+  if (auto Res = instantiate(StoreMgr, *ModInst, ImportSec); !Res) {
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Import));
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+    StoreMgr.recycleModule(std::move(ModInst));
+    return Unexpect(Res);
+  }
+
+  // Instantiate Functions in module. (FunctionSec, CodeSec)
+  // This function will always success.
+  instantiate(*ModInst, Mod);
+  Span<Runtime::Instance::FunctionInstance *const> Funcs = ModInst->FuncInsts;
+
+  // Restore the tables with the references rebound to this module instance.
+  std::vector<RefVariant> Refs;
+  for (uint32_t I = 0; I < Tmpl.Tables.size(); ++I) {
+    const auto &Image = Tmpl.Tables[I];
+    ModInst->addTable(Image.TabType);
+    auto *TabInst = *ModInst->getTable(I);
+    Refs.clear();
+    for (const auto &Ref : Image.Refs) {
+      Refs.push_back(restoreValue(Funcs, Ref).get<UnknownRef>());
+    }
+    TabInst->setRefs(Refs, 0, 0, static_cast<uint32_t>(Refs.size()));
+  }
+
+  // Restore the memories from the snapshots.
+  ModInst->MemoryPtrs.resize(Tmpl.Memories.size());
+  for (const auto &Image : Tmpl.Memories) {
+    ModInst->addMemory(Image.MemType,
+                       Conf.getRuntimeConfigure().getMaxMemoryPage());
+    auto *MemInst = *ModInst->getMemory(ModInst->getMemoryNum() - 1);
+    if (unlikely(MemInst->getDataPtr() == nullptr ||
+                 !Image.Snapshot->restore(MemInst->getDataPtr()))) {
+      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Memory));
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      StoreMgr.recycleModule(std::move(ModInst));
+      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    }
+  }
+
+  // Restore the globals.
+  ModInst->GlobalPtrs.resize(Tmpl.Globals.size());
+  for (const auto &Image : Tmpl.Globals) {
+    ModInst->addGlobal(Image.GlobType, restoreValue(Funcs, Image.Value));
+    const auto Index = ModInst->getGlobalNum() - 1;
+    ModInst->GlobalPtrs[Index] = &((*ModInst->getGlobal(Index))->getValue());
+  }
+
+  // Instantiate ExportSection (ExportSec)
+  const AST::ExportSection &ExportSec = Mod.getExportSection();
+  // This function will always success.
+  instantiate(*ModInst, ExportSec);
+
+  // Restore the element and data instances.
+  for (const auto &Image : Tmpl.Elems) {
+    Refs.clear();
+    for (const auto &Ref : Image.Refs) {
+      Refs.push_back(restoreValue(Funcs, Ref).get<UnknownRef>());
+    }
+    ModInst->addElem(Image.Offset, Image.Type, Refs);
+  }
+  for (const auto &Image : Tmpl.Datas) {
+    ModInst->addData(Image.Offset, Image.Data, Image.Holder);
+  }
+
+  // Instantiate StartSection (StartSec)
+  const AST::StartSection &StartSec = Mod.getStartSection();
+  if (StartSec.getContent()) {
+    // Get the module instance from ID.
+    ModInst->setStartIdx(*StartSec.getContent());
+  }
+  if (StartSec.getContent() && !Tmpl.isStarted()) {
+    // Push a new frame {ModInst, locals:none}
+    Runtime::StackManager StackMgr;
+    StackMgr.pushFrame(ModInst.get(), AST::InstrView::iterator(), 0, 0);
+
+    // Execute instruction.
+    if (auto Res = runFunction(StackMgr, *ModInst->getStartFunc(), {});
+        unlikely(!Res)) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      StoreMgr.recycleModule(std::move(ModInst));
+      return Unexpect(Res);
+    }
+  }
+
+  // For the named modules, register it into the store.
+  if (Name.has_value()) {
+    StoreMgr.registerModule(ModInst.get());
+  }
+
+  return ModInst;
+}
+
+} // namespace Executor
+} // namespace WasmEdge
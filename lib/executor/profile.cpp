@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+/// Get the counter number of the instruction in the branch profile.
+uint32_t getCounterNum(const AST::Instruction &Instr) noexcept {
+  switch (Instr.getOpCode()) {
+  case OpCode::If:
+  case OpCode::Br_if:
+    return 2;
+  case OpCode::Br_table:
+    return static_cast<uint32_t>(Instr.getLabelList().size());
+  default:
+    return 0;
+  }
+}
+
+} // namespace
+
+// Allocate the profile counters. See "include/executor/executor.h".
+void Executor::profileFunction(
+    Runtime::Instance::FunctionInstance &Func) const {
+  using FunctionInstance = Runtime::Instance::FunctionInstance;
+  auto *Code = Func.getWasmFunction();
+  auto Prof = std::make_unique<FunctionInstance::Profile>();
+  Prof->Slots.reserve(Code->Instrs.size() + 1);
+  uint32_t CounterNum = 0;
+  for (const auto &Instr : Code->Instrs) {
+    Prof->Slots.push_back(CounterNum);
+    CounterNum += getCounterNum(Instr);
+  }
+  Prof->Slots.push_back(CounterNum);
+  Prof->Counts = std::make_unique<std::atomic<uint64_t>[]>(CounterNum);
+  for (uint32_t I = 0; I < CounterNum; ++I) {
+    Prof->Counts[I].store(0, std::memory_order_relaxed);
+  }
+  Prof->Begin = Code->Instrs.data();
+  Code->Prof = std::move(Prof);
+}
+
+// Register the profiled functions. See "include/executor/executor.h".
+void Executor::registerProfile(const Runtime::Instance::ModuleInstance &ModInst,
+                               const AST::Module &Mod, uint32_t FuncBase) {
+  ProfiledModule Entry;
+  Entry.Hash = Mod.getHash();
+  for (uint32_t I = 0; I < ModInst.getFuncNum(); ++I) {
+    auto *FuncInst = *ModInst.getFunc(I);
+    if (I < FuncBase) {
+      Entry.Imports.push_back(FuncInst->getWasmFunction());
+    } else {
+      Entry.Funcs.push_back(FuncInst->getSharedCode());
+    }
+  }
+  std::unique_lock Lock(ProfileMutex);
+  Profiled.push_back(std::move(Entry));
+}
+
+// Record the branch or the call target. See "include/executor/executor.h".
+void Executor::recordProfile(Runtime::StackManager &StackMgr,
+                             const AST::Instruction &Instr) noexcept {
+  const auto Op = Instr.getOpCode();
+  if (Op != OpCode::If && Op != OpCode::Br_if && Op != OpCode::Br_table &&
+      Op != OpCode::Call_indirect && Op != OpCode::Return_call_indirect) {
+    return;
+  }
+  auto *Prof = StackMgr.getProfile();
+  if (Prof == nullptr) {
+    return;
+  }
+  const auto Idx = static_cast<uint32_t>(&Instr - Prof->Begin);
+  const uint32_t Val = StackMgr.getTop().get<uint32_t>();
+  switch (Op) {
+  case OpCode::If:
+  case OpCode::Br_if:
+    Prof->Counts[Prof->Slots[Idx] + (Val != 0 ? 1 : 0)].fetch_add(
+        1, std::memory_order_relaxed);
+    return;
+  case OpCode::Br_table: {
+    const auto LabelNum = static_cast<uint32_t>(Instr.getLabelList().size());
+    Prof->Counts[Prof->Slots[Idx] + std::min(Val, LabelNum - 1)].fetch_add(
+        1, std::memory_order_relaxed);
+    return;
+  }
+  default: {
+    // The traps of the indirect calls are left to the execution.
+    const auto *TabInst = getTabInstByIdx(StackMgr, Instr.getSourceIndex());
+    if (Val >= TabInst->getSize()) {
+      return;
+    }
+    ValVariant Ref = TabInst->getRefAddr(Val)->get<UnknownRef>();
+    if (isNullRef(Ref)) {
+      return;
+    }
+    if (auto *Callee = retrieveFuncRef(Ref)->getWasmFunction()) {
+      std::unique_lock Lock(Prof->Mutex);
+      ++Prof->Calls[{Idx, Callee}];
+    }
+    return;
+  }
+  }
+}
+
+// Collect the execution profiles. See "include/executor/executor.h".
+std::map<std::string, ModuleProfile> Executor::getProfiles() const {
+  using FunctionInstance = Runtime::Instance::FunctionInstance;
+  std::map<std::string, ModuleProfile> Profiles;
+  std::unique_lock Lock(ProfileMutex);
+  for (const auto &Entry : Profiled) {
+    const auto FuncBase = static_cast<uint32_t>(Entry.Imports.size());
+    std::unordered_map<const FunctionInstance::WasmFunction *, uint32_t> Idxs;
+    for (uint32_t I = 0; I < FuncBase; ++I) {
+      if (Entry.Imports[I]) {
+        Idxs.emplace(Entry.Imports[I], I);
+      }
+    }
+    for (uint32_t I = 0; I < Entry.Funcs.size(); ++I) {
+      Idxs[Entry.Funcs[I].get()] = FuncBase + I;
+    }
+
+    auto &ModProf = Profiles[Entry.Hash];
+    for (uint32_t I = 0; I < Entry.Funcs.size(); ++I) {
+      const auto &Code = *Entry.Funcs[I];
+      // The profile of the deferred function body is allocated when prepared.
+      if (Code.IsPending.load(std::memory_order_acquire) || !Code.Prof) {
+        continue;
+      }
+      auto &Prof = *Code.Prof;
+      FunctionProfile FuncProf;
+      for (uint32_t J = 0; J + 1 < Prof.Slots.size(); ++J) {
+        if (Prof.Slots[J] == Prof.Slots[J + 1]) {
+          continue;
+        }
+        std::vector<uint64_t> Counts;
+        bool IsReached = false;
+        for (uint32_t K = Prof.Slots[J]; K < Prof.Slots[J + 1]; ++K) {
+          Counts.push_back(Prof.Counts[K].load(std::memory_order_relaxed));
+          IsReached |= Counts.back() != 0;
+        }
+        if (IsReached) {
+          FuncProf.Branches.emplace(J, std::move(Counts));
+        }
+      }
+      {
+        std::unique_lock CallLock(Prof.Mutex);
+        for (const auto &[Key, Count] : Prof.Calls) {
+          if (auto It = Idxs.find(Key.second); It != Idxs.end()) {
+            FuncProf.Calls[Key.first][It->second] += Count;
+          }
+        }
+      }
+      if (!FuncProf.empty()) {
+        ModProf[FuncBase + I].merge(FuncProf);
+      }
+    }
+  }
+  return Profiles;
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/tierup.h"
+
+#include "common/log.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace WasmEdge {
+namespace Executor {
+
+TierUpQueue::TierUpQueue(std::unique_ptr<TierUpCompiler> C,
+                         uint32_t CallThres, uint32_t LoopThres,
+                         uint32_t Threads, Statistics::Statistics *S) noexcept
+    : Compiler(std::move(C)), CallThreshold(std::max(CallThres, UINT32_C(1))),
+      LoopThreshold(std::max(LoopThres, UINT32_C(1))),
+      ThreadNum(std::max(Threads, UINT32_C(1))), Stat(S) {}
+
+TierUpQueue::~TierUpQueue() noexcept {
+  {
+    std::unique_lock Lock(Mutex);
+    Stopped = true;
+  }
+  Cond.notify_all();
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+}
+
+void TierUpQueue::push(TierUp &Tier) noexcept {
+  if (Tier.IsQueued.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  auto Code = Tier.Code.lock();
+  if (unlikely(!Code)) {
+    return;
+  }
+  {
+    std::unique_lock Lock(Mutex);
+    Jobs.push_back(std::move(Code));
+    // Start the threads on demand, so nothing is spawned if no function is
+    // hot enough.
+    if (Workers.size() < std::min<size_t>(ThreadNum, Jobs.size())) {
+      Workers.emplace_back([this]() { run(); });
+    }
+  }
+  Cond.notify_one();
+}
+
+void TierUpQueue::run() noexcept {
+  while (true) {
+    std::shared_ptr<WasmFunction> Code;
+    {
+      std::unique_lock Lock(Mutex);
+      Cond.wait(Lock, [this]() { return Stopped || !Jobs.empty(); });
+      if (Stopped) {
+        return;
+      }
+      Code = std::move(Jobs.front());
+      Jobs.pop_front();
+    }
+
+    // Switch the function to the compiled code. The interpreter keeps running
+    // the function if failed.
+    if (auto Res = Compiler->compile(*Code); unlikely(!Res)) {
+      spdlog::error("    Tier-up compilation failed:{}, keep interpreting.",
+                    Res.error());
+      continue;
+    }
+    Code->Tier->IsCompiled.store(true, std::memory_order_release);
+    if (Stat) {
+      Stat->incTierUpCount();
+    }
+  }
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -21,5 +21,33 @@ Expect<void> Loader::loadExpression(AST::Expression &Expr,
   return {};
 }
 
+// Load the function body deferred by the lazy loading. See
+// "include/loader/loader.h".
+Expect<AST::InstrVec> Loader::loadFunctionBody(Span<const Byte> Body,
+                                               uint64_t Offset) {
+  std::lock_guard Lock(Mutex);
+  // The body is a view into the binary. Set the binary until the end of the
+  // body to keep the offsets for the error messages.
+  const uint64_t EndOffset = Offset + Body.size();
+  FMgr.setCode(Span<const Byte>(Body.data() - Offset, EndOffset));
+  FMgr.seek(Offset);
+  IsUniversalWASM = false;
+  IsSharedLibraryWASM = false;
+
+  auto Res = loadInstrSeq(EndOffset);
+  if (!Res) {
+    if (!IsQuiet) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+    }
+  } else if (FMgr.getOffset() != EndOffset) {
+    // The END of the body should be at the end of the code segment.
+    Res = logLoadError(ErrCode::Value::SectionSizeMismatch, FMgr.getOffset(),
+                       ASTNodeAttr::Seg_Code);
+  }
+  FMgr.reset();
+  return Res;
+}
+
 } // namespace Loader
 } // namespace WasmEdge
@@ -101,7 +101,7 @@ Expect<AST::InstrVec> Loader::loadInstrSeq(std::optional<uint64_t> SizeBound) {
 
     // Create the instruction node and load contents.
     Instrs.emplace_back(Code, Offset);
-    if (auto Res = loadInstruction(Instrs.back()); !Res) {
+    if (auto Res = loadInstruction(Instrs.back(), SizeBound); !Res) {
       return Unexpect(Res);
     }
     if (Code == OpCode::End) {
@@ -117,7 +117,8 @@ Expect<AST::InstrVec> Loader::loadInstrSeq(std::optional<uint64_t> SizeBound) {
 }
 
 // Load instruction node. See "include/loader/loader.h".
-Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
+Expect<void> Loader::loadInstruction(AST::Instruction &Instr,
+                                     std::optional<uint64_t> SizeBound) {
   // Node: The instruction has checked for the proposals. Need to check their
   // immediates.
 
@@ -211,8 +212,14 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
     return {};
 
   case OpCode::Br:
-  case OpCode::Br_if:
-    return readU32(Instr.getJump().TargetIndex);
+  case OpCode::Br_if: {
+    AST::Instruction::JumpDescriptor Jump{};
+    if (auto Res = readU32(Jump.TargetIndex); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    Instr.setJump(Jump);
+    return {};
+  }
 
   case OpCode::Br_table: {
     uint32_t VecCnt = 0;
@@ -225,6 +232,19 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
       return logLoadError(ErrCode::Value::IntegerTooLong, FMgr.getLastOffset(),
                           ASTNodeAttr::Instruction);
     }
+    // Each label takes at least 1 byte. Check the count with the bytes left
+    // in the function body before allocating the label list.
+    if (SizeBound.has_value() || !FMgr.isStream()) {
+      const uint64_t End = SizeBound.has_value()
+                               ? SizeBound.value()
+                               : FMgr.getOffset() + FMgr.getRemainSize();
+      const uint64_t Remain =
+          End > FMgr.getOffset() ? End - FMgr.getOffset() : 0;
+      if (unlikely(static_cast<uint64_t>(VecCnt) + 1 > Remain)) {
+        return logLoadError(ErrCode::Value::UnexpectedEnd,
+                            FMgr.getLastOffset(), ASTNodeAttr::Instruction);
+      }
+    }
     Instr.setLabelListSize(VecCnt + 1);
     for (uint32_t I = 0; I < VecCnt; ++I) {
       if (auto Res = readU32(Instr.getLabelList()[I].TargetIndex);
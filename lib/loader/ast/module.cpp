@@ -3,6 +3,7 @@
 
 #include "loader/loader.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
@@ -40,8 +41,9 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
     return logLoadError(Res.error(), FMgr.getLastOffset(), ASTNodeAttr::Module);
   }
 
-  // Find and Read the AOT custom section first. Jump the others.
-  while (true && !IsSharedLibraryWASM) {
+  // Find and Read the AOT custom section first. Jump the others. The streams
+  // are not looked up for not waiting for the whole binary.
+  while (!IsSharedLibraryWASM && !FMgr.isStream()) {
     // This loop only overview the custom sections and read the AOT section.
     // For the other general errors, break and handle in the sequencially
     // parsing below.
@@ -326,6 +328,14 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
     }
   }
 
+  // Set the decoder for the function bodies deferred by the lazy loading.
+  const auto &CodeSegs = Mod->getCodeSection().getContent();
+  if (std::any_of(CodeSegs.begin(), CodeSegs.end(),
+                  [](const AST::CodeSegment &Seg) { return Seg.isLazy(); })) {
+    Mod->setCodeDecoder(
+        std::make_shared<LazyCodeDecoder>(Conf, HasDataSection));
+  }
+
   return Mod;
 }
 
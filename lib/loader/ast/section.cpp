@@ -5,9 +5,12 @@
 
 #include "aot/version.h"
 #include "common/defines.h"
+#include "common/parallel.h"
 #include <cstdint>
+#include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace WasmEdge {
 namespace Loader {
@@ -15,7 +18,9 @@ namespace Loader {
 // Load content size. See "include/loader/loader.h".
 Expect<uint32_t> Loader::loadSectionSize(ASTNodeAttr Node) {
   if (auto Res = FMgr.readU32()) {
-    if (unlikely(FMgr.getRemainSize() < (*Res))) {
+    // For the stream, the content is checked when reading instead of waiting
+    // for the whole section.
+    if (unlikely(!FMgr.isStream() && FMgr.getRemainSize() < (*Res))) {
       return logLoadError(ErrCode::Value::LengthOutOfBounds,
                           FMgr.getLastOffset(), Node);
     }
@@ -146,12 +151,94 @@ Expect<void> Loader::loadSection(AST::ElementSection &Sec) {
 // Load vector of code section. See "include/loader/loader.h".
 Expect<void> Loader::loadSection(AST::CodeSection &Sec) {
   return loadSectionContent(Sec, [this, &Sec]() {
+    // Decode the function bodies of the large code section in parallel. The
+    // function bodies are skipped in the AOT mode and recorded in the lazy
+    // loading mode.
+    const auto &RTConf = Conf.getRuntimeConfigure();
+    if (RTConf.getLoadingThreads() > 1 && !RTConf.isLazyLoading() &&
+        !IsUniversalWASM && !IsSharedLibraryWASM &&
+        Sec.getContentSize() >= kParallelDecodingSize) {
+      return loadCodeSegmentsParallel(Sec, RTConf.getLoadingThreads());
+    }
     return loadSectionContentVec(Sec, [this](AST::CodeSegment &CodeSeg) {
       return loadSegment(CodeSeg);
     });
   });
 }
 
+// Load vector of code section in parallel. See "include/loader/loader.h".
+Expect<void> Loader::loadCodeSegmentsParallel(AST::CodeSection &Sec,
+                                              uint32_t Threads) {
+  uint32_t VecCnt = 0;
+  // Read the vector size.
+  if (auto Res = FMgr.readU32()) {
+    VecCnt = *Res;
+    Sec.getContent().resize(VecCnt);
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(),
+                        ASTNodeAttr::Sec_Code);
+  }
+  auto &Segs = Sec.getContent();
+
+  // Scan the segment sizes and the locals, and record the function bodies.
+  // The errors are reported later to keep the lowest failing offset.
+  std::vector<uint64_t> SegOffsets(VecCnt);
+  uint32_t FailedIdx = VecCnt;
+  IsQuiet = true;
+  IsDeferringBody = true;
+  for (uint32_t I = 0; I < VecCnt; ++I) {
+    SegOffsets[I] = FMgr.getOffset();
+    if (!loadSegment(Segs[I])) {
+      FailedIdx = I;
+      break;
+    }
+  }
+  IsQuiet = false;
+  IsDeferringBody = false;
+  const uint64_t EndOffset = FMgr.getOffset();
+
+  // Decode the recorded function bodies by the workers. Each worker has its
+  // own file manager cursor over the same binary, and takes the segments in
+  // chunks. The chunks after the lowest failed segment are skipped.
+  const uint32_t Idx = runParallelJobs(
+      FailedIdx, kParallelDecodingChunk, Threads, [this, &Segs]() {
+        auto Worker = std::make_unique<Loader>(Conf, IntrinsicsTable);
+        Worker->HasDataSection = HasDataSection;
+        Worker->IsQuiet = true;
+        return [Worker = std::move(Worker), &Segs](uint32_t I) {
+          auto &Seg = Segs[I];
+          Expect<AST::InstrVec> Res = Unexpect(ErrCode::Value::UnexpectedEnd);
+          if (Seg.isLazy()) {
+            Res = Worker->loadFunctionBody(Seg.getBody(), Seg.getBodyOffset());
+          }
+          if (!Res) {
+            return false;
+          }
+          Seg.getExpr().getInstrs() = std::move(*Res);
+          Seg.setBody({}, 0, nullptr);
+          return true;
+        };
+      });
+
+  if (Idx < VecCnt) {
+    // The segments before the lowest failed one are loaded. Load the rest
+    // sequentially to report the same error as the sequential loading.
+    for (auto &Seg : Segs) {
+      Seg.setBody({}, 0, nullptr);
+    }
+    FMgr.seek(SegOffsets[Idx]);
+    for (uint32_t I = Idx; I < VecCnt; ++I) {
+      if (auto Res = loadSegment(Segs[I]); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Code));
+        return Unexpect(Res);
+      }
+    }
+    return {};
+  }
+  FMgr.seek(EndOffset);
+  return {};
+}
+
 // Load vector of data section. See "include/loader/loader.h".
 Expect<void> Loader::loadSection(AST::DataSection &Sec) {
   return loadSectionContent(Sec, [this, &Sec]() {
@@ -269,6 +269,19 @@ Expect<void> Loader::loadSegment(AST::CodeSegment &CodeSeg) {
   if (IsUniversalWASM || IsSharedLibraryWASM) {
     // For the AOT mode, skip the function body.
     FMgr.seek(ExprSizeBound);
+  } else if (IsDeferringBody ||
+             (Conf.getRuntimeConfigure().isLazyLoading() && FMgr.getHolder() &&
+              ExprSizeBound > FMgr.getOffset())) {
+    // For the lazy loading mode, record the function body to be decoded on its
+    // first call. For the parallel decoding, record the function body to be
+    // decoded by the workers.
+    const uint64_t Offset = FMgr.getOffset();
+    if (auto Res = FMgr.readSpan(ExprSizeBound - Offset); unlikely(!Res)) {
+      return logLoadError(Res.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Seg_Code);
+    } else {
+      CodeSeg.setBody(*Res, Offset, FMgr.getHolder());
+    }
   } else {
     // Read function body with expected expression size.
     if (auto Res = loadExpression(CodeSeg.getExpr(), ExprSizeBound);
@@ -345,8 +358,9 @@ Expect<void> Loader::loadSegment(AST::DataSegment &DataSeg) {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
                           ASTNodeAttr::Seg_Data);
     }
-    if (auto Res = FMgr.readBytes(VecCnt)) {
-      DataSeg.getData() = std::move(*Res);
+    // Refer to the loaded binary without copying if it outlives the loader.
+    if (auto Res = FMgr.readSpan(VecCnt)) {
+      DataSeg.setData(*Res, FMgr.getHolder());
     } else {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
                           ASTNodeAttr::Seg_Data);
@@ -0,0 +1,679 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "loader/cache.h"
+
+#include "common/defines.h"
+#include "common/hexstr.h"
+#include "common/version.h"
+#include "loader/filemgr.h"
+#include "system/path.h"
+
+#include <array>
+#include <blake3.h>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+#endif
+
+namespace WasmEdge {
+namespace Loader {
+
+namespace {
+using namespace std::literals;
+
+/// Magic of the cache files.
+static inline constexpr const std::array<Byte, 4> kMagic{0x57, 0x45, 0x4D,
+                                                          0x43};
+
+/// Digest of the content after the header, for rejecting the corrupted cache
+/// files which may still be parsed into a wrong module.
+std::array<Byte, BLAKE3_OUT_LEN> hashContent(Span<const Byte> Content) {
+  blake3_hasher Hasher;
+  blake3_hasher_init(&Hasher);
+  blake3_hasher_update(&Hasher, Content.data(), Content.size());
+  std::array<Byte, BLAKE3_OUT_LEN> Digest;
+  blake3_hasher_finalize(&Hasher, Digest.data(), Digest.size());
+  return Digest;
+}
+
+/// Write the content into a new temporary file beside the path. The name is
+/// unique, so the concurrent writers of the same cache file never write into
+/// the same temporary file. Return the temporary path, or an empty path if
+/// failed.
+std::filesystem::path writeTempFile(const std::filesystem::path &Path,
+                                    Span<const Byte> Content) noexcept {
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+  std::string Name = Path.u8string() + ".XXXXXX"s;
+  const int FD = ::mkstemp(Name.data());
+  if (FD < 0) {
+    return {};
+  }
+  while (!Content.empty()) {
+    const auto Written = ::write(FD, Content.data(), Content.size());
+    if (Written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (Written <= 0) {
+      ::close(FD);
+      ::unlink(Name.c_str());
+      return {};
+    }
+    Content = Content.subspan(static_cast<size_t>(Written));
+  }
+  if (::close(FD) != 0) {
+    ::unlink(Name.c_str());
+    return {};
+  }
+  return std::filesystem::u8path(Name);
+#else
+  std::random_device Device;
+  for (uint32_t Retry = 0; Retry < 16; ++Retry) {
+    auto TmpPath = Path;
+    TmpPath += "."s + std::to_string(Device()) + ".tmp"s;
+    std::error_code EC;
+    if (std::filesystem::exists(TmpPath, EC) || EC) {
+      continue;
+    }
+    std::ofstream Fout(TmpPath, std::ios::out | std::ios::binary);
+    if (!Fout.write(reinterpret_cast<const char *>(Content.data()),
+                    static_cast<std::streamsize>(Content.size())) ||
+        (Fout.close(), !Fout)) {
+      std::filesystem::remove(TmpPath, EC);
+      return {};
+    }
+    return TmpPath;
+  }
+  return {};
+#endif
+}
+} // namespace
+
+/// Writer of the module into the cache file content. The values are stored in
+/// the native byte order, and the cache files are not portable.
+class ModuleCache::Writer {
+public:
+  std::vector<Byte> Out;
+
+  template <typename T> void write(const T &Val) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto *Ptr = reinterpret_cast<const Byte *>(&Val);
+    Out.insert(Out.end(), Ptr, Ptr + sizeof(T));
+  }
+  template <typename T> void write(Span<const T> Vals) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write(static_cast<uint64_t>(Vals.size()));
+    const auto *Ptr = reinterpret_cast<const Byte *>(Vals.data());
+    Out.insert(Out.end(), Ptr, Ptr + Vals.size() * sizeof(T));
+  }
+  void write(std::string_view Str) {
+    write(Span<const char>(Str.data(), Str.size()));
+  }
+  void writeSection(const AST::Section &Sec) {
+    write(Sec.getContentSize());
+    write(Sec.getStartOffset());
+  }
+  void write(const AST::Limit &Lim) {
+    write(Lim.getType());
+    write(Lim.getMin());
+    write(Lim.getMax());
+  }
+  void write(const AST::FunctionType &FuncType) {
+    write(Span<const ValType>(FuncType.getParamTypes()));
+    write(Span<const ValType>(FuncType.getReturnTypes()));
+  }
+  void write(const AST::TableType &TabType) {
+    write(TabType.getRefType());
+    write(TabType.getLimit());
+  }
+  void write(const AST::MemoryType &MemType) { write(MemType.getLimit()); }
+  void write(const AST::GlobalType &GlobType) {
+    write(GlobType.getValType());
+    write(GlobType.getValMut());
+  }
+  void write(const AST::Expression &Expr) {
+    write(static_cast<uint64_t>(Expr.getInstrs().size()));
+    for (const auto &Instr : Expr.getInstrs()) {
+      writeInstr(*this, Instr);
+    }
+  }
+  template <typename T, typename L> void writeVec(Span<const T> Vec, L &&Func) {
+    write(static_cast<uint64_t>(Vec.size()));
+    for (const auto &Elem : Vec) {
+      Func(Elem);
+    }
+  }
+
+  void write(const AST::Module &Mod) {
+    write(Span<const Byte>(Mod.getMagic()));
+    write(Span<const Byte>(Mod.getVersion()));
+    writeVec(Mod.getCustomSections(), [this](const AST::CustomSection &Sec) {
+      writeSection(Sec);
+      write(Sec.getName());
+      write(Sec.getContent());
+    });
+    writeSection(Mod.getTypeSection());
+    writeVec(Mod.getTypeSection().getContent(),
+             [this](const AST::FunctionType &FuncType) { write(FuncType); });
+    writeSection(Mod.getImportSection());
+    writeVec(Mod.getImportSection().getContent(),
+             [this](const AST::ImportDesc &ImpDesc) {
+               write(ImpDesc.getExternalType());
+               write(ImpDesc.getModuleName());
+               write(ImpDesc.getExternalName());
+               write(ImpDesc.getExternalFuncTypeIdx());
+               write(ImpDesc.getExternalTableType());
+               write(ImpDesc.getExternalMemoryType());
+               write(ImpDesc.getExternalGlobalType());
+             });
+    writeSection(Mod.getFunctionSection());
+    write(Mod.getFunctionSection().getContent());
+    writeSection(Mod.getTableSection());
+    writeVec(Mod.getTableSection().getContent(),
+             [this](const AST::TableType &TabType) { write(TabType); });
+    writeSection(Mod.getMemorySection());
+    writeVec(Mod.getMemorySection().getContent(),
+             [this](const AST::MemoryType &MemType) { write(MemType); });
+    writeSection(Mod.getGlobalSection());
+    writeVec(Mod.getGlobalSection().getContent(),
+             [this](const AST::GlobalSegment &GlobSeg) {
+               write(GlobSeg.getGlobalType());
+               write(GlobSeg.getExpr());
+             });
+    writeSection(Mod.getExportSection());
+    writeVec(Mod.getExportSection().getContent(),
+             [this](const AST::ExportDesc &ExpDesc) {
+               write(ExpDesc.getExternalType());
+               write(ExpDesc.getExternalName());
+               write(ExpDesc.getExternalIndex());
+             });
+    writeSection(Mod.getStartSection());
+    write(Mod.getStartSection().getContent().has_value());
+    write(Mod.getStartSection().getContent().value_or(0));
+    writeSection(Mod.getElementSection());
+    writeVec(Mod.getElementSection().getContent(),
+             [this](const AST::ElementSegment &ElemSeg) {
+               write(ElemSeg.getMode());
+               write(ElemSeg.getRefType());
+               write(ElemSeg.getIdx());
+               write(ElemSeg.getExpr());
+               writeVec(ElemSeg.getInitExprs(),
+                        [this](const AST::Expression &Expr) { write(Expr); });
+             });
+    writeSection(Mod.getCodeSection());
+    writeVec(Mod.getCodeSection().getContent(),
+             [this](const AST::CodeSegment &CodeSeg) {
+               write(CodeSeg.getSegSize());
+               writeVec(CodeSeg.getLocals(),
+                        [this](const std::pair<uint32_t, ValType> &Local) {
+                          write(Local.first);
+                          write(Local.second);
+                        });
+               write(CodeSeg.getExpr());
+             });
+    writeSection(Mod.getDataSection());
+    writeVec(Mod.getDataSection().getContent(),
+             [this](const AST::DataSegment &DataSeg) {
+               write(DataSeg.getMode());
+               write(DataSeg.getIdx());
+               write(DataSeg.getExpr());
+               write(DataSeg.getData());
+             });
+    writeSection(Mod.getDataCountSection());
+    write(Mod.getDataCountSection().getContent().has_value());
+    write(Mod.getDataCountSection().getContent().value_or(0));
+  }
+};
+
+/// Reader of the module from the cache file content. All reads are bounded by
+/// the content, and the data segments refer to the content kept by the holder.
+class ModuleCache::Reader {
+public:
+  Span<const Byte> In;
+  std::shared_ptr<const void> Holder;
+
+  template <typename T> bool read(T &Val) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (In.size() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&Val, In.data(), sizeof(T));
+    In = In.subspan(sizeof(T));
+    return true;
+  }
+  /// Read the array as the view into the content.
+  template <typename T> bool readArray(Span<const Byte> &Bytes) {
+    uint64_t Size = 0;
+    if (!read(Size) || Size > In.size() / sizeof(T)) {
+      return false;
+    }
+    Bytes = In.first(Size * sizeof(T));
+    In = In.subspan(Size * sizeof(T));
+    return true;
+  }
+  template <typename T> bool read(std::vector<T> &Vals) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Span<const Byte> Bytes;
+    if (!readArray<T>(Bytes)) {
+      return false;
+    }
+    Vals.resize(Bytes.size() / sizeof(T));
+    if (!Bytes.empty()) {
+      std::memcpy(Vals.data(), Bytes.data(), Bytes.size());
+    }
+    return true;
+  }
+  bool read(std::string &Str) {
+    Span<const Byte> Bytes;
+    if (!readArray<char>(Bytes)) {
+      return false;
+    }
+    Str.assign(reinterpret_cast<const char *>(Bytes.data()), Bytes.size());
+    return true;
+  }
+  bool readSection(AST::Section &Sec) {
+    uint64_t ContentSize = 0, StartOffset = 0;
+    if (!read(ContentSize) || !read(StartOffset)) {
+      return false;
+    }
+    Sec.setContentSize(ContentSize);
+    Sec.setStartOffset(StartOffset);
+    return true;
+  }
+  bool read(AST::Limit &Lim) {
+    AST::Limit::LimitType Type;
+    uint32_t Min = 0, Max = 0;
+    if (!read(Type) || !read(Min) || !read(Max)) {
+      return false;
+    }
+    Lim.setType(Type);
+    Lim.setMin(Min);
+    Lim.setMax(Max);
+    return true;
+  }
+  bool read(AST::FunctionType &FuncType) {
+    return read(FuncType.getParamTypes()) && read(FuncType.getReturnTypes());
+  }
+  bool read(AST::TableType &TabType) {
+    RefType Type;
+    if (!read(Type)) {
+      return false;
+    }
+    TabType.setRefType(Type);
+    return read(TabType.getLimit());
+  }
+  bool read(AST::MemoryType &MemType) { return read(MemType.getLimit()); }
+  bool read(AST::GlobalType &GlobType) {
+    ValType Type;
+    ValMut Mut;
+    if (!read(Type) || !read(Mut)) {
+      return false;
+    }
+    GlobType.setValType(Type);
+    GlobType.setValMut(Mut);
+    return true;
+  }
+  bool read(AST::Expression &Expr) {
+    uint64_t Size = 0;
+    if (!read(Size) || Size > In.size()) {
+      return false;
+    }
+    auto &Instrs = Expr.getInstrs();
+    Instrs.reserve(Size);
+    for (uint64_t I = 0; I < Size; ++I) {
+      if (!readInstr(*this, Instrs.emplace_back(OpCode::End))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  template <typename T, typename L>
+  bool readVec(std::vector<T> &Vec, L &&Func) {
+    uint64_t Size = 0;
+    if (!read(Size) || Size > In.size()) {
+      return false;
+    }
+    Vec.resize(Size);
+    for (auto &Elem : Vec) {
+      if (!Func(Elem)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  template <typename T> bool readOptional(T &Sec) {
+    bool HasContent = false;
+    uint32_t Content = 0;
+    if (!readSection(Sec) || !read(HasContent) || !read(Content)) {
+      return false;
+    }
+    if (HasContent) {
+      Sec.setContent(Content);
+    }
+    return true;
+  }
+
+  bool read(AST::Module &Mod) {
+    return read(Mod.getMagic()) && read(Mod.getVersion()) &&
+           readVec(Mod.getCustomSections(),
+                   [this](AST::CustomSection &Sec) {
+                     std::string Name;
+                     if (!readSection(Sec) ||
+                         !read(Name)) {
+                       return false;
+                     }
+                     Sec.setName(Name);
+                     return read(Sec.getContent());
+                   }) &&
+           readSection(Mod.getTypeSection()) &&
+           readVec(Mod.getTypeSection().getContent(),
+                   [this](AST::FunctionType &FuncType) {
+                     return read(FuncType);
+                   }) &&
+           readSection(Mod.getImportSection()) &&
+           readVec(Mod.getImportSection().getContent(),
+                   [this](AST::ImportDesc &ImpDesc) {
+                     ExternalType Type;
+                     std::string ModName, ExtName;
+                     uint32_t FuncTypeIdx = 0;
+                     if (!read(Type) || !read(ModName) || !read(ExtName) ||
+                         !read(FuncTypeIdx)) {
+                       return false;
+                     }
+                     ImpDesc.setExternalType(Type);
+                     ImpDesc.setModuleName(ModName);
+                     ImpDesc.setExternalName(ExtName);
+                     ImpDesc.setExternalFuncTypeIdx(FuncTypeIdx);
+                     return read(ImpDesc.getExternalTableType()) &&
+                            read(ImpDesc.getExternalMemoryType()) &&
+                            read(ImpDesc.getExternalGlobalType());
+                   }) &&
+           readSection(Mod.getFunctionSection()) &&
+           read(Mod.getFunctionSection().getContent()) &&
+           readSection(Mod.getTableSection()) &&
+           readVec(Mod.getTableSection().getContent(),
+                   [this](AST::TableType &TabType) { return read(TabType); }) &&
+           readSection(Mod.getMemorySection()) &&
+           readVec(Mod.getMemorySection().getContent(),
+                   [this](AST::MemoryType &MemType) {
+                     return read(MemType);
+                   }) &&
+           readSection(Mod.getGlobalSection()) &&
+           readVec(Mod.getGlobalSection().getContent(),
+                   [this](AST::GlobalSegment &GlobSeg) {
+                     return read(GlobSeg.getGlobalType()) &&
+                            read(GlobSeg.getExpr());
+                   }) &&
+           readSection(Mod.getExportSection()) &&
+           readVec(Mod.getExportSection().getContent(),
+                   [this](AST::ExportDesc &ExpDesc) {
+                     ExternalType Type;
+                     std::string ExtName;
+                     uint32_t ExtIdx = 0;
+                     if (!read(Type) || !read(ExtName) || !read(ExtIdx)) {
+                       return false;
+                     }
+                     ExpDesc.setExternalType(Type);
+                     ExpDesc.setExternalName(ExtName);
+                     ExpDesc.setExternalIndex(ExtIdx);
+                     return true;
+                   }) &&
+           readOptional(Mod.getStartSection()) &&
+           readSection(Mod.getElementSection()) &&
+           readVec(Mod.getElementSection().getContent(),
+                   [this](AST::ElementSegment &ElemSeg) {
+                     AST::ElementSegment::ElemMode Mode;
+                     RefType Type;
+                     uint32_t Idx = 0;
+                     if (!read(Mode) || !read(Type) || !read(Idx)) {
+                       return false;
+                     }
+                     ElemSeg.setMode(Mode);
+                     ElemSeg.setRefType(Type);
+                     ElemSeg.setIdx(Idx);
+                     return read(ElemSeg.getExpr()) &&
+                            readVec(ElemSeg.getInitExprs(),
+                                    [this](AST::Expression &Expr) {
+                                      return read(Expr);
+                                    });
+                   }) &&
+           readSection(Mod.getCodeSection()) &&
+           readVec(Mod.getCodeSection().getContent(),
+                   [this](AST::CodeSegment &CodeSeg) {
+                     uint32_t SegSize = 0;
+                     if (!read(SegSize)) {
+                       return false;
+                     }
+                     CodeSeg.setSegSize(SegSize);
+                     auto ReadLocal = [this](auto &Local) {
+                       return read(Local.first) && read(Local.second);
+                     };
+                     return readVec(CodeSeg.getLocals(), ReadLocal) &&
+                            read(CodeSeg.getExpr());
+                   }) &&
+           readSection(Mod.getDataSection()) &&
+           readVec(Mod.getDataSection().getContent(),
+                   [this](AST::DataSegment &DataSeg) {
+                     AST::DataSegment::DataMode Mode;
+                     uint32_t Idx = 0;
+                     Span<const Byte> Data;
+                     if (!read(Mode) || !read(Idx) ||
+                         !read(DataSeg.getExpr()) || !readArray<Byte>(Data)) {
+                       return false;
+                     }
+                     DataSeg.setMode(Mode);
+                     DataSeg.setIdx(Idx);
+                     DataSeg.setData(Data, Holder);
+                     return true;
+                   }) &&
+           readOptional(Mod.getDataCountSection());
+  }
+};
+
+// Write instruction. See "include/loader/cache.h".
+void ModuleCache::writeInstr(Writer &W, const AST::Instruction &Instr) {
+  W.write(Instr.Code);
+  W.write(Instr.Offset);
+  W.write(Instr.getBlockCost());
+  W.write(Instr.isBlockSync());
+  W.write(static_cast<bool>(Instr.Flags.IsBlockValType));
+  W.write(Instr.MemLane);
+  if (!Instr.Flags.IsPooled) {
+    W.write(static_cast<uint8_t>(0));
+    W.write(Instr.Data);
+    return;
+  }
+  switch (Instr.Code) {
+  case OpCode::Br_table:
+    W.write(static_cast<uint8_t>(1));
+    W.write(Instr.getLabelList());
+    break;
+  case OpCode::Select_t:
+    W.write(static_cast<uint8_t>(2));
+    W.write(Instr.getValTypeList());
+    break;
+  case OpCode::Br:
+  case OpCode::Br_if:
+    W.write(static_cast<uint8_t>(3));
+    W.write(Instr.getJump());
+    break;
+  default:
+    W.write(static_cast<uint8_t>(4));
+    W.write(Instr.getNum().get<uint128_t>());
+    break;
+  }
+}
+
+// Read instruction. See "include/loader/cache.h".
+bool ModuleCache::readInstr(Reader &R, AST::Instruction &Instr) {
+  uint32_t BlockCost = 0;
+  bool IsBlockSync = false;
+  bool IsBlockValType = false;
+  uint8_t Kind = 0;
+  if (!R.read(Instr.Code) || !R.read(Instr.Offset) || !R.read(BlockCost) ||
+      !R.read(IsBlockSync) || !R.read(IsBlockValType) ||
+      !R.read(Instr.MemLane) || !R.read(Kind) ||
+      BlockCost > AST::Instruction::MaxBlockCost) {
+    return false;
+  }
+  Instr.setBlockCost(BlockCost);
+  Instr.setBlockSync(IsBlockSync);
+  Instr.Flags.IsBlockValType = IsBlockValType;
+  Span<const Byte> Bytes;
+  switch (Kind) {
+  case 0:
+    if (!R.read(Instr.Data)) {
+      return false;
+    }
+    break;
+  case 1:
+    if (!R.readArray<AST::Instruction::JumpDescriptor>(Bytes)) {
+      return false;
+    }
+    Instr.setLabelListSize(static_cast<uint32_t>(
+        Bytes.size() / sizeof(AST::Instruction::JumpDescriptor)));
+    if (!Bytes.empty()) {
+      std::memcpy(Instr.getLabelList().data(), Bytes.data(), Bytes.size());
+    }
+    break;
+  case 2:
+    if (!R.readArray<ValType>(Bytes)) {
+      return false;
+    }
+    Instr.setValTypeListSize(
+        static_cast<uint32_t>(Bytes.size() / sizeof(ValType)));
+    if (!Bytes.empty()) {
+      std::memcpy(Instr.getValTypeList().data(), Bytes.data(), Bytes.size());
+    }
+    break;
+  case 3: {
+    AST::Instruction::JumpDescriptor Jump;
+    if (!R.read(Jump)) {
+      return false;
+    }
+    Instr.setJump(Jump);
+    break;
+  }
+  case 4: {
+    uint128_t Num;
+    if (!R.read(Num)) {
+      return false;
+    }
+    Instr.setNum(Num);
+    break;
+  }
+  default:
+    return false;
+  }
+  return true;
+}
+
+// Get the cache file path. See "include/loader/cache.h".
+std::filesystem::path ModuleCache::getPath(Span<const Byte> Code,
+                                           const Configure &Conf) {
+  uint64_t Proposals = 0;
+  for (uint8_t I = 0; I < static_cast<uint8_t>(Proposal::Max); ++I) {
+    if (Conf.hasProposal(static_cast<Proposal>(I))) {
+      Proposals |= UINT64_C(1) << I;
+    }
+  }
+
+  blake3_hasher Hasher;
+  blake3_hasher_init(&Hasher);
+  blake3_hasher_update(&Hasher, kVersionString.data(), kVersionString.size());
+  blake3_hasher_update(&Hasher, &kFormatVersion, sizeof(kFormatVersion));
+  blake3_hasher_update(&Hasher, &Proposals, sizeof(Proposals));
+  blake3_hasher_update(&Hasher, Code.data(), Code.size());
+  std::array<Byte, BLAKE3_OUT_LEN> Hash;
+  blake3_hasher_finalize(&Hasher, Hash.data(), Hash.size());
+  std::string HexStr;
+  convertBytesToHexStr(Hash, HexStr);
+
+  if (const auto Home = Path::home(); !Home.empty()) {
+    return Home / "cache"sv / "interpreter"sv / HexStr;
+  }
+  return {};
+}
+
+// Load the module from the cache file. See "include/loader/cache.h".
+std::unique_ptr<AST::Module>
+ModuleCache::load(const std::filesystem::path &Path) noexcept {
+  if (Path.empty()) {
+    return nullptr;
+  }
+  FileMgr CacheMgr;
+  if (!CacheMgr.setPath(Path)) {
+    return nullptr;
+  }
+  Reader R;
+  R.In = CacheMgr.getData();
+  R.Holder = CacheMgr.getHolder();
+
+  std::array<Byte, 4> Magic;
+  uint32_t Version = 0, InstrSize = 0;
+  std::array<Byte, BLAKE3_OUT_LEN> Digest;
+  if (!R.read(Magic) || Magic != kMagic || !R.read(Version) ||
+      Version != kFormatVersion || !R.read(InstrSize) ||
+      InstrSize != sizeof(AST::Instruction) || !R.read(Digest) ||
+      Digest != hashContent(R.In)) {
+    return nullptr;
+  }
+  auto Mod = std::make_unique<AST::Module>();
+  if (!R.read(*Mod) || !R.In.empty()) {
+    return nullptr;
+  }
+  // The module is not validated again. The digest only rejects the corrupted
+  // files, and does not prove where the file came from: anyone who can write
+  // the cache directory can also write a matching digest. The cache directory
+  // is trusted as the runtime installation itself, and a cached module is as
+  // trusted as the validation result it was stored from.
+  Mod->setIsValidated();
+  Mod->setIsCached();
+  return Mod;
+}
+
+// Store the module into the cache file. See "include/loader/cache.h".
+bool ModuleCache::store(const std::filesystem::path &Path,
+                        const AST::Module &Mod) noexcept {
+  if (Path.empty()) {
+    return false;
+  }
+  Writer Content;
+  Content.write(Mod);
+  Writer W;
+  W.write(kMagic);
+  W.write(kFormatVersion);
+  W.write(static_cast<uint32_t>(sizeof(AST::Instruction)));
+  W.write(hashContent(Content.Out));
+  W.Out.insert(W.Out.end(), Content.Out.begin(), Content.Out.end());
+
+  // Write into a unique temporary file and rename it, for not truncating the
+  // cache file mapped by the others.
+  std::error_code EC;
+  std::filesystem::create_directories(Path.parent_path(), EC);
+  if (EC) {
+    return false;
+  }
+  const auto TmpPath = writeTempFile(Path, W.Out);
+  if (TmpPath.empty()) {
+    return false;
+  }
+  std::filesystem::rename(TmpPath, Path, EC);
+  if (EC) {
+    std::filesystem::remove(TmpPath, EC);
+    return false;
+  }
+  return true;
+}
+
+} // namespace Loader
+} // namespace WasmEdge
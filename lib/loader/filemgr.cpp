@@ -3,8 +3,11 @@
 
 #include "loader/filemgr.h"
 
+#include "system/allocator.h"
+
 #include <algorithm>
 #include <iterator>
+#include <new>
 
 // Error logging of file manager need to be handled in caller.
 
@@ -21,7 +24,7 @@ Expect<void> FileMgr::setPath(const std::filesystem::path &FilePath) {
       Status = ErrCode::Value::IllegalPath;
       return Unexpect(Status);
     }
-    FileMap.emplace(FilePath);
+    FileMap = std::make_shared<MMap>(FilePath);
     if (auto *Pointer = FileMap->address(); likely(Pointer)) {
       Data = reinterpret_cast<const Byte *>(Pointer);
       Status = ErrCode::Value::Success;
@@ -49,13 +52,25 @@ Expect<void> FileMgr::setCode(Span<const Byte> CodeData) {
 // Set code data. See "include/loader/filemgr.h".
 Expect<void> FileMgr::setCode(std::vector<Byte> CodeData) {
   reset();
-  DataHolder.emplace(std::move(CodeData));
+  DataHolder = std::make_shared<std::vector<Byte>>(std::move(CodeData));
   Data = DataHolder->data();
   Size = DataHolder->size();
   Status = ErrCode::Value::Success;
   return {};
 }
 
+// Set code stream. See "include/loader/filemgr.h".
+Expect<void> FileMgr::setStream(std::shared_ptr<ByteStream> CodeStream) {
+  reset();
+  Stream = std::move(CodeStream);
+  // The data of the stream without the reserved region is only available
+  // after waiting.
+  Size = Stream->wait(0);
+  Data = Stream->data();
+  Status = ErrCode::Value::Success;
+  return {};
+}
+
 // Read one byte. See "include/loader/filemgr.h".
 Expect<Byte> FileMgr::readByte() {
   if (unlikely(Status != ErrCode::Value::Success)) {
@@ -82,6 +97,22 @@ Expect<std::vector<Byte>> FileMgr::readBytes(size_t SizeToRead) {
   return Buf;
 }
 
+// Read number of bytes as a view. See "include/loader/filemgr.h".
+Expect<Span<const Byte>> FileMgr::readSpan(size_t SizeToRead) {
+  if (unlikely(Status != ErrCode::Value::Success)) {
+    return Unexpect(Status);
+  }
+  // Set the flag to the start offset.
+  LastPos = Pos;
+  // Check if exceed the data boundary.
+  if (auto Res = testRead(SizeToRead); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  Span<const Byte> Buf(Data + Pos, SizeToRead);
+  Pos += SizeToRead;
+  return Buf;
+}
+
 // Decode and read an unsigned int. See "include/loader/filemgr.h".
 Expect<uint32_t> FileMgr::readU32() {
   if (unlikely(Status != ErrCode::Value::Success)) {
@@ -365,6 +396,9 @@ Expect<std::string> FileMgr::readName() {
 
 // Get the file header type. See "include/loader/filemgr.h".
 FileMgr::FileHeader FileMgr::getHeaderType() {
+  if (Stream) {
+    Size = Stream->wait(4);
+  }
   if (Size >= 4) {
     Byte WASMMagic[] = {0x00, 0x61, 0x73, 0x6D};
     Byte ELFMagic[] = {0x7F, 0x45, 0x4C, 0x46};
@@ -431,6 +465,10 @@ Expect<void> FileMgr::readBytes(Span<Byte> Buffer) {
 
 // Helper function for checking boundary. See "include/loader/filemgr.h".
 Expect<void> FileMgr::testRead(uint64_t Read) {
+  // Wait for the data arriving from the stream.
+  if (unlikely(getRemainSize() < Read) && Stream) {
+    Size = Stream->wait(Pos + Read);
+  }
   // Check if exceed the data boundary
   if (unlikely(getRemainSize() < Read)) {
     Pos = Size;
@@ -441,4 +479,82 @@ Expect<void> FileMgr::testRead(uint64_t Read) {
   return {};
 }
 
+ByteStream::ByteStream(uint64_t C) noexcept
+    : Data(Allocator::allocate_guarded_chunk(C)), Capacity(Data ? C : 0) {}
+
+ByteStream::~ByteStream() noexcept {
+  if (Capacity > 0) {
+    Allocator::release_guarded_chunk(Data, Capacity);
+  }
+}
+
+// Append the bytes. See "include/loader/filemgr.h".
+bool ByteStream::push(Span<const Byte> Bytes) noexcept {
+  std::unique_lock Lock(Mutex);
+  if (Finished) {
+    return false;
+  }
+  if (Capacity == 0) {
+    // The buffer may move when growing, so the readers are not woken up until
+    // the stream is finished.
+    try {
+      Buffer.insert(Buffer.end(), Bytes.begin(), Bytes.end());
+    } catch (const std::bad_alloc &) {
+      finishLocked();
+      Lock.unlock();
+      Cond.notify_all();
+      return false;
+    }
+    return true;
+  }
+  if (unlikely(Capacity - Size < Bytes.size())) {
+    Finished = true;
+    Lock.unlock();
+    Cond.notify_all();
+    return false;
+  }
+  std::copy(Bytes.begin(), Bytes.end(), Data + Size);
+  Size += Bytes.size();
+  Lock.unlock();
+  Cond.notify_all();
+  return true;
+}
+
+// Finish the stream. See "include/loader/filemgr.h".
+void ByteStream::finish() noexcept {
+  {
+    std::unique_lock Lock(Mutex);
+    finishLocked();
+  }
+  Cond.notify_all();
+}
+
+// Cancel the stream. See "include/loader/filemgr.h".
+void ByteStream::cancel() noexcept {
+  {
+    std::unique_lock Lock(Mutex);
+    Cancelled = true;
+    finishLocked();
+  }
+  Cond.notify_all();
+}
+
+// Finish the stream with the mutex locked. See "include/loader/filemgr.h".
+void ByteStream::finishLocked() noexcept {
+  if (!Finished && Capacity == 0) {
+    Data = Buffer.data();
+    Size = Buffer.size();
+  }
+  Finished = true;
+}
+
+// Wait for the data arriving. See "include/loader/filemgr.h".
+uint64_t ByteStream::wait(uint64_t Required) const noexcept {
+  std::unique_lock Lock(Mutex);
+  Cond.wait(Lock, [&]() {
+    return Finished || (Capacity > 0 && Size >= Required);
+  });
+  return Size;
+}
+
 } // namespace WasmEdge
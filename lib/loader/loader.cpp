@@ -4,6 +4,9 @@
 #include "loader/loader.h"
 
 #include "aot/version.h"
+#include "common/defines.h"
+#include "loader/cache.h"
+#include "loader/profile.h"
 
 #include <algorithm>
 #include <cstddef>
@@ -11,8 +14,16 @@
 #include <limits>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <utility>
 
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 namespace WasmEdge {
 namespace Loader {
 
@@ -60,11 +71,71 @@ Loader::loadFile(const std::filesystem::path &FilePath) {
   return Buf;
 }
 
+// Feed the stream from the file. See "include/loader/loader.h".
+void Loader::feedStream(const std::filesystem::path &FilePath,
+                        ByteStream &Stream) noexcept {
+  std::vector<Byte> Buf(kStreamChunkSize);
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+  // Read without blocking and poll with a timeout, so that an idle writer of a
+  // pipe cannot keep the reader blocked after the stream is cancelled.
+  if (int FD = ::open(FilePath.c_str(), O_RDONLY | O_CLOEXEC); FD >= 0) {
+    ::fcntl(FD, F_SETFL, ::fcntl(FD, F_GETFL) | O_NONBLOCK);
+    while (!Stream.isCancelled()) {
+      struct pollfd PFD = {FD, POLLIN, 0};
+      if (int Ready = ::poll(&PFD, 1, kStreamPollTimeout); Ready <= 0) {
+        if (Ready < 0 && errno != EINTR) {
+          break;
+        }
+        continue;
+      }
+      ssize_t Got = ::read(FD, Buf.data(), Buf.size());
+      if (Got < 0 && (errno == EAGAIN || errno == EINTR)) {
+        continue;
+      }
+      if (Got <= 0 || !Stream.push(Span<const Byte>(
+                          Buf.data(), static_cast<size_t>(Got)))) {
+        break;
+      }
+    }
+    ::close(FD);
+  }
+#else
+  std::ifstream Fin(FilePath, std::ios::in | std::ios::binary);
+  while (!Stream.isCancelled() &&
+         (Fin.read(reinterpret_cast<char *>(Buf.data()),
+                   static_cast<std::streamsize>(Buf.size())) ||
+          Fin.gcount() > 0)) {
+    if (!Stream.push(
+            Span<const Byte>(Buf.data(), static_cast<size_t>(Fin.gcount())))) {
+      break;
+    }
+  }
+#endif
+  Stream.finish();
+}
+
 // Parse module from file path. See "include/loader/loader.h".
 Expect<std::unique_ptr<AST::Module>>
 Loader::parseModule(const std::filesystem::path &FilePath) {
   using namespace std::literals::string_view_literals;
   std::lock_guard Lock(Mutex);
+  // Load the pipes and the character devices as streams, which are fed by
+  // reading the file in another thread.
+  if (std::error_code EC; std::filesystem::is_fifo(FilePath, EC) ||
+                          std::filesystem::is_character_file(FilePath, EC)) {
+    auto Stream = std::make_shared<ByteStream>();
+    std::thread Reader(
+        [&FilePath, Stream]() { feedStream(FilePath, *Stream); });
+    auto Res = parseModule(Stream);
+    // Stop the reader whether the parsing succeeded or not. Otherwise an
+    // endless producer would be read until the reserved region is full.
+    Stream->cancel();
+    Reader.join();
+    if (!Res) {
+      spdlog::error(ErrInfo::InfoFile(FilePath));
+    }
+    return Res;
+  }
   // Set path and check the header.
   if (auto Res = FMgr.setPath(FilePath); !Res) {
     spdlog::error(Res.error());
@@ -122,7 +193,7 @@ Loader::parseModule(const std::filesystem::path &FilePath) {
   default:
     // Universal WASM, WASM, or other cases. Load and parse the module directly.
     IsSharedLibraryWASM = false;
-    if (auto Res = loadModule()) {
+    if (auto Res = loadModuleOrCache()) {
       if (auto &Symbol = (*Res)->getSymbol()) {
         *Symbol = IntrinsicsTable;
       }
@@ -138,7 +209,14 @@ Loader::parseModule(const std::filesystem::path &FilePath) {
 Expect<std::unique_ptr<AST::Module>>
 Loader::parseModule(Span<const uint8_t> Code) {
   std::lock_guard Lock(Mutex);
-  if (auto Res = FMgr.setCode(Code); !Res) {
+  // The deferred function bodies of the lazy loading refer to the binary after
+  // loading, so the binary should be owned.
+  if (Conf.getRuntimeConfigure().isLazyLoading()) {
+    if (auto Res = FMgr.setCode(std::vector<Byte>(Code.begin(), Code.end()));
+        !Res) {
+      return Unexpect(Res);
+    }
+  } else if (auto Res = FMgr.setCode(Code); !Res) {
     return Unexpect(Res);
   }
 
@@ -160,7 +238,69 @@ Loader::parseModule(Span<const uint8_t> Code) {
   }
   // For malformed header checking, handle in the module loading.
   IsSharedLibraryWASM = false;
-  return loadModule();
+  return loadModuleOrCache();
+}
+
+// Parse module from stream. See "include/loader/loader.h".
+Expect<std::unique_ptr<AST::Module>>
+Loader::parseModule(std::shared_ptr<ByteStream> Stream) {
+  std::lock_guard Lock(Mutex);
+  if (auto Res = FMgr.setStream(std::move(Stream)); !Res) {
+    return Unexpect(Res);
+  }
+
+  switch (FMgr.getHeaderType()) {
+  // Filter out the Windows .dll, MacOS .dylib, or Linux .so AOT compiled
+  // shared-library-WASM.
+  case FileMgr::FileHeader::ELF:
+  case FileMgr::FileHeader::DLL:
+  case FileMgr::FileHeader::MachO_32:
+  case FileMgr::FileHeader::MachO_64:
+    spdlog::error(ErrCode::Value::MalformedMagic);
+    spdlog::error(
+        "    The AOT compiled WASM shared library is not supported for loading "
+        "from stream. Please use the universal WASM binary or pure WASM, or "
+        "load the AOT compiled WASM shared library from file.");
+    return Unexpect(ErrCode::Value::MalformedMagic);
+  default:
+    break;
+  }
+  // For malformed header checking, handle in the module loading.
+  IsSharedLibraryWASM = false;
+  return loadModuleOrCache();
+}
+
+// Load the module from the module cache if cached, otherwise load the module
+// and set the writer for caching it after validation.
+Expect<std::unique_ptr<AST::Module>> Loader::loadModuleOrCache() {
+  const auto &RTConf = Conf.getRuntimeConfigure();
+  // The profiles are keyed by the hash of the binary, which is unknown until
+  // the whole stream is consumed.
+  std::string Hash;
+  if (RTConf.isProfiling() && !FMgr.isStream()) {
+    Hash = ProfileFile::getKey(FMgr.getData());
+  }
+  auto Res = [&]() -> Expect<std::unique_ptr<AST::Module>> {
+    if (!RTConf.isModuleCaching() || RTConf.isLazyLoading() ||
+        FMgr.isStream()) {
+      return loadModule();
+    }
+    auto CachePath = ModuleCache::getPath(FMgr.getData(), Conf);
+    if (auto Mod = ModuleCache::load(CachePath)) {
+      return Mod;
+    }
+    auto Res = loadModule();
+    // The universal WASM is not cached for keeping the compiled code.
+    if (Res && !IsUniversalWASM && !CachePath.empty()) {
+      (*Res)->setCacheWriter(
+          std::make_shared<ModuleCacheWriter>(std::move(CachePath)));
+    }
+    return Res;
+  }();
+  if (Res) {
+    (*Res)->setHash(std::move(Hash));
+  }
+  return Res;
 }
 
 // Helper function of checking the valid value types.
@@ -218,5 +358,11 @@ Expect<RefType> Loader::checkRefTypeProposals(RefType RType, uint64_t Off,
   }
 }
 
+// Decode the deferred function body. See "include/loader/loader.h".
+Expect<AST::InstrVec> LazyCodeDecoder::decode(Span<const Byte> Body,
+                                              uint64_t Offset) const {
+  return Load.loadFunctionBody(Body, Offset);
+}
+
 } // namespace Loader
 } // namespace WasmEdge
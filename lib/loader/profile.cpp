@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "loader/profile.h"
+
+#include "common/errinfo.h"
+#include "common/hexstr.h"
+#include "common/log.h"
+
+#include <array>
+#include <blake3.h>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+
+using namespace std::literals;
+
+namespace WasmEdge {
+namespace Loader {
+
+// Get the key of the module profile. See "include/loader/profile.h".
+std::string ProfileFile::getKey(Span<const Byte> Code) {
+  blake3_hasher Hasher;
+  blake3_hasher_init(&Hasher);
+  blake3_hasher_update(&Hasher, Code.data(), Code.size());
+  std::array<Byte, BLAKE3_OUT_LEN> Hash;
+  blake3_hasher_finalize(&Hasher, Hash.data(), Hash.size());
+  std::string HexStr;
+  convertBytesToHexStr(Hash, HexStr);
+  return HexStr;
+}
+
+// Read the profile file. See "include/loader/profile.h".
+Expect<void> ProfileFile::load(const std::filesystem::path &Path) {
+  std::error_code EC;
+  if (!std::filesystem::exists(Path, EC)) {
+    return {};
+  }
+  std::ifstream Fin(Path);
+  if (!Fin) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error(ErrInfo::InfoFile(Path));
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+
+  ModuleProfile *Mod = nullptr;
+  FunctionProfile *Func = nullptr;
+  std::string Line;
+  uint32_t LineNum = 0;
+  auto Malformed = [&]() {
+    spdlog::error(ErrCode::Value::ReadError);
+    spdlog::error("    Malformed profile at line {}.", LineNum);
+    spdlog::error(ErrInfo::InfoFile(Path));
+    return Unexpect(ErrCode::Value::ReadError);
+  };
+  while (std::getline(Fin, Line)) {
+    ++LineNum;
+    std::istringstream In(Line);
+    std::string Tag;
+    if (!(In >> Tag)) {
+      continue;
+    }
+    if (Tag == "module"sv) {
+      std::string Key;
+      if (!(In >> Key)) {
+        return Malformed();
+      }
+      Mod = &Modules[Key];
+      Func = nullptr;
+    } else if (Tag == "function"sv) {
+      uint32_t Idx;
+      if (!Mod || !(In >> Idx)) {
+        return Malformed();
+      }
+      Func = &(*Mod)[Idx];
+    } else if (Tag == "branch"sv) {
+      uint32_t Idx;
+      if (!Func || !(In >> Idx)) {
+        return Malformed();
+      }
+      std::vector<uint64_t> Counts;
+      uint64_t Count;
+      while (In >> Count) {
+        Counts.push_back(Count);
+      }
+      if (Counts.empty() || !In.eof()) {
+        return Malformed();
+      }
+      Func->Branches[Idx] = std::move(Counts);
+    } else if (Tag == "call"sv) {
+      uint32_t Idx;
+      if (!Func || !(In >> Idx)) {
+        return Malformed();
+      }
+      auto &Targets = Func->Calls[Idx];
+      uint32_t Target;
+      char Sep;
+      uint64_t Count;
+      while (In >> Target >> Sep >> Count) {
+        if (Sep != ':') {
+          return Malformed();
+        }
+        Targets[Target] = Count;
+      }
+      if (!In.eof()) {
+        return Malformed();
+      }
+    } else {
+      return Malformed();
+    }
+  }
+  return {};
+}
+
+// Write the profile file. See "include/loader/profile.h".
+Expect<void> ProfileFile::store(const std::filesystem::path &Path) const {
+  std::ofstream Fout(Path, std::ios::out | std::ios::trunc);
+  for (const auto &[Key, Mod] : Modules) {
+    Fout << "module " << Key << '\n';
+    for (const auto &[FuncIdx, Func] : Mod) {
+      if (Func.empty()) {
+        continue;
+      }
+      Fout << "function " << FuncIdx << '\n';
+      for (const auto &[Idx, Counts] : Func.Branches) {
+        Fout << "branch " << Idx;
+        for (const auto Count : Counts) {
+          Fout << ' ' << Count;
+        }
+        Fout << '\n';
+      }
+      for (const auto &[Idx, Targets] : Func.Calls) {
+        Fout << "call " << Idx;
+        for (const auto &[Target, Count] : Targets) {
+          Fout << ' ' << Target << ':' << Count;
+        }
+        Fout << '\n';
+      }
+    }
+  }
+  if (!Fout.flush()) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error(ErrInfo::InfoFile(Path));
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+  return {};
+}
+
+// Find the module profile. See "include/loader/profile.h".
+const ModuleProfile *
+ProfileFile::find(const std::string &Key) const noexcept {
+  if (auto It = Modules.find(Key); It != Modules.end()) {
+    return &It->second;
+  }
+  return nullptr;
+}
+
+// Merge the module profile. See "include/loader/profile.h".
+void ProfileFile::merge(const std::string &Key, const ModuleProfile &Prof) {
+  auto &Mod = Modules[Key];
+  for (const auto &[FuncIdx, Func] : Prof) {
+    Mod[FuncIdx].merge(Func);
+  }
+}
+
+} // namespace Loader
+} // namespace WasmEdge
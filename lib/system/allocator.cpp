@@ -7,6 +7,11 @@
 #include "common/defines.h"
 #include "common/errcode.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||       \
     defined(__arm__)
 #include <sys/mman.h>
@@ -55,17 +60,106 @@ static inline constexpr const uint64_t kPageSize = UINT64_C(65536);
 static inline constexpr const uint64_t k4G = UINT64_C(0x100000000);
 static inline constexpr const uint64_t k12G = UINT64_C(0x300000000);
 
-} // namespace
+/// Pool of the reserved regions. It is never destroyed because the linear
+/// memories may be released by the static destructors.
+struct ReservationPool {
+  std::mutex Mutex;
+  std::vector<uint8_t *> Regions;
+  uint32_t Limit = 0;
+  std::atomic<uint64_t> Hits{0};
+  std::atomic<uint64_t> Misses{0};
+};
+ReservationPool &getPool() noexcept {
+  static ReservationPool *Pool = new ReservationPool;
+  return *Pool;
+}
+
+/// Table of the live reserved regions, which is read by the fault handler
+/// without locking. The 47-bit address space holds less than 11k regions of
+/// 12 GiB. The regions out of the table are not recognized by the handler.
+static inline constexpr const uint32_t kMaxReservations = 16384;
+std::atomic<uintptr_t> Reservations[kMaxReservations] = {};
+/// Count of the used table slots, including the cleared ones.
+std::atomic<uint32_t> ReservationEnd = 0;
+
+[[maybe_unused]] void addReservation(const uint8_t *Reserved) noexcept {
+  const auto Begin = reinterpret_cast<uintptr_t>(Reserved);
+  for (uint32_t I = 0; I < kMaxReservations; ++I) {
+    uintptr_t Empty = 0;
+    if (Reservations[I].compare_exchange_strong(Empty, Begin)) {
+      uint32_t End = ReservationEnd.load();
+      while (End < I + 1 && !ReservationEnd.compare_exchange_weak(End, I + 1)) {
+      }
+      return;
+    }
+  }
+}
+
+[[maybe_unused]] void removeReservation(const uint8_t *Reserved) noexcept {
+  const auto Begin = reinterpret_cast<uintptr_t>(Reserved);
+  const uint32_t End = ReservationEnd.load();
+  for (uint32_t I = 0; I < End; ++I) {
+    uintptr_t Expected = Begin;
+    if (Reservations[I].compare_exchange_strong(Expected, 0)) {
+      return;
+    }
+  }
+}
 
-[[gnu::visibility("default")]] uint8_t *
-Allocator::allocate(uint32_t PageCount) noexcept {
 #if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
+uint8_t *reserve() noexcept {
   auto Reserved = reinterpret_cast<uint8_t *>(
       mmap(nullptr, k12G, PROT_NONE,
            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
   if (Reserved == MAP_FAILED) {
     return nullptr;
   }
+  addReservation(Reserved);
+  return Reserved;
+}
+
+uint8_t *acquireReserved() noexcept {
+  auto &Pool = getPool();
+  {
+    std::lock_guard Lock(Pool.Mutex);
+    if (!Pool.Regions.empty()) {
+      auto Reserved = Pool.Regions.back();
+      Pool.Regions.pop_back();
+      Pool.Hits.fetch_add(1, std::memory_order_relaxed);
+      return Reserved;
+    }
+  }
+  Pool.Misses.fetch_add(1, std::memory_order_relaxed);
+  return reserve();
+}
+
+bool recycleReserved(uint8_t *Reserved, uint32_t PageCount) noexcept {
+  auto &Pool = getPool();
+  std::lock_guard Lock(Pool.Mutex);
+  if (Pool.Regions.size() >= Pool.Limit) {
+    return false;
+  }
+  // Drop the pages and make the region inaccessible again. The committed
+  // pages are remapped as the anonymous pages when the region is reused.
+  const uint64_t Size = PageCount * kPageSize;
+  if (Size > 0 && (madvise(Reserved + k4G, Size, MADV_DONTNEED) != 0 ||
+                   mprotect(Reserved + k4G, Size, PROT_NONE) != 0)) {
+    return false;
+  }
+  Pool.Regions.push_back(Reserved);
+  return true;
+}
+#endif
+
+} // namespace
+
+[[gnu::visibility("default")]] uint8_t *
+Allocator::allocate(uint32_t PageCount) noexcept {
+#if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
+  auto Reserved = acquireReserved();
+  if (Reserved == nullptr) {
+    return nullptr;
+  }
   if (PageCount == 0) {
     return Reserved + k4G;
   }
@@ -81,6 +175,7 @@ Allocator::allocate(uint32_t PageCount) noexcept {
   if (Reserved == nullptr) {
     return nullptr;
   }
+  addReservation(Reserved);
   if (PageCount == 0) {
     return Reserved + k4G;
   }
@@ -130,20 +225,91 @@ Allocator::resize(uint8_t *Pointer, uint32_t OldPageCount,
 #endif
 }
 
-[[gnu::visibility("default")]] void Allocator::release(uint8_t *Pointer,
-                                                       uint32_t) noexcept {
+[[gnu::visibility("default")]] void
+Allocator::release(uint8_t *Pointer,
+                   uint32_t PageCount [[maybe_unused]]) noexcept {
 #if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
   if (Pointer == nullptr) {
     return;
   }
+  if (recycleReserved(Pointer - k4G, PageCount)) {
+    return;
+  }
+  removeReservation(Pointer - k4G);
   munmap(Pointer - k4G, k12G);
 #elif WASMEDGE_OS_WINDOWS
+  removeReservation(Pointer - k4G);
   boost::winapi::VirtualFree(Pointer - k4G, 0, boost::winapi::MEM_RELEASE_);
 #else
   return std::free(Pointer);
 #endif
 }
 
+void Allocator::setPoolLimit(uint32_t Limit) noexcept {
+  auto &Pool = getPool();
+  std::vector<uint8_t *> Trimmed;
+  {
+    std::lock_guard Lock(Pool.Mutex);
+    Pool.Limit = Limit;
+    while (Pool.Regions.size() > Limit) {
+      Trimmed.push_back(Pool.Regions.back());
+      Pool.Regions.pop_back();
+    }
+  }
+#if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
+  for (auto *Reserved : Trimmed) {
+    removeReservation(Reserved);
+    munmap(Reserved, k12G);
+  }
+#endif
+}
+
+uint32_t Allocator::getPoolLimit() noexcept {
+  auto &Pool = getPool();
+  std::lock_guard Lock(Pool.Mutex);
+  return Pool.Limit;
+}
+
+void Allocator::reservePool(uint32_t Count [[maybe_unused]]) noexcept {
+#if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
+  auto &Pool = getPool();
+  std::lock_guard Lock(Pool.Mutex);
+  while (Pool.Regions.size() < std::min(Count, Pool.Limit)) {
+    auto Reserved = reserve();
+    if (Reserved == nullptr) {
+      return;
+    }
+    Pool.Regions.push_back(Reserved);
+  }
+#endif
+}
+
+uint32_t Allocator::getPoolSize() noexcept {
+  auto &Pool = getPool();
+  std::lock_guard Lock(Pool.Mutex);
+  return static_cast<uint32_t>(Pool.Regions.size());
+}
+
+uint64_t Allocator::getPoolHitCount() noexcept {
+  return getPool().Hits.load(std::memory_order_relaxed);
+}
+
+uint64_t Allocator::getPoolMissCount() noexcept {
+  return getPool().Misses.load(std::memory_order_relaxed);
+}
+
+bool Allocator::isReserved(const void *Address) noexcept {
+  const auto Addr = reinterpret_cast<uintptr_t>(Address);
+  const uint32_t End = ReservationEnd.load();
+  for (uint32_t I = 0; I < End; ++I) {
+    if (const uintptr_t Begin = Reservations[I].load();
+        Begin != 0 && Addr - Begin < k12G) {
+      return true;
+    }
+  }
+  return false;
+}
+
 uint8_t *Allocator::allocate_chunk(uint64_t Size) noexcept {
 #if defined(HAVE_MMAP)
   if (auto Pointer = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
@@ -178,6 +344,35 @@ void Allocator::release_chunk(uint8_t *Pointer,
 #endif
 }
 
+uint8_t *Allocator::allocate_guarded_chunk(uint64_t Size) noexcept {
+#if defined(HAVE_MMAP)
+  auto Reserved = reinterpret_cast<uint8_t *>(
+      mmap(nullptr, Size + kGuardSize, PROT_NONE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+  if (unlikely(Reserved == MAP_FAILED)) {
+    return nullptr;
+  }
+  if (unlikely(mprotect(Reserved, Size, PROT_READ | PROT_WRITE) != 0)) {
+    munmap(Reserved, Size + kGuardSize);
+    return nullptr;
+  }
+  return Reserved;
+#else
+  // The guard region is not supported.
+  return nullptr;
+#endif
+}
+
+void Allocator::release_guarded_chunk(uint8_t *Pointer,
+                                      uint64_t Size [[maybe_unused]]) noexcept {
+#if defined(HAVE_MMAP)
+  if (Pointer == nullptr) {
+    return;
+  }
+  munmap(Pointer, Size + kGuardSize);
+#endif
+}
+
 bool Allocator::set_chunk_executable(uint8_t *Pointer, uint64_t Size) noexcept {
 #if defined(HAVE_MMAP)
   return mprotect(Pointer, Size, PROT_EXEC | PROT_READ) == 0;
@@ -6,11 +6,12 @@
 #include "common/config.h"
 #include "common/defines.h"
 #include "common/log.h"
+#include "system/allocator.h"
 
-#include <atomic>
 #include <csetjmp>
 #include <csignal>
 #include <cstdint>
+#include <mutex>
 #include <utility>
 
 #if WASMEDGE_OS_WINDOWS
@@ -29,9 +30,6 @@ AddVectoredExceptionHandler(
     boost::winapi::ULONG_ First,
     boost::winapi::LONG_(BOOST_WINAPI_WINAPI_CC *Handler)(
         struct _EXCEPTION_POINTERS *ExceptionInfo));
-
-BOOST_WINAPI_IMPORT boost::winapi::ULONG_ BOOST_WINAPI_WINAPI_CC
-RemoveVectoredExceptionHandler(boost::winapi::PVOID_ Handle);
 }
 #else
 #include <windows.h>
@@ -53,6 +51,8 @@ BOOST_CONSTEXPR_OR_CONST DWORD_ EXCEPTION_INT_OVERFLOW_ =
     EXCEPTION_INT_OVERFLOW;
 BOOST_CONSTEXPR_OR_CONST LONG_ EXCEPTION_CONTINUE_EXECUTION_ =
     EXCEPTION_CONTINUE_EXECUTION;
+BOOST_CONSTEXPR_OR_CONST LONG_ EXCEPTION_CONTINUE_SEARCH_ =
+    EXCEPTION_CONTINUE_SEARCH;
 #else
 BOOST_CONSTEXPR_OR_CONST DWORD_ EXCEPTION_MAXIMUM_PARAMETERS_ = 15;
 BOOST_CONSTEXPR_OR_CONST DWORD_ EXCEPTION_ACCESS_VIOLATION_ = 0xC0000005L;
@@ -60,6 +60,7 @@ BOOST_CONSTEXPR_OR_CONST DWORD_ EXCEPTION_INT_DIVIDE_BY_ZERO_ = 0xC0000094L;
 BOOST_CONSTEXPR_OR_CONST DWORD_ EXCEPTION_INT_OVERFLOW_ = 0xC0000095L;
 BOOST_CONSTEXPR_OR_CONST LONG_ EXCEPTION_CONTINUE_EXECUTION_ =
     static_cast<LONG_>(0xffffffff);
+BOOST_CONSTEXPR_OR_CONST LONG_ EXCEPTION_CONTINUE_SEARCH_ = 0;
 #endif
 
 typedef struct BOOST_MAY_ALIAS _CONTEXT CONTEXT_, *PCONTEXT_;
@@ -86,10 +87,6 @@ BOOST_FORCEINLINE PVOID_ AddVectoredExceptionHandler(
                  ::_EXCEPTION_POINTERS *)>(Handler));
 }
 
-BOOST_FORCEINLINE ULONG_ RemoveVectoredExceptionHandler(PVOID_ Handle) {
-  return ::RemoveVectoredExceptionHandler(Handle);
-}
-
 } // namespace boost::winapi
 
 #endif
@@ -98,12 +95,53 @@ namespace WasmEdge {
 
 namespace {
 
-std::atomic_uint handlerCount = 0;
 thread_local Fault *localHandler = nullptr;
+thread_local const void *const *localProgramCounter = nullptr;
+thread_local bool localGuarded = false;
+
+/// Return true if the fault on this thread is raised by the WebAssembly
+/// execution under the handler, not by the host functions called from it.
+bool isGuarded() noexcept { return localHandler != nullptr && localGuarded; }
 
 #if defined(SA_SIGINFO)
-[[noreturn]] void signalHandler(int Signal, siginfo_t *Siginfo [[maybe_unused]],
-                                void *) noexcept {
+/// Previous actions of the signals, which handle the faults not raised by the
+/// WebAssembly execution.
+struct sigaction PrevFpeAction;
+struct sigaction PrevBusAction;
+struct sigaction PrevSegvAction;
+
+void signalHandler(int Signal, siginfo_t *Siginfo, void *Context) noexcept;
+
+/// Forward the signal to the previous action.
+void forwardSignal(int Signal, siginfo_t *Siginfo, void *Context) noexcept {
+  const struct sigaction &Prev = Signal == SIGFPE   ? PrevFpeAction
+                                 : Signal == SIGBUS ? PrevBusAction
+                                                    : PrevSegvAction;
+  if (Prev.sa_flags & SA_SIGINFO) {
+    if (Prev.sa_sigaction != &signalHandler) {
+      Prev.sa_sigaction(Signal, Siginfo, Context);
+      return;
+    }
+  } else if (Prev.sa_handler != SIG_DFL && Prev.sa_handler != SIG_IGN) {
+    Prev.sa_handler(Signal);
+    return;
+  }
+  // Restore the default action and return, so that the faulting instruction
+  // runs again and raises the signal to the default action.
+  struct sigaction Action {};
+  Action.sa_handler = SIG_DFL;
+  sigaction(Signal, &Action, nullptr);
+}
+
+void signalHandler(int Signal, siginfo_t *Siginfo, void *Context) noexcept {
+  if (Signal == SIGBUS || Signal == SIGSEGV
+          ? !Fault::isAccessViolation(Siginfo->si_addr)
+          : !isGuarded()) {
+    // The handlers stay installed for the following faults of the WebAssembly
+    // execution.
+    forwardSignal(Signal, Siginfo, Context);
+    return;
+  }
   {
     // Unblock current signal
     sigset_t Set;
@@ -114,7 +152,7 @@ thread_local Fault *localHandler = nullptr;
   switch (Signal) {
   case SIGBUS:
   case SIGSEGV:
-    Fault::emitFault(ErrCode::Value::MemoryOutOfBounds);
+    Fault::emitAccessViolation(Siginfo->si_addr);
   case SIGFPE:
     assuming(Siginfo->si_code == FPE_INTDIV);
     Fault::emitFault(ErrCode::Value::DivideByZero);
@@ -127,15 +165,9 @@ void enableHandler() noexcept {
   struct sigaction Action {};
   Action.sa_sigaction = &signalHandler;
   Action.sa_flags = SA_SIGINFO;
-  sigaction(SIGFPE, &Action, nullptr);
-  sigaction(SIGBUS, &Action, nullptr);
-  sigaction(SIGSEGV, &Action, nullptr);
-}
-
-void disableHandler() noexcept {
-  std::signal(SIGFPE, SIG_DFL);
-  std::signal(SIGBUS, SIG_DFL);
-  std::signal(SIGSEGV, SIG_DFL);
+  sigaction(SIGFPE, &Action, &PrevFpeAction);
+  sigaction(SIGBUS, &Action, &PrevBusAction);
+  sigaction(SIGSEGV, &Action, &PrevSegvAction);
 }
 
 #elif WASMEDGE_OS_WINDOWS
@@ -144,52 +176,61 @@ namespace winapi = boost::winapi;
 
 winapi::LONG_
 vectoredExceptionHandler(winapi::EXCEPTION_POINTERS_ *ExceptionInfo) {
+  if (!isGuarded()) {
+    return winapi::EXCEPTION_CONTINUE_SEARCH_;
+  }
   const winapi::DWORD_ Code = ExceptionInfo->ExceptionRecord->ExceptionCode;
   switch (Code) {
   case winapi::EXCEPTION_INT_DIVIDE_BY_ZERO_:
     Fault::emitFault(ErrCode::Value::DivideByZero);
   case winapi::EXCEPTION_INT_OVERFLOW_:
     Fault::emitFault(ErrCode::Value::IntegerOverflow);
-  case winapi::EXCEPTION_ACCESS_VIOLATION_:
-    Fault::emitFault(ErrCode::Value::MemoryOutOfBounds);
+  case winapi::EXCEPTION_ACCESS_VIOLATION_: {
+    const auto *Address = reinterpret_cast<const void *>(
+        ExceptionInfo->ExceptionRecord->ExceptionInformation[1]);
+    if (!Fault::isAccessViolation(Address)) {
+      return winapi::EXCEPTION_CONTINUE_SEARCH_;
+    }
+    Fault::emitAccessViolation(Address);
+  }
   }
-  return winapi::EXCEPTION_CONTINUE_EXECUTION_;
+  return winapi::EXCEPTION_CONTINUE_SEARCH_;
 }
 
-void *HandlerHandle = nullptr;
-
 void enableHandler() noexcept {
-  HandlerHandle =
-      winapi::AddVectoredExceptionHandler(1, &vectoredExceptionHandler);
-}
-
-void disableHandler() noexcept {
-  winapi::RemoveVectoredExceptionHandler(HandlerHandle);
+  winapi::AddVectoredExceptionHandler(1, &vectoredExceptionHandler);
 }
 
 #endif
 
-void increaseHandler() noexcept {
-  if (handlerCount++ == 0) {
-    enableHandler();
-  }
-}
+} // namespace
 
-void decreaseHandler() noexcept {
-  if (--handlerCount == 0) {
-    disableHandler();
-  }
+// Install the handlers once for the process. Installing and uninstalling them
+// per execution costs the system calls, and races between the threads, which
+// may save this handler as the previous action or leave the execution without
+// the handler.
+void Fault::install() noexcept {
+  static std::once_flag Once;
+  std::call_once(Once, &enableHandler);
 }
 
-} // namespace
-
 Fault::Fault() {
   Prev = std::exchange(localHandler, this);
-  increaseHandler();
+  // The nested handlers of the host and compiled function calls still run on
+  // the value stack of the enclosing execution.
+  if (Prev) {
+    GuardBegin = Prev->GuardBegin;
+    GuardEnd = Prev->GuardEnd;
+  }
+  install();
+}
+
+Fault::Fault(const void *Begin, const void *End) : Fault() {
+  GuardBegin = Begin;
+  GuardEnd = End;
 }
 
 Fault::~Fault() noexcept {
-  decreaseHandler();
   localHandler = std::exchange(Prev, nullptr);
 }
 
@@ -198,4 +239,36 @@ Fault::~Fault() noexcept {
   longjmp(localHandler->Buffer, static_cast<int>(Error.operator uint32_t()));
 }
 
+const void *const *
+Fault::exchangeProgramCounter(const void *const *Slot) noexcept {
+  return std::exchange(localProgramCounter, Slot);
+}
+
+bool Fault::isStackGuard(const void *Address) noexcept {
+  const auto *Addr = reinterpret_cast<const uint8_t *>(Address);
+  return localHandler != nullptr &&
+         Addr >= reinterpret_cast<const uint8_t *>(localHandler->GuardBegin) &&
+         Addr < reinterpret_cast<const uint8_t *>(localHandler->GuardEnd);
+}
+
+bool Fault::isAccessViolation(const void *Address) noexcept {
+  return isGuarded() &&
+         (isStackGuard(Address) || Allocator::isReserved(Address));
+}
+
+bool Fault::exchangeGuarded(bool Guarded) noexcept {
+  return std::exchange(localGuarded, Guarded);
+}
+
+[[noreturn]] void Fault::emitAccessViolation(const void *Address) {
+  assuming(localHandler != nullptr);
+  localHandler->Address = Address;
+  localHandler->ProgramCounter =
+      localProgramCounter ? *localProgramCounter : nullptr;
+  if (isStackGuard(Address)) {
+    emitFault(ErrCode::Value::CallStackExhausted);
+  }
+  emitFault(ErrCode::Value::MemoryOutOfBounds);
+}
+
 } // namespace WasmEdge
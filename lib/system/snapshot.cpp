@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "system/snapshot.h"
+
+#include "common/config.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// The copy-on-write restoring replaces the pages reserved by the allocator,
+// which are only mmap-ed on these platforms.
+#if defined(HAVE_MEMFD_CREATE) && (defined(__x86_64__) || defined(__aarch64__))
+#define WASMEDGE_SNAPSHOT_COW 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace WasmEdge {
+
+namespace {
+/// Granularity of skipping the zero-filled regions when taking snapshot.
+static inline constexpr const uint64_t kBlockSize = UINT64_C(4096);
+
+bool isZeroFilled(const uint8_t *Pointer, uint64_t Size) noexcept {
+  return std::all_of(Pointer, Pointer + Size, [](uint8_t B) { return B == 0; });
+}
+
+#if WASMEDGE_SNAPSHOT_COW
+static inline constexpr const bool kSupported = true;
+struct Implement {
+  int File = -1;
+  uint64_t Size = 0;
+  std::vector<uint8_t> Image;
+  Implement(const uint8_t *Pointer, uint64_t S) noexcept : Size(S) {
+    File = memfd_create("wasmedge-memory-snapshot", MFD_CLOEXEC);
+    if (File >= 0 && ftruncate(File, static_cast<off_t>(Size)) == 0) {
+      if (auto View = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                           File, 0);
+          View != MAP_FAILED) {
+        // Only the non-zero blocks are written, the holes of the file are read
+        // as zeros and cost nothing.
+        auto *Dst = reinterpret_cast<uint8_t *>(View);
+        for (uint64_t Off = 0; Off < Size; Off += kBlockSize) {
+          const uint64_t Len = std::min(kBlockSize, Size - Off);
+          if (!isZeroFilled(Pointer + Off, Len)) {
+            std::memcpy(Dst + Off, Pointer + Off, Len);
+          }
+        }
+        munmap(View, Size);
+        return;
+      }
+    }
+    // Fall back to the copied image.
+    if (File >= 0) {
+      close(File);
+      File = -1;
+    }
+    Image.assign(Pointer, Pointer + Size);
+  }
+  ~Implement() noexcept {
+    if (File >= 0) {
+      close(File);
+    }
+  }
+  bool restore(uint8_t *Pointer) const noexcept {
+    if (File >= 0) {
+      return mmap(Pointer, Size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_FIXED, File, 0) != MAP_FAILED;
+    }
+    std::copy(Image.begin(), Image.end(), Pointer);
+    return true;
+  }
+};
+#else
+static inline constexpr const bool kSupported = false;
+struct Implement {
+  std::vector<uint8_t> Image;
+  Implement(const uint8_t *Pointer, uint64_t Size) noexcept
+      : Image(Pointer, Pointer + Size) {}
+  bool restore(uint8_t *Pointer) const noexcept {
+    std::copy(Image.begin(), Image.end(), Pointer);
+    return true;
+  }
+};
+#endif
+} // namespace
+
+MemorySnapshot::MemorySnapshot(const uint8_t *Pointer, uint64_t S) noexcept
+    : Size(S), Handle(nullptr) {
+  if (Size == 0) {
+    return;
+  }
+  Handle = std::make_unique<Implement>(Pointer, Size).release();
+}
+
+MemorySnapshot::~MemorySnapshot() noexcept {
+  if (!Handle) {
+    return;
+  }
+
+  std::unique_ptr<Implement> NativeHandle(
+      reinterpret_cast<Implement *>(std::exchange(Handle, nullptr)));
+}
+
+bool MemorySnapshot::restore(uint8_t *Pointer) const noexcept {
+  if (!Handle) {
+    return true;
+  }
+  return reinterpret_cast<const Implement *>(Handle)->restore(Pointer);
+}
+
+bool MemorySnapshot::supported() noexcept { return kSupported; }
+
+} // namespace WasmEdge
@@ -15,15 +15,10 @@ namespace WasmEdge {
 namespace Validator {
 
 namespace {
-
-// Helper function for printing error log of index out of range.
-auto logOutOfRange(ErrCode Code, ErrInfo::IndexCategory Cate, uint32_t Idx,
-                   uint32_t Bound) {
-  spdlog::error(Code);
-  spdlog::error(ErrInfo::InfoForbidIndex(Cate, Idx, Bound));
-  return Unexpect(Code);
-}
-
+/// Value types for referencing the single value type results of the blocks.
+static inline constexpr const std::array kSingleVTypes{
+    VType::Unknown, VType::I32,  VType::I64,     VType::F32,
+    VType::F64,     VType::V128, VType::FuncRef, VType::ExternRef};
 } // namespace
 
 void FormChecker::reset(bool CleanGlobal) {
@@ -204,18 +199,16 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   // configuration checking in loader phase.
 
   // Helper lambda for checking and resolve the block type.
-  auto checkBlockType = [this](std::vector<VType> &Buffer,
-                               const BlockType &BType)
+  auto checkBlockType = [this](const BlockType &BType)
       -> Expect<std::pair<Span<const VType>, Span<const VType>>> {
     using ReturnType = std::pair<Span<const VType>, Span<const VType>>;
     if (BType.IsValType) {
       // ValType case. t2* = valtype | none
       if (BType.Data.Type != ValType::None) {
-        Buffer.clear();
-        Buffer.reserve(1);
-        Buffer.push_back(ASTToVType(BType.Data.Type));
+        const auto VT = static_cast<uint8_t>(ASTToVType(BType.Data.Type));
+        return ReturnType{{}, Span<const VType>(&kSingleVTypes[VT], 1)};
       }
-      return ReturnType{{}, Buffer};
+      return ReturnType{{}, {}};
     } else {
       // Type index case. t2* = type[index].returns
       const uint32_t TypeIdx = BType.Data.Idx;
@@ -278,9 +271,9 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     if (Instr.getMemoryAlign() > 31 ||
         (1UL << Instr.getMemoryAlign()) > (N >> 3UL)) {
       // 2 ^ align needs to <= N / 8
-      spdlog::error(ErrCode::Value::InvalidAlignment);
-      spdlog::error(ErrInfo::InfoMismatch(static_cast<uint8_t>(N >> 3),
-                                          Instr.getMemoryAlign()));
+      logError(ErrCode::Value::InvalidAlignment);
+      logError(ErrInfo::InfoMismatch(static_cast<uint8_t>(N >> 3),
+                                     Instr.getMemoryAlign()));
       return Unexpect(ErrCode::Value::InvalidAlignment);
     }
     if (CheckLane) {
@@ -303,8 +296,8 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
       for (auto &I : Got) {
         GotV.push_back(VTypeToAST(I));
       }
-      spdlog::error(ErrCode::Value::TypeCheckFailed);
-      spdlog::error(ErrInfo::InfoMismatch(ExpV, GotV));
+      logError(ErrCode::Value::TypeCheckFailed);
+      logError(ErrInfo::InfoMismatch(ExpV, GotV));
       return Unexpect(ErrCode::Value::TypeCheckFailed);
     }
     return {};
@@ -326,9 +319,8 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   case OpCode::Block:
   case OpCode::Loop: {
     // Get blocktype [t1*] -> [t2*]
-    std::vector<VType> Buffer;
     Span<const VType> T1, T2;
-    if (auto Res = checkBlockType(Buffer, Instr.getBlockType())) {
+    if (auto Res = checkBlockType(Instr.getBlockType())) {
       std::tie(T1, T2) = std::move(*Res);
     } else {
       return Unexpect(Res);
@@ -369,7 +361,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     return {};
 
   case OpCode::Br:
-    if (auto D = checkCtrlStackDepth(Instr.getTargetIndex()); !D) {
+    if (auto D = checkCtrlStackDepth(Instr.getJump().TargetIndex); !D) {
       return Unexpect(D);
     } else {
       // D is the last D element of control stack.
@@ -380,14 +372,13 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
       const uint32_t Remain =
           static_cast<uint32_t>(ValStack.size() - CtrlStack[*D].Height);
       const uint32_t Arity = static_cast<uint32_t>(NTypes.size());
-      auto &Jump = const_cast<AST::Instruction &>(Instr).getJump();
-      Jump.StackEraseBegin = Remain + Arity;
-      Jump.StackEraseEnd = Arity;
-      Jump.PCOffset = static_cast<int32_t>(CtrlStack[*D].Jump - &Instr);
+      const_cast<AST::Instruction &>(Instr).setJump(
+          {Instr.getJump().TargetIndex, Remain + Arity, Arity,
+           static_cast<int32_t>(CtrlStack[*D].Jump - &Instr)});
       return unreachable();
     }
   case OpCode::Br_if:
-    if (auto D = checkCtrlStackDepth(Instr.getTargetIndex()); !D) {
+    if (auto D = checkCtrlStackDepth(Instr.getJump().TargetIndex); !D) {
       return Unexpect(D);
     } else {
       // D is the last D element of control stack.
@@ -401,10 +392,9 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
       const uint32_t Remain =
           static_cast<uint32_t>(ValStack.size() - CtrlStack[*D].Height);
       const uint32_t Arity = static_cast<uint32_t>(NTypes.size());
-      auto &Jump = const_cast<AST::Instruction &>(Instr).getJump();
-      Jump.StackEraseBegin = Remain + Arity;
-      Jump.StackEraseEnd = Arity;
-      Jump.PCOffset = static_cast<int32_t>(CtrlStack[*D].Jump - &Instr);
+      const_cast<AST::Instruction &>(Instr).setJump(
+          {Instr.getJump().TargetIndex, Remain + Arity, Arity,
+           static_cast<int32_t>(CtrlStack[*D].Jump - &Instr)});
       pushTypes(NTypes);
       return {};
     }
@@ -426,7 +416,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
             return checkTypesMatching(MTypes, NTypes);
           }
           // Push the popped types.
-          std::vector<VType> TypeBuf(NTypes.size());
+          TypeBuf.resize(NTypes.size());
           for (uint32_t IdxN = static_cast<uint32_t>(NTypes.size()); IdxN >= 1;
                --IdxN) {
             const uint32_t Idx = IdxN - 1;
@@ -498,7 +488,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
                            static_cast<uint32_t>(Tables.size()));
     }
     if (Tables[T] != RefType::FuncRef) {
-      spdlog::error(ErrCode::Value::InvalidTableIdx);
+      logError(ErrCode::Value::InvalidTableIdx);
       return Unexpect(ErrCode::Value::InvalidTableIdx);
     }
     // Check target function type index.
@@ -516,14 +506,13 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     auto N = Instr.getTargetIndex();
     if (Funcs.size() <= N) {
       // Call function index out of range
-      spdlog::error(ErrCode::Value::InvalidFuncIdx);
-      spdlog::error(
-          ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::Function, N,
-                                   static_cast<uint32_t>(Funcs.size())));
+      logError(ErrCode::Value::InvalidFuncIdx);
+      logError(ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::Function, N,
+                                        static_cast<uint32_t>(Funcs.size())));
       return Unexpect(ErrCode::Value::InvalidFuncIdx);
     }
     if (Types[Funcs[N]].second != Returns) {
-      spdlog::error(ErrCode::Value::TypeCheckFailed);
+      logError(ErrCode::Value::TypeCheckFailed);
       // TODO: Print the error info of types.
       return Unexpect(ErrCode::Value::TypeCheckFailed);
     }
@@ -537,26 +526,24 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     auto T = Instr.getSourceIndex();
     // Check source table index.
     if (Tables.size() <= T) {
-      spdlog::error(ErrCode::Value::InvalidTableIdx);
-      spdlog::error(
-          ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::Table, T,
-                                   static_cast<uint32_t>(Tables.size())));
+      logError(ErrCode::Value::InvalidTableIdx);
+      logError(ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::Table, T,
+                                        static_cast<uint32_t>(Tables.size())));
       return Unexpect(ErrCode::Value::InvalidTableIdx);
     }
     if (Tables[T] != RefType::FuncRef) {
-      spdlog::error(ErrCode::Value::InvalidTableIdx);
+      logError(ErrCode::Value::InvalidTableIdx);
       return Unexpect(ErrCode::Value::InvalidTableIdx);
     }
     // Check target function type index.
     if (Types.size() <= N) {
-      spdlog::error(ErrCode::Value::InvalidFuncTypeIdx);
-      spdlog::error(
-          ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::FunctionType, N,
-                                   static_cast<uint32_t>(Types.size())));
+      logError(ErrCode::Value::InvalidFuncTypeIdx);
+      logError(ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::FunctionType, N,
+                                        static_cast<uint32_t>(Types.size())));
       return Unexpect(ErrCode::Value::InvalidFuncTypeIdx);
     }
     if (Types[N].second != Returns) {
-      spdlog::error(ErrCode::Value::TypeCheckFailed);
+      logError(ErrCode::Value::TypeCheckFailed);
       // TODO: Print the error info of types.
       return Unexpect(ErrCode::Value::TypeCheckFailed);
     }
@@ -575,9 +562,8 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   case OpCode::Ref__is_null:
     if (auto Res = popType()) {
       if (!isRefType(*Res)) {
-        spdlog::error(ErrCode::Value::TypeCheckFailed);
-        spdlog::error(
-            ErrInfo::InfoMismatch(ValType::FuncRef, VTypeToAST(*Res)));
+        logError(ErrCode::Value::TypeCheckFailed);
+        logError(ErrInfo::InfoMismatch(ValType::FuncRef, VTypeToAST(*Res)));
         return Unexpect(ErrCode::Value::TypeCheckFailed);
       }
     } else {
@@ -587,7 +573,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   case OpCode::Ref__func:
     if (Refs.find(Instr.getTargetIndex()) == Refs.cend()) {
       // Undeclared function reference.
-      spdlog::error(ErrCode::Value::InvalidRefIdx);
+      logError(ErrCode::Value::InvalidRefIdx);
       return Unexpect(ErrCode::Value::InvalidRefIdx);
     }
     return StackTrans({}, {VType::FuncRef});
@@ -614,19 +600,19 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     }
     // T1 and T2 should be number type.
     if (!isNumType(T1)) {
-      spdlog::error(ErrCode::Value::TypeCheckFailed);
-      spdlog::error(ErrInfo::InfoMismatch(ValType::I32, VTypeToAST(T1)));
+      logError(ErrCode::Value::TypeCheckFailed);
+      logError(ErrInfo::InfoMismatch(ValType::I32, VTypeToAST(T1)));
       return Unexpect(ErrCode::Value::TypeCheckFailed);
     }
     if (!isNumType(T2)) {
-      spdlog::error(ErrCode::Value::TypeCheckFailed);
-      spdlog::error(ErrInfo::InfoMismatch(VTypeToAST(T1), VTypeToAST(T2)));
+      logError(ErrCode::Value::TypeCheckFailed);
+      logError(ErrInfo::InfoMismatch(VTypeToAST(T1), VTypeToAST(T2)));
       return Unexpect(ErrCode::Value::TypeCheckFailed);
     }
     // Error if t1 != t2 && t1 =/= Unknown && t2 =/= Unknown
     if (T1 != T2 && T1 != VType::Unknown && T2 != VType::Unknown) {
-      spdlog::error(ErrCode::Value::TypeCheckFailed);
-      spdlog::error(ErrInfo::InfoMismatch(VTypeToAST(T1), VTypeToAST(T2)));
+      logError(ErrCode::Value::TypeCheckFailed);
+      logError(ErrInfo::InfoMismatch(VTypeToAST(T1), VTypeToAST(T2)));
       return Unexpect(ErrCode::Value::TypeCheckFailed);
     }
     // Push value.
@@ -640,7 +626,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   case OpCode::Select_t: {
     // Note: There may be multiple values choise in the future.
     if (Instr.getValTypeList().size() != 1) {
-      spdlog::error(ErrCode::Value::InvalidResultArity);
+      logError(ErrCode::Value::InvalidResultArity);
       return Unexpect(ErrCode::Value::InvalidResultArity);
     }
     VType ExpT = ASTToVType(Instr.getValTypeList()[0]);
@@ -677,7 +663,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     if (Instr.getTargetIndex() < Globals.size() &&
         Globals[Instr.getTargetIndex()].second != ValMut::Var) {
       // Global is immutable
-      spdlog::error(ErrCode::Value::ImmutableGlobal);
+      logError(ErrCode::Value::ImmutableGlobal);
       return Unexpect(ErrCode::Value::ImmutableGlobal);
     }
     [[fallthrough]];
@@ -729,8 +715,8 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
       }
       // Check is the reference types matched.
       if (Elems[Instr.getSourceIndex()] != Tables[Instr.getTargetIndex()]) {
-        spdlog::error(ErrCode::Value::TypeCheckFailed);
-        spdlog::error(
+        logError(ErrCode::Value::TypeCheckFailed);
+        logError(
             ErrInfo::InfoMismatch(ToValType(Tables[Instr.getTargetIndex()]),
                                   ToValType(Elems[Instr.getSourceIndex()])));
         return Unexpect(ErrCode::Value::TypeCheckFailed);
@@ -745,8 +731,8 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
       }
       // Check is the reference types matched.
       if (Tables[Instr.getSourceIndex()] != Tables[Instr.getTargetIndex()]) {
-        spdlog::error(ErrCode::Value::TypeCheckFailed);
-        spdlog::error(
+        logError(ErrCode::Value::TypeCheckFailed);
+        logError(
             ErrInfo::InfoMismatch(ToValType(Tables[Instr.getTargetIndex()]),
                                   ToValType(Tables[Instr.getSourceIndex()])));
         return Unexpect(ErrCode::Value::TypeCheckFailed);
@@ -1081,7 +1067,7 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
                            uint128_t(0xe0e0e0e0e0e0e0e0U);
     const uint128_t Result = Instr.getNum().get<uint128_t>() & Mask;
     if (Result) {
-      spdlog::error(ErrCode::Value::InvalidLaneIdx);
+      logError(ErrCode::Value::InvalidLaneIdx);
       return Unexpect(ErrCode::Value::InvalidLaneIdx);
     }
     return StackTrans({VType::V128, VType::V128}, {VType::V128});
@@ -1546,8 +1532,8 @@ Expect<VType> FormChecker::popType() {
       return VType::Unknown;
     }
     // Value stack underflow
-    spdlog::error(ErrCode::Value::TypeCheckFailed);
-    spdlog::error("    Value stack underflow.");
+    logError(ErrCode::Value::TypeCheckFailed);
+    logError("    Value stack underflow.");
     return Unexpect(ErrCode::Value::TypeCheckFailed);
   }
   auto Res = ValStack.back();
@@ -1568,8 +1554,8 @@ Expect<VType> FormChecker::popType(VType E) {
   }
   if (*Res != E) {
     // Expect value on value stack is not matched
-    spdlog::error(ErrCode::Value::TypeCheckFailed);
-    spdlog::error(ErrInfo::InfoMismatch(VTypeToAST(E), VTypeToAST(*Res)));
+    logError(ErrCode::Value::TypeCheckFailed);
+    logError(ErrInfo::InfoMismatch(VTypeToAST(E), VTypeToAST(*Res)));
     return Unexpect(ErrCode::Value::TypeCheckFailed);
   }
   return *Res;
@@ -1593,8 +1579,8 @@ void FormChecker::pushCtrl(Span<const VType> In, Span<const VType> Out,
 Expect<FormChecker::CtrlFrame> FormChecker::popCtrl() {
   if (CtrlStack.empty()) {
     // Ctrl stack is empty when popping.
-    spdlog::error(ErrCode::Value::TypeCheckFailed);
-    spdlog::error("    Control stack underflow.");
+    logError(ErrCode::Value::TypeCheckFailed);
+    logError("    Control stack underflow.");
     return Unexpect(ErrCode::Value::TypeCheckFailed);
   }
   if (auto Res = popTypes(CtrlStack.back().EndTypes); !Res) {
@@ -1602,11 +1588,11 @@ Expect<FormChecker::CtrlFrame> FormChecker::popCtrl() {
   }
   if (ValStack.size() != CtrlStack.back().Height) {
     // Value stack size not matched.
-    spdlog::error(ErrCode::Value::TypeCheckFailed);
-    spdlog::error("    Value stack underflow.");
+    logError(ErrCode::Value::TypeCheckFailed);
+    logError("    Value stack underflow.");
     return Unexpect(ErrCode::Value::TypeCheckFailed);
   }
-  auto Head = std::move(CtrlStack.back());
+  auto Head = CtrlStack.back();
   CtrlStack.pop_back();
   return Head;
 }
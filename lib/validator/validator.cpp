@@ -5,19 +5,85 @@
 
 #include "common/errinfo.h"
 #include "common/log.h"
+#include "common/parallel.h"
 
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
 namespace Validator {
 
+namespace {
+/// Validate the function body with the function type index and the locals.
+Expect<void>
+validateFunction(FormChecker &Checker, AST::InstrView Instrs, uint32_t TypeIdx,
+                 Span<const std::pair<uint32_t, ValType>> Locals) {
+  // Reset stack in FormChecker.
+  Checker.reset();
+  // Add parameters into this frame.
+  for (auto Val : Checker.getTypes()[TypeIdx].first) {
+    Checker.addLocal(Val);
+  }
+  // Add locals into this frame.
+  for (auto Val : Locals) {
+    for (uint32_t Cnt = 0; Cnt < Val.first; ++Cnt) {
+      Checker.addLocal(Val.second);
+    }
+  }
+  // Validate function body expression.
+  if (auto Res = Checker.validate(Instrs, Checker.getTypes()[TypeIdx].second);
+      !Res) {
+    if (!Checker.isQuiet()) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
+    }
+    return Unexpect(Res);
+  }
+  return {};
+}
+
+/// Minimum instruction count of the code section for validating in parallel.
+static inline constexpr const size_t kParallelValidationSize = 64 * 1024;
+/// Count of the function bodies taken by a worker at a time.
+static inline constexpr const uint32_t kParallelValidationChunk = 16;
+
+/// Validate the function bodies by the workers with the copies of the formal
+/// checker, and return the lowest index of the failed function bodies. The
+/// workers are quiet, the errors should be reported by validating the failed
+/// one again.
+uint32_t validateFunctionsParallel(const FormChecker &Checker,
+                                   Span<const AST::CodeSegment> CodeVec,
+                                   uint32_t Threads) {
+  return runParallelJobs(
+      static_cast<uint32_t>(CodeVec.size()), kParallelValidationChunk, Threads,
+      [&Checker, CodeVec]() {
+        FormChecker Worker(Checker);
+        Worker.setQuiet();
+        return [Worker = std::move(Worker), CodeVec](uint32_t Id) mutable {
+          // The function body deferred by the lazy loading is skipped.
+          const auto &FuncVec = Worker.getFunctions();
+          const uint32_t TId = Id + Worker.getNumImportFuncs();
+          return TId < static_cast<uint32_t>(FuncVec.size()) &&
+                 (CodeVec[Id].isLazy() ||
+                  validateFunction(Worker, CodeVec[Id].getExpr().getInstrs(),
+                                   FuncVec[TId], CodeVec[Id].getLocals()));
+        };
+      });
+}
+} // namespace
+
 // Validate Module. See "include/validator/validator.h".
 Expect<void> Validator::validate(const AST::Module &Mod) {
   // https://webassembly.github.io/spec/core/valid/modules.html
+  // The modules restored from the module cache have been validated.
+  if (Mod.getIsCached()) {
+    return {};
+  }
   Checker.reset(true);
 
   // Register type definitions into FormChecker.
@@ -112,8 +178,21 @@ Expect<void> Validator::validate(const AST::Module &Mod) {
     return Unexpect(ErrCode::Value::MultiMemories);
   }
 
+  // Keep the context of this module for the function bodies deferred by the
+  // lazy loading.
+  if (Mod.getCodeDecoder()) {
+    const_cast<AST::Module &>(Mod).setCodeChecker(
+        std::make_shared<LazyCodeChecker>(Checker));
+  }
+
   // Set the validated flag.
   const_cast<AST::Module &>(Mod).setIsValidated();
+
+  // Store the validated module into the module cache.
+  if (const auto &Writer = Mod.getCacheWriter()) {
+    Writer->write(Mod);
+    const_cast<AST::Module &>(Mod).setCacheWriter(nullptr);
+  }
   return {};
 }
 
@@ -206,26 +285,13 @@ Expect<void> Validator::validate(const AST::ElementSegment &ElemSeg) {
 // Validate Code segment. See "include/validator/validator.h".
 Expect<void> Validator::validate(const AST::CodeSegment &CodeSeg,
                                  const uint32_t TypeIdx) {
-  // Reset stack in FormChecker.
-  Checker.reset();
-  // Add parameters into this frame.
-  for (auto Val : Checker.getTypes()[TypeIdx].first) {
-    Checker.addLocal(Val);
-  }
-  // Add locals into this frame.
-  for (auto Val : CodeSeg.getLocals()) {
-    for (uint32_t Cnt = 0; Cnt < Val.first; ++Cnt) {
-      Checker.addLocal(Val.second);
-    }
-  }
-  // Validate function body expression.
-  if (auto Res = Checker.validate(CodeSeg.getExpr().getInstrs(),
-                                  Checker.getTypes()[TypeIdx].second);
-      !Res) {
-    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
-    return Unexpect(Res);
+  // The function body deferred by the lazy loading is validated on its first
+  // call.
+  if (CodeSeg.isLazy()) {
+    return {};
   }
-  return {};
+  return validateFunction(Checker, CodeSeg.getExpr().getInstrs(), TypeIdx,
+                          CodeSeg.getLocals());
 }
 
 // Validate Data segment. See "include/validator/validator.h".
@@ -433,8 +499,24 @@ Expect<void> Validator::validate(const AST::CodeSection &CodeSec) {
   const auto &CodeVec = CodeSec.getContent();
   const auto &FuncVec = Checker.getFunctions();
 
+  // Validate the function bodies of the large code section in parallel first.
+  // The function bodies before the lowest failed one are valid, and the rest
+  // are validated sequentially to report the same error.
+  uint32_t StartId = 0;
+  if (const uint32_t Threads = Conf.getRuntimeConfigure().getLoadingThreads();
+      Threads > 1 && CodeVec.size() > 1) {
+    size_t InstrNum = 0;
+    for (const auto &CodeSeg : CodeVec) {
+      InstrNum += CodeSeg.getExpr().getInstrs().size();
+    }
+    if (InstrNum >= kParallelValidationSize) {
+      StartId = validateFunctionsParallel(Checker, CodeVec, Threads);
+    }
+  }
+
   // Validate function body.
-  for (uint32_t Id = 0; Id < static_cast<uint32_t>(CodeVec.size()); ++Id) {
+  for (uint32_t Id = StartId; Id < static_cast<uint32_t>(CodeVec.size());
+       ++Id) {
     // Added functions contains imported functions.
     uint32_t TId = Id + static_cast<uint32_t>(Checker.getNumImportFuncs());
     if (TId >= static_cast<uint32_t>(FuncVec.size())) {
@@ -593,5 +675,17 @@ Expect<void> Validator::validateConstExpr(AST::InstrView Instrs,
   return Checker.validate(Instrs, Returns);
 }
 
+// Validate the deferred function body. See "include/validator/validator.h".
+Expect<void> LazyCodeChecker::validate(
+    AST::InstrView Instrs, uint32_t TypeIdx,
+    Span<const std::pair<uint32_t, ValType>> Locals) const {
+  std::lock_guard Lock(Mutex);
+  if (auto Res = validateFunction(Checker, Instrs, TypeIdx, Locals); !Res) {
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+    return Unexpect(Res);
+  }
+  return {};
+}
+
 } // namespace Validator
 } // namespace WasmEdge
@@ -5,11 +5,45 @@
 #include "vm/async.h"
 
 #include "host/wasi/wasimodule.h"
+#include "loader/profile.h"
 #include "plugin/plugin.h"
 
+#ifdef WASMEDGE_BUILD_AOT_RUNTIME
+#include "aot/compiler.h"
+#endif
+
 namespace WasmEdge {
 namespace VM {
 
+#ifdef WASMEDGE_BUILD_AOT_RUNTIME
+namespace {
+/// Compiler of the hot functions for the tiered execution with the LLVM JIT.
+class JITTierUpCompiler : public Executor::TierUpCompiler {
+public:
+  JITTierUpCompiler(const Configure &C) noexcept : Conf(C) {}
+
+  Expect<void>
+  compile(Runtime::Instance::FunctionInstance::WasmFunction &Code) override {
+    auto &Tier = *Code.Tier;
+    AOT::Compiler Compiler(Conf);
+    auto Res = Compiler.compileFunction(
+        Tier.Module->Types, Tier.Module->FuncTypeIdxs,
+        Tier.Module->GlobalTypes, Tier.FuncIdx, Code.Locals, Code.Instrs,
+        Executor::Executor::Intrinsics);
+    if (unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    Tier.Wrapper = std::move(Res->Wrapper);
+    Tier.Function = std::move(Res->Function);
+    return {};
+  }
+
+private:
+  const Configure &Conf;
+};
+} // namespace
+#endif
+
 VM::VM(const Configure &Conf)
     : Conf(Conf), Stage(VMStage::Inited),
       LoaderEngine(Conf, &Executor::Executor::Intrinsics),
@@ -27,6 +61,13 @@ VM::VM(const Configure &Conf, Runtime::StoreManager &S)
 
 void VM::unsafeInitVM() {
   using namespace std::literals::string_view_literals;
+#ifdef WASMEDGE_BUILD_AOT_RUNTIME
+  // Compile the hot functions in the background for the tiered execution.
+  if (Conf.getRuntimeConfigure().isTiering()) {
+    ExecutorEngine.setTierUpCompiler(
+        std::make_unique<JITTierUpCompiler>(Conf));
+  }
+#endif
   // Create import modules from configuration.
   if (Conf.hasHostRegistration(HostRegistration::Wasi)) {
     std::unique_ptr<Runtime::Instance::ModuleInstance> WasiMod =
@@ -96,6 +137,9 @@ Expect<void> VM::unsafeRegisterModule(std::string_view Name,
   }
   // Load module.
   if (auto Res = LoaderEngine.parseModule(Path)) {
+    if (auto Check = unsafeCompileJIT(*(*Res).get()); !Check) {
+      return Unexpect(Check);
+    }
     return unsafeRegisterModule(Name, *(*Res).get());
   } else {
     return Unexpect(Res);
@@ -111,6 +155,9 @@ Expect<void> VM::unsafeRegisterModule(std::string_view Name,
   }
   // Load module.
   if (auto Res = LoaderEngine.parseModule(Code)) {
+    if (auto Check = unsafeCompileJIT(*(*Res).get()); !Check) {
+      return Unexpect(Check);
+    }
     return unsafeRegisterModule(Name, *(*Res).get());
   } else {
     return Unexpect(Res);
@@ -158,6 +205,9 @@ VM::unsafeRunWasmFile(const std::filesystem::path &Path, std::string_view Func,
   }
   // Load module.
   if (auto Res = LoaderEngine.parseModule(Path)) {
+    if (auto Check = unsafeCompileJIT(*(*Res).get()); !Check) {
+      return Unexpect(Check);
+    }
     return unsafeRunWasmFile(*(*Res).get(), Func, Params, ParamTypes);
   } else {
     return Unexpect(Res);
@@ -175,6 +225,9 @@ VM::unsafeRunWasmFile(Span<const Byte> Code, std::string_view Func,
   }
   // Load module.
   if (auto Res = LoaderEngine.parseModule(Code)) {
+    if (auto Check = unsafeCompileJIT(*(*Res).get()); !Check) {
+      return Unexpect(Check);
+    }
     return unsafeRunWasmFile(*(*Res).get(), Func, Params, ParamTypes);
   } else {
     return Unexpect(Res);
@@ -290,10 +343,10 @@ Expect<void> VM::unsafeValidate() {
   }
   if (auto Res = ValidatorEngine.validate(*Mod.get())) {
     Stage = VMStage::Validated;
-    return {};
   } else {
     return Unexpect(Res);
   }
+  return unsafeCompileJIT(*Mod.get());
 }
 
 Expect<void> VM::unsafeInstantiate() {
@@ -391,6 +444,29 @@ VM::asyncExecute(std::string_view ModName, std::string_view Func,
           std::vector(ParamTypes.begin(), ParamTypes.end())};
 }
 
+Expect<void> VM::unsafeCompileJIT([[maybe_unused]] AST::Module &Module) {
+#ifdef WASMEDGE_BUILD_AOT_RUNTIME
+  if (!Conf.getRuntimeConfigure().isJIT() || Module.getSymbol()) {
+    return {};
+  }
+  if (!Module.getIsValidated()) {
+    if (auto Res = ValidatorEngine.validate(Module); !Res) {
+      return Unexpect(Res);
+    }
+  }
+  // Fallback to the interpreter mode if failed.
+  AOT::Compiler JITCompiler(Conf);
+  if (auto Res = JITCompiler.compileJIT(Module)) {
+    *Module.getSymbol() = &Executor::Executor::Intrinsics;
+  } else {
+    spdlog::error("    JIT compilation failed:{}, use interpreter mode "
+                  "instead.",
+                  Res.error());
+  }
+#endif
+  return {};
+}
+
 void VM::unsafeCleanup() {
   Mod.reset();
   ActiveModInst.reset();
@@ -421,6 +497,17 @@ VM::unsafeGetImportModule(const HostRegistration Type) const {
   return nullptr;
 }
 
+Expect<void> VM::unsafeStoreProfile(const std::filesystem::path &Path) const {
+  Loader::ProfileFile File;
+  if (auto Res = File.load(Path); !Res) {
+    return Unexpect(Res);
+  }
+  for (const auto &[Key, Prof] : ExecutorEngine.getProfiles()) {
+    File.merge(Key, Prof);
+  }
+  return File.store(Path);
+}
+
 const Runtime::Instance::ModuleInstance *VM::unsafeGetActiveModule() const {
   if (ActiveModInst) {
     return ActiveModInst.get();
@@ -0,0 +1,481 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/aot/AOTCompilerTest.cpp - AOT compiler unit tests ---===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents unit tests of the options of the AOT compiler.
+///
+//===----------------------------------------------------------------------===//
+
+#include "aot/cache.h"
+#include "aot/compiler.h"
+#include "common/defines.h"
+#include "common/log.h"
+#include "loader/loader.h"
+#include "loader/profile.h"
+#include "validator/validator.h"
+#include "vm/vm.h"
+
+#include "../common/modulebuilder.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <set>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace WasmEdge;
+
+using Test::Function;
+
+/// Generate the module with the encoded function types, the type indices of
+/// the functions imported from `env`, and the functions. The module has a
+/// memory of a page, a mutable `i32` global, and a table of all the defined
+/// functions. The defined functions are exported as `f0`, `f1`, and so on.
+std::vector<Byte>
+generateExportedModule(const std::vector<std::vector<Byte>> &Types,
+                       const std::vector<uint32_t> &Imports,
+                       const std::vector<Function> &Funcs) {
+  const auto ImportNum = static_cast<uint32_t>(Imports.size());
+  const auto FuncNum = static_cast<uint32_t>(Funcs.size());
+  std::vector<Test::Section> Sections;
+  std::vector<Byte> Content;
+  if (ImportNum > 0) {
+    Test::appendU32(Content, ImportNum);
+    for (uint32_t I = 0; I < ImportNum; ++I) {
+      const std::string Name = "imp" + std::to_string(I);
+      Content.insert(Content.end(), {0x03, 'e', 'n', 'v'});
+      Test::appendU32(Content, static_cast<uint32_t>(Name.size()));
+      Content.insert(Content.end(), Name.begin(), Name.end());
+      Content.push_back(0x00);
+      Test::appendU32(Content, Imports[I]);
+    }
+    Sections.push_back({0x02, std::move(Content)});
+  }
+  Content = {0x01, 0x70, 0x00};
+  Test::appendU32(Content, FuncNum);
+  Sections.push_back({0x04, std::move(Content)});
+  Sections.push_back({0x05, {0x01, 0x00, 0x01}});
+  Sections.push_back({0x06, {0x01, 0x7F, 0x01, 0x41, 0x00, 0x0B}});
+  Content.clear();
+  Test::appendU32(Content, FuncNum);
+  for (uint32_t I = 0; I < FuncNum; ++I) {
+    const std::string Name = "f" + std::to_string(I);
+    Test::appendU32(Content, static_cast<uint32_t>(Name.size()));
+    Content.insert(Content.end(), Name.begin(), Name.end());
+    Content.push_back(0x00);
+    Test::appendU32(Content, ImportNum + I);
+  }
+  Sections.push_back({0x07, std::move(Content)});
+  Content = {0x01, 0x00, 0x41, 0x00, 0x0B};
+  Test::appendU32(Content, FuncNum);
+  for (uint32_t I = 0; I < FuncNum; ++I) {
+    Test::appendU32(Content, ImportNum + I);
+  }
+  Sections.push_back({0x09, std::move(Content)});
+  return Test::generateModule(Types, Funcs, Sections);
+}
+
+/// Type `[i32] -> [i32]`.
+const std::vector<Byte> UnaryType = {0x60, 0x01, 0x7F, 0x01, 0x7F};
+
+/// Generate the functions of `[i32] -> [i32]` calling each other directly and
+/// indirectly, which are split into the different partitions.
+std::vector<Function> generateCallChain(uint32_t Num) {
+  std::vector<Function> Funcs;
+  // Store the argument into the memory and the global, and return `x*3+1`.
+  Funcs.push_back({0,
+                   {0x00},
+                   {0x41, 0x00, 0x20, 0x00, 0x36, 0x02, 0x00, 0x23, 0x00,
+                    0x20, 0x00, 0x6A, 0x24, 0x00, 0x20, 0x00, 0x41, 0x03,
+                    0x6C, 0x41, 0x01, 0x6A}});
+  for (uint32_t I = 1; I + 2 < Num; ++I) {
+    const auto Prev = static_cast<Byte>(I - 1);
+    const auto Cur = static_cast<Byte>(I);
+    if (I % 2) {
+      // Call the previous one directly and add the index.
+      Funcs.push_back({0, {0x00}, {0x20, 0x00, 0x10, Prev, 0x41, Cur, 0x6A}});
+    } else {
+      // Call the previous one indirectly and xor the index.
+      Funcs.push_back({0,
+                       {0x00},
+                       {0x20, 0x00, 0x41, Prev, 0x11, 0x00, 0x00, 0x41, Cur,
+                        0x73}});
+    }
+  }
+  // Sum the numbers from the argument down to 1.
+  Funcs.push_back({0,
+                   {0x01, 0x01, 0x7F},
+                   {0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6A, 0x21, 0x01,
+                    0x20, 0x00, 0x41, 0x7F, 0x6A, 0x21, 0x00, 0x20, 0x00,
+                    0x0D, 0x00, 0x0B, 0x20, 0x01}});
+  // Add the stored argument, the global, and the argument.
+  Funcs.push_back({0,
+                   {0x00},
+                   {0x41, 0x00, 0x28, 0x02, 0x00, 0x23, 0x00, 0x6A, 0x20,
+                    0x00, 0x6A}});
+  return Funcs;
+}
+
+Expect<void> compile(const Configure &Conf, Span<const Byte> Wasm,
+                     const std::filesystem::path &Path) {
+  Loader::Loader Load(Conf);
+  Validator::Validator Valid(Conf);
+  AOT::Compiler Compiler(Conf);
+  auto Mod = Load.parseModule(Wasm);
+  if (!Mod) {
+    return Unexpect(Mod);
+  }
+  if (auto Res = Valid.validate(**Mod); !Res) {
+    return Unexpect(Res);
+  }
+  return Compiler.compile(Wasm, **Mod, Path);
+}
+
+/// Call the exported functions in order with the arguments, and collect the
+/// results. The module is given by the binary or the compiled file.
+template <typename T>
+std::vector<uint32_t> run(const Configure &Conf, T &&Input, uint32_t FuncNum) {
+  VM::VM VM(Conf);
+  std::vector<uint32_t> Rets;
+  EXPECT_TRUE(VM.loadWasm(Input));
+  EXPECT_TRUE(VM.validate());
+  EXPECT_TRUE(VM.instantiate());
+  for (const uint32_t Arg : {1U, 7U, 1000U}) {
+    for (uint32_t I = 0; I < FuncNum; ++I) {
+      auto Res = VM.execute("f" + std::to_string(I),
+                            std::array{ValVariant(Arg)},
+                            std::array{ValType::I32});
+      EXPECT_TRUE(Res);
+      if (Res && Res->size() == 1) {
+        Rets.push_back((*Res)[0].first.template get<uint32_t>());
+      }
+    }
+  }
+  return Rets;
+}
+
+TEST(CompilerTest, Jobs) {
+  constexpr uint32_t kFuncNum = 16;
+  const auto Wasm =
+      generateExportedModule({UnaryType}, {}, generateCallChain(kFuncNum));
+  Configure Conf;
+  const auto Expected = run(Conf, Span<const Byte>(Wasm), kFuncNum);
+  ASSERT_EQ(Expected.size(), kFuncNum * 3);
+
+  // The partitions compiled by the jobs are linked into the same result as
+  // compiling the whole module by a job, including the more jobs than the
+  // functions.
+  for (const auto Format : {CompilerConfigure::OutputFormat::Native,
+                            CompilerConfigure::OutputFormat::Wasm}) {
+    for (const uint32_t Jobs : {1U, 2U, 4U, 32U}) {
+      Configure CompileConf;
+      CompileConf.getCompilerConfigure().setOutputFormat(Format);
+      CompileConf.getCompilerConfigure().setOptimizationLevel(
+          CompilerConfigure::OptimizationLevel::O0);
+      CompileConf.getCompilerConfigure().setJobs(Jobs);
+      const auto Path =
+          std::filesystem::temp_directory_path() /
+          std::filesystem::u8path(
+              "AOTCompilerTestJobs" +
+              std::string(Format == CompilerConfigure::OutputFormat::Native
+                              ? WASMEDGE_LIB_EXTENSION
+                              : ".aot.wasm"));
+      ASSERT_TRUE(compile(CompileConf, Wasm, Path));
+      EXPECT_EQ(run(Conf, Path, kFuncNum), Expected) << Jobs << " jobs";
+      std::error_code EC;
+      std::filesystem::remove(Path, EC);
+    }
+  }
+}
+
+/// Wait for the background compilations of the tier-up.
+template <typename PredT> bool waitFor(PredT &&Pred) {
+  const auto Deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!Pred()) {
+    if (std::chrono::steady_clock::now() > Deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+TEST(TierUpTest, HotFunction) {
+  constexpr uint32_t kFuncNum = 16;
+  const auto Wasm =
+      generateExportedModule({UnaryType}, {}, generateCallChain(kFuncNum));
+  const auto Expected = run(Configure(), Span<const Byte>(Wasm), kFuncNum);
+
+  Configure Conf;
+  Conf.getRuntimeConfigure().setTiering(true);
+  Conf.getRuntimeConfigure().setTierUpCallThreshold(8);
+  Conf.getRuntimeConfigure().setTierUpLoopThreshold(1000);
+  Conf.getStatisticsConfigure().setTierUpCounting(true);
+  Conf.getCompilerConfigure().setOptimizationLevel(
+      CompilerConfigure::OptimizationLevel::O0);
+  VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(Span<const Byte>(Wasm)));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  const auto *ModInst = VM.getActiveModule();
+  ASSERT_NE(ModInst, nullptr);
+  std::vector<const Runtime::Instance::FunctionInstance *> Funcs;
+  for (uint32_t I = 0; I < kFuncNum; ++I) {
+    Funcs.push_back(ModInst->findFuncExports("f" + std::to_string(I)));
+    ASSERT_NE(Funcs.back(), nullptr);
+  }
+
+  // Calling `f3` over the threshold makes it and its direct and indirect
+  // callees hot, and the others are kept interpreting.
+  for (uint32_t I = 0; I < 8; ++I) {
+    ASSERT_TRUE(VM.execute("f3", std::array{ValVariant(I)},
+                           std::array{ValType::I32}));
+  }
+  auto &Stat = VM.getStatistics();
+  EXPECT_TRUE(waitFor([&Stat]() { return Stat.getTierUpCount() >= 4; }));
+  for (uint32_t I = 0; I < 4; ++I) {
+    EXPECT_TRUE(Funcs[I]->isTieredUp()) << "f" << I;
+  }
+
+  // The loop back-edges make the function hot in a call.
+  const uint32_t SumIdx = kFuncNum - 2;
+  ASSERT_TRUE(VM.execute("f" + std::to_string(SumIdx),
+                         std::array{ValVariant(UINT32_C(2000))},
+                         std::array{ValType::I32}));
+  EXPECT_TRUE(waitFor([&Stat]() { return Stat.getTierUpCount() >= 5; }));
+  EXPECT_TRUE(Funcs[SumIdx]->isTieredUp());
+  EXPECT_EQ(Stat.getTierUpCount(), 5U);
+  for (uint32_t I = 4; I < kFuncNum; ++I) {
+    if (I != SumIdx) {
+      EXPECT_FALSE(Funcs[I]->isTieredUp()) << "f" << I;
+    }
+  }
+
+  // The switched functions return the same results as interpreting. The state
+  // of the memory and the global is reset as the expected run.
+  ASSERT_TRUE(VM.instantiate());
+  std::vector<uint32_t> Rets;
+  for (const uint32_t Arg : {1U, 7U, 1000U}) {
+    for (uint32_t I = 0; I < kFuncNum; ++I) {
+      auto Res = VM.execute("f" + std::to_string(I),
+                            std::array{ValVariant(Arg)},
+                            std::array{ValType::I32});
+      ASSERT_TRUE(Res);
+      Rets.push_back((*Res)[0].first.get<uint32_t>());
+    }
+  }
+  EXPECT_EQ(Rets, Expected);
+}
+
+/// Read the IR dumped by the compiler.
+std::string readDumpedIR() {
+  std::ifstream Fin("wasm.ll");
+  return std::string(std::istreambuf_iterator<char>(Fin),
+                     std::istreambuf_iterator<char>());
+}
+
+TEST(ProfileTest, RoundTrip) {
+  constexpr uint32_t kFuncNum = 16;
+  const auto Wasm =
+      generateExportedModule({UnaryType}, {}, generateCallChain(kFuncNum));
+  const auto ProfilePath = std::filesystem::temp_directory_path() /
+                           std::filesystem::u8path("AOTCompilerTest.profile");
+  std::error_code EC;
+  std::filesystem::remove(ProfilePath, EC);
+
+  // Record the profile. The loop of `sum` takes the back-edge 99 times and
+  // exits once, and `f2` calls `f1` indirectly.
+  {
+    Configure Conf;
+    Conf.getRuntimeConfigure().setProfiling(true);
+    VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Span<const Byte>(Wasm)));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    ASSERT_TRUE(VM.execute("f" + std::to_string(kFuncNum - 2),
+                           std::array{ValVariant(UINT32_C(100))},
+                           std::array{ValType::I32}));
+    for (uint32_t I = 0; I < 5; ++I) {
+      ASSERT_TRUE(VM.execute("f2", std::array{ValVariant(I)},
+                             std::array{ValType::I32}));
+    }
+    ASSERT_TRUE(VM.storeProfile(ProfilePath));
+  }
+
+  // Read it back by the key of the binary.
+  Loader::ProfileFile File;
+  ASSERT_TRUE(File.load(ProfilePath));
+  const auto *Profile = File.find(Loader::ProfileFile::getKey(Wasm));
+  ASSERT_NE(Profile, nullptr);
+  EXPECT_FALSE(Profile->empty());
+
+  // The branch weights and the call targets are attached to the IR only if
+  // compiled with the profile.
+  Configure Conf;
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Native);
+  Conf.getCompilerConfigure().setOptimizationLevel(
+      CompilerConfigure::OptimizationLevel::O1);
+  Conf.getCompilerConfigure().setDumpIR(true);
+  const auto Path =
+      std::filesystem::temp_directory_path() /
+      std::filesystem::u8path("AOTCompilerTestProfile" WASMEDGE_LIB_EXTENSION);
+  {
+    Loader::Loader Load(Conf);
+    Validator::Validator Valid(Conf);
+    auto Mod = Load.parseModule(Wasm);
+    ASSERT_TRUE(Mod);
+    ASSERT_TRUE(Valid.validate(**Mod));
+    AOT::Compiler Compiler(Conf);
+    ASSERT_TRUE(Compiler.compile(Wasm, **Mod, Path));
+    const auto IR = readDumpedIR();
+    EXPECT_EQ(IR.find("branch_weights"), std::string::npos);
+    EXPECT_EQ(IR.find("!\"VP\""), std::string::npos);
+
+    Compiler.setProfile(Profile);
+    ASSERT_TRUE(Compiler.compile(Wasm, **Mod, Path));
+    const auto ProfiledIR = readDumpedIR();
+    EXPECT_NE(ProfiledIR.find("!{!\"branch_weights\", i32 99, i32 1}"),
+              std::string::npos);
+    EXPECT_NE(ProfiledIR.find("!{!\"VP\", i32 0, i64 5,"), std::string::npos);
+  }
+  EXPECT_EQ(run(Configure(), Path, kFuncNum),
+            run(Configure(), Span<const Byte>(Wasm), kFuncNum));
+
+  std::filesystem::remove(ProfilePath, EC);
+  std::filesystem::remove(Path, EC);
+  std::filesystem::remove("wasm.ll", EC);
+  std::filesystem::remove("wasm-opt.ll", EC);
+}
+
+/// Generate the functions of `[i32] -> [i32]` with about 1024 instructions,
+/// which are over the size of a fragment of the object cache in total. The
+/// functions of the indices from `Base` call the function 0 and add the
+/// constants decided by their indices to the argument. The constant of the
+/// function of the index `Edited` is changed.
+std::vector<Function> generateLargeFunctions(uint32_t Num, uint32_t Base = 0,
+                                             uint32_t Edited = UINT32_MAX) {
+  std::vector<Function> Funcs;
+  for (uint32_t Idx = Base; Idx < Base + Num; ++Idx) {
+    Function Func{0, {0x00}, {}};
+    if (Idx != 0) {
+      Func.Body.insert(Func.Body.end(), {0x20, 0x00, 0x10, 0x00, 0x21, 0x00});
+    }
+    for (uint32_t J = 0; J < 255; ++J) {
+      const auto Num =
+          static_cast<Byte>(Idx == Edited && J == 0 ? 63 : (Idx + J) % 63);
+      Func.Body.insert(Func.Body.end(),
+                       {0x20, 0x00, 0x41, Num, 0x6A, 0x21, 0x00});
+    }
+    Func.Body.insert(Func.Body.end(), {0x20, 0x00});
+    Funcs.push_back(std::move(Func));
+  }
+  return Funcs;
+}
+
+/// Get the file names of the cached objects.
+std::set<std::string> listCachedObjects() {
+  std::set<std::string> Names;
+  const auto Path = AOT::Cache::getPath({}, AOT::Cache::StorageScope::Local,
+                                        "objects");
+  EXPECT_TRUE(Path);
+  std::error_code EC;
+  for (const auto &Entry :
+       std::filesystem::directory_iterator(Path->parent_path(), EC)) {
+    Names.insert(Entry.path().filename().u8string());
+  }
+  return Names;
+}
+
+/// Compile the module with the object cache, and return the count of the
+/// objects compiled and stored into the cache.
+size_t compileCached(const Configure &Conf, Span<const Byte> Wasm,
+                     const std::filesystem::path &Path) {
+  const auto Before = listCachedObjects();
+  EXPECT_TRUE(compile(Conf, Wasm, Path));
+  size_t Count = 0;
+  for (const auto &Name : listCachedObjects()) {
+    Count += Before.count(Name) == 0;
+  }
+  return Count;
+}
+
+TEST(ObjectCacheTest, Incremental) {
+  constexpr uint32_t kFuncNum = 64;
+  const auto Wasm =
+      generateExportedModule({UnaryType}, {}, generateLargeFunctions(kFuncNum));
+  // An edit of a function body.
+  const auto EditedWasm = generateExportedModule(
+      {UnaryType}, {}, generateLargeFunctions(kFuncNum, 0, 20));
+  // A type not used by the functions.
+  const auto TypedWasm = generateExportedModule(
+      {UnaryType, {0x60, 0x00, 0x00}}, {}, generateLargeFunctions(kFuncNum));
+  // The function 0 is replaced by an import. The other functions have the
+  // same indices and bodies, but call the import instead.
+  const auto ImportedWasm = generateExportedModule(
+      {UnaryType}, {0}, generateLargeFunctions(kFuncNum - 1, 1));
+
+  Configure Conf;
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Native);
+  Conf.getCompilerConfigure().setOptimizationLevel(
+      CompilerConfigure::OptimizationLevel::O0);
+  Conf.getCompilerConfigure().setObjectCaching(true);
+  const auto Path =
+      std::filesystem::temp_directory_path() /
+      std::filesystem::u8path("AOTCompilerTestCache" WASMEDGE_LIB_EXTENSION);
+
+  // Count the fragments of the changed modules from the empty cache.
+  AOT::Cache::clear(AOT::Cache::StorageScope::Local, "objects");
+  const size_t TypedCount = compileCached(Conf, TypedWasm, Path);
+  AOT::Cache::clear(AOT::Cache::StorageScope::Local, "objects");
+  const size_t ImportedCount = compileCached(Conf, ImportedWasm, Path);
+  AOT::Cache::clear(AOT::Cache::StorageScope::Local, "objects");
+
+  // The functions are split into several fragments, and all of them are
+  // reused by compiling the same module again.
+  const size_t Count = compileCached(Conf, Wasm, Path);
+  EXPECT_GE(Count, 2U);
+  EXPECT_EQ(compileCached(Conf, Wasm, Path), 0U);
+  EXPECT_EQ(run(Configure(), Path, kFuncNum),
+            run(Configure(), Span<const Byte>(Wasm), kFuncNum));
+
+  // Only the fragment of the edited function is compiled again, and linked
+  // with the reused ones.
+  EXPECT_EQ(compileCached(Conf, EditedWasm, Path), 1U);
+  EXPECT_EQ(run(Configure(), Path, kFuncNum),
+            run(Configure(), Span<const Byte>(EditedWasm), kFuncNum));
+
+  // The changes of the types invalidate all the fragments, and the changes of
+  // the imports invalidate the fragments of their callers.
+  EXPECT_EQ(compileCached(Conf, TypedWasm, Path), TypedCount);
+  EXPECT_EQ(compileCached(Conf, ImportedWasm, Path), ImportedCount);
+
+  AOT::Cache::clear(AOT::Cache::StorageScope::Local, "objects");
+  std::error_code EC;
+  std::filesystem::remove(Path, EC);
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -44,6 +44,7 @@ static SpecTest T(std::filesystem::u8path("../spec/testSuites"sv));
 // Parameterized testing class.
 class NativeCoreTest : public testing::TestWithParam<std::string> {};
 class CustomWasmCoreTest : public testing::TestWithParam<std::string> {};
+class JITCoreTest : public testing::TestWithParam<std::string> {};
 
 TEST_P(NativeCoreTest, TestSuites) {
   const auto [Proposal, Conf, UnitName] = T.resolve(GetParam());
@@ -259,11 +260,108 @@ TEST_P(CustomWasmCoreTest, TestSuites) {
   T.run(Proposal, UnitName);
 }
 
+TEST_P(JITCoreTest, TestSuites) {
+  const auto [Proposal, Conf, UnitName] = T.resolve(GetParam());
+  WasmEdge::Configure CopyConf = Conf;
+  CopyConf.getRuntimeConfigure().setJIT(true);
+  CopyConf.getCompilerConfigure().setOptimizationLevel(
+      WasmEdge::CompilerConfigure::OptimizationLevel::O0);
+  WasmEdge::VM::VM VM(CopyConf);
+  WasmEdge::SpecTestModule SpecTestMod;
+  VM.registerModule(SpecTestMod);
+  // The modules are compiled in memory when instantiating, and the functions
+  // should not fall back to the interpreter.
+  auto CheckCompiled =
+      [](const WasmEdge::Runtime::Instance::ModuleInstance *ModInst)
+      -> Expect<void> {
+    if (ModInst == nullptr) {
+      return Unexpect(ErrCode::Value::WrongInstanceAddress);
+    }
+    bool IsCompiled = true;
+    ModInst->getFuncExports([&IsCompiled](const auto &FuncExports) {
+      for (auto &&Func : FuncExports) {
+        if (Func.second->isWasmFunction()) {
+          IsCompiled = false;
+        }
+      }
+    });
+    EXPECT_TRUE(IsCompiled);
+    return {};
+  };
+  T.onModule = [&VM, &CheckCompiled](const std::string &ModName,
+                                     const std::string &Filename)
+      -> Expect<void> {
+    if (!ModName.empty()) {
+      return VM.registerModule(ModName, Filename).and_then([&]() {
+        return CheckCompiled(VM.getStoreManager().findModule(ModName));
+      });
+    } else {
+      return VM.loadWasm(Filename)
+          .and_then([&VM]() { return VM.validate(); })
+          .and_then([&VM]() { return VM.instantiate(); })
+          .and_then([&]() { return CheckCompiled(VM.getActiveModule()); });
+    }
+  };
+  T.onLoad = [&VM](const std::string &Filename) -> Expect<void> {
+    return VM.loadWasm(Filename);
+  };
+  T.onValidate = [&VM](const std::string &Filename) -> Expect<void> {
+    return VM.loadWasm(Filename).and_then([&VM]() { return VM.validate(); });
+  };
+  T.onInstantiate = [&VM](const std::string &Filename) -> Expect<void> {
+    return VM.loadWasm(Filename)
+        .and_then([&VM]() { return VM.validate(); })
+        .and_then([&VM]() { return VM.instantiate(); });
+  };
+  // Helper function to call functions.
+  T.onInvoke = [&VM](const std::string &ModName, const std::string &Field,
+                     const std::vector<ValVariant> &Params,
+                     const std::vector<ValType> &ParamTypes)
+      -> Expect<std::vector<std::pair<ValVariant, ValType>>> {
+    if (!ModName.empty()) {
+      // Invoke function of named module. Named modules are registered in Store
+      // Manager.
+      return VM.execute(ModName, Field, Params, ParamTypes);
+    } else {
+      // Invoke function of anonymous module. Anonymous modules are instantiated
+      // in VM.
+      return VM.execute(Field, Params, ParamTypes);
+    }
+  };
+  // Helper function to get values.
+  T.onGet = [&VM](const std::string &ModName, const std::string &Field)
+      -> Expect<std::pair<ValVariant, ValType>> {
+    // Get module instance.
+    const WasmEdge::Runtime::Instance::ModuleInstance *ModInst = nullptr;
+    if (ModName.empty()) {
+      ModInst = VM.getActiveModule();
+    } else {
+      ModInst = VM.getStoreManager().findModule(ModName);
+    }
+    if (ModInst == nullptr) {
+      return Unexpect(ErrCode::Value::WrongInstanceAddress);
+    }
+
+    // Get global instance.
+    WasmEdge::Runtime::Instance::GlobalInstance *GlobInst =
+        ModInst->findGlobalExports(Field);
+    if (unlikely(GlobInst == nullptr)) {
+      return Unexpect(ErrCode::Value::WrongInstanceAddress);
+    }
+    return std::make_pair(GlobInst->getValue(),
+                          GlobInst->getGlobalType().getValType());
+  };
+
+  T.run(Proposal, UnitName);
+}
+
 // Initiate test suite.
 INSTANTIATE_TEST_SUITE_P(TestUnit, NativeCoreTest,
                          testing::ValuesIn(T.enumerate()));
 INSTANTIATE_TEST_SUITE_P(TestUnit, CustomWasmCoreTest,
                          testing::ValuesIn(T.enumerate()));
+INSTANTIATE_TEST_SUITE_P(TestUnit, JITCoreTest,
+                         testing::ValuesIn(T.enumerate()));
 
 TEST(AsyncRunWsmFile, NativeInterruptTest) {
   WasmEdge::Configure Conf;
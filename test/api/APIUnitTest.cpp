@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -302,6 +303,48 @@ TEST(APICoreTest, Log) {
   EXPECT_TRUE(true);
 }
 
+TEST(APICoreTest, Allocator) {
+  // Disabling the pool releases all the pooled regions.
+  WasmEdge_AllocatorSetPoolLimit(0);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 0U);
+  WasmEdge_AllocatorReservePool(2);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 0U);
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#if defined(__x86_64__) || defined(__aarch64__)
+  // Reserving more than the limit stops at the limit.
+  WasmEdge_AllocatorSetPoolLimit(2);
+  WasmEdge_AllocatorReservePool(4);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 2U);
+
+  // The memory instance takes the pooled region, and returns it when deleted.
+  const uint64_t Hits = WasmEdge_AllocatorGetPoolHitCount();
+  const uint64_t Misses = WasmEdge_AllocatorGetPoolMissCount();
+  WasmEdge_MemoryTypeContext *MemType = WasmEdge_MemoryTypeCreate(
+      WasmEdge_Limit{.HasMax = true, .Shared = false, .Min = 1, .Max = 3});
+  WasmEdge_MemoryInstanceContext *MemCxt =
+      WasmEdge_MemoryInstanceCreate(MemType);
+  EXPECT_NE(MemCxt, nullptr);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 1U);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolHitCount(), Hits + 1);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolMissCount(), Misses);
+  WasmEdge_MemoryInstanceDelete(MemCxt);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 2U);
+
+  // The memory instance reserves a new region when the pool is disabled.
+  WasmEdge_AllocatorSetPoolLimit(0);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 0U);
+  MemCxt = WasmEdge_MemoryInstanceCreate(MemType);
+  EXPECT_NE(MemCxt, nullptr);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolHitCount(), Hits + 1);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolMissCount(), Misses + 1);
+  WasmEdge_MemoryInstanceDelete(MemCxt);
+  EXPECT_EQ(WasmEdge_AllocatorGetPoolSize(), 0U);
+  WasmEdge_MemoryTypeDelete(MemType);
+#endif
+#endif
+}
+
 TEST(APICoreTest, Value) {
   std::vector<uint32_t> Vec = {1U, 2U, 3U};
   WasmEdge_Value Val = WasmEdge_ValueGenI32(INT32_MAX);
@@ -423,6 +466,58 @@ TEST(APICoreTest, Configure) {
   WasmEdge_ConfigureSetMaxMemoryPage(Conf, 1234U);
   EXPECT_NE(WasmEdge_ConfigureGetMaxMemoryPage(ConfNull), 1234U);
   EXPECT_EQ(WasmEdge_ConfigureGetMaxMemoryPage(Conf), 1234U);
+  // Tests for register-based IR.
+  WasmEdge_ConfigureSetRegisterIR(ConfNull, true);
+  WasmEdge_ConfigureSetRegisterIR(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsRegisterIR(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsRegisterIR(Conf));
+  // Tests for instruction fusion.
+  WasmEdge_ConfigureSetInstructionFusion(ConfNull, true);
+  WasmEdge_ConfigureSetInstructionFusion(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsInstructionFusion(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsInstructionFusion(Conf));
+  // Tests for lazy loading.
+  WasmEdge_ConfigureSetLazyLoading(ConfNull, true);
+  WasmEdge_ConfigureSetLazyLoading(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsLazyLoading(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsLazyLoading(Conf));
+  // Tests for loading threads.
+  WasmEdge_ConfigureSetLoadingThreads(ConfNull, 4U);
+  WasmEdge_ConfigureSetLoadingThreads(Conf, 4U);
+  EXPECT_NE(WasmEdge_ConfigureGetLoadingThreads(ConfNull), 4U);
+  EXPECT_EQ(WasmEdge_ConfigureGetLoadingThreads(Conf), 4U);
+  // Tests for module caching.
+  WasmEdge_ConfigureSetModuleCaching(ConfNull, true);
+  WasmEdge_ConfigureSetModuleCaching(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsModuleCaching(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsModuleCaching(Conf));
+  // Tests for JIT.
+  WasmEdge_ConfigureSetJIT(ConfNull, true);
+  WasmEdge_ConfigureSetJIT(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsJIT(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsJIT(Conf));
+  // Tests for tiering.
+  WasmEdge_ConfigureSetTiering(ConfNull, true);
+  WasmEdge_ConfigureSetTiering(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsTiering(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsTiering(Conf));
+  WasmEdge_ConfigureSetTierUpCallThreshold(ConfNull, 12U);
+  WasmEdge_ConfigureSetTierUpCallThreshold(Conf, 12U);
+  EXPECT_NE(WasmEdge_ConfigureGetTierUpCallThreshold(ConfNull), 12U);
+  EXPECT_EQ(WasmEdge_ConfigureGetTierUpCallThreshold(Conf), 12U);
+  WasmEdge_ConfigureSetTierUpLoopThreshold(ConfNull, 34U);
+  WasmEdge_ConfigureSetTierUpLoopThreshold(Conf, 34U);
+  EXPECT_NE(WasmEdge_ConfigureGetTierUpLoopThreshold(ConfNull), 34U);
+  EXPECT_EQ(WasmEdge_ConfigureGetTierUpLoopThreshold(Conf), 34U);
+  WasmEdge_ConfigureSetTierUpThreads(ConfNull, 4U);
+  WasmEdge_ConfigureSetTierUpThreads(Conf, 4U);
+  EXPECT_NE(WasmEdge_ConfigureGetTierUpThreads(ConfNull), 4U);
+  EXPECT_EQ(WasmEdge_ConfigureGetTierUpThreads(Conf), 4U);
+  // Tests for profiling.
+  WasmEdge_ConfigureSetProfiling(ConfNull, true);
+  WasmEdge_ConfigureSetProfiling(Conf, true);
+  EXPECT_FALSE(WasmEdge_ConfigureIsProfiling(ConfNull));
+  EXPECT_TRUE(WasmEdge_ConfigureIsProfiling(Conf));
   // Tests for AOT compiler configurations.
   WasmEdge_ConfigureCompilerSetOptimizationLevel(
       ConfNull, WasmEdge_CompilerOptimizationLevel_Os);
@@ -452,6 +547,14 @@ TEST(APICoreTest, Configure) {
   WasmEdge_ConfigureCompilerSetInterruptible(Conf, true);
   EXPECT_NE(WasmEdge_ConfigureCompilerIsInterruptible(ConfNull), true);
   EXPECT_EQ(WasmEdge_ConfigureCompilerIsInterruptible(Conf), true);
+  WasmEdge_ConfigureCompilerSetJobs(ConfNull, 4U);
+  WasmEdge_ConfigureCompilerSetJobs(Conf, 4U);
+  EXPECT_NE(WasmEdge_ConfigureCompilerGetJobs(ConfNull), 4U);
+  EXPECT_EQ(WasmEdge_ConfigureCompilerGetJobs(Conf), 4U);
+  WasmEdge_ConfigureCompilerSetObjectCaching(ConfNull, true);
+  WasmEdge_ConfigureCompilerSetObjectCaching(Conf, true);
+  EXPECT_NE(WasmEdge_ConfigureCompilerIsObjectCaching(ConfNull), true);
+  EXPECT_EQ(WasmEdge_ConfigureCompilerIsObjectCaching(Conf), true);
   // Tests for Statistics configurations.
   WasmEdge_ConfigureStatisticsSetInstructionCounting(ConfNull, true);
   WasmEdge_ConfigureStatisticsSetInstructionCounting(Conf, true);
@@ -465,6 +568,14 @@ TEST(APICoreTest, Configure) {
   WasmEdge_ConfigureStatisticsSetTimeMeasuring(Conf, true);
   EXPECT_NE(WasmEdge_ConfigureStatisticsIsTimeMeasuring(ConfNull), true);
   EXPECT_EQ(WasmEdge_ConfigureStatisticsIsTimeMeasuring(Conf), true);
+  WasmEdge_ConfigureStatisticsSetFusionCounting(ConfNull, true);
+  WasmEdge_ConfigureStatisticsSetFusionCounting(Conf, true);
+  EXPECT_NE(WasmEdge_ConfigureStatisticsIsFusionCounting(ConfNull), true);
+  EXPECT_EQ(WasmEdge_ConfigureStatisticsIsFusionCounting(Conf), true);
+  WasmEdge_ConfigureStatisticsSetTierUpCounting(ConfNull, true);
+  WasmEdge_ConfigureStatisticsSetTierUpCounting(Conf, true);
+  EXPECT_NE(WasmEdge_ConfigureStatisticsIsTierUpCounting(ConfNull), true);
+  EXPECT_EQ(WasmEdge_ConfigureStatisticsIsTierUpCounting(Conf), true);
   // Test to delete nullptr.
   WasmEdge_ConfigureDelete(ConfNull);
   EXPECT_TRUE(true);
@@ -1049,6 +1160,82 @@ TEST(APICoreTest, Loader) {
                                      static_cast<uint32_t>(Buf.size()))));
 #endif
 
+  // Parse from stream
+  WasmEdge_LoaderStreamContext *Stream = WasmEdge_LoaderStreamCreate();
+  EXPECT_NE(Stream, nullptr);
+  WasmEdge_LoaderStreamDelete(nullptr);
+  EXPECT_TRUE(true);
+  WasmEdge_LoaderStreamDelete(Stream);
+  EXPECT_TRUE(true);
+  EXPECT_FALSE(WasmEdge_LoaderStreamPush(nullptr, Buf.data(),
+                                         static_cast<uint32_t>(Buf.size())));
+  WasmEdge_LoaderStreamFinish(nullptr);
+  EXPECT_TRUE(true);
+  // The bytes pushed in chunks by another thread are parsed into the same
+  // module as the one parsed from the whole buffer.
+  EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_LoaderParseFromBuffer(
+      Loader, ModPtr, Buf.data(), static_cast<uint32_t>(Buf.size()))));
+  WasmEdge_ASTModuleContext *BufMod = Mod;
+  Stream = WasmEdge_LoaderStreamCreate();
+  std::thread Pusher([&]() {
+    for (size_t I = 0; I < Buf.size(); I += 7) {
+      const auto Len =
+          static_cast<uint32_t>(std::min<size_t>(7, Buf.size() - I));
+      EXPECT_TRUE(WasmEdge_LoaderStreamPush(Stream, Buf.data() + I, Len));
+    }
+    WasmEdge_LoaderStreamFinish(Stream);
+  });
+  Mod = nullptr;
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_LoaderParseFromStream(Loader, ModPtr, Stream)));
+  Pusher.join();
+  EXPECT_NE(Mod, nullptr);
+  EXPECT_EQ(WasmEdge_ASTModuleListImportsLength(Mod),
+            WasmEdge_ASTModuleListImportsLength(BufMod));
+  const uint32_t ExpLen = WasmEdge_ASTModuleListExportsLength(BufMod);
+  EXPECT_EQ(WasmEdge_ASTModuleListExportsLength(Mod), ExpLen);
+  std::vector<const WasmEdge_ExportTypeContext *> Exps(ExpLen),
+      BufExps(ExpLen);
+  EXPECT_EQ(WasmEdge_ASTModuleListExports(Mod, Exps.data(), ExpLen), ExpLen);
+  EXPECT_EQ(WasmEdge_ASTModuleListExports(BufMod, BufExps.data(), ExpLen),
+            ExpLen);
+  for (uint32_t I = 0; I < ExpLen; ++I) {
+    EXPECT_TRUE(
+        WasmEdge_StringIsEqual(WasmEdge_ExportTypeGetExternalName(Exps[I]),
+                               WasmEdge_ExportTypeGetExternalName(BufExps[I])));
+    EXPECT_EQ(WasmEdge_ExportTypeGetExternalType(Exps[I]),
+              WasmEdge_ExportTypeGetExternalType(BufExps[I]));
+  }
+  EXPECT_TRUE(validateModule(Conf, Mod));
+  WasmEdge_ASTModuleDelete(Mod);
+  WasmEdge_ASTModuleDelete(BufMod);
+  // The pushes after finishing the stream are rejected.
+  EXPECT_FALSE(WasmEdge_LoaderStreamPush(Stream, Buf.data(),
+                                         static_cast<uint32_t>(Buf.size())));
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_LoaderParseFromStream(nullptr, ModPtr, Stream)));
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_LoaderParseFromStream(Loader, nullptr, Stream)));
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_LoaderParseFromStream(Loader, ModPtr, nullptr)));
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_LoaderParseFromStream(nullptr, nullptr, nullptr)));
+  WasmEdge_LoaderStreamDelete(Stream);
+  // The stream finished within the header fails to be parsed.
+  Stream = WasmEdge_LoaderStreamCreate();
+  EXPECT_TRUE(WasmEdge_LoaderStreamPush(Stream, Buf.data(), 6U));
+  WasmEdge_LoaderStreamFinish(Stream);
+  Mod = nullptr;
+  EXPECT_TRUE(
+      isErrMatch(WasmEdge_ErrCode_UnexpectedEnd,
+                 WasmEdge_LoaderParseFromStream(Loader, ModPtr, Stream)));
+  EXPECT_EQ(Mod, nullptr);
+  WasmEdge_LoaderStreamDelete(Stream);
+
   // AST module deletion
   WasmEdge_ASTModuleDelete(nullptr);
   EXPECT_TRUE(true);
@@ -1426,6 +1613,124 @@ TEST(APICoreTest, ExecutorWithStatistics) {
   WasmEdge_ModuleInstanceDelete(HostModWrap);
 }
 
+TEST(APICoreTest, ModuleTemplate) {
+  // Create contexts
+  WasmEdge_ConfigureContext *Conf = WasmEdge_ConfigureCreate();
+  WasmEdge_StoreContext *Store = WasmEdge_StoreCreate();
+  WasmEdge_ExecutorContext *ExecCxt = WasmEdge_ExecutorCreate(Conf, nullptr);
+  WasmEdge_ModuleInstanceContext *HostMod = createExternModule("extern");
+  EXPECT_NE(HostMod, nullptr);
+  EXPECT_TRUE(registerModule(Conf, Store, HostMod));
+
+  // Load and validate file
+  WasmEdge_ASTModuleContext *Mod = loadModule(Conf, TPath);
+  EXPECT_NE(Mod, nullptr);
+  EXPECT_TRUE(validateModule(Conf, Mod));
+
+  // Create module template
+  WasmEdge_ModuleTemplateContext *TmplCxt = nullptr;
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_ExecutorCreateTemplate(nullptr, &TmplCxt,
+                                                         Store, Mod, false)));
+  EXPECT_EQ(TmplCxt, nullptr);
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_ExecutorCreateTemplate(ExecCxt, nullptr, Store, Mod, false)));
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_ExecutorCreateTemplate(ExecCxt, &TmplCxt,
+                                                         nullptr, Mod, false)));
+  EXPECT_EQ(TmplCxt, nullptr);
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_ExecutorCreateTemplate(
+                             ExecCxt, &TmplCxt, Store, nullptr, false)));
+  EXPECT_EQ(TmplCxt, nullptr);
+  // Hasn't validated yet
+  WasmEdge_ASTModuleContext *ModNotValid = loadModule(Conf, TPath);
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_NotValidated,
+                         WasmEdge_ExecutorCreateTemplate(
+                             ExecCxt, &TmplCxt, Store, ModNotValid, false)));
+  EXPECT_EQ(TmplCxt, nullptr);
+  WasmEdge_ASTModuleDelete(ModNotValid);
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_ExecutorCreateTemplate(ExecCxt, &TmplCxt, Store, Mod, true)));
+  EXPECT_NE(TmplCxt, nullptr);
+
+  // Instantiate module template
+  WasmEdge_ModuleInstanceContext *ModCxt = nullptr;
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_ExecutorInstantiateTemplate(nullptr, &ModCxt, Store, TmplCxt)));
+  EXPECT_EQ(ModCxt, nullptr);
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_ExecutorInstantiateTemplate(ExecCxt, nullptr, Store, TmplCxt)));
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_ExecutorInstantiateTemplate(
+                             ExecCxt, &ModCxt, nullptr, TmplCxt)));
+  EXPECT_EQ(ModCxt, nullptr);
+  EXPECT_TRUE(isErrMatch(
+      WasmEdge_ErrCode_WrongVMWorkflow,
+      WasmEdge_ExecutorInstantiateTemplate(ExecCxt, &ModCxt, Store, nullptr)));
+  EXPECT_EQ(ModCxt, nullptr);
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_ExecutorInstantiateTemplate(ExecCxt, &ModCxt, Store, TmplCxt)));
+  EXPECT_NE(ModCxt, nullptr);
+  WasmEdge_ModuleInstanceContext *ModCxt2 = nullptr;
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_ExecutorInstantiateTemplate(ExecCxt, &ModCxt2, Store, TmplCxt)));
+  EXPECT_NE(ModCxt2, nullptr);
+
+  // The memories of the cloned module instances are independent.
+  WasmEdge_String MemName = WasmEdge_StringCreateByCString("mem");
+  WasmEdge_MemoryInstanceContext *MemCxt =
+      WasmEdge_ModuleInstanceFindMemory(ModCxt, MemName);
+  WasmEdge_MemoryInstanceContext *MemCxt2 =
+      WasmEdge_ModuleInstanceFindMemory(ModCxt2, MemName);
+  WasmEdge_StringDelete(MemName);
+  EXPECT_NE(MemCxt, nullptr);
+  EXPECT_NE(MemCxt2, nullptr);
+  std::vector<uint8_t> DataSet = {'t', 'e', 's', 't', ' ',
+                                  'd', 'a', 't', 'a', '\n'};
+  std::vector<uint8_t> DataInit = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<uint8_t> DataGet(10);
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_MemoryInstanceSetData(MemCxt, DataSet.data(), 10, 10)));
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_MemoryInstanceGetData(MemCxt2, DataGet.data(), 10, 10)));
+  EXPECT_EQ(DataGet, DataInit);
+
+  // Module template deletion
+  WasmEdge_ModuleTemplateDelete(nullptr);
+  EXPECT_TRUE(true);
+  WasmEdge_ModuleTemplateDelete(TmplCxt);
+  EXPECT_TRUE(true);
+
+  // The cloned module instances are still usable after the template deletion.
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_MemoryInstanceGetData(MemCxt, DataGet.data(), 10, 10)));
+  EXPECT_EQ(DataGet, DataSet);
+  WasmEdge_String FuncName = WasmEdge_StringCreateByCString("func-mul-2");
+  WasmEdge_FunctionInstanceContext *FuncCxt =
+      WasmEdge_ModuleInstanceFindFunction(ModCxt2, FuncName);
+  EXPECT_NE(FuncCxt, nullptr);
+  WasmEdge_StringDelete(FuncName);
+  WasmEdge_Value P[2], R[2];
+  P[0] = WasmEdge_ValueGenI32(123);
+  P[1] = WasmEdge_ValueGenI32(456);
+  EXPECT_TRUE(
+      WasmEdge_ResultOK(WasmEdge_ExecutorInvoke(ExecCxt, FuncCxt, P, 2, R, 2)));
+  EXPECT_EQ(246, WasmEdge_ValueGetI32(R[0]));
+  EXPECT_EQ(912, WasmEdge_ValueGetI32(R[1]));
+
+  WasmEdge_ModuleInstanceDelete(ModCxt);
+  WasmEdge_ModuleInstanceDelete(ModCxt2);
+  WasmEdge_ASTModuleDelete(Mod);
+  WasmEdge_ExecutorDelete(ExecCxt);
+  WasmEdge_StoreDelete(Store);
+  WasmEdge_ModuleInstanceDelete(HostMod);
+  WasmEdge_ConfigureDelete(Conf);
+}
+
 TEST(APICoreTest, Store) {
   // Create contexts
   WasmEdge_ConfigureContext *Conf = WasmEdge_ConfigureCreate();
@@ -3119,6 +3424,62 @@ TEST(APICoreTest, VM) {
   WasmEdge_StoreDelete(Store);
   WasmEdge_VMDelete(VM);
 }
+
+TEST(APICoreTest, VMProfile) {
+  // The module exports `sum`, which loops with a `br_if` for the argument
+  // times.
+  const std::vector<uint8_t> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x1d, 0x01, 0x1b, 0x01, 0x01, 0x7f,
+      0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+      0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b};
+  WasmEdge_ConfigureContext *Conf = WasmEdge_ConfigureCreate();
+  WasmEdge_ConfigureSetProfiling(Conf, true);
+  WasmEdge_LoaderContext *Loader = WasmEdge_LoaderCreate(Conf);
+  WasmEdge_ASTModuleContext *Mod = nullptr;
+  EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_LoaderParseFromBuffer(
+      Loader, &Mod, Wasm.data(), static_cast<uint32_t>(Wasm.size()))));
+  ASSERT_NE(Mod, nullptr);
+  WasmEdge_String FuncName = WasmEdge_StringCreateByCString("sum");
+  WasmEdge_Value P[1], R[1];
+
+  // Run the same AST module in the VMs and store their profiles.
+  auto StoreProfile = [&](const WasmEdge_ConfigureContext *C,
+                          const char *Path) -> uintmax_t {
+    std::error_code EC;
+    std::filesystem::remove(Path, EC);
+    WasmEdge_VMContext *VM = WasmEdge_VMCreate(C, nullptr);
+    P[0] = WasmEdge_ValueGenI32(10);
+    EXPECT_TRUE(WasmEdge_ResultOK(
+        WasmEdge_VMRunWasmFromASTModule(VM, Mod, FuncName, P, 1, R, 1)));
+    EXPECT_EQ(55, WasmEdge_ValueGetI32(R[0]));
+    EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_VMStoreProfile(VM, Path)));
+    EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                           WasmEdge_VMStoreProfile(VM, nullptr)));
+    WasmEdge_VMDelete(VM);
+    const auto Size = std::filesystem::file_size(Path, EC);
+    EXPECT_FALSE(EC);
+    std::filesystem::remove(Path, EC);
+    return Size;
+  };
+  WasmEdge_ConfigureContext *PlainConf = WasmEdge_ConfigureCreate();
+  const auto PlainSize = StoreProfile(PlainConf, "test_plain.profile");
+  EXPECT_GT(StoreProfile(Conf, "test_1.profile"), PlainSize);
+  EXPECT_GT(StoreProfile(Conf, "test_2.profile"), PlainSize);
+  WasmEdge_ConfigureDelete(PlainConf);
+
+  // Store profile with the null contexts.
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_VMStoreProfile(nullptr, "test.profile")));
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_VMStoreProfile(nullptr, nullptr)));
+
+  WasmEdge_StringDelete(FuncName);
+  WasmEdge_ASTModuleDelete(Mod);
+  WasmEdge_LoaderDelete(Loader);
+  WasmEdge_ConfigureDelete(Conf);
+}
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
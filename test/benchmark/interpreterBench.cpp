@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/benchmark/interpreterBench.cpp - Interpreter bench --===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the throughput benchmarks of the interpreter. Each
+/// benchmark reports the executed Wasm instructions per second, so that the
+/// dispatch engines can be compared directly. The second argument of the
+/// benchmarks selects the switch-based dispatch, the threaded dispatch, or the
+/// register-based IR execution by the runtime options.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/configure.h"
+#include "common/log.h"
+#include "vm/vm.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using namespace std::literals;
+using namespace WasmEdge;
+
+/// (func (export "fib") (param i32) (result i32)
+///   (if (result i32) (i32.lt_s (local.get 0) (i32.const 2))
+///     (then (local.get 0))
+///     (else (i32.add (call 0 (i32.sub (local.get 0) (i32.const 1)))
+///                    (call 0 (i32.sub (local.get 0) (i32.const 2)))))))
+const std::array<WasmEdge::Byte, 61> FibWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+    0x66, 0x69, 0x62, 0x00, 0x00, 0x0a, 0x1e, 0x01, 0x1c, 0x00, 0x20, 0x00,
+    0x41, 0x02, 0x48, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41, 0x01,
+    0x6b, 0x10, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b,
+    0x0b};
+
+/// (memory 1)
+/// (func (export "loop") (param i32) (result i32) (local i32 i32)
+///   (block (loop
+///     (local.set 1 (i32.add (local.get 1)
+///       (i32.xor (i32.mul (local.get 2) (local.get 2)) (local.get 2))))
+///     (i32.store (i32.shl (i32.and (local.get 2) (i32.const 1023))
+///                         (i32.const 2)) (local.get 1))
+///     (local.set 1 (i32.add (i32.load (i32.shl (i32.and (local.get 2)
+///       (i32.const 1023)) (i32.const 2))) (local.get 1)))
+///     (br_if 0 (i32.lt_s (local.tee 2 (i32.add (local.get 2) (i32.const 1)))
+///                        (local.get 0)))))
+///   (local.get 1))
+const std::array<WasmEdge::Byte, 107> LoopWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00,
+    0x01, 0x07, 0x08, 0x01, 0x04, 0x6c, 0x6f, 0x6f, 0x70, 0x00, 0x00, 0x0a,
+    0x46, 0x01, 0x44, 0x01, 0x02, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01,
+    0x20, 0x02, 0x20, 0x02, 0x6c, 0x20, 0x02, 0x73, 0x6a, 0x21, 0x01, 0x20,
+    0x02, 0x41, 0xff, 0x07, 0x71, 0x41, 0x02, 0x74, 0x20, 0x01, 0x36, 0x02,
+    0x00, 0x20, 0x02, 0x41, 0xff, 0x07, 0x71, 0x41, 0x02, 0x74, 0x28, 0x02,
+    0x00, 0x20, 0x01, 0x6a, 0x21, 0x01, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x22,
+    0x02, 0x20, 0x00, 0x48, 0x0d, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b};
+
+/// (table 4 funcref) (elem (i32.const 0) 1 2 1 2)
+/// (func (export "indirect") (param i32) (result i32) (local i32 i32)
+///   (block (loop
+///     (local.set 1 (call_indirect (type 0) (local.get 1)
+///                    (i32.and (local.get 2) (i32.const 3))))
+///     (br_if 0 (i32.lt_s (local.tee 2 (i32.add (local.get 2) (i32.const 1)))
+///                        (local.get 0)))))
+///   (local.get 1))
+/// (func (param i32) (result i32) (i32.add (local.get 0) (i32.const 3)))
+/// (func (param i32) (result i32) (i32.xor (local.get 0) (i32.const 5)))
+const std::array<WasmEdge::Byte, 110> IndirectWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x00, 0x00, 0x04, 0x04,
+    0x01, 0x70, 0x00, 0x04, 0x07, 0x0c, 0x01, 0x08, 0x69, 0x6e, 0x64, 0x69,
+    0x72, 0x65, 0x63, 0x74, 0x00, 0x00, 0x09, 0x0a, 0x01, 0x00, 0x41, 0x00,
+    0x0b, 0x04, 0x01, 0x02, 0x01, 0x02, 0x0a, 0x36, 0x03, 0x24, 0x01, 0x02,
+    0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x02, 0x41, 0x03, 0x71,
+    0x11, 0x00, 0x00, 0x21, 0x01, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x22, 0x02,
+    0x20, 0x00, 0x48, 0x0d, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b, 0x07, 0x00,
+    0x20, 0x00, 0x41, 0x03, 0x6a, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x41, 0x05,
+    0x73, 0x0b};
+
+/// The same as above with the table of the same callee
+/// `(elem (i32.const 0) 1 1 1 1)`, which keeps the call site monomorphic.
+const std::array<WasmEdge::Byte, 110> MonoIndirectWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x00, 0x00, 0x04, 0x04,
+    0x01, 0x70, 0x00, 0x04, 0x07, 0x0c, 0x01, 0x08, 0x69, 0x6e, 0x64, 0x69,
+    0x72, 0x65, 0x63, 0x74, 0x00, 0x00, 0x09, 0x0a, 0x01, 0x00, 0x41, 0x00,
+    0x0b, 0x04, 0x01, 0x01, 0x01, 0x01, 0x0a, 0x36, 0x03, 0x24, 0x01, 0x02,
+    0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x02, 0x41, 0x03, 0x71,
+    0x11, 0x00, 0x00, 0x21, 0x01, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x22, 0x02,
+    0x20, 0x00, 0x48, 0x0d, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b, 0x07, 0x00,
+    0x20, 0x00, 0x41, 0x03, 0x6a, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x41, 0x05,
+    0x73, 0x0b};
+
+/// (func (export "brtable") (param i32) (result i32) (local i32 i32)
+///   (block (loop
+///     (block (block (block
+///       (br_table 0 1 2 (i32.and (local.get 2) (i32.const 3))))
+///       (local.set 1 (i32.add (local.get 1) (i32.const 7))))
+///       (local.set 1 (i32.mul (local.get 1) (i32.const 3))))
+///     (br_if 0 (i32.lt_s (local.tee 2 (i32.add (local.get 2) (i32.const 1)))
+///                        (local.get 0)))))
+///   (local.get 1))
+const std::array<WasmEdge::Byte, 94> BrTableWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x0b, 0x01, 0x07,
+    0x62, 0x72, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x00, 0x0a, 0x3b, 0x01,
+    0x39, 0x01, 0x02, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x02, 0x40, 0x02, 0x40,
+    0x02, 0x40, 0x20, 0x02, 0x41, 0x03, 0x71, 0x0e, 0x02, 0x00, 0x01, 0x02,
+    0x0b, 0x20, 0x01, 0x41, 0x07, 0x6a, 0x21, 0x01, 0x0b, 0x20, 0x01, 0x41,
+    0x03, 0x6c, 0x21, 0x01, 0x0b, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x22, 0x02,
+    0x20, 0x00, 0x48, 0x0d, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b};
+
+/// Interpreters to run the benchmarks, selected by the runtime options.
+enum class Mode : int64_t { Switch, Threaded, Register };
+
+/// The threaded dispatch falls back to the switch-based one if it is not built
+/// in the executor.
+std::string getModeName(Mode M) {
+  switch (M) {
+  case Mode::Switch:
+    return "switch"s;
+  case Mode::Threaded:
+#ifdef WASMEDGE_USE_THREADED_DISPATCH
+    return "threaded"s;
+#else
+    return "switch (threaded not built)"s;
+#endif
+  case Mode::Register:
+  default:
+    return "register"s;
+  }
+}
+
+/// Count the instructions executed by one invocation of the function.
+uint64_t countInstructions(Span<const Byte> Wasm, std::string_view Func,
+                           uint32_t Arg) {
+  Configure Conf;
+  Conf.getStatisticsConfigure().setInstructionCounting(true);
+  VM::VM VM(Conf);
+  if (!VM.loadWasm(Wasm) || !VM.validate() || !VM.instantiate() ||
+      !VM.execute(Func, std::array{ValVariant(Arg)},
+                  std::array{ValType::I32})) {
+    return 0;
+  }
+  return VM.getStatistics().getInstrCount();
+}
+
+void runInterpreter(benchmark::State &State, Span<const Byte> Wasm,
+                    std::string_view Func) {
+  const auto Arg = static_cast<uint32_t>(State.range(0));
+  const auto M = static_cast<Mode>(State.range(1));
+  const uint64_t InstrCnt = countInstructions(Wasm, Func, Arg);
+
+  Configure Conf;
+  Conf.getRuntimeConfigure().setRegisterIR(M == Mode::Register);
+  Conf.getRuntimeConfigure().setThreadedDispatch(M == Mode::Threaded);
+  VM::VM VM(Conf);
+  if (!VM.loadWasm(Wasm) || !VM.validate() || !VM.instantiate()) {
+    State.SkipWithError("failed to instantiate the benchmark module");
+    return;
+  }
+  const std::array Params{ValVariant(Arg)};
+  const std::array ParamTypes{ValType::I32};
+  for (auto _ : State) {
+    auto Res = VM.execute(Func, Params, ParamTypes);
+    if (unlikely(!Res)) {
+      State.SkipWithError("failed to execute the benchmark function");
+      return;
+    }
+    benchmark::DoNotOptimize(*Res);
+  }
+  // Report the instructions per second as the items per second.
+  State.SetItemsProcessed(static_cast<int64_t>(InstrCnt * State.iterations()));
+  State.SetLabel(getModeName(M));
+}
+
+void BM_Fib(benchmark::State &State) { runInterpreter(State, FibWasm, "fib"); }
+void BM_Loop(benchmark::State &State) {
+  runInterpreter(State, LoopWasm, "loop");
+}
+void BM_CallIndirect(benchmark::State &State) {
+  runInterpreter(State, IndirectWasm, "indirect");
+}
+void BM_CallIndirectMono(benchmark::State &State) {
+  runInterpreter(State, MonoIndirectWasm, "indirect");
+}
+void BM_BrTable(benchmark::State &State) {
+  runInterpreter(State, BrTableWasm, "brtable");
+}
+
+BENCHMARK(BM_Fib)->ArgsProduct({{20}, {0, 1, 2}});
+BENCHMARK(BM_Loop)->ArgsProduct({{100000}, {0, 1, 2}});
+BENCHMARK(BM_CallIndirect)->ArgsProduct({{100000}, {0, 1, 2}});
+BENCHMARK(BM_CallIndirectMono)->ArgsProduct({{100000}, {0, 1, 2}});
+BENCHMARK(BM_BrTable)->ArgsProduct({{100000}, {0, 1, 2}});
+
+} // namespace
+
+int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
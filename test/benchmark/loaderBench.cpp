@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/benchmark/loaderBench.cpp - Loader bench ------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the throughput and memory benchmarks of the loader. Each
+/// benchmark loads a module of the repeated function bodies, and reports the
+/// loaded functions per second and the heap bytes kept by the loaded module
+/// per instruction. The argument of the benchmarks is the count of the
+/// functions.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/configure.h"
+#include "common/log.h"
+#include "loader/loader.h"
+
+#include "../common/modulebuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+/// Size of the heap blocks not released yet.
+std::atomic<int64_t> LiveBytes = 0;
+
+/// Allocate the block with the size stored before the returned pointer.
+void *allocate(std::size_t Size, std::size_t Align) {
+  const std::size_t Prefix = std::max(Align, alignof(std::max_align_t));
+  const std::size_t Total = (Prefix + Size + Align - 1) / Align * Align;
+  auto *Base = static_cast<std::byte *>(
+      Align > alignof(std::max_align_t) ? std::aligned_alloc(Align, Total)
+                                        : std::malloc(Total));
+  if (Base == nullptr) {
+    throw std::bad_alloc();
+  }
+  auto *Ptr = Base + Prefix;
+  reinterpret_cast<std::size_t *>(Ptr)[-1] = Size;
+  LiveBytes.fetch_add(static_cast<int64_t>(Size), std::memory_order_relaxed);
+  return Ptr;
+}
+
+void deallocate(void *Ptr, std::size_t Align) noexcept {
+  if (Ptr == nullptr) {
+    return;
+  }
+  const std::size_t Prefix = std::max(Align, alignof(std::max_align_t));
+  const std::size_t Size = static_cast<std::size_t *>(Ptr)[-1];
+  LiveBytes.fetch_sub(static_cast<int64_t>(Size), std::memory_order_relaxed);
+  std::free(static_cast<std::byte *>(Ptr) - Prefix);
+}
+} // namespace
+
+void *operator new(std::size_t Size) { return allocate(Size, 1); }
+void *operator new(std::size_t Size, std::align_val_t Align) {
+  return allocate(Size, static_cast<std::size_t>(Align));
+}
+void operator delete(void *Ptr) noexcept { deallocate(Ptr, 1); }
+void operator delete(void *Ptr, std::size_t) noexcept { deallocate(Ptr, 1); }
+void operator delete(void *Ptr, std::align_val_t Align) noexcept {
+  deallocate(Ptr, static_cast<std::size_t>(Align));
+}
+void operator delete(void *Ptr, std::size_t, std::align_val_t Align) noexcept {
+  deallocate(Ptr, static_cast<std::size_t>(Align));
+}
+
+namespace {
+
+using namespace WasmEdge;
+
+/// (func (param i32) (result i32) (local i32 i32)
+///   (block (loop
+///     (block (block (block
+///       (br_table 0 1 2 (i32.and (local.get 2) (i32.const 3))))
+///       (local.set 1 (i32.add (local.get 1) (i32.const 7))))
+///       (local.set 1 (if (result i32) (local.get 1)
+///                      (then (i32.mul (local.get 1) (i32.const 3)))
+///                      (else (i32.const 1)))))
+///     (br_if 0 (i32.lt_s (local.tee 2 (i32.add (local.get 2) (i32.const 1)))
+///                        (local.get 0)))))
+///   (local.get 1))
+const Test::Function Func{
+    0,
+    {0x01, 0x02, 0x7f},
+    {0x02, 0x40, 0x03, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x02,
+     0x41, 0x03, 0x71, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b, 0x20, 0x01, 0x41,
+     0x07, 0x6a, 0x21, 0x01, 0x0b, 0x20, 0x01, 0x04, 0x7f, 0x20, 0x01, 0x41,
+     0x03, 0x6c, 0x05, 0x41, 0x01, 0x0b, 0x21, 0x01, 0x0b, 0x20, 0x02, 0x41,
+     0x01, 0x6a, 0x22, 0x02, 0x20, 0x00, 0x48, 0x0d, 0x00, 0x0b, 0x0b, 0x20,
+     0x01}};
+
+void BM_Load(benchmark::State &State) {
+  const auto FuncCnt = static_cast<uint32_t>(State.range(0));
+  const auto Wasm =
+      Test::generateModule({{0x60, 0x01, 0x7f, 0x01, 0x7f}},
+                           std::vector<Test::Function>(FuncCnt, Func));
+  Configure Conf;
+  Loader::Loader Load(Conf);
+  uint64_t InstrCnt = 0;
+  int64_t ModuleBytes = 0;
+  for (auto _ : State) {
+    const int64_t LiveBegin = LiveBytes.load(std::memory_order_relaxed);
+    auto Mod = Load.parseModule(Wasm);
+    if (!Mod) {
+      State.SkipWithError("failed to load the benchmark module");
+      return;
+    }
+    ModuleBytes = LiveBytes.load(std::memory_order_relaxed) - LiveBegin;
+    if (InstrCnt == 0) {
+      for (const auto &Seg : (*Mod)->getCodeSection().getContent()) {
+        InstrCnt += Seg.getExpr().getInstrs().size();
+      }
+    }
+    benchmark::DoNotOptimize(Mod);
+  }
+  State.SetItemsProcessed(static_cast<int64_t>(FuncCnt * State.iterations()));
+  State.counters["bytes/instr"] =
+      static_cast<double>(ModuleBytes) / static_cast<double>(InstrCnt);
+}
+
+BENCHMARK(BM_Load)->Arg(1000)->Arg(10000);
+
+} // namespace
+
+int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
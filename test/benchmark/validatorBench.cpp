@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/benchmark/validatorBench.cpp - Validator bench ------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the throughput benchmarks of the validator. Each
+/// benchmark validates a module of the repeated function bodies, and reports
+/// the validated functions per second and the heap allocations per function.
+/// The argument of the benchmarks is the count of the functions.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/configure.h"
+#include "common/log.h"
+#include "loader/loader.h"
+#include "validator/validator.h"
+
+#include "../common/modulebuilder.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+/// Count of the heap allocations.
+std::atomic<uint64_t> AllocCnt = 0;
+} // namespace
+
+void *operator new(std::size_t Size) {
+  AllocCnt.fetch_add(1, std::memory_order_relaxed);
+  if (void *Ptr = std::malloc(Size != 0 ? Size : 1)) {
+    return Ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *Ptr) noexcept { std::free(Ptr); }
+void operator delete(void *Ptr, std::size_t) noexcept { std::free(Ptr); }
+
+namespace {
+
+using namespace WasmEdge;
+
+/// (func (param i32) (result i32) (local i32 i32)
+///   (block (loop
+///     (block (block (block
+///       (br_table 0 1 2 (i32.and (local.get 2) (i32.const 3))))
+///       (local.set 1 (i32.add (local.get 1) (i32.const 7))))
+///       (local.set 1 (if (result i32) (local.get 1)
+///                      (then (i32.mul (local.get 1) (i32.const 3)))
+///                      (else (i32.const 1)))))
+///     (br_if 0 (i32.lt_s (local.tee 2 (i32.add (local.get 2) (i32.const 1)))
+///                        (local.get 0)))))
+///   (local.get 1))
+const Test::Function Func{
+    0,
+    {0x01, 0x02, 0x7f},
+    {0x02, 0x40, 0x03, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x02,
+     0x41, 0x03, 0x71, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b, 0x20, 0x01, 0x41,
+     0x07, 0x6a, 0x21, 0x01, 0x0b, 0x20, 0x01, 0x04, 0x7f, 0x20, 0x01, 0x41,
+     0x03, 0x6c, 0x05, 0x41, 0x01, 0x0b, 0x21, 0x01, 0x0b, 0x20, 0x02, 0x41,
+     0x01, 0x6a, 0x22, 0x02, 0x20, 0x00, 0x48, 0x0d, 0x00, 0x0b, 0x0b, 0x20,
+     0x01}};
+
+void BM_Validate(benchmark::State &State) {
+  const auto FuncCnt = static_cast<uint32_t>(State.range(0));
+  Configure Conf;
+  Loader::Loader Load(Conf);
+  auto Mod = Load.parseModule(Test::generateModule(
+      {{0x60, 0x01, 0x7f, 0x01, 0x7f}},
+      std::vector<Test::Function>(FuncCnt, Func)));
+  if (!Mod) {
+    State.SkipWithError("failed to load the benchmark module");
+    return;
+  }
+  Validator::Validator Valid(Conf);
+  // Warm up the capacities of the checker.
+  if (!Valid.validate(**Mod)) {
+    State.SkipWithError("failed to validate the benchmark module");
+    return;
+  }
+  const uint64_t AllocBegin = AllocCnt.load(std::memory_order_relaxed);
+  for (auto _ : State) {
+    auto Res = Valid.validate(**Mod);
+    benchmark::DoNotOptimize(Res);
+  }
+  const uint64_t Allocs = AllocCnt.load(std::memory_order_relaxed) - AllocBegin;
+  const auto Funcs = static_cast<int64_t>(FuncCnt * State.iterations());
+  State.SetItemsProcessed(Funcs);
+  State.counters["allocs/func"] =
+      static_cast<double>(Allocs) / static_cast<double>(Funcs);
+}
+
+BENCHMARK(BM_Validate)->Arg(1000)->Arg(10000);
+
+} // namespace
+
+int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
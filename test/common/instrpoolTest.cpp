@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "ast/instruction.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <utility>
+
+// Count the aligned allocations, which are the chunks of the pool.
+namespace {
+std::atomic<uint64_t> ChunkNews = 0;
+std::atomic<uint64_t> ChunkDeletes = 0;
+} // namespace
+
+void *operator new(std::size_t Size, std::align_val_t Align) {
+  ++ChunkNews;
+  const auto A = static_cast<std::size_t>(Align);
+  if (void *Ptr = std::aligned_alloc(A, (Size + A - 1) / A * A)) {
+    return Ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *Ptr, std::align_val_t) noexcept {
+  ++ChunkDeletes;
+  std::free(Ptr);
+}
+
+namespace {
+
+using WasmEdge::OpCode;
+using WasmEdge::AST::Instruction;
+
+// The label lists of this size are larger than a chunk, so each of them is
+// allocated and released in a dedicated chunk.
+constexpr uint32_t kLargeList = 2048;
+
+TEST(InstrPoolTest, Copy__Deep) {
+  Instruction BrTable(OpCode::Br_table);
+  BrTable.setLabelListSize(3);
+  BrTable.getLabelList()[1].TargetIndex = 7;
+
+  Instruction Copy(BrTable);
+  ASSERT_EQ(Copy.getLabelList().size(), 3U);
+  EXPECT_NE(Copy.getLabelList().data(), BrTable.getLabelList().data());
+  EXPECT_EQ(Copy.getLabelList()[1].TargetIndex, 7U);
+  Copy.getLabelList()[1].TargetIndex = 9;
+  EXPECT_EQ(BrTable.getLabelList()[1].TargetIndex, 7U);
+
+  Instruction Assigned(OpCode::Select_t);
+  Assigned.setValTypeListSize(1);
+  Assigned = BrTable;
+  ASSERT_EQ(Assigned.getLabelList().size(), 3U);
+  EXPECT_NE(Assigned.getLabelList().data(), BrTable.getLabelList().data());
+  Assigned.getLabelList()[1].TargetIndex = 11;
+  EXPECT_EQ(BrTable.getLabelList()[1].TargetIndex, 7U);
+
+  Instruction V128(OpCode::V128__const);
+  const WasmEdge::uint128_t Num = WasmEdge::uint128_t(1) << 100;
+  V128.setNum(Num);
+  Instruction V128Copy(V128);
+  V128.setNum(WasmEdge::uint128_t(3) << 100);
+  EXPECT_EQ(V128Copy.getNum().get<WasmEdge::uint128_t>(), Num);
+}
+
+TEST(InstrPoolTest, Move__Transfer) {
+  Instruction SelectT(OpCode::Select_t);
+  SelectT.setValTypeListSize(2);
+  const auto *Data = SelectT.getValTypeList().data();
+
+  Instruction Moved(std::move(SelectT));
+  EXPECT_EQ(Moved.getValTypeList().data(), Data);
+  EXPECT_EQ(Moved.getValTypeList().size(), 2U);
+  EXPECT_TRUE(SelectT.getValTypeList().empty());
+
+  Instruction Assigned(OpCode::Nop);
+  Assigned = std::move(Moved);
+  EXPECT_EQ(Assigned.getValTypeList().data(), Data);
+  EXPECT_TRUE(Moved.getValTypeList().empty());
+}
+
+TEST(InstrPoolTest, Release__Chunk) {
+  const uint64_t News = ChunkNews;
+  const uint64_t Deletes = ChunkDeletes;
+  {
+    Instruction BrTable(OpCode::Br_table);
+    BrTable.setLabelListSize(kLargeList);
+    EXPECT_EQ(ChunkNews - News, 1U);
+    {
+      // Copying allocates a new entry, and destroying the copy releases it.
+      Instruction Copy(BrTable);
+      EXPECT_EQ(ChunkNews - News, 2U);
+    }
+    EXPECT_EQ(ChunkDeletes - Deletes, 1U);
+    // Moving transfers the entry without allocating.
+    Instruction Moved(std::move(BrTable));
+    EXPECT_EQ(ChunkNews - News, 2U);
+    // Resizing releases the previous entry.
+    Moved.setLabelListSize(kLargeList);
+    EXPECT_EQ(ChunkNews - News, 3U);
+    EXPECT_EQ(ChunkDeletes - Deletes, 2U);
+  }
+  EXPECT_EQ(ChunkDeletes - Deletes, 3U);
+}
+
+TEST(InstrPoolTest, Jump__Inline) {
+  const uint64_t News = ChunkNews;
+  Instruction Br(OpCode::Br);
+  Br.setJump({3, 65535, 2, -40});
+  Instruction Copy(Br);
+  // The jump fitting in the slot does not touch the pool.
+  EXPECT_EQ(ChunkNews, News);
+  EXPECT_EQ(Copy.getJump().TargetIndex, 3U);
+  EXPECT_EQ(Copy.getJump().StackEraseBegin, 65535U);
+  EXPECT_EQ(Copy.getJump().StackEraseEnd, 2U);
+  EXPECT_EQ(Copy.getJump().PCOffset, -40);
+
+  // The wide stack erase range is stored out of line and copied.
+  Instruction BrIf(OpCode::Br_if);
+  BrIf.setJump({1, 70000, 65536, 12});
+  Instruction WideCopy(BrIf);
+  BrIf.setJump({2, 0, 0, 0});
+  EXPECT_EQ(WideCopy.getJump().TargetIndex, 1U);
+  EXPECT_EQ(WideCopy.getJump().StackEraseBegin, 70000U);
+  EXPECT_EQ(WideCopy.getJump().StackEraseEnd, 65536U);
+  EXPECT_EQ(WideCopy.getJump().PCOffset, 12);
+  EXPECT_EQ(BrIf.getJump().StackEraseBegin, 0U);
+}
+
+} // namespace
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/common/modulebuilder.h - Module generating helpers --===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the helpers of encoding the generated modules for the
+/// tests and the benchmarks.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/types.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace WasmEdge {
+namespace Test {
+
+/// Function of the generated module.
+struct Function {
+  uint32_t TypeIdx;
+  /// Encoded vector of the local declarations.
+  std::vector<Byte> Locals;
+  /// Instructions before the `end`.
+  std::vector<Byte> Body;
+};
+
+/// Section of the generated module besides the type, the function, and the
+/// code sections.
+struct Section {
+  Byte Id;
+  std::vector<Byte> Content;
+};
+
+/// Append the number in the unsigned LEB128 encoding.
+inline void appendU32(std::vector<Byte> &Bin, uint32_t Num) {
+  do {
+    Byte B = static_cast<Byte>(Num & 0x7FU);
+    Num >>= 7;
+    Bin.push_back(Num ? static_cast<Byte>(B | 0x80U) : B);
+  } while (Num);
+}
+
+/// Append the section with the size of the content.
+inline void appendSection(std::vector<Byte> &Bin, Byte Id,
+                          const std::vector<Byte> &Content) {
+  Bin.push_back(Id);
+  appendU32(Bin, static_cast<uint32_t>(Content.size()));
+  Bin.insert(Bin.end(), Content.begin(), Content.end());
+}
+
+/// Generate the module with the encoded function types and the functions.
+/// The other sections are in the given order, and placed before the function
+/// section if their IDs are less than the one of the function section, or
+/// before the code section otherwise.
+inline std::vector<Byte>
+generateModule(const std::vector<std::vector<Byte>> &Types,
+               const std::vector<Function> &Funcs,
+               const std::vector<Section> &Sections = {}) {
+  std::vector<Byte> Bin = {0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00};
+  std::vector<Byte> Content;
+  appendU32(Content, static_cast<uint32_t>(Types.size()));
+  for (const auto &Type : Types) {
+    Content.insert(Content.end(), Type.begin(), Type.end());
+  }
+  appendSection(Bin, 0x01, Content);
+  for (const auto &Sec : Sections) {
+    if (Sec.Id < 0x03) {
+      appendSection(Bin, Sec.Id, Sec.Content);
+    }
+  }
+  Content.clear();
+  appendU32(Content, static_cast<uint32_t>(Funcs.size()));
+  for (const auto &Func : Funcs) {
+    appendU32(Content, Func.TypeIdx);
+  }
+  appendSection(Bin, 0x03, Content);
+  for (const auto &Sec : Sections) {
+    if (Sec.Id > 0x03) {
+      appendSection(Bin, Sec.Id, Sec.Content);
+    }
+  }
+  Content.clear();
+  appendU32(Content, static_cast<uint32_t>(Funcs.size()));
+  for (const auto &Func : Funcs) {
+    appendU32(Content,
+              static_cast<uint32_t>(Func.Locals.size() + Func.Body.size() + 1));
+    Content.insert(Content.end(), Func.Locals.begin(), Func.Locals.end());
+    Content.insert(Content.end(), Func.Body.begin(), Func.Body.end());
+    Content.push_back(0x0B);
+  }
+  appendSection(Bin, 0x0A, Content);
+  return Bin;
+}
+
+} // namespace Test
+} // namespace WasmEdge
@@ -14,36 +14,55 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include "common/config.h"
+#include "common/defines.h"
 #include "common/log.h"
+#include "loader/profile.h"
 #include "vm/vm.h"
 
 #include "../spec/hostfunc.h"
 #include "../spec/spectest.h"
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <csignal>
 #include <cstdint>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <gtest/gtest.h>
 #include <map>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <sys/mman.h>
+#endif
+#if WASMEDGE_OS_LINUX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 namespace {
 
 using namespace std::literals;
 using namespace WasmEdge;
 static SpecTest T(std::filesystem::u8path("../spec/testSuites"sv));
 
-// Parameterized testing class.
-class CoreTest : public testing::TestWithParam<std::string> {};
-
-TEST_P(CoreTest, TestSuites) {
-  const auto [Proposal, Conf, UnitName] = T.resolve(GetParam());
+// Run the test suite of the unit with the configuration adjusted for the
+// interpreter variant.
+template <typename AdjustT>
+void runTestSuite(const std::string &Param, AdjustT &&Adjust) {
+  auto [Proposal, Conf, UnitName] = T.resolve(Param);
+  Adjust(Conf);
   WasmEdge::VM::VM VM(Conf);
   WasmEdge::SpecTestModule SpecTestMod;
   VM.registerModule(SpecTestMod);
@@ -57,11 +76,18 @@ TEST_P(CoreTest, TestSuites) {
           .and_then([&VM]() { return VM.instantiate(); });
     }
   };
-  T.onLoad = [&VM](const std::string &Filename) -> Expect<void> {
-    return VM.loadWasm(Filename);
+  // The lazy loading defers the errors of the function bodies to their first
+  // calls, so the assertions of the malformed and the invalid modules are
+  // checked with the eager loading.
+  WasmEdge::Configure CheckConf(Conf);
+  CheckConf.getRuntimeConfigure().setLazyLoading(false);
+  WasmEdge::VM::VM CheckVM(CheckConf);
+  T.onLoad = [&CheckVM](const std::string &Filename) -> Expect<void> {
+    return CheckVM.loadWasm(Filename);
   };
-  T.onValidate = [&VM](const std::string &Filename) -> Expect<void> {
-    return VM.loadWasm(Filename).and_then([&VM]() { return VM.validate(); });
+  T.onValidate = [&CheckVM](const std::string &Filename) -> Expect<void> {
+    return CheckVM.loadWasm(Filename).and_then(
+        [&CheckVM]() { return CheckVM.validate(); });
   };
   T.onInstantiate = [&VM](const std::string &Filename) -> Expect<void> {
     return VM.loadWasm(Filename)
@@ -110,8 +136,60 @@ TEST_P(CoreTest, TestSuites) {
   T.run(Proposal, UnitName);
 }
 
+// Parameterized testing class.
+class CoreTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(CoreTest, TestSuites) {
+  runTestSuite(GetParam(), [](WasmEdge::Configure &) {});
+}
+
+// Parameterized testing class of the register-based interpreter.
+class RegisterIRCoreTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(RegisterIRCoreTest, TestSuites) {
+  runTestSuite(GetParam(), [](WasmEdge::Configure &Conf) {
+    Conf.getRuntimeConfigure().setRegisterIR(true);
+  });
+}
+
+// Parameterized testing class of the instruction fusion.
+class FusionCoreTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(FusionCoreTest, TestSuites) {
+  runTestSuite(GetParam(), [](WasmEdge::Configure &Conf) {
+    Conf.getRuntimeConfigure().setInstructionFusion(true);
+  });
+}
+
+// Parameterized testing class of the lazy loading.
+class LazyLoadingCoreTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(LazyLoadingCoreTest, TestSuites) {
+  runTestSuite(GetParam(), [](WasmEdge::Configure &Conf) {
+    Conf.getRuntimeConfigure().setLazyLoading(true);
+  });
+}
+
+// Parameterized testing class of the switch-based dispatch, which is the
+// reference of the threaded dispatch.
+class SwitchDispatchCoreTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(SwitchDispatchCoreTest, TestSuites) {
+  runTestSuite(GetParam(), [](WasmEdge::Configure &Conf) {
+    Conf.getRuntimeConfigure().setThreadedDispatch(false);
+  });
+}
+
 // Initiate test suite.
 INSTANTIATE_TEST_SUITE_P(TestUnit, CoreTest, testing::ValuesIn(T.enumerate()));
+INSTANTIATE_TEST_SUITE_P(TestUnit, RegisterIRCoreTest,
+                         testing::ValuesIn(T.enumerate()));
+INSTANTIATE_TEST_SUITE_P(TestUnit, FusionCoreTest,
+                         testing::ValuesIn(T.enumerate()));
+INSTANTIATE_TEST_SUITE_P(TestUnit, LazyLoadingCoreTest,
+                         testing::ValuesIn(T.enumerate()));
+INSTANTIATE_TEST_SUITE_P(TestUnit, SwitchDispatchCoreTest,
+                         testing::ValuesIn(T.enumerate()));
 
 TEST(AsyncRunWsmFile, InterruptTest) {
   WasmEdge::Configure Conf;
@@ -176,6 +254,1095 @@ TEST(AsyncExecute, InterruptTest) {
   }
 }
 
+TEST(GasMeasuring, TrappingLoadTest) {
+  // The function body is a block of 8 instructions ending with the load at
+  // 70000 out of the 1-page memory, which traps after the block is charged.
+  WasmEdge::Configure Conf;
+  Conf.getStatisticsConfigure().setInstructionCounting(true);
+  Conf.getStatisticsConfigure().setCostMeasuring(true);
+  WasmEdge::VM::VM VM(Conf);
+  std::array<WasmEdge::Byte, 56> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+      0x00, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01,
+      0x07, 0x08, 0x01, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x00, 0x0a, 0x14,
+      0x01, 0x12, 0x00, 0x41, 0x00, 0x1a, 0x41, 0x00, 0x1a, 0x41, 0x00, 0x1a,
+      0x41, 0xf0, 0xa2, 0x04, 0x28, 0x02, 0x00, 0x0b};
+  ASSERT_TRUE(VM.loadWasm(Wasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  for (uint64_t I = 1; I <= 2; ++I) {
+    auto Result = VM.execute("load");
+    ASSERT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::MemoryOutOfBounds);
+    EXPECT_EQ(VM.getStatistics().getInstrCount(), I * 8);
+    EXPECT_EQ(VM.getStatistics().getTotalCost(), I * 8);
+  }
+}
+
+TEST(GasMeasuring, StackOverflowTest) {
+  // The recursive function pushes 16 values in a block of 17 instructions
+  // before the call, and the value stack overflows inside that block.
+  WasmEdge::Configure Conf;
+  Conf.getStatisticsConfigure().setInstructionCounting(true);
+  Conf.getStatisticsConfigure().setCostMeasuring(true);
+  WasmEdge::VM::VM VM(Conf);
+  std::array<WasmEdge::Byte, 105> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x17, 0x02, 0x60,
+      0x00, 0x00, 0x60, 0x00, 0x10, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f,
+      0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x03, 0x02, 0x01,
+      0x00, 0x07, 0x07, 0x01, 0x03, 0x72, 0x65, 0x63, 0x00, 0x00, 0x0a, 0x39,
+      0x01, 0x37, 0x00, 0x02, 0x01, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41,
+      0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41,
+      0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41,
+      0x00, 0x0b, 0x10, 0x00, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a,
+      0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x1a, 0x0b};
+  ASSERT_TRUE(VM.loadWasm(Wasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  auto Result = VM.execute("rec");
+  ASSERT_FALSE(Result);
+  EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::CallStackExhausted);
+  // The cost of the overflowing block is charged in whole at its start.
+  EXPECT_GT(VM.getStatistics().getInstrCount(), 0U);
+  EXPECT_GE(VM.getStatistics().getTotalCost(),
+            VM.getStatistics().getInstrCount());
+}
+
+TEST(CallStack, FrameExhaustedTest) {
+  // The function `rec` calls itself without pushing any value, and only the
+  // frames grow. The call stack is exhausted under every policy.
+  std::array<WasmEdge::Byte, 36> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+      0x00, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03, 0x72,
+      0x65, 0x63, 0x00, 0x00, 0x0a, 0x06, 0x01, 0x04, 0x00, 0x10, 0x00, 0x0b};
+  for (uint32_t Policy = 0; Policy < 16; ++Policy) {
+    SCOPED_TRACE(Policy);
+    WasmEdge::Configure Conf;
+    Conf.getRuntimeConfigure().setRegisterIR((Policy & 1U) != 0);
+    Conf.getRuntimeConfigure().setInstructionFusion((Policy & 2U) != 0);
+    Conf.getRuntimeConfigure().setLazyLoading((Policy & 4U) != 0);
+    Conf.getStatisticsConfigure().setCostMeasuring((Policy & 8U) != 0);
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    auto Result = VM.execute("rec");
+    ASSERT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::CallStackExhausted);
+  }
+}
+
+// Run the function under every cost limit up to the total cost of the trace,
+// and without the limit. The trace is the executed instructions, and ends with
+// the trapping one if the expected result is an error. The execution should
+// trip at the same instruction as the per-instruction metering, which counts
+// and charges each instruction before running it.
+void checkCostLimits(WasmEdge::VM::VM &VM, std::string_view Func, uint32_t Arg,
+                     Span<const OpCode> Trace, Expect<uint32_t> Expected) {
+  auto &Stat = VM.getStatistics();
+  const auto CostTab = Stat.getCostTable();
+  auto getCost = [&CostTab](OpCode Code) {
+    return CostTab[static_cast<uint16_t>(Code)];
+  };
+  uint64_t Total = 0;
+  for (const auto Code : Trace) {
+    Total += getCost(Code);
+  }
+  for (uint64_t I = 0; I <= Total + 1; ++I) {
+    const uint64_t Limit = I <= Total ? I : UINT64_MAX;
+    SCOPED_TRACE(Limit);
+    uint64_t Count = 0;
+    uint64_t Cost = 0;
+    while (Count < Trace.size() && Cost + getCost(Trace[Count]) <= Limit) {
+      Cost += getCost(Trace[Count++]);
+    }
+    Stat.clear();
+    Stat.setCostLimit(Limit);
+    auto Result = VM.execute(Func, std::array{ValVariant(Arg)},
+                             std::array{ValType::I32});
+    if (Count < Trace.size()) {
+      ASSERT_FALSE(Result);
+      EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::CostLimitExceeded);
+      EXPECT_EQ(Stat.getInstrCount(), Count + 1);
+    } else if (Expected) {
+      ASSERT_TRUE(Result);
+      EXPECT_EQ((*Result)[0].first.get<uint32_t>(), *Expected);
+      EXPECT_EQ(Stat.getInstrCount(), Count);
+    } else {
+      ASSERT_FALSE(Result);
+      EXPECT_EQ(Result.error(), Expected.error());
+      EXPECT_EQ(Stat.getInstrCount(), Count);
+    }
+    EXPECT_EQ(Stat.getTotalCost(), Cost);
+  }
+}
+
+TEST(GasMeasuring, CostLimitTest) {
+  // The function `count` counts down the argument in a loop with `br` as the
+  // back-edge, and leaves the outer block by `br_if`. The function `div`
+  // traps by dividing by zero in the middle of its block, and `load` traps by
+  // loading at 70000 out of the 1-page memory in the middle of its block. The
+  // function `skip` leaves the block by `br` over the unreachable code.
+  std::array<WasmEdge::Byte, 135> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x05, 0x04, 0x00, 0x00, 0x00, 0x00, 0x05,
+      0x03, 0x01, 0x00, 0x01, 0x07, 0x1d, 0x04, 0x05, 0x63, 0x6f, 0x75, 0x6e,
+      0x74, 0x00, 0x00, 0x03, 0x64, 0x69, 0x76, 0x00, 0x01, 0x04, 0x73, 0x6b,
+      0x69, 0x70, 0x00, 0x02, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x03, 0x0a,
+      0x4a, 0x04, 0x21, 0x01, 0x01, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00,
+      0x45, 0x0d, 0x01, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x20, 0x01,
+      0x41, 0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b,
+      0x0a, 0x00, 0x41, 0x0a, 0x20, 0x00, 0x6e, 0x41, 0x01, 0x6a, 0x0b, 0x0e,
+      0x00, 0x02, 0x7f, 0x41, 0x05, 0x0c, 0x00, 0x41, 0x07, 0x0b, 0x41, 0x01,
+      0x6a, 0x0b, 0x0c, 0x00, 0x41, 0xf0, 0xa2, 0x04, 0x28, 0x02, 0x00, 0x41,
+      0x01, 0x6a, 0x0b};
+  std::vector<OpCode> CountTrace{OpCode::Block};
+  for (uint32_t I = 0; I < 3; ++I) {
+    CountTrace.insert(CountTrace.end(),
+                      {OpCode::Loop, OpCode::Local__get, OpCode::I32__eqz,
+                       OpCode::Br_if, OpCode::Local__get, OpCode::I32__const,
+                       OpCode::I32__sub, OpCode::Local__set, OpCode::Local__get,
+                       OpCode::I32__const, OpCode::I32__add, OpCode::Local__set,
+                       OpCode::Br});
+  }
+  CountTrace.insert(CountTrace.end(),
+                    {OpCode::Loop, OpCode::Local__get, OpCode::I32__eqz,
+                     OpCode::Br_if, OpCode::End, OpCode::Local__get,
+                     OpCode::End});
+  const std::array DivTrace{OpCode::I32__const, OpCode::Local__get,
+                            OpCode::I32__div_u, OpCode::I32__const,
+                            OpCode::I32__add, OpCode::End};
+  const std::array SkipTrace{OpCode::Block,      OpCode::I32__const,
+                             OpCode::Br,         OpCode::End,
+                             OpCode::I32__const, OpCode::I32__add,
+                             OpCode::End};
+  const std::array LoadTrace{OpCode::I32__const, OpCode::I32__load};
+
+  // Run with the default costs, and with the costs making the blocks of zero
+  // costs and the instructions of different costs.
+  std::vector<uint64_t> CostTab(UINT16_MAX + 1, 1);
+  CostTab[static_cast<uint16_t>(OpCode::I32__const)] = 3;
+  CostTab[static_cast<uint16_t>(OpCode::Local__get)] = 2;
+  CostTab[static_cast<uint16_t>(OpCode::Br)] = 0;
+  CostTab[static_cast<uint16_t>(OpCode::End)] = 0;
+  for (const bool IsDefaultCost : {true, false}) {
+    SCOPED_TRACE(IsDefaultCost);
+    WasmEdge::Configure Conf;
+    Conf.getStatisticsConfigure().setInstructionCounting(true);
+    Conf.getStatisticsConfigure().setCostMeasuring(true);
+    WasmEdge::VM::VM VM(Conf);
+    if (!IsDefaultCost) {
+      VM.getStatistics().setCostTable(CostTab);
+    }
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    checkCostLimits(VM, "count", 3, CountTrace, 3U);
+    checkCostLimits(VM, "div", 2, DivTrace, 6U);
+    checkCostLimits(VM, "div", 0, Span<const OpCode>(DivTrace).first(3),
+                    Unexpect(WasmEdge::ErrCode::Value::DivideByZero));
+    checkCostLimits(VM, "skip", 0, SkipTrace, 6U);
+    checkCostLimits(VM, "load", 0, LoadTrace,
+                    Unexpect(WasmEdge::ErrCode::Value::MemoryOutOfBounds));
+  }
+}
+
+TEST(ExecutionPolicy, EquivalenceTest) {
+  // The function `sum` adds up the squares from the argument down to 1 in a
+  // loop, `sel` selects a constant by `br_table`, `div` divides 100 by the
+  // argument, `load` stores and loads the argument at the address of itself,
+  // `indirect` calls the table entry of the argument with 7, and `unreach`
+  // runs `unreachable` if the argument is not zero. The results, the traps,
+  // and the counted instructions and costs are the same under every policy of
+  // the statistics and the profiling, with or without the fusion, and with the
+  // threaded or the switch-based dispatch.
+  std::array<WasmEdge::Byte, 225> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x02, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x03, 0x09,
+      0x08, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x01,
+      0x70, 0x00, 0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x2f, 0x06, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x03, 0x73, 0x65, 0x6c, 0x00, 0x03, 0x03,
+      0x64, 0x69, 0x76, 0x00, 0x04, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x05,
+      0x08, 0x69, 0x6e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x00, 0x06, 0x07,
+      0x75, 0x6e, 0x72, 0x65, 0x61, 0x63, 0x68, 0x00, 0x07, 0x09, 0x08, 0x01,
+      0x00, 0x41, 0x00, 0x0b, 0x02, 0x01, 0x02, 0x0a, 0x78, 0x08, 0x1d, 0x01,
+      0x01, 0x7f, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x10, 0x01, 0x6a, 0x21,
+      0x01, 0x20, 0x00, 0x41, 0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00,
+      0x0b, 0x20, 0x01, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x00, 0x6c, 0x0b,
+      0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6a, 0x0b, 0x1a, 0x00, 0x02, 0x40,
+      0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b,
+      0x41, 0x0a, 0x0f, 0x0b, 0x41, 0x14, 0x0f, 0x0b, 0x41, 0x1e, 0x0b, 0x08,
+      0x00, 0x41, 0xe4, 0x00, 0x20, 0x00, 0x6e, 0x0b, 0x0e, 0x00, 0x20, 0x00,
+      0x20, 0x00, 0x36, 0x02, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x09,
+      0x00, 0x41, 0x07, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b, 0x0b, 0x00, 0x20,
+      0x00, 0x04, 0x7f, 0x00, 0x05, 0x41, 0x01, 0x0b, 0x0b};
+  struct Case {
+    std::string_view Func;
+    uint32_t Arg;
+    Expect<uint32_t> Expected;
+  };
+  const std::array<Case, 15> Cases{{
+      {"sum"sv, 1, 1U},
+      {"sum"sv, 20, 2870U},
+      {"sel"sv, 0, 10U},
+      {"sel"sv, 1, 20U},
+      {"sel"sv, 2, 30U},
+      {"sel"sv, 9, 30U},
+      {"div"sv, 7, 14U},
+      {"div"sv, 0, Unexpect(WasmEdge::ErrCode::Value::DivideByZero)},
+      {"load"sv, 16, 16U},
+      {"load"sv, 65536, Unexpect(WasmEdge::ErrCode::Value::MemoryOutOfBounds)},
+      {"indirect"sv, 0, 49U},
+      {"indirect"sv, 1,
+       Unexpect(WasmEdge::ErrCode::Value::IndirectCallTypeMismatch)},
+      {"indirect"sv, 2, Unexpect(WasmEdge::ErrCode::Value::UndefinedElement)},
+      {"unreach"sv, 0, 1U},
+      {"unreach"sv, 1, Unexpect(WasmEdge::ErrCode::Value::Unreachable)},
+  }};
+  // The instruction counts and the costs of the cases recorded by the first
+  // policy which enables them.
+  std::array<std::optional<uint64_t>, Cases.size()> Counts, Costs;
+  for (uint32_t Policy = 0; Policy < 64; ++Policy) {
+    SCOPED_TRACE(Policy);
+    const bool IsCounting = (Policy & 1U) != 0;
+    const bool IsMeasuring = (Policy & 2U) != 0;
+    WasmEdge::Configure Conf;
+    Conf.getStatisticsConfigure().setInstructionCounting(IsCounting);
+    Conf.getStatisticsConfigure().setCostMeasuring(IsMeasuring);
+    Conf.getStatisticsConfigure().setFusionCounting((Policy & 4U) != 0);
+    Conf.getRuntimeConfigure().setProfiling((Policy & 8U) != 0);
+    Conf.getRuntimeConfigure().setInstructionFusion((Policy & 16U) != 0);
+    Conf.getRuntimeConfigure().setThreadedDispatch((Policy & 32U) == 0);
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    auto &Stat = VM.getStatistics();
+    for (size_t I = 0; I < Cases.size(); ++I) {
+      const auto &[Func, Arg, Expected] = Cases[I];
+      SCOPED_TRACE(Func);
+      SCOPED_TRACE(Arg);
+      Stat.clear();
+      auto Result = VM.execute(Func, std::array{ValVariant(Arg)},
+                               std::array{ValType::I32});
+      if (Expected) {
+        ASSERT_TRUE(Result);
+        ASSERT_EQ(Result->size(), 1U);
+        EXPECT_EQ((*Result)[0].first.get<uint32_t>(), *Expected);
+      } else {
+        ASSERT_FALSE(Result);
+        EXPECT_EQ(Result.error(), Expected.error());
+      }
+      if (IsCounting) {
+        EXPECT_EQ(Counts[I].value_or(Stat.getInstrCount()),
+                  Stat.getInstrCount());
+        Counts[I] = Stat.getInstrCount();
+      }
+      if (IsMeasuring) {
+        EXPECT_EQ(Costs[I].value_or(Stat.getTotalCost()), Stat.getTotalCost());
+        Costs[I] = Stat.getTotalCost();
+      }
+      if (IsCounting && IsMeasuring) {
+        // Every instruction costs 1 by default.
+        EXPECT_EQ(Stat.getInstrCount(), Stat.getTotalCost());
+      }
+    }
+  }
+}
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+// The host function reading the inaccessible page, which is neither the guard
+// region of the value stack nor the reserved region of a linear memory.
+class FaultingHostFunc : public Runtime::HostFunction<FaultingHostFunc> {
+public:
+  Expect<void> body(const Runtime::CallingFrame &) {
+    void *Page = mmap(nullptr, 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+    if (Page == MAP_FAILED) {
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
+    Value = *static_cast<volatile uint8_t *>(Page);
+    return {};
+  }
+  uint8_t Value = 0;
+};
+
+class FaultingHostModule : public Runtime::Instance::ModuleInstance {
+public:
+  FaultingHostModule() : ModuleInstance("env") {
+    addHostFunc("crash", std::make_unique<FaultingHostFunc>());
+  }
+};
+
+TEST(FaultHandling, HostFaultTest) {
+  // The function `run` calls the imported `env.crash`. The access violation
+  // in the host function is not turned into a trap, and kills the process.
+  std::array<WasmEdge::Byte, 50> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x02, 0x0d, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x05, 0x63, 0x72,
+      0x61, 0x73, 0x68, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01,
+      0x03, 0x72, 0x75, 0x6e, 0x00, 0x01, 0x0a, 0x06, 0x01, 0x04, 0x00, 0x10,
+      0x00, 0x0b};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        WasmEdge::Configure Conf;
+        WasmEdge::VM::VM VM(Conf);
+        FaultingHostModule HostMod;
+        if (!VM.registerModule(HostMod) || !VM.loadWasm(Wasm) ||
+            !VM.validate() || !VM.instantiate()) {
+          std::exit(1);
+        }
+        // Exit normally if the fault is reported as a trap.
+        VM.execute("run");
+        std::exit(0);
+      },
+      testing::KilledBySignal(SIGSEGV), "");
+}
+
+// The inaccessible page owned by the foreign signal handler, which makes the
+// page accessible on the first fault, such as the handlers of the JVM and the
+// Go runtime.
+void *ForeignPage = nullptr;
+volatile std::sig_atomic_t IsForeignFaultHandled = 0;
+
+void foreignSignalHandler(int Signal, siginfo_t *Siginfo, void *) {
+  if (Siginfo->si_addr == ForeignPage &&
+      mprotect(ForeignPage, 4096, PROT_READ | PROT_WRITE) == 0) {
+    IsForeignFaultHandled = 1;
+    return;
+  }
+  std::signal(Signal, SIG_DFL);
+}
+
+class ForeignFaultHostFunc : public Runtime::HostFunction<ForeignFaultHostFunc> {
+public:
+  Expect<void> body(const Runtime::CallingFrame &) {
+    Value = *static_cast<volatile uint8_t *>(ForeignPage);
+    return {};
+  }
+  uint8_t Value = 0;
+};
+
+class ForeignFaultHostModule : public Runtime::Instance::ModuleInstance {
+public:
+  ForeignFaultHostModule() : ModuleInstance("env") {
+    addHostFunc("touch", std::make_unique<ForeignFaultHostFunc>());
+  }
+};
+
+TEST(FaultHandling, ForeignFaultTest) {
+  // The function `run` calls the imported `env.touch`, and then loads at 70000
+  // out of the 1-page memory. The fault in the host function is recovered by
+  // the foreign handler, and the out-of-bounds load still traps.
+  std::array<WasmEdge::Byte, 63> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x02, 0x0d, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x05, 0x74, 0x6f,
+      0x75, 0x63, 0x68, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01,
+      0x00, 0x01, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x01, 0x0a,
+      0x0e, 0x01, 0x0c, 0x00, 0x10, 0x00, 0x41, 0xf0, 0xa2, 0x04, 0x28, 0x02,
+      0x00, 0x1a, 0x0b};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        ForeignPage = mmap(nullptr, 4096, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        struct sigaction Action {};
+        Action.sa_sigaction = &foreignSignalHandler;
+        Action.sa_flags = SA_SIGINFO;
+        if (ForeignPage == MAP_FAILED ||
+            sigaction(SIGSEGV, &Action, nullptr) != 0 ||
+            sigaction(SIGBUS, &Action, nullptr) != 0) {
+          std::exit(1);
+        }
+        WasmEdge::Configure Conf;
+        WasmEdge::VM::VM VM(Conf);
+        ForeignFaultHostModule HostMod;
+        if (!VM.registerModule(HostMod) || !VM.loadWasm(Wasm) ||
+            !VM.validate() || !VM.instantiate()) {
+          std::exit(1);
+        }
+        for (uint32_t I = 0; I < 2; ++I) {
+          auto Result = VM.execute("run");
+          if (Result ||
+              Result.error() != WasmEdge::ErrCode::Value::MemoryOutOfBounds) {
+            std::exit(2);
+          }
+        }
+        std::exit(IsForeignFaultHandled ? 0 : 3);
+      },
+      testing::ExitedWithCode(0), "");
+}
+
+TEST(FaultHandling, ConcurrentFaultTest) {
+  // The function `run` loads at 70000 out of the 1-page memory. The threads
+  // trap concurrently, and the fault out of the execution is still handled by
+  // the foreign handler afterwards.
+  std::array<WasmEdge::Byte, 46> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07,
+      0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x00, 0x0a, 0x0c, 0x01, 0x0a,
+      0x00, 0x41, 0xf0, 0xa2, 0x04, 0x28, 0x02, 0x00, 0x1a, 0x0b};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        ForeignPage = mmap(nullptr, 4096, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        struct sigaction Action {};
+        Action.sa_sigaction = &foreignSignalHandler;
+        Action.sa_flags = SA_SIGINFO;
+        if (ForeignPage == MAP_FAILED ||
+            sigaction(SIGSEGV, &Action, nullptr) != 0 ||
+            sigaction(SIGBUS, &Action, nullptr) != 0) {
+          std::exit(1);
+        }
+        std::atomic_bool IsFailed = false;
+        std::vector<std::thread> Threads;
+        for (uint32_t I = 0; I < 4; ++I) {
+          Threads.emplace_back([&Wasm, &IsFailed]() {
+            WasmEdge::Configure Conf;
+            WasmEdge::VM::VM VM(Conf);
+            if (!VM.loadWasm(Wasm) || !VM.validate() || !VM.instantiate()) {
+              IsFailed = true;
+              return;
+            }
+            for (uint32_t J = 0; J < 1000; ++J) {
+              auto Result = VM.execute("run");
+              if (Result || Result.error() !=
+                                WasmEdge::ErrCode::Value::MemoryOutOfBounds) {
+                IsFailed = true;
+              }
+            }
+          });
+        }
+        for (auto &Thread : Threads) {
+          Thread.join();
+        }
+        if (IsFailed) {
+          std::exit(2);
+        }
+        static_cast<void>(*static_cast<volatile uint8_t *>(ForeignPage));
+        std::exit(IsForeignFaultHandled ? 0 : 3);
+      },
+      testing::ExitedWithCode(0), "");
+}
+
+// The previous actions saved by the foreign handler installed after the VM.
+struct sigaction PrevForeignBusAction;
+struct sigaction PrevForeignSegvAction;
+
+void chainingSignalHandler(int Signal, siginfo_t *Siginfo, void *Context) {
+  if (Siginfo->si_addr == ForeignPage &&
+      mprotect(ForeignPage, 4096, PROT_READ | PROT_WRITE) == 0) {
+    IsForeignFaultHandled = 1;
+    return;
+  }
+  // Forward the other faults, such as the ones of the WebAssembly execution,
+  // to the handlers installed before.
+  const struct sigaction &Prev =
+      Signal == SIGBUS ? PrevForeignBusAction : PrevForeignSegvAction;
+  if (Prev.sa_flags & SA_SIGINFO) {
+    Prev.sa_sigaction(Signal, Siginfo, Context);
+    return;
+  }
+  std::signal(Signal, SIG_DFL);
+}
+
+TEST(FaultHandling, LaterForeignFaultTest) {
+  // Same as `ForeignFaultTest`, but the foreign handler is installed after
+  // creating the VM, and forwards the faults it does not handle to the handler
+  // of the VM.
+  std::array<WasmEdge::Byte, 63> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x02, 0x0d, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x05, 0x74, 0x6f,
+      0x75, 0x63, 0x68, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01,
+      0x00, 0x01, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x01, 0x0a,
+      0x0e, 0x01, 0x0c, 0x00, 0x10, 0x00, 0x41, 0xf0, 0xa2, 0x04, 0x28, 0x02,
+      0x00, 0x1a, 0x0b};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        WasmEdge::Configure Conf;
+        WasmEdge::VM::VM VM(Conf);
+        ForeignPage = mmap(nullptr, 4096, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        struct sigaction Action {};
+        Action.sa_sigaction = &chainingSignalHandler;
+        Action.sa_flags = SA_SIGINFO;
+        if (ForeignPage == MAP_FAILED ||
+            sigaction(SIGSEGV, &Action, &PrevForeignSegvAction) != 0 ||
+            sigaction(SIGBUS, &Action, &PrevForeignBusAction) != 0) {
+          std::exit(1);
+        }
+        ForeignFaultHostModule HostMod;
+        if (!VM.registerModule(HostMod) || !VM.loadWasm(Wasm) ||
+            !VM.validate() || !VM.instantiate()) {
+          std::exit(1);
+        }
+        for (uint32_t I = 0; I < 2; ++I) {
+          auto Result = VM.execute("run");
+          if (Result ||
+              Result.error() != WasmEdge::ErrCode::Value::MemoryOutOfBounds) {
+            std::exit(2);
+          }
+        }
+        std::exit(IsForeignFaultHandled ? 0 : 3);
+      },
+      testing::ExitedWithCode(0), "");
+}
+
+#if WASMEDGE_GUARDED_LINEAR_MEMORY
+// The host function reading the reserved region after the memory of the
+// calling module, which is only guarded for the WebAssembly execution.
+class GuardFaultHostFunc : public Runtime::HostFunction<GuardFaultHostFunc> {
+public:
+  Expect<void> body(const Runtime::CallingFrame &Frame) {
+    auto *MemInst = Frame.getMemoryByIndex(0);
+    if (MemInst == nullptr) {
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
+    Value = *static_cast<volatile uint8_t *>(MemInst->getDataPtr() + 70000);
+    return {};
+  }
+  uint8_t Value = 0;
+};
+
+class GuardFaultHostModule : public Runtime::Instance::ModuleInstance {
+public:
+  GuardFaultHostModule() : ModuleInstance("env") {
+    addHostFunc("touch", std::make_unique<GuardFaultHostFunc>());
+  }
+};
+
+TEST(FaultHandling, HostGuardFaultTest) {
+  // The function `run` calls the imported `env.touch`, which reads at 70000
+  // out of the 1-page memory. The address is in the guard region, but the
+  // fault in the host function is not turned into the trap.
+  std::array<WasmEdge::Byte, 63> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x02, 0x0d, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x05, 0x74, 0x6f,
+      0x75, 0x63, 0x68, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01,
+      0x00, 0x01, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x01, 0x0a,
+      0x0e, 0x01, 0x0c, 0x00, 0x10, 0x00, 0x41, 0xf0, 0xa2, 0x04, 0x28, 0x02,
+      0x00, 0x1a, 0x0b};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        WasmEdge::Configure Conf;
+        WasmEdge::VM::VM VM(Conf);
+        GuardFaultHostModule HostMod;
+        if (!VM.registerModule(HostMod) || !VM.loadWasm(Wasm) ||
+            !VM.validate() || !VM.instantiate()) {
+          std::exit(1);
+        }
+        static_cast<void>(VM.execute("run"));
+        std::exit(0);
+      },
+      testing::KilledBySignal(SIGSEGV), "");
+}
+#endif
+#endif
+
+#if WASMEDGE_OS_LINUX
+TEST(CallStack, GrowableFallbackTest) {
+  // The function `inc` returns the argument plus 1. Without the address space
+  // for the guarded region, the value stack falls back to the growable one.
+  std::array<WasmEdge::Byte, 40> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x69, 0x6e, 0x63, 0x00, 0x00, 0x0a, 0x09, 0x01, 0x07, 0x00, 0x20, 0x00,
+      0x41, 0x01, 0x6a, 0x0b};
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        uint64_t Pages = 0;
+        std::ifstream("/proc/self/statm") >> Pages;
+        struct rlimit Limit {};
+        Limit.rlim_cur = Limit.rlim_max =
+            Pages * static_cast<uint64_t>(getpagesize()) +
+            UINT64_C(32) * 1024 * 1024;
+        if (Pages == 0 || setrlimit(RLIMIT_AS, &Limit) != 0) {
+          std::exit(1);
+        }
+        WasmEdge::Configure Conf;
+        WasmEdge::VM::VM VM(Conf);
+        if (!VM.loadWasm(Wasm) || !VM.validate() || !VM.instantiate()) {
+          std::exit(1);
+        }
+        auto Result = VM.execute("inc", std::array{ValVariant(UINT32_C(41))},
+                                 std::array{ValType::I32});
+        if (!Result || (*Result)[0].first.get<uint32_t>() != 42U) {
+          std::exit(2);
+        }
+        std::exit(0);
+      },
+      testing::ExitedWithCode(0), "");
+}
+#endif
+
+TEST(CallIndirect, TableSetTest) {
+  // The function `call` calls the function at the table index with the type
+  // `[] -> [i32]`, and `set` copies the table element at the second index to
+  // the first index. The table holds the functions returning `1` and `2`, and
+  // the function of the type `[] -> [i64]`. The callee changed by `table.set`
+  // is called and checked again after the calls of the previous one.
+  std::array<WasmEdge::Byte, 107> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x13, 0x04, 0x60,
+      0x00, 0x01, 0x7f, 0x60, 0x00, 0x01, 0x7e, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+      0x60, 0x02, 0x7f, 0x7f, 0x00, 0x03, 0x06, 0x05, 0x00, 0x00, 0x01, 0x02,
+      0x03, 0x04, 0x04, 0x01, 0x70, 0x00, 0x03, 0x07, 0x0e, 0x02, 0x04, 0x63,
+      0x61, 0x6c, 0x6c, 0x00, 0x03, 0x03, 0x73, 0x65, 0x74, 0x00, 0x04, 0x09,
+      0x09, 0x01, 0x00, 0x41, 0x00, 0x0b, 0x03, 0x00, 0x01, 0x02, 0x0a, 0x23,
+      0x05, 0x04, 0x00, 0x41, 0x01, 0x0b, 0x04, 0x00, 0x41, 0x02, 0x0b, 0x04,
+      0x00, 0x42, 0x03, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b,
+      0x0a, 0x00, 0x20, 0x00, 0x20, 0x01, 0x25, 0x00, 0x26, 0x00, 0x0b};
+  for (const bool IsRegisterIR : {false, true}) {
+    WasmEdge::Configure Conf;
+    Conf.getRuntimeConfigure().setRegisterIR(IsRegisterIR);
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    auto Call = [&VM]() {
+      return VM.execute("call", std::array{ValVariant(UINT32_C(0))},
+                        std::array{ValType::I32});
+    };
+    auto Set = [&VM](uint32_t Src) {
+      return VM.execute("set",
+                        std::array{ValVariant(UINT32_C(0)), ValVariant(Src)},
+                        std::array{ValType::I32, ValType::I32});
+    };
+    for (uint32_t I = 0; I < 2; ++I) {
+      auto Result = Call();
+      ASSERT_TRUE(Result);
+      EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 1U);
+    }
+    ASSERT_TRUE(Set(1));
+    auto Result = Call();
+    ASSERT_TRUE(Result);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 2U);
+    ASSERT_TRUE(Set(2));
+    Result = Call();
+    ASSERT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::IndirectCallTypeMismatch);
+    ASSERT_TRUE(Set(1));
+    Result = Call();
+    ASSERT_TRUE(Result);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 2U);
+  }
+}
+
+class DivModHostFunc : public Runtime::HostFunction<DivModHostFunc> {
+public:
+  Expect<std::tuple<uint32_t, uint32_t>> body(const Runtime::CallingFrame &,
+                                              uint32_t A, uint32_t B) {
+    if (B == 0) {
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
+    return std::make_tuple(A / B, A % B);
+  }
+};
+
+class DivModHostModule : public Runtime::Instance::ModuleInstance {
+public:
+  DivModHostModule(bool IsLeaf) : ModuleInstance("env") {
+    auto Func = std::make_unique<DivModHostFunc>();
+    Func->setLeaf(IsLeaf);
+    addHostFunc("divmod", std::move(Func));
+  }
+};
+
+TEST(HostFunction, LeafCallTest) {
+  // The imported `env.divmod` returns the quotient and the remainder, and
+  // fails on the zero divisor. The function `run` calls it above a constant
+  // and returns all the three values, `nested` calls `run` and adds up the
+  // returns with the first arg, `tail` tail-calls `env.divmod`, and
+  // `tailnest` calls `tail` above a constant and adds up the returns. The
+  // results are the same whether the host function is a leaf or not.
+  std::array<WasmEdge::Byte, 142> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x16, 0x03, 0x60,
+      0x02, 0x7f, 0x7f, 0x02, 0x7f, 0x7f, 0x60, 0x02, 0x7f, 0x7f, 0x03, 0x7f,
+      0x7f, 0x7f, 0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x02, 0x0e, 0x01, 0x03,
+      0x65, 0x6e, 0x76, 0x06, 0x64, 0x69, 0x76, 0x6d, 0x6f, 0x64, 0x00, 0x00,
+      0x03, 0x05, 0x04, 0x01, 0x02, 0x00, 0x02, 0x07, 0x22, 0x04, 0x03, 0x72,
+      0x75, 0x6e, 0x00, 0x01, 0x06, 0x6e, 0x65, 0x73, 0x74, 0x65, 0x64, 0x00,
+      0x02, 0x04, 0x74, 0x61, 0x69, 0x6c, 0x00, 0x03, 0x08, 0x74, 0x61, 0x69,
+      0x6c, 0x6e, 0x65, 0x73, 0x74, 0x00, 0x04, 0x0a, 0x31, 0x04, 0x0b, 0x00,
+      0x41, 0xe4, 0x00, 0x20, 0x00, 0x20, 0x01, 0x10, 0x00, 0x0b, 0x0d, 0x00,
+      0x20, 0x00, 0x20, 0x01, 0x10, 0x01, 0x6a, 0x6a, 0x20, 0x00, 0x6a, 0x0b,
+      0x08, 0x00, 0x20, 0x00, 0x20, 0x01, 0x12, 0x00, 0x0b, 0x0c, 0x00, 0x41,
+      0x07, 0x20, 0x00, 0x20, 0x01, 0x10, 0x03, 0x6a, 0x6a, 0x0b};
+  const std::array ParamTypes{ValType::I32, ValType::I32};
+  const std::array Params{ValVariant(UINT32_C(47)), ValVariant(UINT32_C(5))};
+  const std::array ZeroParams{ValVariant(UINT32_C(47)),
+                              ValVariant(UINT32_C(0))};
+  for (const bool IsLeaf : {false, true}) {
+    SCOPED_TRACE(IsLeaf ? "leaf" : "frame");
+    WasmEdge::Configure Conf;
+    Conf.addProposal(Proposal::TailCall);
+    WasmEdge::VM::VM VM(Conf);
+    DivModHostModule HostMod(IsLeaf);
+    ASSERT_TRUE(VM.registerModule(HostMod));
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+
+    // The returns are written above the args, and the constant under the args
+    // is kept.
+    auto Result = VM.execute("run", Params, ParamTypes);
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(Result->size(), 3U);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 100U);
+    EXPECT_EQ((*Result)[1].first.get<uint32_t>(), 9U);
+    EXPECT_EQ((*Result)[2].first.get<uint32_t>(), 2U);
+    Result = VM.execute("nested", Params, ParamTypes);
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(Result->size(), 1U);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 158U);
+
+    // The tail-call replaces the frame of the caller.
+    Result = VM.execute("tail", Params, ParamTypes);
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(Result->size(), 2U);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 9U);
+    EXPECT_EQ((*Result)[1].first.get<uint32_t>(), 2U);
+    Result = VM.execute("tailnest", Params, ParamTypes);
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(Result->size(), 1U);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 18U);
+
+    // The error of the host function is returned, and the VM is still usable.
+    for (const auto Func : {"run"sv, "nested"sv, "tail"sv, "tailnest"sv}) {
+      Result = VM.execute(Func, ZeroParams, ParamTypes);
+      ASSERT_FALSE(Result);
+      EXPECT_EQ(Result.error(), ErrCode::Value::HostFuncError);
+    }
+    Result = VM.execute("nested", Params, ParamTypes);
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(Result->size(), 1U);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 158U);
+  }
+}
+
+TEST(CallIndirect, GenerationTest) {
+  // The inline caches of call_indirect are invalidated once when a module
+  // instance is destroyed with all its functions, and once when a function
+  // instance not owned by any module is destroyed.
+  std::array<WasmEdge::Byte, 39> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01,
+      0x60, 0x00, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x00, 0x00, 0x0a,
+      0x10, 0x03, 0x04, 0x00, 0x41, 0x01, 0x0b, 0x04, 0x00, 0x41, 0x02,
+      0x0b, 0x04, 0x00, 0x41, 0x03, 0x0b};
+  WasmEdge::VM::VM VM(WasmEdge::Configure{});
+  ASSERT_TRUE(VM.loadWasm(Wasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  uint64_t Gen = FuncInstGeneration.load();
+  VM.cleanup();
+  EXPECT_EQ(FuncInstGeneration.load(), Gen + 1);
+
+  Gen = FuncInstGeneration.load();
+  {
+    Runtime::Instance::FunctionInstance Func(
+        nullptr, std::make_unique<DivModHostFunc>());
+  }
+  EXPECT_EQ(FuncInstGeneration.load(), Gen + 1);
+}
+
+TEST(InstructionFusion, FusionCountTest) {
+  // The loop body of the function summing from 1 to the argument has the
+  // sequences `local.get, local.get, i32.add` and `local.get, i32.const,
+  // i32.add, local.set`, and each of them is fused once per iteration.
+  std::array<WasmEdge::Byte, 60> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x1d, 0x01, 0x1b, 0x01, 0x01, 0x7f,
+      0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+      0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b};
+  for (const bool IsFusion : {false, true}) {
+    WasmEdge::Configure Conf;
+    Conf.getRuntimeConfigure().setInstructionFusion(IsFusion);
+    Conf.getStatisticsConfigure().setFusionCounting(true);
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    auto Result = VM.execute("sum", std::array{ValVariant(UINT32_C(10))},
+                             std::array{ValType::I32});
+    ASSERT_TRUE(Result);
+    ASSERT_EQ(Result->size(), 1U);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 55U);
+    const auto &Stat = VM.getStatistics();
+    const uint64_t Expected = IsFusion ? 10U : 0U;
+    EXPECT_EQ(Stat.getFusionCount(OpCode::Fused__local_get_local_get_i32_add),
+              Expected);
+    EXPECT_EQ(Stat.getFusionCount(
+                  OpCode::Fused__local_get_i32_const_i32_add_local_set),
+              Expected);
+    EXPECT_EQ(Stat.getFusionCount(OpCode::Fused__local_get_local_get), 0U);
+    EXPECT_EQ(Stat.getFusionCount(OpCode::Fused__local_get_i32_const_i32_add),
+              0U);
+    EXPECT_EQ(Stat.getFusionCount(OpCode::Fused__i32_const_br_if), 0U);
+  }
+}
+
+TEST(InstructionFusion, RegisterIRTest) {
+  // With both the fusion and the register-based IR, the lowered function is
+  // not fused and runs on the register-based interpreter, so no fused
+  // instruction is executed.
+  std::array<WasmEdge::Byte, 60> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x1d, 0x01, 0x1b, 0x01, 0x01, 0x7f,
+      0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+      0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b};
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setInstructionFusion(true);
+  Conf.getRuntimeConfigure().setRegisterIR(true);
+  Conf.getStatisticsConfigure().setFusionCounting(true);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(Wasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  const auto *Func = VM.getActiveModule()->findFuncExports("sum");
+  ASSERT_NE(Func, nullptr);
+  ASSERT_NE(Func->getRegisterCode(), nullptr);
+  for (const auto &Instr : Func->getInstrs()) {
+    EXPECT_LT(static_cast<uint16_t>(Instr.getOpCode()),
+              static_cast<uint16_t>(OpCode::Fused__local_get_local_get));
+  }
+  auto Result = VM.execute("sum", std::array{ValVariant(UINT32_C(10))},
+                           std::array{ValType::I32});
+  ASSERT_TRUE(Result);
+  ASSERT_EQ(Result->size(), 1U);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 55U);
+  const auto &Stat = VM.getStatistics();
+  EXPECT_EQ(Stat.getFusionCount(OpCode::Fused__local_get_local_get_i32_add),
+            0U);
+  EXPECT_EQ(
+      Stat.getFusionCount(OpCode::Fused__local_get_i32_const_i32_add_local_set),
+      0U);
+}
+
+TEST(SharedCode, InstantiateTest) {
+  // The instances of an AST module share the function code prepared under the
+  // same configuration. The code prepared under the different fusion or
+  // register-based IR flags, and the gas-metered code, are not shared.
+  std::array<WasmEdge::Byte, 60> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x1d, 0x01, 0x1b, 0x01, 0x01, 0x7f,
+      0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+      0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b};
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Load(Conf);
+  WasmEdge::Validator::Validator Valid(Conf);
+  auto Mod = Load.parseModule(Wasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Valid.validate(**Mod));
+
+  WasmEdge::Configure FusedConf;
+  FusedConf.getRuntimeConfigure().setInstructionFusion(true);
+  WasmEdge::Configure CountedConf(FusedConf);
+  CountedConf.getStatisticsConfigure().setInstructionCounting(true);
+  WasmEdge::Configure LoweredConf;
+  LoweredConf.getRuntimeConfigure().setRegisterIR(true);
+  WasmEdge::Configure MeteredConf(LoweredConf);
+  MeteredConf.getStatisticsConfigure().setCostMeasuring(true);
+
+  // Instantiate the module and run the exported function, which is kept alive
+  // with its module instance until the end of the test.
+  std::vector<std::unique_ptr<WasmEdge::Runtime::Instance::ModuleInstance>>
+      ModInsts;
+  auto Instantiate = [&](const WasmEdge::Configure &C)
+      -> const WasmEdge::Runtime::Instance::FunctionInstance * {
+    WasmEdge::Statistics::Statistics Stat;
+    WasmEdge::Executor::Executor Exec(C, &Stat);
+    WasmEdge::Runtime::StoreManager StoreMgr;
+    auto ModInst = Exec.instantiateModule(StoreMgr, **Mod);
+    EXPECT_TRUE(ModInst);
+    if (!ModInst) {
+      return nullptr;
+    }
+    const auto *Func = (*ModInst)->findFuncExports("sum");
+    EXPECT_NE(Func, nullptr);
+    if (Func) {
+      auto Result = Exec.invoke(*Func, std::array{ValVariant(UINT32_C(10))},
+                                std::array{ValType::I32});
+      EXPECT_TRUE(Result);
+      if (Result) {
+        EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 55U);
+      }
+    }
+    ModInsts.push_back(std::move(*ModInst));
+    return Func;
+  };
+
+  // The same configuration shares the code.
+  const auto *Plain1 = Instantiate(Conf);
+  const auto *Plain2 = Instantiate(Conf);
+  ASSERT_NE(Plain1, nullptr);
+  ASSERT_NE(Plain2, nullptr);
+  EXPECT_NE(Plain1, Plain2);
+  EXPECT_EQ(Plain1->getInstrs().data(), Plain2->getInstrs().data());
+
+  // The fused code is not shared with the code prepared without the fusion,
+  // and the instruction counting skips the fusion.
+  const auto *Fused1 = Instantiate(FusedConf);
+  const auto *Fused2 = Instantiate(FusedConf);
+  const auto *Counted = Instantiate(CountedConf);
+  ASSERT_NE(Fused1, nullptr);
+  ASSERT_NE(Fused2, nullptr);
+  ASSERT_NE(Counted, nullptr);
+  EXPECT_NE(Fused1->getInstrs().data(), Plain1->getInstrs().data());
+  EXPECT_EQ(Fused1->getInstrs().data(), Fused2->getInstrs().data());
+  EXPECT_NE(Counted->getInstrs().data(), Fused1->getInstrs().data());
+  auto IsFused = [](const WasmEdge::Runtime::Instance::FunctionInstance &F) {
+    for (const auto &Instr : F.getInstrs()) {
+      if (static_cast<uint16_t>(Instr.getOpCode()) >=
+          static_cast<uint16_t>(OpCode::Fused__local_get_local_get)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  EXPECT_TRUE(IsFused(*Fused1));
+  EXPECT_FALSE(IsFused(*Counted));
+
+  // The lowered code is not shared with the stack-based code.
+  const auto *Lowered1 = Instantiate(LoweredConf);
+  const auto *Lowered2 = Instantiate(LoweredConf);
+  const auto *Plain3 = Instantiate(Conf);
+  ASSERT_NE(Lowered1, nullptr);
+  ASSERT_NE(Lowered2, nullptr);
+  ASSERT_NE(Plain3, nullptr);
+  ASSERT_NE(Lowered1->getRegisterCode(), nullptr);
+  EXPECT_EQ(Lowered1->getRegisterCode(), Lowered2->getRegisterCode());
+  EXPECT_NE(Lowered1->getInstrs().data(), Counted->getInstrs().data());
+  EXPECT_EQ(Plain3->getRegisterCode(), nullptr);
+  EXPECT_NE(Plain3->getInstrs().data(), Lowered1->getInstrs().data());
+
+  // The metered code is never shared, even under the same configuration.
+  const auto *Metered1 = Instantiate(MeteredConf);
+  const auto *Metered2 = Instantiate(MeteredConf);
+  ASSERT_NE(Metered1, nullptr);
+  ASSERT_NE(Metered2, nullptr);
+  EXPECT_NE(Metered1->getInstrs().data(), Metered2->getInstrs().data());
+  EXPECT_NE(Metered1->getRegisterCode(), Metered2->getRegisterCode());
+  EXPECT_NE(Metered1->getRegisterCode(), Lowered1->getRegisterCode());
+  EXPECT_NE(Metered1->getInstrs().data(), Plain3->getInstrs().data());
+  EXPECT_EQ(Instantiate(Conf)->getInstrs().data(), Plain3->getInstrs().data());
+}
+
+TEST(SharedCode, ProfileTest) {
+  // The profile counters belong to the executor, so the VMs instantiating the
+  // same AST module with the profiling record their own profiles.
+  std::array<WasmEdge::Byte, 60> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x1d, 0x01, 0x1b, 0x01, 0x01, 0x7f,
+      0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+      0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b};
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setProfiling(true);
+  WasmEdge::Loader::Loader Load(Conf);
+  WasmEdge::Validator::Validator Valid(Conf);
+  auto Mod = Load.parseModule(Wasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Valid.validate(**Mod));
+
+  // Run `sum` in each VM, in which the `br_if` of the loop is taken one time
+  // less than the argument, and store the profiles into the separate files.
+  const auto Key = WasmEdge::Loader::ProfileFile::getKey(Wasm);
+  auto Record = [&](uint32_t Arg) -> std::vector<uint64_t> {
+    const auto Path =
+        std::filesystem::temp_directory_path() /
+        std::filesystem::u8path("ExecutorTest" + std::to_string(Arg) +
+                                ".profile");
+    std::error_code EC;
+    std::filesystem::remove(Path, EC);
+    WasmEdge::VM::VM VM(Conf);
+    EXPECT_TRUE(VM.runWasmFile(**Mod, "sum", std::array{ValVariant(Arg)},
+                               std::array{ValType::I32}));
+    EXPECT_TRUE(VM.storeProfile(Path));
+    WasmEdge::Loader::ProfileFile File;
+    EXPECT_TRUE(File.load(Path));
+    std::filesystem::remove(Path, EC);
+    const auto *Prof = File.find(Key);
+    if (Prof == nullptr || Prof->count(0) == 0 ||
+        Prof->at(0).Branches.size() != 1) {
+      ADD_FAILURE() << "no branch profile of sum(" << Arg << ")";
+      return {};
+    }
+    return Prof->at(0).Branches.begin()->second;
+  };
+  EXPECT_EQ(Record(10), (std::vector<uint64_t>{1, 9}));
+  EXPECT_EQ(Record(20), (std::vector<uint64_t>{1, 19}));
+}
+
+TEST(DataSegment, ZeroCopyTest) {
+  // The data instance refers to the given data without copying if the holder
+  // is given, otherwise it owns a copy.
+  auto Buffer = std::make_shared<std::vector<WasmEdge::Byte>>(
+      std::initializer_list<WasmEdge::Byte>{0x68, 0x69});
+  Runtime::Instance::DataInstance Aliased(0, *Buffer, Buffer);
+  EXPECT_EQ(Aliased.getData().data(), Buffer->data());
+  EXPECT_EQ(Aliased.getDataHolder(), Buffer);
+  Runtime::Instance::DataInstance Copied(0, *Buffer);
+  EXPECT_NE(Copied.getData().data(), Buffer->data());
+  ASSERT_EQ(Copied.getData().size(), 2U);
+  EXPECT_EQ(Copied.getData()[1], 0x69U);
+  EXPECT_EQ(Buffer.use_count(), 2);
+  Aliased.clear();
+  EXPECT_TRUE(Aliased.getData().empty());
+  EXPECT_EQ(Buffer.use_count(), 1);
+
+  // The passive data segment of the module loaded from the file refers to the
+  // mapped file. Instantiating keeps a reference to the mapping, and the
+  // function `drop` with `data.drop 0` releases it.
+  std::array<WasmEdge::Byte, 52> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01,
+      0x60, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00,
+      0x01, 0x07, 0x08, 0x01, 0x04, 0x64, 0x72, 0x6f, 0x70, 0x00, 0x00,
+      0x0c, 0x01, 0x01, 0x0a, 0x07, 0x01, 0x05, 0x00, 0xfc, 0x09, 0x00,
+      0x0b, 0x0b, 0x05, 0x01, 0x01, 0x02, 0x68, 0x69};
+  const auto Path =
+      std::filesystem::temp_directory_path() / "ExecutorTestData.wasm"sv;
+  {
+    std::ofstream Fout(Path, std::ios::binary | std::ios::trunc);
+    Fout.write(reinterpret_cast<const char *>(Wasm.data()), Wasm.size());
+  }
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Load(Conf);
+  WasmEdge::Validator::Validator Valid(Conf);
+  WasmEdge::Executor::Executor Exec(Conf);
+  WasmEdge::Runtime::StoreManager StoreMgr;
+  auto Mod = Load.parseModule(Path);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Valid.validate(**Mod));
+  const auto &DataSegs = (*Mod)->getDataSection().getContent();
+  ASSERT_EQ(DataSegs.size(), 1U);
+  const auto &Holder = DataSegs[0].getDataHolder();
+  ASSERT_NE(Holder, nullptr);
+  const auto Count = Holder.use_count();
+  {
+    auto ModInst = Exec.instantiateModule(StoreMgr, **Mod);
+    ASSERT_TRUE(ModInst);
+    EXPECT_EQ(Holder.use_count(), Count + 1);
+    const auto *Func = (*ModInst)->findFuncExports("drop");
+    ASSERT_NE(Func, nullptr);
+    ASSERT_TRUE(Exec.invoke(*Func, {}, {}));
+    EXPECT_EQ(Holder.use_count(), Count);
+    // Dropping again is a no-op.
+    ASSERT_TRUE(Exec.invoke(*Func, {}, {}));
+    EXPECT_EQ(Holder.use_count(), Count);
+  }
+  EXPECT_EQ(Holder.use_count(), Count);
+  Mod->reset();
+  std::error_code EC;
+  std::filesystem::remove(Path, EC);
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/executor/TemplateTest.cpp - Module template tests ---===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains tests of freezing the modules into the templates and
+/// instantiating the module instances from them.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/log.h"
+#include "executor/executor.h"
+#include "loader/loader.h"
+#include "runtime/instance/template.h"
+#include "runtime/storemgr.h"
+#include "validator/validator.h"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace WasmEdge;
+
+// The module imports `env.tick` called by the start function, which also
+// increases the global `count`. The table and the global `g` hold the function
+// references to `a` returning 1 and `b` returning 2, and the passive element
+// segment holds `b` and `a`. The memory is initialized with 42 at address 0.
+std::array<Byte, 271> Wasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0d, 0x03, 0x60,
+    0x00, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x00, 0x02,
+    0x0c, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x04, 0x74, 0x69, 0x63, 0x6b, 0x00,
+    0x02, 0x03, 0x0a, 0x09, 0x00, 0x00, 0x01, 0x00, 0x02, 0x01, 0x00, 0x02,
+    0x00, 0x04, 0x04, 0x01, 0x70, 0x00, 0x03, 0x05, 0x03, 0x01, 0x00, 0x01,
+    0x06, 0x0b, 0x02, 0x70, 0x00, 0xd2, 0x02, 0x0b, 0x7f, 0x01, 0x41, 0x00,
+    0x0b, 0x07, 0x4e, 0x0a, 0x01, 0x61, 0x00, 0x01, 0x01, 0x62, 0x00, 0x02,
+    0x09, 0x63, 0x61, 0x6c, 0x6c, 0x54, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x03,
+    0x0a, 0x63, 0x61, 0x6c, 0x6c, 0x47, 0x6c, 0x6f, 0x62, 0x61, 0x6c, 0x00,
+    0x04, 0x08, 0x69, 0x6e, 0x69, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x00, 0x05,
+    0x05, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x00, 0x06, 0x04, 0x6c, 0x6f, 0x61,
+    0x64, 0x00, 0x07, 0x05, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x00, 0x09, 0x03,
+    0x74, 0x61, 0x62, 0x01, 0x00, 0x01, 0x67, 0x03, 0x00, 0x08, 0x01, 0x08,
+    0x09, 0x0d, 0x02, 0x00, 0x41, 0x00, 0x0b, 0x02, 0x01, 0x02, 0x01, 0x00,
+    0x02, 0x02, 0x01, 0x0a, 0x56, 0x09, 0x04, 0x00, 0x41, 0x01, 0x0b, 0x04,
+    0x00, 0x41, 0x02, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b,
+    0x0d, 0x00, 0x41, 0x02, 0x23, 0x00, 0x26, 0x00, 0x41, 0x02, 0x11, 0x00,
+    0x00, 0x0b, 0x0c, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x02, 0xfc, 0x0c,
+    0x01, 0x00, 0x0b, 0x0e, 0x00, 0x41, 0x00, 0x20, 0x00, 0x36, 0x02, 0x00,
+    0x41, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x07, 0x00, 0x41, 0x00, 0x28, 0x02,
+    0x00, 0x0b, 0x0b, 0x00, 0x10, 0x00, 0x23, 0x01, 0x41, 0x01, 0x6a, 0x24,
+    0x01, 0x0b, 0x04, 0x00, 0x23, 0x01, 0x0b, 0x0b, 0x0a, 0x01, 0x00, 0x41,
+    0x00, 0x0b, 0x04, 0x2a, 0x00, 0x00, 0x00};
+
+uint32_t TickCount = 0;
+
+class Tick : public Runtime::HostFunction<Tick> {
+public:
+  Expect<void> body(const Runtime::CallingFrame &) {
+    ++TickCount;
+    return {};
+  }
+};
+
+class EnvModule : public Runtime::Instance::ModuleInstance {
+public:
+  EnvModule() : ModuleInstance("env") {
+    addHostFunc("tick", std::make_unique<Tick>());
+  }
+};
+
+std::unique_ptr<AST::Module> loadModule(const Configure &Conf,
+                                        Span<const Byte> Code) {
+  Loader::Loader Load(Conf);
+  Validator::Validator Valid(Conf);
+  auto Mod = Load.parseModule(Code);
+  if (!Mod || !Valid.validate(**Mod)) {
+    return nullptr;
+  }
+  return std::move(*Mod);
+}
+
+// Invoke the exported function and return the i32 result, or 0 if none.
+uint32_t invoke(Executor::Executor &Exec,
+                const Runtime::Instance::ModuleInstance &ModInst,
+                std::string_view Name, std::vector<ValVariant> Params = {}) {
+  const auto *FuncInst = ModInst.findFuncExports(Name);
+  EXPECT_NE(FuncInst, nullptr);
+  if (FuncInst == nullptr) {
+    return 0;
+  }
+  std::vector<ValType> ParamTypes(Params.size(), ValType::I32);
+  auto Res = Exec.invoke(*FuncInst, Params, ParamTypes);
+  EXPECT_TRUE(Res);
+  if (!Res || Res->empty()) {
+    return 0;
+  }
+  return (*Res)[0].first.get<uint32_t>();
+}
+
+const Runtime::Instance::FunctionInstance *
+getTableRef(const Runtime::Instance::ModuleInstance &ModInst, uint32_t Idx) {
+  return retrieveFuncRef(*ModInst.findTableExports("tab")->getRefAddr(Idx));
+}
+
+void testTemplate(bool IsStarted) {
+  Configure Conf;
+  auto Mod = loadModule(Conf, Wasm);
+  ASSERT_TRUE(Mod);
+  Runtime::StoreManager StoreMgr;
+  Executor::Executor Exec(Conf);
+  EnvModule Env;
+  ASSERT_TRUE(Exec.registerModule(StoreMgr, Env));
+  TickCount = 0;
+
+  auto Tmpl = Exec.createTemplate(StoreMgr, *Mod, IsStarted);
+  ASSERT_TRUE(Tmpl);
+  EXPECT_EQ((*Tmpl)->isStarted(), IsStarted);
+  EXPECT_EQ(TickCount, IsStarted ? 1U : 0U);
+
+  auto CloneA = Exec.instantiateModule(StoreMgr, **Tmpl);
+  ASSERT_TRUE(CloneA);
+  auto CloneB = Exec.instantiateModule(StoreMgr, **Tmpl);
+  ASSERT_TRUE(CloneB);
+  // The start function is run before freezing or by every clone.
+  EXPECT_EQ(TickCount, IsStarted ? 1U : 2U);
+
+  for (const auto *Clone : {CloneA->get(), CloneB->get()}) {
+    EXPECT_EQ(invoke(Exec, *Clone, "count"), 1U);
+
+    // The function references in the table and the global are rebound to the
+    // functions of the clone.
+    const auto *FuncA = Clone->findFuncExports("a");
+    const auto *FuncB = Clone->findFuncExports("b");
+    EXPECT_EQ(getTableRef(*Clone, 0), FuncA);
+    EXPECT_EQ(getTableRef(*Clone, 1), FuncB);
+    EXPECT_EQ(retrieveFuncRef(Clone->findGlobalExports("g")->getValue()),
+              FuncB);
+    EXPECT_EQ(invoke(Exec, *Clone, "callTable", {UINT32_C(0)}), 1U);
+    EXPECT_EQ(invoke(Exec, *Clone, "callTable", {UINT32_C(1)}), 2U);
+    EXPECT_EQ(invoke(Exec, *Clone, "callGlobal"), 2U);
+    EXPECT_EQ(getTableRef(*Clone, 2), FuncB);
+
+    // So are the ones in the passive element segment.
+    invoke(Exec, *Clone, "initElem");
+    EXPECT_EQ(getTableRef(*Clone, 0), FuncB);
+    EXPECT_EQ(getTableRef(*Clone, 1), FuncA);
+    EXPECT_EQ(invoke(Exec, *Clone, "callTable", {UINT32_C(0)}), 2U);
+    EXPECT_EQ(invoke(Exec, *Clone, "callTable", {UINT32_C(1)}), 1U);
+  }
+
+  // The memories of the clones are independent after the writes.
+  EXPECT_EQ(invoke(Exec, **CloneA, "load"), 42U);
+  EXPECT_EQ(invoke(Exec, **CloneA, "store", {UINT32_C(7)}), 7U);
+  EXPECT_EQ(invoke(Exec, **CloneB, "load"), 42U);
+  EXPECT_EQ(invoke(Exec, **CloneB, "store", {UINT32_C(9)}), 9U);
+  EXPECT_EQ(invoke(Exec, **CloneA, "load"), 7U);
+  auto CloneC = Exec.instantiateModule(StoreMgr, **Tmpl);
+  ASSERT_TRUE(CloneC);
+  EXPECT_EQ(invoke(Exec, **CloneC, "load"), 42U);
+  EXPECT_EQ(invoke(Exec, **CloneB, "load"), 9U);
+}
+
+TEST(ModuleTemplateTest, Started) { testTemplate(true); }
+
+TEST(ModuleTemplateTest, NotStarted) { testTemplate(false); }
+
+TEST(ModuleTemplateTest, Unfreezable) {
+  // The module imports the memory `env.mem`.
+  std::array<Byte, 22> MemImport{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x02, 0x0c, 0x01, 0x03,
+      0x65, 0x6e, 0x76, 0x03, 0x6d, 0x65, 0x6d, 0x02, 0x00, 0x01};
+  Configure Conf;
+  auto Mod = loadModule(Conf, MemImport);
+  ASSERT_TRUE(Mod);
+  Runtime::StoreManager StoreMgr;
+  Executor::Executor Exec(Conf);
+  auto Tmpl = Exec.createTemplate(StoreMgr, *Mod);
+  ASSERT_FALSE(Tmpl);
+  EXPECT_EQ(Tmpl.error(), ErrCode::Value::UnfreezableModule);
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/loader/cacheTest.cpp - module cache unit tests ------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents unit tests of caching the validated modules.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/log.h"
+#include "loader/cache.h"
+#include "loader/loader.h"
+#include "validator/validator.h"
+#include "vm/vm.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace WasmEdge;
+
+// The module exports `sum` looping from the argument down to 1, `select`
+// branching by `br_table`, and `load` reading the data segment.
+std::array<Byte, 132> Wasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0a, 0x02, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00,
+    0x00, 0x01, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x17, 0x03, 0x03, 0x73,
+    0x75, 0x6d, 0x00, 0x00, 0x06, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x00,
+    0x01, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x02, 0x0a, 0x40, 0x03, 0x1b,
+    0x01, 0x01, 0x7f, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01,
+    0x20, 0x00, 0x41, 0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b,
+    0x20, 0x01, 0x0b, 0x1a, 0x00, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20,
+    0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b, 0x41, 0x0a, 0x0f, 0x0b, 0x41,
+    0x14, 0x0f, 0x0b, 0x41, 0x1e, 0x0b, 0x07, 0x00, 0x41, 0x00, 0x2d, 0x00,
+    0x01, 0x0b, 0x0b, 0x08, 0x01, 0x00, 0x41, 0x00, 0x0b, 0x02, 0x68, 0x69};
+
+std::unique_ptr<AST::Module> loadAndValidate(const Configure &Conf) {
+  Loader::Loader Load(Conf);
+  Validator::Validator Valid(Conf);
+  auto Mod = Load.parseModule(Wasm);
+  if (!Mod || !Valid.validate(**Mod)) {
+    return nullptr;
+  }
+  return std::move(*Mod);
+}
+
+std::filesystem::path getCachePath(const char *Name) {
+  return std::filesystem::temp_directory_path() /
+         std::filesystem::u8path(Name);
+}
+
+void expectSameJump(const AST::Instruction::JumpDescriptor &Expected,
+                    const AST::Instruction::JumpDescriptor &Got) {
+  EXPECT_EQ(Expected.TargetIndex, Got.TargetIndex);
+  EXPECT_EQ(Expected.StackEraseBegin, Got.StackEraseBegin);
+  EXPECT_EQ(Expected.StackEraseEnd, Got.StackEraseEnd);
+  EXPECT_EQ(Expected.PCOffset, Got.PCOffset);
+}
+
+std::vector<uint32_t> runModule(const Configure &Conf,
+                                const AST::Module &Mod) {
+  VM::VM VM(Conf);
+  std::vector<uint32_t> Rets;
+  if (!VM.loadWasm(Mod) || !VM.validate() || !VM.instantiate()) {
+    return Rets;
+  }
+  auto Collect = [&Rets](auto Res) {
+    if (Res && Res->size() == 1) {
+      Rets.push_back((*Res)[0].first.template get<uint32_t>());
+    }
+  };
+  Collect(VM.execute("sum", std::array{ValVariant(UINT32_C(10))},
+                     std::array{ValType::I32}));
+  for (uint32_t I = 0; I < 4; ++I) {
+    Collect(VM.execute("select", std::array{ValVariant(I)},
+                       std::array{ValType::I32}));
+  }
+  Collect(VM.execute("load"));
+  return Rets;
+}
+
+TEST(ModuleCacheTest, RoundTrip) {
+  Configure Conf;
+  auto Mod = loadAndValidate(Conf);
+  ASSERT_TRUE(Mod);
+  const auto Path = getCachePath("ModuleCacheTestRoundTrip");
+  ASSERT_TRUE(Loader::ModuleCache::store(Path, *Mod));
+  auto Restored = Loader::ModuleCache::load(Path);
+  ASSERT_TRUE(Restored);
+  EXPECT_TRUE(Restored->getIsValidated());
+
+  // The instructions keep the jump descriptors and the stack offsets computed
+  // by the validator.
+  const auto &Codes = Mod->getCodeSection().getContent();
+  const auto &RestoredCodes = Restored->getCodeSection().getContent();
+  ASSERT_EQ(Codes.size(), RestoredCodes.size());
+  for (size_t I = 0; I < Codes.size(); ++I) {
+    const auto Locals = Codes[I].getLocals();
+    const auto RestoredLocals = RestoredCodes[I].getLocals();
+    EXPECT_TRUE(std::equal(Locals.begin(), Locals.end(),
+                           RestoredLocals.begin(), RestoredLocals.end()));
+    const auto Instrs = Codes[I].getExpr().getInstrs();
+    const auto RestoredInstrs = RestoredCodes[I].getExpr().getInstrs();
+    ASSERT_EQ(Instrs.size(), RestoredInstrs.size());
+    for (size_t J = 0; J < Instrs.size(); ++J) {
+      const auto &Instr = Instrs[J];
+      const auto &Got = RestoredInstrs[J];
+      ASSERT_EQ(Instr.getOpCode(), Got.getOpCode());
+      EXPECT_EQ(Instr.getOffset(), Got.getOffset());
+      EXPECT_EQ(Instr.getBlockCost(), Got.getBlockCost());
+      EXPECT_EQ(Instr.isBlockSync(), Got.isBlockSync());
+      switch (Instr.getOpCode()) {
+      case OpCode::Block:
+      case OpCode::Loop:
+      case OpCode::If:
+        EXPECT_EQ(Instr.getJumpEnd(), Got.getJumpEnd());
+        EXPECT_EQ(Instr.getJumpElse(), Got.getJumpElse());
+        break;
+      case OpCode::Br:
+      case OpCode::Br_if:
+        expectSameJump(Instr.getJump(), Got.getJump());
+        break;
+      case OpCode::Br_table: {
+        const auto Labels = Instr.getLabelList();
+        const auto RestoredLabels = Got.getLabelList();
+        ASSERT_EQ(Labels.size(), RestoredLabels.size());
+        for (size_t K = 0; K < Labels.size(); ++K) {
+          expectSameJump(Labels[K], RestoredLabels[K]);
+        }
+        break;
+      }
+      case OpCode::Local__get:
+      case OpCode::Local__set:
+      case OpCode::Local__tee:
+        EXPECT_EQ(Instr.getStackOffset(), Got.getStackOffset());
+        break;
+      case OpCode::I32__const:
+        EXPECT_EQ(Instr.getNum().get<uint32_t>(),
+                  Got.getNum().get<uint32_t>());
+        break;
+      default:
+        break;
+      }
+    }
+  }
+
+  // The restored module runs the same as the freshly loaded one.
+  const auto Expected = runModule(Conf, *Mod);
+  EXPECT_EQ(Expected, (std::vector<uint32_t>{55, 10, 20, 30, 30, 0x69}));
+  EXPECT_EQ(runModule(Conf, *Restored), Expected);
+
+  std::error_code EC;
+  std::filesystem::remove(Path, EC);
+}
+
+TEST(ModuleCacheTest, BrokenFile) {
+  Configure Conf;
+  auto Mod = loadAndValidate(Conf);
+  ASSERT_TRUE(Mod);
+  const auto Path = getCachePath("ModuleCacheTestBrokenFile");
+  ASSERT_TRUE(Loader::ModuleCache::store(Path, *Mod));
+  std::vector<char> Content;
+  {
+    std::ifstream Fin(Path, std::ios::in | std::ios::binary);
+    Content.assign(std::istreambuf_iterator<char>(Fin),
+                   std::istreambuf_iterator<char>());
+  }
+  ASSERT_FALSE(Content.empty());
+  auto Rewrite = [&Path](const std::vector<char> &Bytes) {
+    std::ofstream Fout(Path,
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+    Fout.write(Bytes.data(), static_cast<std::streamsize>(Bytes.size()));
+  };
+
+  // Truncated files.
+  for (const size_t Size : {size_t(0), size_t(3), size_t(16),
+                            Content.size() / 2, Content.size() - 1}) {
+    Rewrite(std::vector<char>(Content.begin(),
+                              Content.begin() + static_cast<ptrdiff_t>(Size)));
+    EXPECT_FALSE(Loader::ModuleCache::load(Path)) << "size " << Size;
+  }
+
+  // Corrupted files, including the flipped bytes in the instructions which
+  // are still parsed.
+  for (const size_t Pos : {size_t(0), size_t(4), size_t(8), Content.size() / 2,
+                           Content.size() - 1}) {
+    auto Bytes = Content;
+    Bytes[Pos] = static_cast<char>(Bytes[Pos] ^ 0x01);
+    Rewrite(Bytes);
+    EXPECT_FALSE(Loader::ModuleCache::load(Path)) << "position " << Pos;
+  }
+
+  // Trailing garbage.
+  {
+    auto Bytes = Content;
+    Bytes.push_back(0);
+    Rewrite(Bytes);
+    EXPECT_FALSE(Loader::ModuleCache::load(Path));
+  }
+
+  // The intact file is still a hit.
+  Rewrite(Content);
+  EXPECT_TRUE(Loader::ModuleCache::load(Path));
+
+  std::error_code EC;
+  std::filesystem::remove(Path, EC);
+  EXPECT_FALSE(Loader::ModuleCache::load(Path));
+}
+
+TEST(ModuleCacheTest, ConcurrentStore) {
+  Configure Conf;
+  auto Mod = loadAndValidate(Conf);
+  ASSERT_TRUE(Mod);
+  const auto Dir = getCachePath("ModuleCacheTestConcurrentStore");
+  const auto Path = Dir / std::filesystem::u8path("module");
+  std::error_code EC;
+  std::filesystem::remove_all(Dir, EC);
+
+  // The writers of the same cache file never share the temporary file, so
+  // every store succeeds and leaves only the intact cache file.
+  std::atomic<uint32_t> Failures = 0;
+  std::vector<std::thread> Writers;
+  for (uint32_t I = 0; I < 8; ++I) {
+    Writers.emplace_back([&]() {
+      for (uint32_t J = 0; J < 20; ++J) {
+        if (!Loader::ModuleCache::store(Path, *Mod)) {
+          ++Failures;
+        }
+      }
+    });
+  }
+  for (auto &Writer : Writers) {
+    Writer.join();
+  }
+  EXPECT_EQ(Failures, 0U);
+  EXPECT_TRUE(Loader::ModuleCache::load(Path));
+  std::vector<std::filesystem::path> Files;
+  for (const auto &Entry : std::filesystem::directory_iterator(Dir)) {
+    Files.push_back(Entry.path());
+  }
+  EXPECT_EQ(Files, std::vector<std::filesystem::path>{Path});
+  std::filesystem::remove_all(Dir, EC);
+}
+
+TEST(ModuleCacheTest, Key) {
+  Configure Conf;
+  const auto Path = Loader::ModuleCache::getPath(Wasm, Conf);
+  EXPECT_EQ(Loader::ModuleCache::getPath(Wasm, Configure()), Path);
+
+  // The proposals change the key.
+  Configure RemovedConf;
+  RemovedConf.removeProposal(Proposal::SIMD);
+  EXPECT_NE(Loader::ModuleCache::getPath(Wasm, RemovedConf), Path);
+  Configure AddedConf;
+  AddedConf.addProposal(Proposal::TailCall);
+  EXPECT_NE(Loader::ModuleCache::getPath(Wasm, AddedConf), Path);
+  EXPECT_NE(Loader::ModuleCache::getPath(Wasm, AddedConf),
+            Loader::ModuleCache::getPath(Wasm, RemovedConf));
+
+  // The binary changes the key.
+  auto Modified = Wasm;
+  Modified.back() = 0x6a;
+  EXPECT_NE(Loader::ModuleCache::getPath(Modified, Conf), Path);
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -12,14 +12,29 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include "common/defines.h"
 #include "loader/filemgr.h"
+#include "loader/loader.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <sys/stat.h>
+#endif
+
 namespace {
 
 WasmEdge::FileMgr Mgr;
@@ -746,6 +761,138 @@ TEST(FileManagerTest, Vector__ReadSigned64TooLarge) {
   ASSERT_FALSE(ReadNum = Mgr.readS64());
   EXPECT_EQ(WasmEdge::ErrCode::Value::IntegerTooLarge, ReadNum.error());
 }
+
+TEST(FileManagerTest, Stream__ChunkedPush) {
+  // 36. Test reading the chunks pushed from another thread, with the reserved
+  // region and with the buffer for the capacity which cannot be reserved.
+  for (const uint64_t Capacity : {UINT64_C(4096), UINT64_C(1) << 62}) {
+    auto Stream = std::make_shared<WasmEdge::ByteStream>(Capacity);
+    std::thread Producer([Stream]() {
+      std::array<WasmEdge::Byte, 64> Chunk;
+      for (uint32_t I = 0; I < 16; ++I) {
+        Chunk.fill(static_cast<WasmEdge::Byte>(I));
+        EXPECT_TRUE(Stream->push(Chunk));
+      }
+      Stream->finish();
+    });
+    WasmEdge::FileMgr StreamMgr;
+    ASSERT_TRUE(StreamMgr.setStream(Stream));
+    for (uint32_t I = 0; I < 16 * 64; ++I) {
+      auto ReadByte = StreamMgr.readByte();
+      ASSERT_TRUE(ReadByte);
+      EXPECT_EQ(*ReadByte, I / 64);
+    }
+    auto ReadByte = StreamMgr.readByte();
+    ASSERT_FALSE(ReadByte);
+    EXPECT_EQ(WasmEdge::ErrCode::Value::UnexpectedEnd, ReadByte.error());
+    Producer.join();
+    EXPECT_FALSE(Stream->push(std::array<WasmEdge::Byte, 1>{0x00}));
+  }
+}
+
+TEST(FileManagerTest, Stream__CapacityExceeded) {
+  // 37. Test finishing the stream when the pushed data exceeds the capacity.
+  auto Stream = std::make_shared<WasmEdge::ByteStream>(100);
+  std::array<WasmEdge::Byte, 64> Chunk;
+  Chunk.fill(0x01);
+  EXPECT_TRUE(Stream->push(Chunk));
+  EXPECT_FALSE(Stream->push(Chunk));
+  EXPECT_FALSE(Stream->push(std::array<WasmEdge::Byte, 1>{0x00}));
+  WasmEdge::FileMgr StreamMgr;
+  ASSERT_TRUE(StreamMgr.setStream(Stream));
+  auto ReadBytes = StreamMgr.readBytes(64);
+  ASSERT_TRUE(ReadBytes);
+  EXPECT_EQ(*ReadBytes, std::vector<WasmEdge::Byte>(64, 0x01));
+  EXPECT_FALSE(StreamMgr.readByte());
+}
+
+TEST(FileManagerTest, Stream__Cancel) {
+  // 38. Test cancelling the stream from the consumer side.
+  auto Stream = std::make_shared<WasmEdge::ByteStream>(4096);
+  EXPECT_TRUE(Stream->push(std::array<WasmEdge::Byte, 1>{0x01}));
+  std::thread Waiter([Stream]() { EXPECT_EQ(Stream->wait(100), 1U); });
+  Stream->cancel();
+  Waiter.join();
+  EXPECT_TRUE(Stream->isCancelled());
+  EXPECT_FALSE(Stream->push(std::array<WasmEdge::Byte, 1>{0x02}));
+  EXPECT_EQ(Stream->wait(100), 1U);
+}
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+TEST(FileManagerTest, Stream__LoadPipe) {
+  // 39. Test loading the module from a pipe written in small chunks.
+  std::array<WasmEdge::Byte, 60> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+      0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+      0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x1d, 0x01, 0x1b, 0x01, 0x01, 0x7f,
+      0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+      0x7f, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b};
+  const auto Path = std::filesystem::temp_directory_path() /
+                    std::filesystem::u8path("filemgrTestPipe");
+  std::error_code EC;
+  std::filesystem::remove(Path, EC);
+  ASSERT_EQ(mkfifo(Path.c_str(), 0600), 0);
+  std::thread Writer([&Path, &Wasm]() {
+    std::ofstream Fout(Path, std::ios::out | std::ios::binary);
+    for (size_t I = 0; I < Wasm.size(); I += 7) {
+      Fout.write(reinterpret_cast<const char *>(Wasm.data() + I),
+                 static_cast<std::streamsize>(
+                     std::min(Wasm.size() - I, static_cast<size_t>(7))));
+      Fout.flush();
+    }
+  });
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Loader(Conf);
+  auto Mod = Loader.parseModule(Path);
+  Writer.join();
+  std::filesystem::remove(Path, EC);
+  ASSERT_TRUE(Mod);
+  EXPECT_EQ((*Mod)->getCodeSection().getContent().size(), 1U);
+  EXPECT_EQ((*Mod)->getExportSection().getContent().size(), 1U);
+}
+
+TEST(FileManagerTest, Stream__LoadEndless) {
+  // 40. Test the parsing error returning promptly on the endless streams,
+  // which are a character device and a pipe whose writer stays open.
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Loader(Conf);
+  if (std::filesystem::is_character_file("/dev/zero")) {
+    auto Start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(Loader.parseModule("/dev/zero"));
+    EXPECT_LT(std::chrono::steady_clock::now() - Start,
+              std::chrono::seconds(1));
+  }
+
+  const auto Path = std::filesystem::temp_directory_path() /
+                    std::filesystem::u8path("filemgrTestEndlessPipe");
+  std::error_code EC;
+  std::filesystem::remove(Path, EC);
+  ASSERT_EQ(mkfifo(Path.c_str(), 0600), 0);
+  std::mutex Mutex;
+  std::condition_variable Cond;
+  bool Parsed = false;
+  std::thread Writer([&]() {
+    std::ofstream Fout(Path, std::ios::out | std::ios::binary);
+    // Wrong version, and the pipe is kept open until the parsing returns.
+    Fout.write("\0asm\x02\0\0\0", 8);
+    Fout.flush();
+    std::unique_lock Lock(Mutex);
+    Cond.wait_for(Lock, std::chrono::seconds(5), [&]() { return Parsed; });
+  });
+  auto Start = std::chrono::steady_clock::now();
+  auto Mod = Loader.parseModule(Path);
+  auto Elapsed = std::chrono::steady_clock::now() - Start;
+  {
+    std::unique_lock Lock(Mutex);
+    Parsed = true;
+  }
+  Cond.notify_all();
+  Writer.join();
+  std::filesystem::remove(Path, EC);
+  EXPECT_FALSE(Mod);
+  EXPECT_LT(Elapsed, std::chrono::seconds(1));
+}
+#endif
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
@@ -337,6 +337,7 @@ TEST(InstructionTest, LoadBrTableControlInstruction) {
   //   2.  Load instruction with empty label vector.
   //   3.  Load instruction with label vector.
   //   4.  Load instruction with wrong length of label vector.
+  //   5.  Load instruction with the label vector length exceeding the body.
 
   Vec = {
       0x0AU, // Code section
@@ -390,6 +391,36 @@ TEST(InstructionTest, LoadBrTableControlInstruction) {
              // Missed vec[2] and label index
   };
   EXPECT_FALSE(Ldr.parseModule(prefixedVec(Vec)));
+
+  Vec = {
+      0x0AU,                             // Code section
+      0x0CU,                             // Content size = 12
+      0x01U,                             // Vector length = 1
+      0x0AU,                             // Code segment size = 10
+      0x00U,                             // Local vec(0)
+      0x0EU,                             // OpCode Br_table.
+      0x80U, 0x80U, 0x80U, 0x80U, 0x01U, // Vector length = 2^28
+      0x00U,                             // vec[0]
+      0x00U,                             // vec[1]
+      0x00U,                             // vec[2]
+      0x0BU                              // Expression End.
+  };
+  EXPECT_FALSE(Ldr.parseModule(prefixedVec(Vec)));
+
+  Vec = {
+      0x0AU,                      // Code section
+      0x0BU,                      // Content size = 11
+      0x01U,                      // Vector length = 1
+      0x09U,                      // Code segment size = 9
+      0x00U,                      // Local vec(0)
+      0x0EU,                      // OpCode Br_table.
+      0xFFU, 0xFFU, 0xFFU, 0x7FU, // Vector length = 2^28 - 1
+      0x00U,                      // vec[0]
+      0x00U,                      // vec[1]
+      0x00U,                      // vec[2]
+      0x0BU                       // Expression End.
+  };
+  EXPECT_FALSE(Ldr.parseModule(prefixedVec(Vec)));
 }
 
 TEST(InstructionTest, LoadCallControlInstruction) {
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/loader/parallelTest.cpp - parallel loading tests ----===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents unit tests of decoding and validating the code section
+/// in parallel.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/log.h"
+#include "loader/loader.h"
+#include "validator/validator.h"
+
+#include "../common/modulebuilder.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace WasmEdge;
+
+// The generated module is over the size thresholds of the parallel paths: the
+// code section has 1024 function bodies of 128 instructions.
+constexpr const uint32_t kFuncNum = 1024;
+constexpr const uint32_t kFuncInstrNum = 128;
+
+// Generate the module with `kFuncNum` functions of type `[] -> []`. The
+// function bodies are `nop`s except the ones given in `Bodies`, which are
+// the instructions before the `end`.
+std::vector<Byte> buildModule(
+    std::initializer_list<std::pair<uint32_t, std::vector<Byte>>> Bodies) {
+  std::vector<Test::Function> Funcs(
+      kFuncNum, {0, {0x00}, std::vector<Byte>(kFuncInstrNum - 1, 0x01)});
+  for (const auto &[Idx, Body] : Bodies) {
+    Funcs[Idx].Body = Body;
+  }
+  return Test::generateModule({{0x60, 0x00, 0x00}}, Funcs,
+                              {{0x05, {0x01, 0x00, 0x01}}});
+}
+
+// `memory.size` with the non-zero memory index.
+const std::vector<Byte> NonZeroIdxBody = {0x3F, 0x01, 0x1A};
+// The illegal opcode.
+const std::vector<Byte> IllegalBody = {0xFF};
+
+// Adding `i32` and `i64`.
+const std::vector<Byte> TypeMismatchBody = {0x41, 0x00, 0x42, 0x00, 0x6A, 0x1A};
+// `local.get` of the unknown local.
+const std::vector<Byte> UnknownLocalBody = {0x20, 0x05, 0x1A};
+
+Expect<std::unique_ptr<AST::Module>> load(Span<const Byte> Bin,
+                                          uint32_t Threads) {
+  Configure Conf;
+  Conf.getRuntimeConfigure().setLoadingThreads(Threads);
+  Loader::Loader Load(Conf);
+  return Load.parseModule(Bin);
+}
+
+Expect<void> validate(Span<const Byte> Bin, uint32_t Threads) {
+  Configure Conf;
+  Conf.getRuntimeConfigure().setLoadingThreads(Threads);
+  Loader::Loader Load(Conf);
+  Validator::Validator Valid(Conf);
+  auto Mod = Load.parseModule(Bin);
+  if (!Mod) {
+    return Unexpect(Mod);
+  }
+  return Valid.validate(**Mod);
+}
+
+TEST(ParallelLoadTest, Valid) {
+  const auto Bin = buildModule({});
+  auto Expected = load(Bin, 1);
+  ASSERT_TRUE(Expected);
+  for (const uint32_t Threads : {2U, 4U, 8U}) {
+    auto Mod = load(Bin, Threads);
+    ASSERT_TRUE(Mod);
+    const auto &Codes = (*Mod)->getCodeSection().getContent();
+    const auto &ExpectedCodes = (*Expected)->getCodeSection().getContent();
+    ASSERT_EQ(Codes.size(), ExpectedCodes.size());
+    for (size_t I = 0; I < Codes.size(); ++I) {
+      EXPECT_FALSE(Codes[I].isLazy());
+      EXPECT_EQ(Codes[I].getExpr().getInstrs().size(),
+                ExpectedCodes[I].getExpr().getInstrs().size());
+    }
+  }
+}
+
+TEST(ParallelLoadTest, LowestError) {
+  // Two broken function bodies at the end and the start of the adjacent
+  // chunks of the workers. The error of the lower one is reported whichever
+  // worker fails first.
+  ASSERT_NE(load(buildModule({{37, NonZeroIdxBody}}), 1).error(),
+            load(buildModule({{37, IllegalBody}}), 1).error());
+  for (const auto &[Low, High] :
+       {std::make_pair(NonZeroIdxBody, IllegalBody),
+        std::make_pair(IllegalBody, NonZeroIdxBody)}) {
+    const auto Bin = buildModule({{48, High}, {47, Low}});
+    const auto Expected = load(Bin, 1);
+    ASSERT_FALSE(Expected);
+    EXPECT_EQ(Expected.error(),
+              load(buildModule({{47, Low}}), 1).error());
+    for (const uint32_t Threads : {2U, 4U, 8U}) {
+      for (uint32_t Round = 0; Round < 64; ++Round) {
+        const auto Res = load(Bin, Threads);
+        ASSERT_FALSE(Res);
+        EXPECT_EQ(Res.error(), Expected.error()) << Threads << " threads";
+      }
+    }
+  }
+}
+
+TEST(ParallelValidateTest, Valid) {
+  const auto Bin = buildModule({});
+  for (const uint32_t Threads : {1U, 2U, 4U, 8U}) {
+    EXPECT_TRUE(validate(Bin, Threads)) << Threads << " threads";
+  }
+}
+
+TEST(ParallelValidateTest, LowestError) {
+  // Same as the loading, the error of the lower broken function body is
+  // reported by validating it again sequentially.
+  ASSERT_NE(validate(buildModule({{47, TypeMismatchBody}}), 1).error(),
+            validate(buildModule({{47, UnknownLocalBody}}), 1).error());
+  for (const auto &[Low, High] :
+       {std::make_pair(TypeMismatchBody, UnknownLocalBody),
+        std::make_pair(UnknownLocalBody, TypeMismatchBody)}) {
+    const auto Bin = buildModule({{48, High}, {47, Low}});
+    const auto Expected = validate(Bin, 1);
+    ASSERT_FALSE(Expected);
+    EXPECT_EQ(Expected.error(),
+              validate(buildModule({{47, Low}}), 1).error());
+    for (const uint32_t Threads : {2U, 4U, 8U}) {
+      for (uint32_t Round = 0; Round < 64; ++Round) {
+        const auto Res = validate(Bin, Threads);
+        ASSERT_FALSE(Res);
+        EXPECT_EQ(Res.error(), Expected.error()) << Threads << " threads";
+      }
+    }
+  }
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
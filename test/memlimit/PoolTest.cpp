@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/defines.h"
+#include "runtime/instance/memory.h"
+#include "system/allocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace {
+
+using WasmEdge::Allocator;
+using MemInst = WasmEdge::Runtime::Instance::MemoryInstance;
+
+// The pool only keeps the reserved regions on the platforms mapping the
+// linear memories with the guard regions.
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#if defined(__x86_64__) || defined(__aarch64__)
+#define POOL_ENABLED 1
+#endif
+#endif
+
+#if defined(POOL_ENABLED)
+
+TEST(MemPoolTest, Limit__Trim) {
+  Allocator::setPoolLimit(4);
+  EXPECT_EQ(Allocator::getPoolLimit(), 4U);
+  Allocator::reservePool(3);
+  EXPECT_EQ(Allocator::getPoolSize(), 3U);
+
+  // Reserving more than the limit stops at the limit.
+  Allocator::reservePool(8);
+  EXPECT_EQ(Allocator::getPoolSize(), 4U);
+
+  // Lowering the limit unmaps the regions over it.
+  Allocator::setPoolLimit(1);
+  EXPECT_EQ(Allocator::getPoolSize(), 1U);
+  Allocator::setPoolLimit(0);
+  EXPECT_EQ(Allocator::getPoolSize(), 0U);
+
+  // Nothing is kept while the pool is disabled.
+  auto *Pointer = Allocator::allocate(1);
+  ASSERT_NE(Pointer, nullptr);
+  Allocator::release(Pointer, 1);
+  EXPECT_EQ(Allocator::getPoolSize(), 0U);
+}
+
+TEST(MemPoolTest, Counter__HitMiss) {
+  Allocator::setPoolLimit(0);
+  Allocator::setPoolLimit(2);
+  const auto Hits = Allocator::getPoolHitCount();
+  const auto Misses = Allocator::getPoolMissCount();
+
+  // The empty pool misses and maps a new region.
+  auto *First = Allocator::allocate(1);
+  ASSERT_NE(First, nullptr);
+  EXPECT_EQ(Allocator::getPoolHitCount(), Hits);
+  EXPECT_EQ(Allocator::getPoolMissCount(), Misses + 1);
+
+  // The released region is recycled by the next allocation.
+  Allocator::release(First, 1);
+  EXPECT_EQ(Allocator::getPoolSize(), 1U);
+  auto *Second = Allocator::allocate(2);
+  ASSERT_NE(Second, nullptr);
+  EXPECT_EQ(Second, First);
+  EXPECT_EQ(Allocator::getPoolSize(), 0U);
+  EXPECT_EQ(Allocator::getPoolHitCount(), Hits + 1);
+  EXPECT_EQ(Allocator::getPoolMissCount(), Misses + 1);
+
+  Allocator::release(Second, 2);
+  Allocator::setPoolLimit(0);
+}
+
+TEST(MemPoolTest, Recycle__Zeroed) {
+  Allocator::setPoolLimit(0);
+  Allocator::setPoolLimit(1);
+  constexpr uint64_t kPageSize = UINT64_C(65536);
+
+  // Dirty a grown memory, then release it into the pool.
+  uint8_t *DirtyPtr = nullptr;
+  {
+    MemInst Inst(WasmEdge::AST::MemoryType(1));
+    ASSERT_NE(Inst.getDataPtr(), nullptr);
+    ASSERT_TRUE(Inst.growPage(2));
+    DirtyPtr = Inst.getDataPtr();
+    std::fill_n(DirtyPtr, 3 * kPageSize, static_cast<uint8_t>(0xA5));
+  }
+  ASSERT_EQ(Allocator::getPoolSize(), 1U);
+
+  // The recycled region reads back as zeros, including the pages beyond the
+  // new initial size which are committed by growing.
+  MemInst Inst(WasmEdge::AST::MemoryType(1));
+  ASSERT_EQ(Inst.getDataPtr(), DirtyPtr);
+  ASSERT_TRUE(Inst.growPage(2));
+  const auto *Data = Inst.getDataPtr();
+  EXPECT_TRUE(std::all_of(Data, Data + 3 * kPageSize,
+                          [](uint8_t B) { return B == 0; }));
+}
+
+#endif
+
+} // namespace
@@ -223,6 +223,59 @@ TEST(AsyncExecute, GasThreadTest) {
   }
 }
 
+TEST(AsyncExecute, LazyLoadingThreadTest) {
+  // The function bodies are prepared on their first calls racing in the
+  // threads. The body of `bad` is invalid, and `dispatch` calls the functions
+  // returning 42 and 7 through the table.
+  std::array<WasmEdge::Byte, 88> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0a, 0x02, 0x60,
+      0x00, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x03, 0x05, 0x04, 0x00,
+      0x00, 0x00, 0x01, 0x04, 0x04, 0x01, 0x70, 0x00, 0x02, 0x07, 0x12, 0x02,
+      0x03, 0x62, 0x61, 0x64, 0x00, 0x02, 0x08, 0x64, 0x69, 0x73, 0x70, 0x61,
+      0x74, 0x63, 0x68, 0x00, 0x03, 0x09, 0x08, 0x01, 0x00, 0x41, 0x00, 0x0b,
+      0x02, 0x00, 0x01, 0x0a, 0x17, 0x04, 0x04, 0x00, 0x41, 0x2a, 0x0b, 0x04,
+      0x00, 0x41, 0x07, 0x0b, 0x03, 0x00, 0x6a, 0x0b, 0x07, 0x00, 0x20, 0x00,
+      0x11, 0x00, 0x00, 0x0b};
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setLazyLoading(true);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(Wasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  {
+    std::array<WasmEdge::VM::Async<WasmEdge::Expect<std::vector<
+                   std::pair<WasmEdge::ValVariant, WasmEdge::ValType>>>>,
+               8>
+        AsyncResults;
+    for (uint32_t Index = 0; Index < AsyncResults.size(); ++Index) {
+      if (Index % 4 == 3) {
+        AsyncResults[Index] = VM.asyncExecute("bad");
+      } else {
+        AsyncResults[Index] = VM.asyncExecute(
+            "dispatch",
+            std::initializer_list<WasmEdge::ValVariant>{Index % 2},
+            {WasmEdge::ValType::I32});
+      }
+    }
+    for (uint32_t Index = 0; Index < AsyncResults.size(); ++Index) {
+      auto Result = AsyncResults[Index].get();
+      if (Index % 4 == 3) {
+        ASSERT_FALSE(Result);
+        EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::TypeCheckFailed);
+      } else {
+        ASSERT_TRUE(Result);
+        ASSERT_EQ((*Result)[0].second, WasmEdge::ValType::I32);
+        EXPECT_EQ((*Result)[0].first.get<uint32_t>(),
+                  Index % 2 == 0 ? 42U : 7U);
+      }
+    }
+  }
+  // The deferred error is kept for the later calls.
+  auto Result = VM.execute("bad");
+  ASSERT_FALSE(Result);
+  EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::TypeCheckFailed);
+}
+
 #ifdef WASMEDGE_BUILD_AOT_RUNTIME
 
 TEST(AOTAsyncExecute, ThreadTest) {
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/validator/formcheckerTest.cpp - form checker tests --===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents unit tests of checking the types of the function bodies,
+/// especially the block types referenced by the control frames.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/log.h"
+#include "loader/loader.h"
+#include "validator/validator.h"
+
+#include "../common/modulebuilder.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace WasmEdge;
+
+// The function types, which are also referenced as the block types:
+//   0: [] -> []
+//   1: [i32] -> [i32]
+//   2: [i32 i64] -> [i64]
+//   3: [] -> [i32 i32]
+const std::vector<std::vector<Byte>> Types = {
+    {0x60, 0x00, 0x00},
+    {0x60, 0x01, 0x7F, 0x01, 0x7F},
+    {0x60, 0x02, 0x7F, 0x7E, 0x01, 0x7E},
+    {0x60, 0x00, 0x02, 0x7F, 0x7F}};
+
+// Nest the instructions in the blocks of the given block type.
+std::vector<Byte> nest(uint32_t Depth, Byte BlockType,
+                       const std::vector<Byte> &Instrs) {
+  std::vector<Byte> Body;
+  for (uint32_t I = 0; I < Depth; ++I) {
+    Body.push_back(0x02);
+    Body.push_back(BlockType);
+  }
+  Body.insert(Body.end(), Instrs.begin(), Instrs.end());
+  Body.insert(Body.end(), Depth, 0x0B);
+  return Body;
+}
+
+Expect<void> validate(
+    const std::vector<std::pair<uint32_t, std::vector<Byte>>> &Bodies) {
+  Configure Conf;
+  Loader::Loader Load(Conf);
+  Validator::Validator Valid(Conf);
+  // Generate the module with the functions of the given type indices and the
+  // instructions before the `end`.
+  std::vector<Test::Function> Funcs;
+  for (const auto &[TypeIdx, Body] : Bodies) {
+    Funcs.push_back({TypeIdx, {0x00}, Body});
+  }
+  auto Mod = Load.parseModule(Test::generateModule(Types, Funcs));
+  if (!Mod) {
+    return Unexpect(Mod);
+  }
+  return Valid.validate(**Mod);
+}
+
+Expect<void> validate(uint32_t TypeIdx, const std::vector<Byte> &Body) {
+  return validate({{TypeIdx, Body}});
+}
+
+TEST(FormCheckerTest, BlockType) {
+  // `block (type 2)` takes the params from the stack in order.
+  EXPECT_TRUE(validate(0, {0x41, 0x01, 0x42, 0x02, 0x02, 0x02, 0x1A, 0x1A,
+                           0x42, 0x03, 0x0B, 0x1A}));
+  EXPECT_EQ(validate(0, {0x42, 0x02, 0x41, 0x01, 0x02, 0x02, 0x1A, 0x1A, 0x42,
+                         0x03, 0x0B, 0x1A})
+                .error(),
+            ErrCode::Value::TypeCheckFailed);
+  // `block (type 3)` returns multiple values to the function results.
+  EXPECT_TRUE(validate(3, {0x02, 0x03, 0x41, 0x01, 0x41, 0x02, 0x0B}));
+  EXPECT_EQ(validate(3, {0x02, 0x03, 0x41, 0x01, 0x0B}).error(),
+            ErrCode::Value::TypeCheckFailed);
+  // `block (result i32)` with the empty body.
+  EXPECT_EQ(validate(0, {0x02, 0x7F, 0x0B, 0x1A}).error(),
+            ErrCode::Value::TypeCheckFailed);
+  // The block type index out of the type section.
+  EXPECT_EQ(validate(0, {0x02, 0x09, 0x0B}).error(),
+            ErrCode::Value::InvalidFuncTypeIdx);
+  // The function result mismatched with the stack.
+  EXPECT_EQ(validate(1, {0x42, 0x00}).error(),
+            ErrCode::Value::TypeCheckFailed);
+}
+
+TEST(FormCheckerTest, LoopAndIf) {
+  // The branch to `loop (type 1)` takes the params of the loop.
+  EXPECT_TRUE(
+      validate(1, {0x20, 0x00, 0x03, 0x01, 0x41, 0x00, 0x0D, 0x00, 0x0B}));
+  EXPECT_EQ(validate(1, {0x20, 0x00, 0x03, 0x01, 0x1A, 0x42, 0x00, 0x0C, 0x00,
+                         0x0B})
+                .error(),
+            ErrCode::Value::TypeCheckFailed);
+  // `if (type 1)` without `else` passes the params through.
+  EXPECT_TRUE(validate(1, {0x20, 0x00, 0x20, 0x00, 0x04, 0x01, 0x0B}));
+  // `if (result i32)` without `else` leaves nothing on the other branch.
+  EXPECT_EQ(validate(1, {0x20, 0x00, 0x04, 0x7F, 0x41, 0x01, 0x0B}).error(),
+            ErrCode::Value::TypeCheckFailed);
+  // Both branches of `if (type 1)` with `else` return `i32`.
+  EXPECT_TRUE(validate(1, {0x20, 0x00, 0x20, 0x00, 0x04, 0x01, 0x05, 0x1A,
+                           0x41, 0x02, 0x0B}));
+  EXPECT_EQ(validate(1, {0x20, 0x00, 0x20, 0x00, 0x04, 0x01, 0x05, 0x1A, 0x42,
+                         0x02, 0x0B})
+                .error(),
+            ErrCode::Value::TypeCheckFailed);
+}
+
+TEST(FormCheckerTest, BrTable) {
+  // The labels of the same arity and types.
+  EXPECT_TRUE(validate(1, {0x02, 0x7F, 0x02, 0x7F, 0x20, 0x00, 0x20, 0x00,
+                           0x0E, 0x01, 0x00, 0x01, 0x0B, 0x0B}));
+  // The labels of the different arities.
+  EXPECT_EQ(validate(1, {0x02, 0x7F, 0x02, 0x40, 0x20, 0x00, 0x20, 0x00, 0x0E,
+                         0x01, 0x00, 0x01, 0x0B, 0x0B})
+                .error(),
+            ErrCode::Value::TypeCheckFailed);
+  // The labels of the different types.
+  EXPECT_EQ(validate(1, {0x02, 0x7F, 0x02, 0x7D, 0x20, 0x00, 0x20, 0x00, 0x0E,
+                         0x01, 0x00, 0x01, 0x0B, 0x0B})
+                .error(),
+            ErrCode::Value::TypeCheckFailed);
+  // The label out of the blocks.
+  EXPECT_EQ(validate(1, {0x02, 0x7F, 0x20, 0x00, 0x20, 0x00, 0x0E, 0x01, 0x00,
+                         0x03, 0x0B})
+                .error(),
+            ErrCode::Value::InvalidLabelIdx);
+}
+
+TEST(FormCheckerTest, DeepNesting) {
+  // The control frames of the nested blocks outlive the growing of the
+  // control stack.
+  EXPECT_TRUE(validate(1, nest(2000, 0x7F, {0x41, 0x01})));
+  EXPECT_EQ(validate(1, nest(2000, 0x7F, {0x42, 0x01})).error(),
+            ErrCode::Value::TypeCheckFailed);
+  EXPECT_TRUE(validate(3, nest(2000, 0x03, {0x41, 0x01, 0x41, 0x02})));
+  EXPECT_EQ(validate(3, nest(2000, 0x03, {0x41, 0x01})).error(),
+            ErrCode::Value::TypeCheckFailed);
+}
+
+TEST(FormCheckerTest, ReusedStacks) {
+  // The stacks are reused across the functions of a module, and the errors of
+  // the later functions are still reported.
+  const auto Deep = nest(2000, 0x7F, {0x41, 0x01});
+  EXPECT_TRUE(validate({{1, Deep}, {3, {0x41, 0x01, 0x41, 0x02}}, {1, Deep}}));
+  EXPECT_EQ(validate({{1, Deep}, {1, {0x20, 0x05}}}).error(),
+            ErrCode::Value::InvalidLocalIdx);
+  EXPECT_EQ(validate({{1, Deep}, {3, {0x41, 0x01}}}).error(),
+            ErrCode::Value::TypeCheckFailed);
+  EXPECT_EQ(validate({{3, {0x41, 0x01, 0x41, 0x02}}, {0, {0x0C, 0x01}}})
+                .error(),
+            ErrCode::Value::InvalidLabelIdx);
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}